@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/aligned_vector_allocation.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
@@ -55,6 +56,12 @@ DEAL_II_NAMESPACE_OPEN
  * assertions, and cut some unnecessary functionality. Note that this vector
  * is a bit more memory-consuming than std::vector because of alignment, so it
  * is recommended to only use this vector on long vectors.
+ *
+ * The memory is allocated through posix_memalign() by default. Different
+ * allocation strategies, e.g. placing the memory on huge pages or reusing
+ * previously freed memory blocks, can be selected for all objects through
+ * AlignedVectorAllocation::set_default_allocator() or for an individual object
+ * through set_allocator().
  */
 template <class T>
 class AlignedVector
@@ -224,6 +231,30 @@ public:
   void
   clear();
 
+  /**
+   * Set the allocator used for the memory of this object, overriding the
+   * default allocator set through
+   * AlignedVectorAllocation::set_default_allocator(). If memory has been
+   * allocated already, the elements are moved to memory obtained from the new
+   * allocator. The allocator is kept for the lifetime of the object,
+   * including calls to clear(), until this function is called again. Passing
+   * an empty pointer makes the object use the default allocator again.
+   *
+   * The allocator is associated with the memory of the object, which means
+   * that it is transferred along with the memory in move operations and
+   * swap(), whereas copies of the object use the default allocator.
+   */
+  void
+  set_allocator(
+    const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator);
+
+  /**
+   * Return the allocator set through set_allocator(), or an empty pointer if
+   * the object uses the default allocator.
+   */
+  std::shared_ptr<AlignedVectorAllocation::Allocator>
+  get_allocator() const;
+
   /**
    * Inserts an element at the end of the vector, increasing the vector size
    * by one. Note that the allocated size will double whenever the previous
@@ -518,11 +549,26 @@ private:
                     const std::size_t new_size,
                     const std::size_t new_allocated_size);
 
+  /**
+   * Same as above, but use the given @p allocator for the new memory region,
+   * or posix_memalign() if the pointer is empty. The flag
+   * @p is_object_allocator indicates whether the allocator has been set
+   * through set_allocator() and must hence be retained for future
+   * allocations.
+   */
+  void
+  allocate_and_move(
+    const std::size_t                                          old_size,
+    const std::size_t                                          new_size,
+    const std::size_t                                          new_alloc_size,
+    const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator,
+    const bool is_object_allocator);
+
   /**
    * A class that is used as the "deleter" for a `std::unique_ptr` object that
    * AlignedVector uses to store the memory used for the elements.
    *
-   * There are two ways the AlignedVector class can handle memory:
+   * There are three ways the AlignedVector class can handle memory:
    * - Allocation via `new[]` in reserve() where we call `posix_memalign()`
    *   to obtain a chunk of memory and then do placement-`new` to initialize
    *   memory. If this is what we have done, then we need to call the
@@ -542,6 +588,13 @@ private:
    *   following data: A pointer to the owning AlignedVector object to know
    *   which elements need to be destroyed, copies of the MPI window
    *   and communicator objects, and a couple of ancillary pieces of data.
+   * - Memory has been obtained from an allocator derived from
+   *   AlignedVectorAllocation::Allocator, either the one set through
+   *   set_allocator() or the one set through
+   *   AlignedVectorAllocation::set_default_allocator(). In that case, we need
+   *   to destroy the elements as in the first case, and then return the
+   *   memory to the allocator, for which we store a pointer to the allocator
+   *   and the size and alignment the memory was allocated with.
    *
    * A common idiom towards using `std::unique_ptr` with complex de-allocation
    * semantics is to use `std::unique_ptr<T, std::function<void (T*)>`
@@ -593,21 +646,14 @@ private:
    * action pointer point somewhere, but this case is expensive anyway and so
    * the extra dynamic memory allocation does little harm.
    *
-   * (One could in that case go even further: There is no really only one
-   * possible non-default action left, namely the MPI-based destruction of
-   * the shared-memory window. Instead of having the Deleter::DeleterActionBase
-   * class below, and the derived Deleter::MPISharedMemDeleterAction class, both
-   * with `virtual` functions, we could just get rid of the base class and make
-   * the member functions of the derived class non-`virtual`. We would then
-   * either store a pointer to an MPISharedMemDeleterAction object if the
-   * non-default action is requested, or a `nullptr` for the default action.
-   * Avoiding `virtual` functions would make these objects smaller by a few
-   * bytes, and the call to the `delete_array()` function marginally faster.
-   * That said, given that the Deleter::MPISharedMemDeleterAction object already
-   * stores all sorts of stuff and its execution is not cheap, these additional
-   * optimizations are probably not worth it. Instead, we kept the class
-   * hierarchy so that one could define other non-standard actions in the future
-   * through other derived classes.)
+   * The same holds for memory obtained from a user-selected allocator, where
+   * the dynamic memory allocation of the action object is cheap compared to
+   * the allocations the user-selected strategy is meant for. The action
+   * object for this case, Deleter::AllocatorDeleterAction, also stores whether
+   * the allocator was selected for the owning object specifically, which
+   * allows the object to keep its allocator across re-allocations and calls to
+   * clear() without storing an additional member variable in every
+   * AlignedVector object.
    */
   class Deleter
   {
@@ -619,6 +665,23 @@ private:
      */
     Deleter(AlignedVector<T> *owning_object);
 
+    /**
+     * Constructor. When this constructor is called, it installs an action
+     * that corresponds to memory that has been obtained from an allocator
+     * derived from AlignedVectorAllocation::Allocator, which needs to be
+     * returned to that allocator. The arguments @p n_bytes and @p alignment
+     * are the ones the memory has been allocated with, and
+     * @p is_object_allocator indicates whether the allocator has been set
+     * specifically for the owning object through
+     * AlignedVector::set_allocator().
+     */
+    Deleter(
+      AlignedVector<T>                                          *owning_object,
+      const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator,
+      const std::size_t                                          n_bytes,
+      const std::size_t                                          alignment,
+      const bool is_object_allocator);
+
 #ifdef DEAL_II_WITH_MPI
     /**
      * Constructor. When this constructor is called, it installs an
@@ -652,6 +715,14 @@ private:
     void
     reset_owning_object(const AlignedVector<T> *new_aligned_vector_ptr);
 
+    /**
+     * Return the allocator that has been set for the owning object through
+     * AlignedVector::set_allocator(), or an empty pointer if the memory is
+     * handled through any other action.
+     */
+    std::shared_ptr<AlignedVectorAllocation::Allocator>
+    get_object_allocator() const;
+
   private:
     /**
      * Base class for the action necessary to de-allocate memory.
@@ -673,6 +744,50 @@ private:
       delete_array(const AlignedVector<T> *owning_aligned_vector, T *ptr) = 0;
     };
 
+    /**
+     * A class that implements the deleter action for data allocated through
+     * an object derived from AlignedVectorAllocation::Allocator.
+     */
+    class AllocatorDeleterAction : public DeleterActionBase
+    {
+    public:
+      /**
+       * Constructor. Store the allocator and the arguments the memory has
+       * been allocated with.
+       */
+      AllocatorDeleterAction(
+        const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator,
+        const std::size_t                                          n_bytes,
+        const std::size_t                                          alignment,
+        const bool is_object_allocator);
+
+      /**
+       * The function that implements the action of de-allocating memory.
+       * It receives as arguments a pointer to the owning AlignedVector object
+       * as well as a pointer to the memory being de-allocated.
+       */
+      virtual void
+      delete_array(const AlignedVector<T> *aligned_vector, T *ptr) override;
+
+      /**
+       * The allocator the memory has been obtained from.
+       */
+      const std::shared_ptr<AlignedVectorAllocation::Allocator> allocator;
+
+      /**
+       * The number of bytes and the alignment the memory has been allocated
+       * with.
+       */
+      const std::size_t n_bytes;
+      const std::size_t alignment;
+
+      /**
+       * Whether the allocator has been set through
+       * AlignedVector::set_allocator().
+       */
+      const bool is_object_allocator;
+    };
+
 #ifdef DEAL_II_WITH_MPI
 
     /**
@@ -1101,6 +1216,23 @@ inline AlignedVector<T>::Deleter::Deleter(AlignedVector<T> *owning_object)
 {}
 
 
+
+template <typename T>
+inline AlignedVector<T>::Deleter::Deleter(
+  AlignedVector<T>                                          *owning_object,
+  const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator,
+  const std::size_t                                          n_bytes,
+  const std::size_t                                          alignment,
+  const bool is_object_allocator)
+  : deleter_action_object(
+      std::make_unique<AllocatorDeleterAction>(allocator,
+                                               n_bytes,
+                                               alignment,
+                                               is_object_allocator))
+  , owning_aligned_vector(owning_object)
+{}
+
+
 #  ifdef DEAL_II_WITH_MPI
 
 template <typename T>
@@ -1156,6 +1288,54 @@ AlignedVector<T>::Deleter::reset_owning_object(
 }
 
 
+
+template <typename T>
+inline std::shared_ptr<AlignedVectorAllocation::Allocator>
+AlignedVector<T>::Deleter::get_object_allocator() const
+{
+  if (const auto *action = dynamic_cast<const AllocatorDeleterAction *>(
+        deleter_action_object.get()))
+    if (action->is_object_allocator)
+      return action->allocator;
+  return {};
+}
+
+
+
+template <typename T>
+inline AlignedVector<T>::Deleter::AllocatorDeleterAction::
+  AllocatorDeleterAction(
+    const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator,
+    const std::size_t                                          n_bytes,
+    const std::size_t                                          alignment,
+    const bool is_object_allocator)
+  : allocator(allocator)
+  , n_bytes(n_bytes)
+  , alignment(alignment)
+  , is_object_allocator(is_object_allocator)
+{}
+
+
+
+template <typename T>
+inline void
+AlignedVector<T>::Deleter::AllocatorDeleterAction::delete_array(
+  const AlignedVector<T> *aligned_vector,
+  T                      *ptr)
+{
+  if (ptr != nullptr)
+    {
+      Assert(aligned_vector->used_elements_end != nullptr, ExcInternalError());
+
+      if (std::is_trivially_destructible_v<T> == false)
+        for (T *p = aligned_vector->used_elements_end - 1; p >= ptr; --p)
+          p->~T();
+
+      allocator->deallocate(ptr, n_bytes, alignment);
+    }
+}
+
+
 #  ifdef DEAL_II_WITH_MPI
 
 template <typename T>
@@ -1434,23 +1614,60 @@ inline void
 AlignedVector<T>::allocate_and_move(const std::size_t old_size,
                                     const std::size_t new_size,
                                     const std::size_t new_allocated_size)
+{
+  // use the allocator set for this object, if any, or otherwise the default
+  // allocator. the check of the flag avoids locking the mutex that guards
+  // the default allocator in the common case that none has been set
+  std::shared_ptr<AlignedVectorAllocation::Allocator> allocator =
+    elements.get_deleter().get_object_allocator();
+  const bool is_object_allocator = (allocator != nullptr);
+  if (is_object_allocator == false &&
+      AlignedVectorAllocation::internal::default_allocator_is_set)
+    allocator = AlignedVectorAllocation::get_default_allocator();
+
+  allocate_and_move(
+    old_size, new_size, new_allocated_size, allocator, is_object_allocator);
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::allocate_and_move(
+  const std::size_t                                          old_size,
+  const std::size_t                                          new_size,
+  const std::size_t                                          new_alloc_size,
+  const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator,
+  const bool is_object_allocator)
 {
   // allocate and align along 64-byte boundaries (this is enough for all
   // levels of vectorization currently supported by deal.II)
-  T *new_data_ptr;
-  Utilities::System::posix_memalign(reinterpret_cast<void **>(&new_data_ptr),
-                                    64,
-                                    new_size * sizeof(T));
+  constexpr std::size_t alignment = 64;
+  T                    *new_data_ptr;
+  if (allocator == nullptr)
+    Utilities::System::posix_memalign(reinterpret_cast<void **>(&new_data_ptr),
+                                      alignment,
+                                      new_size * sizeof(T));
+  else
+    new_data_ptr =
+      static_cast<T *>(allocator->allocate(new_size * sizeof(T), alignment));
 
   // Now create a deleter that encodes what should happen when the object is
   // released: We need to destroy the objects that are currently alive (in
   // reverse order, and then release the memory. Note that we catch the
   // 'this' pointer because the number of elements currently alive might
-  // change over time.
-  Deleter deleter(this);
+  // change over time. Memory obtained from an allocator also needs to be
+  // returned to that allocator.
+  Deleter deleter =
+    (allocator == nullptr ? Deleter(this) :
+                            Deleter(this,
+                                    allocator,
+                                    new_size * sizeof(T),
+                                    alignment,
+                                    is_object_allocator));
 
   // copy whatever elements we need to retain
-  if (new_allocated_size > 0)
+  if (new_alloc_size > 0)
     dealii::internal::AlignedVectorMoveConstruct<T *, T>(
       elements.get(), elements.get() + old_size, new_data_ptr);
 
@@ -1512,6 +1729,52 @@ AlignedVector<T>::shrink_to_fit()
 
 
 
+template <class T>
+inline void
+AlignedVector<T>::set_allocator(
+  const std::shared_ptr<AlignedVectorAllocation::Allocator> &allocator)
+{
+  if constexpr (running_in_debug_mode())
+    {
+      Assert(replicated_across_communicator == false,
+             ExcAlignedVectorChangeAfterReplication());
+    }
+
+  const size_type used_size      = used_elements_end - elements.get();
+  const size_type allocated_size = allocated_elements_end - elements.get();
+  if (allocated_size > 0)
+    {
+      // move the elements to memory obtained from the new allocator, which
+      // also installs the deleter that retains the allocator
+      std::shared_ptr<AlignedVectorAllocation::Allocator> new_allocator =
+        allocator;
+      if (allocator == nullptr &&
+          AlignedVectorAllocation::internal::default_allocator_is_set)
+        new_allocator = AlignedVectorAllocation::get_default_allocator();
+      allocate_and_move(used_size,
+                        allocated_size,
+                        used_size,
+                        new_allocator,
+                        allocator != nullptr);
+    }
+  else if (allocator != nullptr)
+    elements = decltype(elements)(nullptr,
+                                  Deleter(this, allocator, 0, 64, true));
+  else
+    elements = decltype(elements)(nullptr, Deleter(this));
+}
+
+
+
+template <class T>
+inline std::shared_ptr<AlignedVectorAllocation::Allocator>
+AlignedVector<T>::get_allocator() const
+{
+  return elements.get_deleter().get_object_allocator();
+}
+
+
+
 template <class T>
 inline void
 AlignedVector<T>::clear()
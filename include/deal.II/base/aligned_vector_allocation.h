@@ -0,0 +1,298 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_aligned_vector_allocation_h
+#define dealii_aligned_vector_allocation_h
+
+#include <deal.II/base/config.h>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A namespace for the strategies with which AlignedVector obtains and
+ * releases the memory for its elements. By default, AlignedVector allocates
+ * its memory through Utilities::System::posix_memalign() and releases it
+ * through `std::free()`. Different strategies can be installed by deriving
+ * from the Allocator class, either globally for all AlignedVector objects
+ * through set_default_allocator(), or for an individual object through
+ * AlignedVector::set_allocator(). This includes the vectors that are built
+ * on top of AlignedVector, such as Vector, and the data structures of the
+ * matrix-free framework. The following strategies are provided:
+ * - Standard: the default behavior of AlignedVector. This class can be used
+ *   to opt individual objects out of a different global default.
+ * - HugePages: large allocations are aligned to the 2 MB boundaries of huge
+ *   pages and the operating system is asked to back them with transparent
+ *   huge pages, reducing the number of TLB misses when streaming through
+ *   vectors of many megabytes or gigabytes.
+ * - Pool: freed memory blocks are kept and handed out again for requests of
+ *   the same size, avoiding the cost of repeated system allocations, and of
+ *   the page faults on fresh memory, for temporary vectors.
+ *
+ * The placement of memory on the NUMA domains of a compute node is not
+ * controlled by the allocator: operating systems place a page on the NUMA
+ * domain of the thread that first writes to it. Vector and
+ * LinearAlgebra::distributed::Vector initialize their memory with the same
+ * partitioning of the index range onto threads as the one used in the vector
+ * operations, which places the entries close to the threads working on them.
+ * Allocators that use a NUMA library to place memory explicitly can be
+ * written by deriving from the Allocator class.
+ *
+ * @ingroup memory
+ */
+namespace AlignedVectorAllocation
+{
+  /**
+   * The interface for the strategies to allocate and release memory used by
+   * AlignedVector. Since AlignedVector objects are created and destroyed from
+   * several threads at the same time, derived classes must make the
+   * allocate() and deallocate() functions thread-safe.
+   *
+   * AlignedVector keeps a `std::shared_ptr` to the allocator along with each
+   * memory block it allocated, so the allocator is only destroyed after all
+   * memory allocated through it has been released again.
+   */
+  class Allocator
+  {
+  public:
+    /**
+     * Destructor.
+     */
+    virtual ~Allocator() = default;
+
+    /**
+     * Allocate a memory block of @p n_bytes bytes whose address is a multiple
+     * of @p alignment. For a size of zero, implementations may return a
+     * `nullptr`.
+     */
+    virtual void *
+    allocate(const std::size_t n_bytes, const std::size_t alignment) = 0;
+
+    /**
+     * Release the memory block @p ptr, which has been obtained through a call
+     * to allocate() with the same arguments @p n_bytes and @p alignment. The
+     * @p ptr argument may be a `nullptr`.
+     */
+    virtual void
+    deallocate(void             *ptr,
+               const std::size_t n_bytes,
+               const std::size_t alignment) = 0;
+  };
+
+
+
+  /**
+   * The default allocation strategy of AlignedVector, allocating memory
+   * through Utilities::System::posix_memalign() and releasing it through
+   * `std::free()`.
+   */
+  class Standard : public Allocator
+  {
+  public:
+    virtual void *
+    allocate(const std::size_t n_bytes, const std::size_t alignment) override;
+
+    virtual void
+    deallocate(void             *ptr,
+               const std::size_t n_bytes,
+               const std::size_t alignment) override;
+  };
+
+
+
+  /**
+   * An allocation strategy that places large memory blocks on huge pages.
+   * Memory blocks of at least the size given to the constructor are aligned
+   * to the huge page size of 2 MB, their size is rounded up to a multiple of
+   * the huge page size, and on Linux, the kernel is asked through
+   * `madvise(MADV_HUGEPAGE)` to back the block by transparent huge pages.
+   * With the 4 kB pages used otherwise, a vector of one gigabyte spans more
+   * than 250,000 pages, many more than the translation lookaside buffer (TLB)
+   * of a processor can hold, so that bandwidth-bound operations like the
+   * vector updates in iterative solvers or the cell loops of matrix-free
+   * operator evaluation suffer from frequent TLB misses. Huge pages reduce
+   * the number of pages by a factor of 512.
+   *
+   * Whether huge pages are actually used depends on the configuration of the
+   * operating system: the setting in
+   * `/sys/kernel/mm/transparent_hugepage/enabled` must be either `always` or
+   * `madvise`. On other operating systems, the memory is only aligned and
+   * the operating system decides about the page size. Smaller memory blocks
+   * are allocated as in the Standard strategy to not waste memory through
+   * the rounding to the huge page size.
+   */
+  class HugePages : public Allocator
+  {
+  public:
+    /**
+     * The size of huge pages in bytes.
+     */
+    static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+    /**
+     * Constructor. Memory blocks with at least @p threshold bytes are placed
+     * on huge pages.
+     */
+    HugePages(const std::size_t threshold = huge_page_size);
+
+    virtual void *
+    allocate(const std::size_t n_bytes, const std::size_t alignment) override;
+
+    virtual void
+    deallocate(void             *ptr,
+               const std::size_t n_bytes,
+               const std::size_t alignment) override;
+
+  private:
+    /**
+     * The minimal size of memory blocks placed on huge pages.
+     */
+    const std::size_t threshold;
+  };
+
+
+
+  /**
+   * An allocation strategy that keeps memory blocks that are released and
+   * reuses them for subsequent requests of the same size and alignment.
+   * This avoids repeated calls to the system allocator, and the page faults
+   * when first writing to freshly allocated memory, in codes that repeatedly
+   * create and destroy temporary vectors of the same sizes, e.g. in
+   * time-stepping loops. The memory blocks are obtained from and eventually
+   * returned to an underlying allocator given to the constructor, which
+   * allows to combine the pool with the HugePages strategy.
+   *
+   * The memory kept in the pool is released in the destructor, or earlier
+   * through a call to release_unused_memory(). Since AlignedVector keeps a
+   * `std::shared_ptr` to the allocator of each memory block, the destructor
+   * only runs after all vectors using the pool have released their memory.
+   */
+  class Pool : public Allocator
+  {
+  public:
+    /**
+     * Constructor. The memory blocks are allocated through @p underlying, or
+     * through the Standard strategy if the pointer is empty. At most @p
+     * max_pooled_bytes bytes are kept for reuse, memory blocks released
+     * beyond this limit are returned to the underlying allocator.
+     */
+    Pool(const std::shared_ptr<Allocator> &underlying = {},
+         const std::size_t max_pooled_bytes = static_cast<std::size_t>(-1));
+
+    /**
+     * Destructor. Returns all memory kept for reuse to the underlying
+     * allocator.
+     */
+    virtual ~Pool() override;
+
+    virtual void *
+    allocate(const std::size_t n_bytes, const std::size_t alignment) override;
+
+    virtual void
+    deallocate(void             *ptr,
+               const std::size_t n_bytes,
+               const std::size_t alignment) override;
+
+    /**
+     * Return the memory blocks kept for reuse to the underlying allocator.
+     */
+    void
+    release_unused_memory();
+
+    /**
+     * Return the number of bytes in the memory blocks that are currently
+     * kept for reuse.
+     */
+    std::size_t
+    n_pooled_bytes() const;
+
+  private:
+    /**
+     * The allocator used to obtain and release the memory blocks.
+     */
+    const std::shared_ptr<Allocator> underlying;
+
+    /**
+     * The maximal number of bytes kept for reuse.
+     */
+    const std::size_t max_pooled_bytes;
+
+    /**
+     * A mutex to guard the access to the free blocks from several threads.
+     */
+    mutable std::mutex mutex;
+
+    /**
+     * The free memory blocks, sorted by their size in bytes and the
+     * alignment they have been allocated with.
+     */
+    std::multimap<std::pair<std::size_t, std::size_t>, void *> free_blocks;
+
+    /**
+     * The number of bytes in #free_blocks.
+     */
+    std::size_t pooled_bytes;
+  };
+
+
+
+  /**
+   * Set the allocator used by all AlignedVector objects for which no
+   * allocator has been set through AlignedVector::set_allocator(). The
+   * setting takes effect for allocations made after the call to this
+   * function; memory allocated before is released through the allocator it
+   * has been obtained from. Passing an empty pointer restores the default
+   * behavior of using posix_memalign() and `std::free()`.
+   *
+   * The following code places the memory of all large vectors on huge
+   * pages:
+   * @code
+   *   AlignedVectorAllocation::set_default_allocator(
+   *     std::make_shared<AlignedVectorAllocation::HugePages>());
+   * @endcode
+   */
+  void
+  set_default_allocator(const std::shared_ptr<Allocator> &allocator);
+
+  /**
+   * Return the allocator set through set_default_allocator(), or an empty
+   * pointer if none has been set.
+   */
+  std::shared_ptr<Allocator>
+  get_default_allocator();
+
+  namespace internal
+  {
+    /**
+     * A flag indicating whether an allocator has been set through
+     * set_default_allocator(), which allows AlignedVector to skip the
+     * synchronized access to the default allocator in the common case that
+     * none has been set.
+     */
+    extern std::atomic<bool> default_allocator_is_set;
+  } // namespace internal
+} // namespace AlignedVectorAllocation
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
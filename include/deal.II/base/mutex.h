@@ -18,7 +18,11 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/exceptions.h>
+
+#include <cstddef>
 #include <mutex>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -73,6 +77,60 @@ namespace Threads
       return *this;
     }
   };
+
+
+
+  /**
+   * A fixed number of mutexes, one of which is selected by an index such as
+   * the number of a row of a matrix. This allows several threads to write
+   * into different parts of one large object at the same time, for example
+   * into a sparse matrix in
+   * AffineConstraints::distribute_local_to_global(), while each part is
+   * guarded against concurrent modification. Since one mutex per part of
+   * the object would cost too much memory, all indices that agree modulo
+   * the number of mutexes share the same one (a technique often called
+   * "lock striping"). As long as the number of mutexes is large compared to
+   * the number of threads, two threads rarely have to wait for each other.
+   *
+   * Like Mutex, this class can be copied, with the copy getting its own,
+   * unlocked mutexes.
+   */
+  class StripedMutex
+  {
+  public:
+    /**
+     * Constructor. Create @p n_stripes mutexes.
+     */
+    explicit StripedMutex(const unsigned int n_stripes = 4096)
+      : mutexes(n_stripes)
+    {
+      Assert(n_stripes > 0, ExcMessage("At least one mutex is needed."));
+    }
+
+    /**
+     * Return the mutex responsible for the given index.
+     */
+    Mutex &
+    get(const std::size_t index)
+    {
+      return mutexes[index % mutexes.size()];
+    }
+
+    /**
+     * Return the number of mutexes stored by this object.
+     */
+    unsigned int
+    n_stripes() const
+    {
+      return mutexes.size();
+    }
+
+  private:
+    /**
+     * The mutexes.
+     */
+    std::vector<Mutex> mutexes;
+  };
 } // namespace Threads
 
 /**
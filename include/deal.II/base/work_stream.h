@@ -1641,6 +1641,108 @@ namespace WorkStream
 
 
 
+  /**
+   * A variant of the run() function above for copier functions that may be
+   * called concurrently from several threads. The functions above call the
+   * copier for one item at a time, in the order of the items, which
+   * serializes the assembly of the global objects as soon as the worker is
+   * cheap compared to the copier. If the copier protects the global objects
+   * by other means, for example by calling
+   * AffineConstraints::distribute_local_to_global() with a
+   * Threads::StripedMutex object that locks individual rows of a matrix,
+   * this is unnecessary. This function then calls the copier on the same
+   * thread directly after the worker, in no particular order, and with
+   * several copiers running at the same time.
+   *
+   * This is equivalent to calling the colored version of run() above with
+   * all iterators put into a single color.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run_with_concurrent_copiers(
+    const Iterator                             &begin,
+    const std_cxx20::type_identity_t<Iterator> &end,
+    Worker                                      worker,
+    Copier                                      copier,
+    const ScratchData                          &sample_scratch_data,
+    const CopyData                             &sample_copy_data,
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    Assert(queue_length > 0,
+           ExcMessage("The queue length must be at least one, and preferably "
+                      "larger than the number of processors on this system."));
+    (void)queue_length; // removes -Wunused-parameter warning in optimized mode
+    Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
+    (void)chunk_size; // removes -Wunused-parameter warning in optimized mode
+
+    // If no work then skip. (only use operator!= for iterators since we may
+    // not have an equality comparison operator)
+    if (!(begin != end))
+      return;
+
+    if (MultithreadInfo::n_threads() > 1)
+      {
+#  if defined(DEAL_II_WITH_TBB) || defined(DEAL_II_WITH_TASKFLOW)
+        std::vector<std::vector<Iterator>> all_iterators(1);
+        for (Iterator p = begin; p != end; ++p)
+          all_iterators[0].push_back(p);
+
+        run(all_iterators,
+            worker,
+            copier,
+            sample_scratch_data,
+            sample_copy_data,
+            queue_length,
+            chunk_size);
+
+        // exit this function to not run the sequential version below:
+        return;
+#  endif
+      }
+
+    // no TBB or Taskflow installed or we are requested to run sequentially:
+    internal::sequential::run(
+      begin, end, worker, copier, sample_scratch_data, sample_copy_data);
+  }
+
+
+
+  /**
+   * Same as the function above, but for deal.II's IteratorRange.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run_with_concurrent_copiers(
+    const IteratorRange<Iterator> &iterator_range,
+    Worker                         worker,
+    Copier                         copier,
+    const ScratchData             &sample_scratch_data,
+    const CopyData                &sample_copy_data,
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    // Call the function above
+    run_with_concurrent_copiers(iterator_range.begin(),
+                                iterator_range.end(),
+                                worker,
+                                copier,
+                                sample_scratch_data,
+                                sample_copy_data,
+                                queue_length,
+                                chunk_size);
+  }
+
+
+
   template <typename Worker,
             typename Copier,
             typename Iterator,
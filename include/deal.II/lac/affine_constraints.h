@@ -20,6 +20,7 @@
 #include <deal.II/base/enable_observer_pointer.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/mutex.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_local_storage.h>
@@ -1702,6 +1703,46 @@ public:
                              VectorType                   &global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Same as the previous function, but the function may be called
+   * concurrently from several threads for the same @p global_matrix and
+   * @p global_vector, even if the calls write into the same rows. Before
+   * writing into a row of the matrix and the vector, the function locks the
+   * mutex of @p row_mutexes that is responsible for this row, so several
+   * threads can write into different rows at the same time while writes
+   * into the same row are serialized.
+   *
+   * This allows the copier functions of an assembly loop to run in
+   * parallel rather than one after the other, see
+   * WorkStream::run_with_concurrent_copiers(). The same @p row_mutexes
+   * object has to be passed to all concurrent calls writing into the same
+   * global objects.
+   *
+   * @p VectorType must allow concurrent write access to different elements,
+   * which is the case for Vector and LinearAlgebra::distributed::Vector.
+   * Since the order in which the contributions are added to an element
+   * depends on the scheduling of the threads, the result may differ from
+   * the one of a sequential assembly by roundoff.
+   */
+  template <typename VectorType>
+  void
+  distribute_local_to_global(const FullMatrix<number>     &local_matrix,
+                             const Vector<number>         &local_vector,
+                             const std::vector<size_type> &local_dof_indices,
+                             SparseMatrix<number>         &global_matrix,
+                             VectorType                   &global_vector,
+                             const bool             use_inhomogeneities_for_rhs,
+                             Threads::StripedMutex &row_mutexes) const;
+
+  /**
+   * Same as the previous function, but for assembling only a matrix.
+   */
+  void
+  distribute_local_to_global(const FullMatrix<number>     &local_matrix,
+                             const std::vector<size_type> &local_dof_indices,
+                             SparseMatrix<number>         &global_matrix,
+                             Threads::StripedMutex        &row_mutexes) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -2280,6 +2321,21 @@ private:
                              const bool use_inhomogeneities_for_rhs,
                              const std::bool_constant<false>) const;
 
+  /**
+   * Same as the previous function, but if @p row_mutexes is not a null
+   * pointer, lock the mutex responsible for a row before writing into it.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(const FullMatrix<number>     &local_matrix,
+                             const Vector<number>         &local_vector,
+                             const std::vector<size_type> &local_dof_indices,
+                             MatrixType                   &global_matrix,
+                             VectorType                   &global_vector,
+                             const bool             use_inhomogeneities_for_rhs,
+                             const std::bool_constant<false>,
+                             Threads::StripedMutex *row_mutexes) const;
+
   /**
    * This function actually implements the local_to_global function for block
    * matrices.
@@ -3032,6 +3088,51 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+template <typename number>
+template <typename VectorType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const FullMatrix<number>     &local_matrix,
+  const Vector<number>         &local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  SparseMatrix<number>         &global_matrix,
+  VectorType                   &global_vector,
+  const bool                    use_inhomogeneities_for_rhs,
+  Threads::StripedMutex        &row_mutexes) const
+{
+  distribute_local_to_global(local_matrix,
+                             local_vector,
+                             local_dof_indices,
+                             global_matrix,
+                             global_vector,
+                             use_inhomogeneities_for_rhs,
+                             std::bool_constant<false>(),
+                             &row_mutexes);
+}
+
+
+
+template <typename number>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const FullMatrix<number>     &local_matrix,
+  const std::vector<size_type> &local_dof_indices,
+  SparseMatrix<number>         &global_matrix,
+  Threads::StripedMutex        &row_mutexes) const
+{
+  Vector<number> dummy(0);
+  distribute_local_to_global(local_matrix,
+                             dummy,
+                             local_dof_indices,
+                             global_matrix,
+                             dummy,
+                             false,
+                             std::bool_constant<false>(),
+                             &row_mutexes);
+}
+
+
+
 template <typename number>
 inline AffineConstraints<number>::ConstraintLine::ConstraintLine(
   const size_type                                                   &index,
@@ -43,6 +43,7 @@
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/sparse_matrix_ez.h>
 #include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/symmetric_sparse_matrix.h>
 #include <deal.II/lac/trilinos_block_sparse_matrix.h>
 #include <deal.II/lac/trilinos_parallel_block_vector.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
@@ -3953,7 +3954,8 @@ namespace internal
       const dealii::AffineConstraints<number> &constraints,
       MatrixType                              &global_matrix,
       VectorType                              &global_vector,
-      bool                                     use_inhomogeneities_for_rhs)
+      bool                                     use_inhomogeneities_for_rhs,
+      Threads::StripedMutex                   *row_mutexes = nullptr)
     {
       if (global_rows.n_constraints() > 0)
         {
@@ -3977,6 +3979,11 @@ namespace internal
               const size_type local_row  = global_rows.constraint_origin(i);
               const size_type global_row = local_dof_indices[local_row];
 
+              std::unique_lock<Threads::Mutex> row_lock;
+              if (row_mutexes != nullptr)
+                row_lock = std::unique_lock<Threads::Mutex>(
+                  row_mutexes->get(global_row));
+
               const number current_diagonal =
                 local_matrix(local_row, local_row);
               if (std::abs(current_diagonal) != 0.)
@@ -4249,6 +4256,31 @@ AffineConstraints<number>::distribute_local_to_global(
   VectorType                   &global_vector,
   const bool                    use_inhomogeneities_for_rhs,
   const std::bool_constant<false>) const
+{
+  distribute_local_to_global(local_matrix,
+                             local_vector,
+                             local_dof_indices,
+                             global_matrix,
+                             global_vector,
+                             use_inhomogeneities_for_rhs,
+                             std::bool_constant<false>(),
+                             nullptr);
+}
+
+
+
+template <typename number>
+template <typename MatrixType, typename VectorType>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const FullMatrix<number>     &local_matrix,
+  const Vector<number>         &local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  MatrixType                   &global_matrix,
+  VectorType                   &global_vector,
+  const bool                    use_inhomogeneities_for_rhs,
+  const std::bool_constant<false>,
+  Threads::StripedMutex *row_mutexes) const
 {
   // FIXME: static_assert MatrixType::value_type == number
 
@@ -4258,6 +4290,11 @@ AffineConstraints<number>::distribute_local_to_global(
     (local_vector.size() == 0 && global_vector.size() == 0) ? false : true;
   const bool use_dealii_matrix =
     std::is_same_v<MatrixType, SparseMatrix<number>>;
+  // a matrix that only stores the upper triangle ignores all entries left of
+  // the diagonal, so we need not compute them. since the global rows are
+  // sorted, these are the ones before the current row
+  const bool upper_triangle_only =
+    std::is_same_v<MatrixType, SymmetricSparseMatrix<number>>;
 
   AssertDimension(local_matrix.n(), local_dof_indices.size());
   AssertDimension(local_matrix.m(), local_dof_indices.size());
@@ -4313,6 +4350,12 @@ AffineConstraints<number>::distribute_local_to_global(
     {
       const size_type row = global_rows.global_row(i);
 
+      // when called concurrently, make sure that no other thread writes into
+      // this row of the matrix and the vector until we are done with it
+      std::unique_lock<Threads::Mutex> row_lock;
+      if (row_mutexes != nullptr)
+        row_lock = std::unique_lock<Threads::Mutex>(row_mutexes->get(row));
+
       // calculate all the data that will be written into the matrix row.
       if (use_dealii_matrix == false)
         {
@@ -4320,14 +4363,15 @@ AffineConstraints<number>::distribute_local_to_global(
           // cast is uncritical here and only used to avoid compiler
           // warnings. We never access a non-double array
           number *val_ptr = vals.data();
-          internal::AffineConstraints::resolve_matrix_row(global_rows,
-                                                          global_rows,
-                                                          i,
-                                                          0,
-                                                          n_actual_dofs,
-                                                          local_matrix,
-                                                          col_ptr,
-                                                          val_ptr);
+          internal::AffineConstraints::resolve_matrix_row(
+            global_rows,
+            global_rows,
+            i,
+            upper_triangle_only ? i : 0,
+            n_actual_dofs,
+            local_matrix,
+            col_ptr,
+            val_ptr);
           const size_type n_values = col_ptr - cols.data();
           if (n_values > 0)
             global_matrix.add(row,
@@ -4354,9 +4398,16 @@ AffineConstraints<number>::distribute_local_to_global(
 
           if (val != typename VectorType::value_type())
             {
-              vector_indices[local_row_n] = row;
-              vector_values[local_row_n]  = val;
-              ++local_row_n;
+              // write directly while we hold the lock for this row,
+              // otherwise collect the entries for a bulk update below
+              if (row_mutexes != nullptr)
+                global_vector(row) += val;
+              else
+                {
+                  vector_indices[local_row_n] = row;
+                  vector_values[local_row_n]  = val;
+                  ++local_row_n;
+                }
             }
         }
     }
@@ -4391,7 +4442,8 @@ AffineConstraints<number>::distribute_local_to_global(
     *this,
     global_matrix,
     global_vector,
-    use_inhomogeneities_for_rhs);
+    use_inhomogeneities_for_rhs,
+    row_mutexes);
 }
 
 
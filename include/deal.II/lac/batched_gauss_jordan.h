@@ -0,0 +1,278 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_batched_gauss_jordan_h
+#define dealii_batched_gauss_jordan_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <array>
+#include <map>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A class to compute the inverses of many small dense matrices at once.
+ * Block preconditioners like PreconditionBlockJacobi or RelaxationBlockJacobi
+ * need the inverses of thousands of small diagonal blocks of a matrix, e.g.
+ * the cell blocks of a discontinuous Galerkin discretization. Inverting them
+ * one at a time through FullMatrix::invert() leaves the SIMD units of the
+ * processor mostly idle for the small sizes involved, and the overhead of
+ * calling a LAPACK function dominates for each block. This class instead
+ * collects matrices of the same size in batches of
+ * VectorizedArray<Number>::size() matrices, stores them interleaved such
+ * that entry $(i,j)$ of all matrices in a batch is contiguous in memory, and
+ * runs the Gauss-Jordan algorithm of FullMatrix::gauss_jordan() on all lanes
+ * of the batch at once. The pivot search with row interchanges is done
+ * separately for each lane, so the results agree with the ones of
+ * FullMatrix::invert() up to roundoff.
+ *
+ * Matrices are handed to the class through add(), along with the matrix the
+ * inverse should be written to. Matrices of different sizes are collected in
+ * separate batches, and a batch is inverted as soon as it is full. The
+ * remaining partially filled batches are inverted by flush(), which must be
+ * called before the inverses are used:
+ * @code
+ *   BatchedGaussJordan<double> batch;
+ *   for (unsigned int block = 0; block < n_blocks; ++block)
+ *     {
+ *       ... // fill diagonal_block
+ *       batch.add(diagonal_block, inverses[block]);
+ *     }
+ *   batch.flush();
+ * @endcode
+ *
+ * The class is not thread-safe, but different threads can use different
+ * objects to invert different sets of matrices.
+ */
+template <typename Number>
+class BatchedGaussJordan
+{
+public:
+  /**
+   * The vectorized type used to process a batch of matrices.
+   */
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * The number of matrices inverted at once.
+   */
+  static constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+  /**
+   * Add the square matrix @p matrix to the batch of matrices of the same
+   * size, and invert the batch if it is full. The inverse is written to @p
+   * inverse, which must have the same size as @p matrix and must not be
+   * changed or destroyed until the batch has been inverted, at the latest in
+   * the next call to flush(). The content of @p matrix is copied, so it may
+   * be overwritten after this call.
+   */
+  void
+  add(const FullMatrix<Number> &matrix, FullMatrix<Number> &inverse);
+
+  /**
+   * Invert all matrices added through add() that have not been inverted yet.
+   */
+  void
+  flush();
+
+private:
+  /**
+   * A batch of matrices of the same size.
+   */
+  struct Batch
+  {
+    /**
+     * The entries of the matrices, with the matrices in the lanes of the
+     * vectorized array and the entries in row-major order.
+     */
+    AlignedVector<VectorizedArrayType> values;
+
+    /**
+     * The matrices the inverses are written to.
+     */
+    std::array<FullMatrix<Number> *, n_lanes> inverses;
+
+    /**
+     * The number of lanes filled with matrices.
+     */
+    unsigned int n_filled = 0;
+  };
+
+  /**
+   * Invert the matrices of size @p n in @p batch, write them to their
+   * destinations and empty the batch.
+   */
+  void
+  invert_batch(const unsigned int n, Batch &batch);
+
+  /**
+   * The batches of matrices not yet inverted, sorted by their size.
+   */
+  std::map<unsigned int, Batch> batches;
+
+  /**
+   * The row permutations of the pivot search, stored for all lanes of a
+   * batch.
+   */
+  std::vector<std::array<unsigned int, n_lanes>> permutation;
+};
+
+
+
+/*---------------------- Inline functions -----------------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename Number>
+inline void
+BatchedGaussJordan<Number>::add(const FullMatrix<Number> &matrix,
+                                FullMatrix<Number>       &inverse)
+{
+  Assert(!matrix.empty(), (typename FullMatrix<Number>::ExcEmptyMatrix()));
+  Assert(matrix.n() == matrix.m(), LACExceptions::ExcNotQuadratic());
+  AssertDimension(inverse.m(), matrix.m());
+  AssertDimension(inverse.n(), matrix.n());
+
+  const unsigned int n     = matrix.m();
+  Batch             &batch = batches[n];
+  if (batch.n_filled == 0)
+    batch.values.resize_fast(n * n);
+
+  const unsigned int lane = batch.n_filled;
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      batch.values[i * n + j][lane] = matrix(i, j);
+  batch.inverses[lane] = &inverse;
+  ++batch.n_filled;
+
+  if (batch.n_filled == n_lanes)
+    invert_batch(n, batch);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedGaussJordan<Number>::flush()
+{
+  for (auto &batch : batches)
+    if (batch.second.n_filled > 0)
+      invert_batch(batch.first, batch.second);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedGaussJordan<Number>::invert_batch(const unsigned int n, Batch &batch)
+{
+  VectorizedArrayType *a = batch.values.data();
+
+  // fill the unused lanes with identity matrices, which keeps the pivots of
+  // these lanes away from zero
+  for (unsigned int lane = batch.n_filled; lane < n_lanes; ++lane)
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < n; ++j)
+        a[i * n + j][lane] = (i == j) ? Number(1.) : Number(0.);
+
+  // the same algorithm as in FullMatrix::gauss_jordan(), i.e., the
+  // Gauss-Jordan algorithm from Stoer & Bulirsch I (4th Edition), p. 153,
+  // with the pivot search and the row interchanges done lane by lane
+  VectorizedArrayType diagonal_sum = Number(0.);
+  for (unsigned int i = 0; i < n; ++i)
+    diagonal_sum += std::abs(a[i * n + i]);
+  const VectorizedArrayType typical_diagonal_element =
+    diagonal_sum / Number(n);
+  (void)typical_diagonal_element;
+
+  permutation.resize(n);
+  for (unsigned int i = 0; i < n; ++i)
+    permutation[i].fill(i);
+
+  for (unsigned int j = 0; j < n; ++j)
+    {
+      // pivot search: find the largest element in column j on and below the
+      // diagonal, storing the row index as a floating point number to select
+      // it in the lanes where the comparison is true
+      VectorizedArrayType max       = std::abs(a[j * n + j]);
+      VectorizedArrayType pivot_row = Number(j);
+      for (unsigned int i = j + 1; i < n; ++i)
+        {
+          const VectorizedArrayType value = std::abs(a[i * n + j]);
+          pivot_row = compare_and_apply_mask<SIMDComparison::greater_than>(
+            value, max, VectorizedArrayType(Number(i)), pivot_row);
+          max = std::max(max, value);
+        }
+
+      // check whether the pivot is too small and interchange rows
+      for (unsigned int lane = 0; lane < n_lanes; ++lane)
+        {
+          Assert(max[lane] > 1.e-16 * typical_diagonal_element[lane],
+                 (typename FullMatrix<Number>::ExcNotRegular(max[lane])));
+
+          const unsigned int r = static_cast<unsigned int>(pivot_row[lane]);
+          if (r > j)
+            {
+              for (unsigned int k = 0; k < n; ++k)
+                std::swap(a[j * n + k][lane], a[r * n + k][lane]);
+              std::swap(permutation[j][lane], permutation[r][lane]);
+            }
+        }
+
+      // transformation
+      const VectorizedArrayType hr = Number(1.) / a[j * n + j];
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          if (i == j)
+            continue;
+          const VectorizedArrayType factor = a[i * n + j] * hr;
+          for (unsigned int k = 0; k < n; ++k)
+            if (k != j)
+              a[i * n + k] -= factor * a[j * n + k];
+        }
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          a[i * n + j] *= hr;
+          a[j * n + i] *= -hr;
+        }
+      a[j * n + j] = hr;
+    }
+
+  // column interchange, done while writing the inverses to their
+  // destinations
+  for (unsigned int lane = 0; lane < batch.n_filled; ++lane)
+    {
+      FullMatrix<Number> &inverse = *batch.inverses[lane];
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int k = 0; k < n; ++k)
+          inverse(i, permutation[k][lane]) = a[i * n + k][lane];
+    }
+
+  batch.n_filled = 0;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
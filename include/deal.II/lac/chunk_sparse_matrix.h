@@ -438,6 +438,34 @@ DEAL_II_NAMESPACE_OPEN // Do not convert for module purposes
    *
    * The use of this class is demonstrated in step-51.
    *
+   * <h3>Block compressed row storage for vector-valued problems</h3>
+   *
+   * The chunks of this class are the square blocks of size
+   * ChunkSparsityPattern::get_chunk_size() whose first row and column are
+   * multiples of the chunk size. For a vector-valued finite element like
+   * FESystem(FE_Q<dim>(degree), n_components), in which every component has
+   * the same support points, the degrees of freedom can be renumbered with
+   * DoFRenumbering::support_point_wise() so that the components of each
+   * support point are numbered consecutively, starting at a multiple of
+   * `n_components`. If the chunk size then equals `n_components`, every
+   * chunk holds the couplings between all components of two support points,
+   * i.e., the matrix is stored in the block compressed row storage (BSR)
+   * format and needs only one column index per block:
+   * @code
+   *   DoFRenumbering::support_point_wise(dof_handler);
+   *
+   *   DynamicSparsityPattern dsp(dof_handler.n_dofs());
+   *   DoFTools::make_sparsity_pattern(dof_handler, dsp);
+   *   ChunkSparsityPattern sparsity_pattern;
+   *   sparsity_pattern.copy_from(dsp, fe.n_components());
+   *   ChunkSparseMatrix<double> system_matrix(sparsity_pattern);
+   * @endcode
+   * For the chunk sizes 2, 3, 4, and 6, e.g., for elasticity in 2d and 3d
+   * and for the Stokes or Navier-Stokes equations with equal-order elements
+   * in 2d and 3d, vmult() and vmult_add() use kernels in which the chunk size
+   * is a compile-time constant, so the compiler can unroll and vectorize the
+   * loops over the entries of each chunk.
+   *
    * @note Instantiations for this template are provided for <tt>@<float@> and
    * @<double@></tt>; others can be generated in application programs (see the
    * section on
@@ -39,9 +39,11 @@ DEAL_II_NAMESPACE_OPEN
 namespace internal
 {
   // TODO: the goal of the ChunkSparseMatrix class is to stream data and use
-  // the vectorization features of modern processors. to make this happen,
-  // we will have to vectorize the functions in the following namespace, either
-  // by hand or by using, for example, optimized BLAS versions for them.
+  // the vectorization features of modern processors. vmult_add_on_subrange()
+  // uses kernels with a chunk size known at compile time for small chunks,
+  // but the other functions in the following namespace still have to be
+  // vectorized, either by hand or by using, for example, optimized BLAS
+  // versions for them.
   namespace ChunkSparseMatrixImplementation
   {
     /**
@@ -164,6 +166,100 @@ namespace internal
 
 
 
+    /**
+     * Perform a vmult_add on the chunk rows in the range
+     * [begin_row, end_row), all of which must be without padding, i.e., have
+     * @p chunk_size rows. Chunks in the chunk column @p irregular_col only
+     * have @p n_filled_last_cols columns.
+     *
+     * If the template argument @p static_chunk_size is positive, it must be
+     * equal to @p chunk_size. The loops over the entries of a chunk then have
+     * a length known at compile time, so the compiler can unroll and
+     * vectorize them, and the results of a chunk row are accumulated in
+     * registers before they are added to the destination vector. This is the
+     * case of matrices of vector-valued problems whose chunks are the
+     * couplings between the components of two support points, with a chunk
+     * size that equals the number of components.
+     */
+    template <int static_chunk_size,
+              typename number,
+              typename InVector,
+              typename OutVector>
+    void
+    vmult_add_on_regular_chunk_rows(const size_type    chunk_size,
+                                    const unsigned int begin_row,
+                                    const unsigned int end_row,
+                                    const size_type    irregular_col,
+                                    const size_type    n_filled_last_cols,
+                                    const number      *values,
+                                    const std::size_t *rowstart,
+                                    const size_type   *colnums,
+                                    const InVector    &src,
+                                    OutVector         &dst)
+    {
+      Assert(static_chunk_size <= 0 || static_chunk_size == int(chunk_size),
+             ExcInternalError());
+
+      typename OutVector::iterator dst_ptr =
+        dst.begin() + chunk_size * begin_row;
+      const number *val_ptr =
+        &values[rowstart[begin_row] * chunk_size * chunk_size];
+      const size_type *colnum_ptr = &colnums[rowstart[begin_row]];
+      for (unsigned int chunk_row = begin_row; chunk_row < end_row;
+           ++chunk_row)
+        {
+          const number *const val_end_of_row =
+            &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
+          if constexpr (static_chunk_size > 0)
+            {
+              typename OutVector::value_type sums[static_chunk_size] = {};
+              while (val_ptr != val_end_of_row)
+                {
+                  const auto src_ptr =
+                    src.begin() + *colnum_ptr * static_chunk_size;
+                  if (*colnum_ptr != irregular_col)
+                    for (int i = 0; i < static_chunk_size; ++i)
+                      for (int j = 0; j < static_chunk_size; ++j)
+                        sums[i] +=
+                          val_ptr[i * static_chunk_size + j] * src_ptr[j];
+                  else
+                    // we're at a chunk column that has padding
+                    for (int i = 0; i < static_chunk_size; ++i)
+                      for (size_type j = 0; j < n_filled_last_cols; ++j)
+                        sums[i] +=
+                          val_ptr[i * static_chunk_size + j] * src_ptr[j];
+
+                  ++colnum_ptr;
+                  val_ptr += static_chunk_size * static_chunk_size;
+                }
+              for (int i = 0; i < static_chunk_size; ++i)
+                dst_ptr[i] += sums[i];
+            }
+          else
+            while (val_ptr != val_end_of_row)
+              {
+                if (*colnum_ptr != irregular_col)
+                  chunk_vmult_add(chunk_size,
+                                  val_ptr,
+                                  src.begin() + *colnum_ptr * chunk_size,
+                                  dst_ptr);
+                else
+                  // we're at a chunk column that has padding
+                  for (size_type r = 0; r < chunk_size; ++r)
+                    for (size_type c = 0; c < n_filled_last_cols; ++c)
+                      dst_ptr[r] += (val_ptr[r * chunk_size + c] *
+                                     src(*colnum_ptr * chunk_size + c));
+
+                ++colnum_ptr;
+                val_ptr += chunk_size * chunk_size;
+              }
+
+          dst_ptr += chunk_size;
+        }
+    }
+
+
+
     /**
      * Perform a vmult_add using the ChunkSparseMatrix data structures, but
      * only using a subinterval of the matrix rows.
@@ -198,42 +294,53 @@ namespace internal
           end_row;
       const size_type irregular_col = n / chunk_size;
 
-      typename OutVector::iterator dst_ptr =
-        dst.begin() + chunk_size * begin_row;
-      const number *val_ptr =
-        &values[rowstart[begin_row] * chunk_size * chunk_size];
-      const size_type *colnum_ptr = &colnums[rowstart[begin_row]];
-      for (unsigned int chunk_row = begin_row; chunk_row < last_regular_row;
-           ++chunk_row)
+      // use kernels with a chunk size fixed at compile time for the chunk
+      // sizes of vector-valued problems in 2d and 3d, and a generic kernel
+      // otherwise
+      if (begin_row < last_regular_row)
         {
-          const number *const val_end_of_row =
-            &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
-          while (val_ptr != val_end_of_row)
+          const auto regular_rows = [&](const auto static_chunk_size) {
+            vmult_add_on_regular_chunk_rows<decltype(static_chunk_size)::value>(
+              chunk_size,
+              begin_row,
+              last_regular_row,
+              irregular_col,
+              n_filled_last_cols,
+              values,
+              rowstart,
+              colnums,
+              src,
+              dst);
+          };
+          switch (chunk_size)
             {
-              if (*colnum_ptr != irregular_col)
-                chunk_vmult_add(chunk_size,
-                                val_ptr,
-                                src.begin() + *colnum_ptr * chunk_size,
-                                dst_ptr);
-              else
-                // we're at a chunk column that has padding
-                for (size_type r = 0; r < chunk_size; ++r)
-                  for (size_type c = 0; c < n_filled_last_cols; ++c)
-                    dst_ptr[r] += (val_ptr[r * chunk_size + c] *
-                                   src(*colnum_ptr * chunk_size + c));
-
-              ++colnum_ptr;
-              val_ptr += chunk_size * chunk_size;
+              case 2:
+                regular_rows(std::integral_constant<int, 2>());
+                break;
+              case 3:
+                regular_rows(std::integral_constant<int, 3>());
+                break;
+              case 4:
+                regular_rows(std::integral_constant<int, 4>());
+                break;
+              case 6:
+                regular_rows(std::integral_constant<int, 6>());
+                break;
+              default:
+                regular_rows(std::integral_constant<int, 0>());
             }
-
-          dst_ptr += chunk_size;
         }
 
       // now deal with last chunk row if necessary
       if (n_filled_last_rows > 0 && end_row == (m / chunk_size + 1))
         {
-          const size_type chunk_row = last_regular_row;
+          const size_type chunk_row = m / chunk_size;
 
+          typename OutVector::iterator dst_ptr =
+            dst.begin() + chunk_size * chunk_row;
+          const number *val_ptr =
+            &values[rowstart[chunk_row] * chunk_size * chunk_size];
+          const size_type *colnum_ptr = &colnums[rowstart[chunk_row]];
           const number *const val_end_of_row =
             &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
           while (val_ptr != val_end_of_row)
@@ -256,12 +363,12 @@ namespace internal
               ++colnum_ptr;
               val_ptr += chunk_size * chunk_size;
             }
+          Assert(std::size_t(colnum_ptr - colnums) == rowstart[end_row],
+                 ExcInternalError());
+          Assert(std::size_t(val_ptr - values) ==
+                   rowstart[end_row] * chunk_size * chunk_size,
+                 ExcInternalError());
         }
-      Assert(std::size_t(colnum_ptr - colnums) == rowstart[end_row],
-             ExcInternalError());
-      Assert(std::size_t(val_ptr - values) ==
-               rowstart[end_row] * chunk_size * chunk_size,
-             ExcInternalError());
     }
   } // namespace ChunkSparseMatrixImplementation
 } // namespace internal
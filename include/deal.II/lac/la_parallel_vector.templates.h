@@ -134,10 +134,14 @@ namespace LinearAlgebra
         {
           if (comm_shared == MPI_COMM_SELF)
             {
+              // all callers overwrite the entries after resizing, so do not
+              // let Kokkos copy the old entries on the calling thread: the
+              // memory pages should be touched first by the threads of the
+              // vector operations, see the reinit() functions
 #if DEAL_II_KOKKOS_VERSION_GTE(3, 6, 0)
-              Kokkos::resize(Kokkos::WithoutInitializing,
-                             data.values,
-                             new_alloc_size);
+              Kokkos::realloc(Kokkos::WithoutInitializing,
+                              data.values,
+                              new_alloc_size);
 #else
               Kokkos::resize(data.values, new_alloc_size);
 #endif
@@ -622,6 +626,11 @@ namespace LinearAlgebra
           resize_val(new_allocated_size, this->comm_sm);
         }
 
+      // take over the thread partitioning of v before setting the entries to
+      // zero, such that the memory pages are first touched by the same
+      // threads that will work on them in vector operations with v
+      thread_loop_partitioner = v.thread_loop_partitioner;
+
       if (omit_zeroing_entries == false)
         this->operator=(Number());
       else
@@ -633,8 +642,6 @@ namespace LinearAlgebra
       // call these methods and hence do not need to have the storage.
       Kokkos::resize(import_data.values_host_buffer, 0);
       Kokkos::resize(import_data.values, 0);
-
-      thread_loop_partitioner = v.thread_loop_partitioner;
     }
 
 
@@ -0,0 +1,247 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_la_parallel_vector_fused_operations_h
+#define dealii_la_parallel_vector_fused_operations_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+
+#include <array>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+#endif
+
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    /**
+     * @addtogroup Vectors
+     * @{
+     */
+
+    /**
+     * Namespace for a small interface that fuses several vector updates and
+     * inner products, as they appear in the inner loops of Krylov solvers,
+     * into a single sweep through memory.
+     *
+     * Iterative solvers are usually limited by memory bandwidth rather than
+     * by arithmetic. A sequence like
+     * @code
+     *   x.add(alpha, p);
+     *   r.add(-alpha, v);
+     *   const double residual_norm_square = r.norm_sqr();
+     * @endcode
+     * loads the vector `r` from main memory twice and starts three parallel
+     * loops (and, for a vector distributed over several MPI processes, a
+     * global reduction). The functions in this namespace instead split the
+     * locally owned range of the vectors into chunks of
+     * FusedOperations::chunk_size entries and call one or several
+     * <i>kernels</i> on each chunk, one kernel after the other, while the
+     * chunk still resides in cache. A kernel is any callable object with the
+     * signature
+     * @code
+     *   void kernel(const unsigned int          begin,
+     *               const unsigned int          end,
+     *               std::array<Number, n_sums> &sums);
+     * @endcode
+     * that works on the locally owned entries `[begin, end)` of whatever
+     * vectors it has access to and adds its contributions to the inner
+     * products it computes to `sums`. The sequence above then reads:
+     * @code
+     *   const double *p_values = p.begin();
+     *   const double *v_values = v.begin();
+     *   double       *x_values = x.begin();
+     *   double       *r_values = r.begin();
+     *   const std::array<double, 1> sums = FusedOperations::run<1>(
+     *     x,
+     *     [&](const unsigned int     begin,
+     *         const unsigned int     end,
+     *         std::array<double, 1> &sums) {
+     *       double r_norm_square = 0;
+     *       for (unsigned int i = begin; i < end; ++i)
+     *         {
+     *           x_values[i] += alpha * p_values[i];
+     *           r_values[i] -= alpha * v_values[i];
+     *           r_norm_square += r_values[i] * r_values[i];
+     *         }
+     *       sums[0] += r_norm_square;
+     *     });
+     * @endcode
+     * Accumulating into a local variable as above, rather than directly into
+     * `sums`, tells the compiler that the sum does not alias the vector
+     * entries written in the loop, which is necessary to keep it in a
+     * register.
+     *
+     * Existing kernels can also be composed without writing a new loop, by
+     * passing them as separate arguments:
+     * @code
+     *   FusedOperations::run<1>(x, update_solution, update_residual);
+     * @endcode
+     * which runs `update_residual` on every chunk right after
+     * `update_solution`.
+     *
+     * The chunks are distributed to several threads if the vectors are large
+     * enough. The local results of the inner products are computed per chunk
+     * and then added in a fixed order, so the results do not depend on the
+     * number of threads. run() finally adds the results of all MPI processes
+     * with a single reduction, whereas run_local() leaves this to the caller,
+     * e.g. to overlap the reduction with other work.
+     *
+     * All vectors accessed by the kernels must have the same locally owned
+     * range. Ghost entries are neither read nor updated.
+     */
+    namespace FusedOperations
+    {
+      /**
+       * The number of vector entries the kernels are called on at once. A
+       * multiple of the SIMD width, so that vectorized kernels only need to
+       * treat a remainder at the end of the locally owned range, and small
+       * enough for a few vectors to fit into the level 1 or level 2 cache.
+       */
+      constexpr unsigned int chunk_size = 1024;
+
+      /**
+       * Call the given @p kernels on the chunks of the range
+       * `[0, locally_owned_size)` and return the sum of the @p n_sums local
+       * results of all kernels, without communication between MPI
+       * processes.
+       */
+      template <unsigned int n_sums, typename Number, typename... Kernels>
+      std::array<Number, n_sums>
+      run_local(const unsigned int locally_owned_size,
+                const Kernels &...kernels);
+
+      /**
+       * Call the given @p kernels on the chunks of the locally owned range
+       * of @p vector and return the sum of the @p n_sums results of all
+       * kernels over all MPI processes that share @p vector.
+       */
+      template <unsigned int n_sums, typename Number, typename... Kernels>
+      std::array<Number, n_sums>
+      run(const Vector<Number, MemorySpace::Host> &vector,
+          const Kernels &...kernels);
+    } // namespace FusedOperations
+
+    /** @} */
+  } // namespace distributed
+} // namespace LinearAlgebra
+
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    namespace FusedOperations
+    {
+      template <unsigned int n_sums, typename Number, typename... Kernels>
+      std::array<Number, n_sums>
+      run_local(const unsigned int locally_owned_size,
+                const Kernels &...kernels)
+      {
+        const auto run_on_chunk = [&](const unsigned int          begin,
+                                      const unsigned int          end,
+                                      std::array<Number, n_sums> &sums) {
+          (kernels(begin, end, sums), ...);
+        };
+
+        const unsigned int n_chunks =
+          (locally_owned_size + chunk_size - 1) / chunk_size;
+
+        std::array<Number, n_sums> sums = {};
+        if (n_chunks <= 1)
+          {
+            if (locally_owned_size > 0)
+              run_on_chunk(0, locally_owned_size, sums);
+            return sums;
+          }
+
+        // keep the results of each chunk separately and add them afterwards
+        // in order, to get the same results independently of how the chunks
+        // were distributed to the threads
+        std::vector<std::array<Number, n_sums>> chunk_sums(
+          n_sums > 0 ? n_chunks : 0);
+        parallel::apply_to_subranges(
+          0U,
+          n_chunks,
+          [&](const unsigned int chunk_begin, const unsigned int chunk_end) {
+            for (unsigned int chunk = chunk_begin; chunk < chunk_end; ++chunk)
+              {
+                std::array<Number, n_sums> my_sums = {};
+                run_on_chunk(chunk * chunk_size,
+                             std::min((chunk + 1) * chunk_size,
+                                      locally_owned_size),
+                             my_sums);
+                if constexpr (n_sums > 0)
+                  chunk_sums[chunk] = my_sums;
+              }
+          },
+          4);
+
+        if constexpr (n_sums > 0)
+          for (const auto &chunk_sum : chunk_sums)
+            for (unsigned int i = 0; i < n_sums; ++i)
+              sums[i] += chunk_sum[i];
+
+        return sums;
+      }
+
+
+
+      template <unsigned int n_sums, typename Number, typename... Kernels>
+      std::array<Number, n_sums>
+      run(const Vector<Number, MemorySpace::Host> &vector,
+          const Kernels &...kernels)
+      {
+        std::array<Number, n_sums> sums =
+          run_local<n_sums, Number>(vector.locally_owned_size(), kernels...);
+
+        if constexpr (n_sums > 0)
+          Utilities::MPI::sum(ArrayView<const Number>(sums.data(), n_sums),
+                              vector.get_mpi_communicator(),
+                              ArrayView<Number>(sums.data(), n_sums));
+
+        return sums;
+      }
+    } // namespace FusedOperations
+  } // namespace distributed
+} // namespace LinearAlgebra
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
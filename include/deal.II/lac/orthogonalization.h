@@ -52,6 +52,15 @@ namespace LinearAlgebra
      * Gram-Schmidt algorithm, because the second orthogonalization step is
      * done on cached data. For these beneficial reasons, this is the default
      * algorithm in the SolverGMRES class.
+     *
+     * For deal.II's own vectors, all inner products of an Arnoldi step, i.e.,
+     * the projections onto the basis vectors, the correction terms of the
+     * delayed reorthogonalization and the norm of the new vector, are
+     * computed in a single sweep over the basis vectors with one global
+     * reduction (MPI_Allreduce) per iteration, so that the latency of the
+     * orthogonalization does not grow with the number of basis vectors. For
+     * other vector types, the inner products are computed by separate calls
+     * to the scalar product of the vector class.
      */
     delayed_classical_gram_schmidt
   };
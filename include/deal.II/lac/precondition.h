@@ -1078,6 +1078,158 @@ namespace internal
       const std::vector<size_type> &inverse_permutation;
     };
 
+    template <typename MatrixType>
+    class PreconditionMulticolorSORImpl
+    {
+    public:
+      using size_type = typename MatrixType::size_type;
+
+      PreconditionMulticolorSORImpl(const MatrixType &A,
+                                    const double      relaxation,
+                                    const bool        symmetric)
+        : A(&A)
+        , relaxation(relaxation)
+        , symmetric(symmetric)
+      {
+        const auto     &sparsity = A.get_sparsity_pattern();
+        const size_type n        = sparsity.n_rows();
+        AssertDimension(n, sparsity.n_cols());
+
+        // rows i and j need different colors if either A_ij or A_ji is
+        // nonzero. collect the rows k<j with A_kj nonzero for every column
+        // j, so that the neighbors of row j that are colored before it can
+        // be found without searching
+        std::vector<std::vector<size_type>> upper_neighbors(n);
+        for (size_type row = 0; row < n; ++row)
+          for (auto p = sparsity.begin(row); p != sparsity.end(row); ++p)
+            if (p->column() > row)
+              upper_neighbors[p->column()].push_back(row);
+
+        // greedy coloring: give every row the smallest color not used by
+        // any of its neighbors colored before. the entry forbidden[c] holds
+        // the last row for which color c was found to be taken
+        std::vector<unsigned int> color(n);
+        std::vector<size_type>    forbidden;
+        for (size_type row = 0; row < n; ++row)
+          {
+            const auto forbid = [&](const size_type neighbor) {
+              if (neighbor < row)
+                forbidden[color[neighbor]] = row;
+            };
+            for (auto p = sparsity.begin(row); p != sparsity.end(row); ++p)
+              forbid(p->column());
+            for (const size_type neighbor : upper_neighbors[row])
+              forbid(neighbor);
+
+            unsigned int c = 0;
+            while (c < forbidden.size() && forbidden[c] == row)
+              ++c;
+            if (c == forbidden.size())
+              forbidden.push_back(numbers::invalid_size_type);
+            color[row] = c;
+          }
+
+        // sort the rows by color, keeping them in ascending order within
+        // each color
+        color_start.assign(forbidden.size() + 1, 0);
+        for (size_type row = 0; row < n; ++row)
+          ++color_start[color[row] + 1];
+        for (unsigned int c = 0; c < forbidden.size(); ++c)
+          color_start[c + 1] += color_start[c];
+        std::vector<size_type> next_position(color_start.begin(),
+                                             color_start.end() - 1);
+        color_rows.resize(n);
+        for (size_type row = 0; row < n; ++row)
+          color_rows[next_position[color[row]]++] = row;
+      }
+
+      unsigned int
+      n_colors() const
+      {
+        return color_start.size() - 1;
+      }
+
+      template <typename VectorType>
+      void
+      vmult(VectorType &dst, const VectorType &src) const
+      {
+        dst = typename VectorType::value_type();
+        this->step(dst, src);
+      }
+
+      template <typename VectorType>
+      void
+      Tvmult(VectorType &dst, const VectorType &src) const
+      {
+        dst = typename VectorType::value_type();
+        this->Tstep(dst, src);
+      }
+
+      template <typename VectorType>
+      void
+      step(VectorType &dst, const VectorType &src) const
+      {
+        sweep(dst, src, true);
+        if (symmetric)
+          sweep(dst, src, false);
+      }
+
+      template <typename VectorType>
+      void
+      Tstep(VectorType &dst, const VectorType &src) const
+      {
+        if (symmetric)
+          sweep(dst, src, true);
+        sweep(dst, src, false);
+      }
+
+    private:
+      /**
+       * Perform one Gauss-Seidel sweep over the rows in the order of the
+       * colors, ascending if @p forward is true and descending otherwise.
+       * Rows of the same color do not couple, so they are updated in
+       * parallel.
+       */
+      template <typename VectorType>
+      void
+      sweep(VectorType &dst, const VectorType &src, const bool forward) const
+      {
+        using Number = typename VectorType::value_type;
+
+        for (unsigned int c = 0; c < n_colors(); ++c)
+          {
+            const unsigned int color = forward ? c : n_colors() - 1 - c;
+            parallel::apply_to_subranges(
+              color_start[color],
+              color_start[color + 1],
+              [this, &dst, &src](const size_type begin, const size_type end) {
+                for (size_type i = begin; i < end; ++i)
+                  {
+                    const size_type row = color_rows[i];
+                    Number          s   = src(row);
+                    for (auto p = A->begin(row); p != A->end(row); ++p)
+                      s -= Number(p->value()) * dst(p->column());
+                    dst(row) +=
+                      Number(relaxation) * s / Number(A->diag_element(row));
+                  }
+              },
+              internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+          }
+      }
+
+      const ObserverPointer<const MatrixType> A;
+      const double                            relaxation;
+      const bool                              symmetric;
+
+      /**
+       * The rows sorted by color. The rows of color @p c are stored at the
+       * positions <code>color_start[c]</code> through
+       * <code>color_start[c+1]-1</code> of @p color_rows.
+       */
+      std::vector<size_type> color_start;
+      std::vector<size_type> color_rows;
+    };
+
     template <typename MatrixType,
               typename PreconditionerType,
               typename VectorType,
@@ -1907,6 +2059,125 @@ public:
 
 
 
+/**
+ * Multicolor SOR preconditioner for SparseMatrix. In contrast to
+ * PreconditionSOR, which works on the rows of the matrix one after the
+ * other, this class computes a coloring of the graph of the matrix in
+ * initialize(), i.e., it groups the rows into colors such that no two rows
+ * of the same color couple through a nonzero entry $A_{ij}$ or $A_{ji}$. The
+ * Gauss-Seidel sweeps then go through the colors one after the other and
+ * update all rows of one color in parallel, using
+ * parallel::apply_to_subranges().
+ *
+ * The result is the one of the SOR method applied to the matrix with the
+ * rows and columns renumbered color by color. For the coloring, a greedy
+ * algorithm is used that goes through the rows in their natural order; for
+ * example, it produces the well-known red-black ordering for a five-point
+ * stencil on a structured grid. The convergence of the preconditioner
+ * depends on the ordering and is typically somewhat worse than the one of
+ * the SOR method in a good sequential ordering, in exchange for the
+ * parallelism.
+ *
+ * In addition to vmult() and Tvmult(), the class provides step() and
+ * Tstep() functions that perform a single forward (or backward) sweep on a
+ * given approximation of the solution. With these, it can be used as a
+ * smoother in MGSmootherPrecondition or MGSmootherRelaxation.
+ *
+ * @code
+ * PreconditionMulticolorSOR<SparseMatrix<double>> precondition;
+ * precondition.initialize(
+ *   A, PreconditionMulticolorSOR<SparseMatrix<double>>::AdditionalData(.6));
+ *
+ * solver.solve (A, x, b, precondition);
+ * @endcode
+ */
+template <typename MatrixType = SparseMatrix<double>>
+class PreconditionMulticolorSOR
+  : public PreconditionRelaxation<
+      MatrixType,
+      internal::PreconditionRelaxation::PreconditionMulticolorSORImpl<
+        MatrixType>>
+{
+  using PreconditionerType =
+    internal::PreconditionRelaxation::PreconditionMulticolorSORImpl<MatrixType>;
+  using BaseClass = PreconditionRelaxation<MatrixType, PreconditionerType>;
+
+public:
+  /**
+   * An alias to the base class AdditionalData.
+   */
+  using AdditionalData = typename BaseClass::AdditionalData;
+
+  /**
+   * Initialize matrix and relaxation parameter and compute the coloring of
+   * the rows of the matrix. The relaxation parameter should be larger than
+   * zero and smaller than 2 for numerical reasons. It defaults to 1.
+   */
+  void
+  initialize(const MatrixType     &A,
+             const AdditionalData &parameters = AdditionalData());
+
+  /**
+   * Return the number of colors the rows of the matrix have been grouped
+   * into, i.e., the number of sequential steps of one sweep.
+   */
+  unsigned int
+  n_colors() const;
+};
+
+
+
+/**
+ * Multicolor SSOR preconditioner for SparseMatrix. This class works like
+ * PreconditionMulticolorSOR, but every application consists of a forward
+ * sweep through the colors followed by a backward sweep, which results in a
+ * symmetric preconditioner for symmetric matrices that can be used with
+ * SolverCG.
+ *
+ * @code
+ * PreconditionMulticolorSSOR<SparseMatrix<double>> precondition;
+ * precondition.initialize(
+ *   A, PreconditionMulticolorSSOR<SparseMatrix<double>>::AdditionalData(1.2));
+ *
+ * solver.solve (A, x, b, precondition);
+ * @endcode
+ */
+template <typename MatrixType = SparseMatrix<double>>
+class PreconditionMulticolorSSOR
+  : public PreconditionRelaxation<
+      MatrixType,
+      internal::PreconditionRelaxation::PreconditionMulticolorSORImpl<
+        MatrixType>>
+{
+  using PreconditionerType =
+    internal::PreconditionRelaxation::PreconditionMulticolorSORImpl<MatrixType>;
+  using BaseClass = PreconditionRelaxation<MatrixType, PreconditionerType>;
+
+public:
+  /**
+   * An alias to the base class AdditionalData.
+   */
+  using AdditionalData = typename BaseClass::AdditionalData;
+
+  /**
+   * Initialize matrix and relaxation parameter and compute the coloring of
+   * the rows of the matrix. The relaxation parameter should be larger than
+   * zero and smaller than 2 for numerical reasons. It defaults to 1.
+   */
+  void
+  initialize(const MatrixType     &A,
+             const AdditionalData &parameters = AdditionalData());
+
+  /**
+   * Return the number of colors the rows of the matrix have been grouped
+   * into, i.e., the number of sequential steps of one sweep.
+   */
+  unsigned int
+  n_colors() const;
+};
+
+
+
 /**
  * Preconditioning with a Chebyshev polynomial for symmetric positive definite
  * matrices. This preconditioner is based on an iteration of an inner
@@ -2991,6 +3262,71 @@ PreconditionPSOR<MatrixType>::AdditionalData::AdditionalData(
 {}
 
 
+//---------------------------------------------------------------------------
+
+template <typename MatrixType>
+inline void
+PreconditionMulticolorSOR<MatrixType>::initialize(
+  const MatrixType     &A,
+  const AdditionalData &parameters_in)
+{
+  Assert(parameters_in.preconditioner == nullptr, ExcInternalError());
+  Assert(parameters_in.relaxation != 0.0,
+         ExcMessage("Relaxation cannot automatically be determined by "
+                    "PreconditionMulticolorSOR."));
+
+  AdditionalData parameters;
+  parameters.relaxation   = 1.0;
+  parameters.n_iterations = parameters_in.n_iterations;
+  parameters.preconditioner =
+    std::make_shared<PreconditionerType>(A, parameters_in.relaxation, false);
+
+  this->BaseClass::initialize(A, parameters);
+}
+
+
+
+template <typename MatrixType>
+inline unsigned int
+PreconditionMulticolorSOR<MatrixType>::n_colors() const
+{
+  Assert(this->data.preconditioner != nullptr, ExcNotInitialized());
+  return this->data.preconditioner->n_colors();
+}
+
+//---------------------------------------------------------------------------
+
+template <typename MatrixType>
+inline void
+PreconditionMulticolorSSOR<MatrixType>::initialize(
+  const MatrixType     &A,
+  const AdditionalData &parameters_in)
+{
+  Assert(parameters_in.preconditioner == nullptr, ExcInternalError());
+  Assert(parameters_in.relaxation != 0.0,
+         ExcMessage("Relaxation cannot automatically be determined by "
+                    "PreconditionMulticolorSSOR."));
+
+  AdditionalData parameters;
+  parameters.relaxation   = 1.0;
+  parameters.n_iterations = parameters_in.n_iterations;
+  parameters.preconditioner =
+    std::make_shared<PreconditionerType>(A, parameters_in.relaxation, true);
+
+  this->BaseClass::initialize(A, parameters);
+}
+
+
+
+template <typename MatrixType>
+inline unsigned int
+PreconditionMulticolorSSOR<MatrixType>::n_colors() const
+{
+  Assert(this->data.preconditioner != nullptr, ExcNotInitialized());
+  return this->data.preconditioner->n_colors();
+}
+
+
 //---------------------------------------------------------------------------
 
 
@@ -0,0 +1,356 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_precondition_amg_h
+#define dealii_precondition_amg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/enable_observer_pointer.h>
+#include <deal.II/base/observer_pointer.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Preconditioners
+ * @{
+ */
+
+/**
+ * An algebraic multigrid preconditioner based on smoothed aggregation, see
+ * @cite Vanek1996, for symmetric positive definite matrices stored as
+ * SparseMatrix<double>. In contrast to TrilinosWrappers::PreconditionAMG and
+ * PETScWrappers::PreconditionBoomerAMG, this class does not need any
+ * external library.
+ *
+ * <h3>Setup</h3>
+ *
+ * The initialize() function builds a hierarchy of successively coarser
+ * matrices from the given matrix alone, without any geometric information:
+ * <ol>
+ * <li> The unknowns are grouped into <i>aggregates</i> of strongly coupled
+ * unknowns. An off-diagonal entry $a_{ij}$ is considered a strong
+ * coupling if $|a_{ij}| \geq \theta \sqrt{|a_{ii} a_{jj}|}$ with the
+ * threshold $\theta$ given by AdditionalData::strong_threshold. Unknowns
+ * without any strong coupling, such as rows that only contain a diagonal
+ * entry, are not assigned to any aggregate and are therefore only treated
+ * by the smoother.
+ * <li> The tentative prolongation $P_\text{tent}$ has one column per
+ * aggregate that interpolates a constant value to all unknowns of the
+ * aggregate, i.e., the coarse space contains the constant vector, which is
+ * the near null space of scalar elliptic problems like the Laplace
+ * equation. It is then improved by one step of damped Jacobi,
+ * $P = (I - \omega D^{-1} A) P_\text{tent}$, with $\omega =
+ * \frac{4}{3\rho}$ and an upper bound $\rho$ for the largest eigenvalue of
+ * $D^{-1}A$ given by the Gershgorin circle theorem.
+ * <li> The matrix on the next coarser level is the Galerkin product
+ * $P^T A P$, computed with SparseMatrix::PtAP(). It forms $AP$ and then
+ * multiplies it from the left with $P^T$, which is transposed explicitly
+ * into compressed row storage first, so that the rows of both products are
+ * computed in parallel without going through a DynamicSparsityPattern.
+ * </ol>
+ * The coarsening stops once the number of unknowns is at most
+ * AdditionalData::max_coarse_size, or if the number of levels reaches
+ * AdditionalData::max_n_levels, or if the aggregation does not reduce the
+ * size of the matrix substantially any more.
+ *
+ * <h3>Application</h3>
+ *
+ * The vmult() function performs one V-cycle with zero starting guess. On
+ * each level except the coarsest one, the smoother selected by
+ * AdditionalData::smoother_type, i.e., either PreconditionChebyshev or
+ * PreconditionJacobi with the inverse of the diagonal as preconditioner, is
+ * applied before and after the coarse grid correction. On the coarsest
+ * level, the system is solved exactly with the inverse of the matrix stored
+ * as a FullMatrix if it is small enough, and approximately with the smoother
+ * otherwise. Both the setup and the application are deterministic.
+ *
+ * Since the V-cycle is symmetric, the preconditioner can be used with
+ * SolverCG:
+ * @code
+ *   PreconditionAMG preconditioner;
+ *   preconditioner.initialize(system_matrix);
+ *
+ *   SolverControl            solver_control(1000, 1e-12);
+ *   SolverCG<Vector<double>> solver(solver_control);
+ *   solver.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ * Like any preconditioner, it can also be wrapped into an
+ * MGCoarseGridApplyOperator object, or be given as preconditioner to an
+ * MGCoarseGridIterativeSolver object, to act as coarse grid solver of a
+ * geometric Multigrid. This is useful if the coarse mesh of the geometric
+ * hierarchy is still large.
+ *
+ * The setup assumes the matrix to be symmetric and to have nonzero diagonal
+ * entries. As the coarse space is built from the constant vector only, the
+ * method is meant for scalar problems. For systems of PDEs like elasticity,
+ * whose near null space consists of several vectors, the iteration counts
+ * will grow with the problem size.
+ */
+class PreconditionAMG : public EnableObserverPointer
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional parameters to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * The smoothers that can be selected.
+     */
+    enum class SmootherType
+    {
+      /**
+       * PreconditionChebyshev with the inverse of the diagonal as inner
+       * preconditioner, where the degree of the polynomial is given by
+       * AdditionalData::smoother_sweeps. The eigenvalue bound $\rho$ of the
+       * prolongation smoothing is used as largest eigenvalue, so no
+       * eigenvalue estimation is needed.
+       */
+      chebyshev,
+      /**
+       * PreconditionJacobi with the damping factor $\frac{4}{3\rho}$, using
+       * the same eigenvalue bound $\rho$ as the prolongation smoothing,
+       * applied AdditionalData::smoother_sweeps times.
+       */
+      jacobi
+    };
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(
+      const double       strong_threshold = 0.08,
+      const unsigned int max_coarse_size  = 500,
+      const unsigned int max_n_levels     = 20,
+      const SmootherType smoother_type    = SmootherType::chebyshev,
+      const unsigned int smoother_sweeps  = 2,
+      const double       smoothing_range  = 20.);
+
+    /**
+     * The threshold $\theta$ in the definition of strong couplings between
+     * unknowns. Larger values lead to smaller aggregates and therefore to
+     * more levels.
+     */
+    double strong_threshold;
+
+    /**
+     * The size of the matrix below which no further coarsening is done.
+     */
+    unsigned int max_coarse_size;
+
+    /**
+     * The maximal number of levels, including the level of the given
+     * matrix.
+     */
+    unsigned int max_n_levels;
+
+    /**
+     * The smoother used on all but the coarsest level.
+     */
+    SmootherType smoother_type;
+
+    /**
+     * The degree of the Chebyshev polynomial, or the number of Jacobi
+     * iterations, in each pre- and post-smoothing step.
+     */
+    unsigned int smoother_sweeps;
+
+    /**
+     * The ratio between the largest eigenvalue and the smallest eigenvalue
+     * targeted by the Chebyshev smoother, see
+     * PreconditionChebyshev::AdditionalData::smoothing_range.
+     */
+    double smoothing_range;
+  };
+
+  /**
+   * Constructor. Does not do anything, call initialize() before using the
+   * object.
+   */
+  PreconditionAMG();
+
+  /**
+   * Destructor.
+   */
+  ~PreconditionAMG() override;
+
+  /**
+   * Build the multigrid hierarchy for the given matrix. The matrix is not
+   * copied, so it has to stay alive as long as this object is used.
+   */
+  void
+  initialize(const SparseMatrix<double> &matrix,
+             const AdditionalData       &additional_data = AdditionalData());
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner, i.e., one V-cycle with zero starting guess.
+   */
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner. Since the V-cycle is
+   * symmetric, this is the same as vmult().
+   */
+  void
+  Tvmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of levels of the hierarchy, including the level of
+   * the matrix given to initialize().
+   */
+  unsigned int
+  n_levels() const;
+
+  /**
+   * Return the matrix on the given level, where level zero is the matrix
+   * given to initialize() and level `n_levels()-1` is the coarsest one.
+   */
+  const SparseMatrix<double> &
+  get_matrix(const unsigned int level) const;
+
+  /**
+   * Return the operator complexity of the hierarchy, i.e., the number of
+   * nonzero entries of the matrices on all levels divided by the number of
+   * nonzero entries of the matrix on level zero.
+   */
+  double
+  operator_complexity() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The data of one level of the hierarchy.
+   */
+  struct Level
+  {
+    /**
+     * The matrix on this level, pointing to either the matrix given to
+     * initialize() or to #coarse_matrix.
+     */
+    ObserverPointer<const SparseMatrix<double>> matrix;
+
+    /**
+     * The sparsity pattern and the entries of the Galerkin coarse matrix on
+     * this level, unused on level zero.
+     */
+    SparsityPattern      coarse_sparsity;
+    SparseMatrix<double> coarse_matrix;
+
+    /**
+     * The prolongation from the next coarser level to this level, and its
+     * sparsity pattern. Unused on the coarsest level.
+     */
+    SparsityPattern      prolongation_sparsity;
+    SparseMatrix<double> prolongation;
+
+    /**
+     * The smoothers, of which only the one selected by
+     * AdditionalData::smoother_type is set up.
+     */
+    std::unique_ptr<PreconditionChebyshev<SparseMatrix<double>,
+                                          Vector<double>,
+                                          DiagonalMatrix<Vector<double>>>>
+      chebyshev;
+    std::unique_ptr<PreconditionJacobi<SparseMatrix<double>>> jacobi;
+
+    /**
+     * Vectors for the solution, the right hand side, and the residual on
+     * this level, used during vmult().
+     */
+    mutable Vector<double> solution;
+    mutable Vector<double> rhs;
+    mutable Vector<double> residual;
+  };
+
+  /**
+   * Set up the smoother of the given level.
+   */
+  void
+  setup_smoother(Level &level, const double max_eigenvalue_bound) const;
+
+  /**
+   * Apply one V-cycle on the given level to the right hand side stored in
+   * the rhs vector of the level, storing the result in its solution vector.
+   */
+  void
+  v_cycle(const unsigned int level) const;
+
+  /**
+   * The levels of the hierarchy, from the finest to the coarsest. The levels
+   * are stored through pointers because the matrices and smoothers refer to
+   * each other by address.
+   */
+  std::vector<std::unique_ptr<Level>> levels;
+
+  /**
+   * The inverse of the matrix on the coarsest level, empty if the coarsest
+   * level is too large to be inverted and the smoother is used instead.
+   */
+  FullMatrix<double> coarse_inverse;
+
+  /**
+   * The parameters given to initialize().
+   */
+  AdditionalData additional_data;
+};
+
+/** @} */
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
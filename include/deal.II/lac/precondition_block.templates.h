@@ -21,6 +21,7 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/memory_consumption.h>
 
+#include <deal.II/lac/batched_gauss_jordan.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
 #include <deal.II/lac/precondition_block.h>
@@ -164,6 +165,10 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
       // of the unknowns.
       M_cell = 0;
 
+      // invert the blocks in batches, with several blocks processed at once
+      // in the lanes of SIMD instructions
+      BatchedGaussJordan<inverse_type> batched_inverse;
+
       for (unsigned int cell = 0; cell < this->size(); ++cell)
         {
           const size_type cell_start = cell * blocksize;
@@ -195,7 +200,7 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
           switch (this->inversion)
             {
               case PreconditionBlockBase<inverse_type>::gauss_jordan:
-                this->inverse(cell).invert(M_cell);
+                batched_inverse.add(M_cell, this->inverse(cell));
                 break;
               case PreconditionBlockBase<inverse_type>::householder:
                 this->inverse_householder(cell).initialize(M_cell);
@@ -208,6 +213,7 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
                 DEAL_II_NOT_IMPLEMENTED();
             }
         }
+      batched_inverse.flush();
     }
   this->inverses_computed(true);
 }
@@ -459,6 +465,10 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
     {
       M_cell = 0;
 
+      // invert the blocks in batches, with several blocks processed at once
+      // in the lanes of SIMD instructions
+      BatchedGaussJordan<inverse_type> batched_inverse;
+
       for (unsigned int cell = 0; cell < this->size(); ++cell)
         {
           const size_type cell_start = cell * blocksize;
@@ -485,7 +495,7 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
           switch (this->inversion)
             {
               case PreconditionBlockBase<inverse_type>::gauss_jordan:
-                this->inverse(cell).invert(M_cell);
+                batched_inverse.add(M_cell, this->inverse(cell));
                 break;
               case PreconditionBlockBase<inverse_type>::householder:
                 this->inverse_householder(cell).initialize(M_cell);
@@ -498,6 +508,7 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
                 DEAL_II_NOT_IMPLEMENTED();
             }
         }
+      batched_inverse.flush();
     }
   this->inverses_computed(true);
 }
@@ -17,6 +17,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/lac/batched_gauss_jordan.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/relaxation_block.h>
 #include <deal.II/lac/trilinos_vector.h>
@@ -119,6 +120,10 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
   const MatrixType             &M = *(this->A);
   FullMatrix<InverseNumberType> M_cell;
 
+  // invert the blocks in batches of blocks of the same size, with several
+  // blocks processed at once in the lanes of SIMD instructions
+  BatchedGaussJordan<InverseNumberType> batched_inverse;
+
   for (size_type block = block_begin; block < block_end; ++block)
     {
       const size_type bs = this->additional_data->block_list.row_length(block);
@@ -152,7 +157,7 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
         {
           case PreconditionBlockBase<InverseNumberType>::gauss_jordan:
             this->inverse(block).reinit(bs, bs);
-            this->inverse(block).invert(M_cell);
+            batched_inverse.add(M_cell, this->inverse(block));
             break;
           case PreconditionBlockBase<InverseNumberType>::householder:
             this->inverse_householder(block).initialize(M_cell);
@@ -171,6 +176,7 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
             DEAL_II_NOT_IMPLEMENTED();
         }
     }
+  batched_inverse.flush();
 }
 
 namespace internal
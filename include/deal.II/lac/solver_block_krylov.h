@@ -0,0 +1,740 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_solver_block_krylov_h
+#define dealii_solver_block_krylov_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/** @addtogroup Solvers */
+/** @{ */
+
+/**
+ * This class implements the block variant of the preconditioned Conjugate
+ * Gradients method by O'Leary for solving a linear system with a symmetric
+ * positive definite matrix for several right hand sides at once.
+ *
+ * The right hand sides and solutions are stored in the blocks of a block
+ * vector of type @p BlockVectorType, such as BlockVector or
+ * LinearAlgebra::distributed::BlockVector, i.e., block $j$ of the solution
+ * vector is the solution of the linear system with block $j$ of the right
+ * hand side. All iterates form a common Krylov space, such that the method
+ * typically needs fewer iterations than solving for each right hand side
+ * separately with SolverCG, at the price of dense operations on matrices of
+ * size $k\times k$ for $k$ right hand sides.
+ *
+ * More importantly, the matrix and the preconditioner are applied to all
+ * vectors at once. If they provide a function
+ * @code
+ * void vmult_blockwise(BlockVectorType &dst, const BlockVectorType &src) const;
+ * @endcode
+ * that multiplies each block of @p src and writes the result into the
+ * corresponding block of @p dst, this function is used, which allows
+ * implementations to load the matrix only once for all vectors. This is
+ * the case for SparseMatrix; for matrix-free operators, the cell loop can
+ * work on all blocks at once. Otherwise, the <code>vmult()</code> function
+ * of the matrix or preconditioner is called for each block separately.
+ *
+ * The iteration stops when the largest of the residual norms of the
+ * individual systems satisfies the criterion of the SolverControl object.
+ * Once the residual of one of the systems falls below the tolerance, the
+ * method is restarted with the remaining systems only, which avoids the
+ * breakdown of the method due to linearly dependent residuals. For the same
+ * reason, the right hand sides must be linearly independent.
+ *
+ * @see D. P. O'Leary: "The block conjugate gradient algorithm and related
+ * methods", Linear Algebra and its Applications 29 (1980), pp. 293-322.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. The value passed to the
+ * iteration status is the largest residual norm of all systems.
+ */
+template <typename BlockVectorType>
+class SolverBlockCG : public SolverBase<BlockVectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver. This
+   * solver does not need additional data yet.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverBlockCG(SolverControl                 &cn,
+                VectorMemory<BlockVectorType> &mem,
+                const AdditionalData          &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverBlockCG(SolverControl        &cn,
+                const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear systems $Ax_j=b_j$ for all blocks $x_j$ of @p x and
+   * $b_j$ of @p b.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType         &A,
+        BlockVectorType          &x,
+        const BlockVectorType    &b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * A reference to the underlying SolverControl object, whose tolerance is
+   * used to decide when individual systems have converged.
+   */
+  SolverControl &solver_control;
+};
+
+
+
+/**
+ * This class implements the block variant of the restarted GMRES method for
+ * solving a linear system with a general matrix for several right hand
+ * sides at once. The right hand sides and solutions are stored in the blocks
+ * of a block vector, and the matrix and the preconditioner are applied to
+ * all vectors at once, in the same way as described for SolverBlockCG.
+ *
+ * The block Arnoldi process builds an orthonormal basis of the sum of the
+ * Krylov spaces of all right hand sides, with $k$ new basis vectors in each
+ * step for $k$ right hand sides. The projected least-squares problems of
+ * all systems share the same block Hessenberg matrix and are solved by
+ * Givens rotations. The preconditioner is applied from the right, such that
+ * the residual norms monitored by the iteration are the ones of the
+ * unpreconditioned systems.
+ *
+ * The method is restarted after AdditionalData::max_block_basis_size steps,
+ * i.e., with a basis of at most <code>max_block_basis_size</code> times $k$
+ * vectors. Systems that have converged at a restart are not considered any
+ * further. The iteration stops when the largest of the residual norms of the
+ * individual systems satisfies the criterion of the SolverControl object.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. The value passed to the
+ * iteration status is the largest residual norm of all systems.
+ */
+template <typename BlockVectorType>
+class SolverBlockGMRES : public SolverBase<BlockVectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, restart after 10 steps of the block Arnoldi
+     * process.
+     */
+    explicit AdditionalData(const unsigned int max_block_basis_size = 10);
+
+    /**
+     * Maximum number of steps of the block Arnoldi process before a restart.
+     * Every step adds one basis vector per right hand side, so the number of
+     * vectors to be stored grows with the number of right hand sides.
+     */
+    unsigned int max_block_basis_size;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverBlockGMRES(SolverControl                 &cn,
+                   VectorMemory<BlockVectorType> &mem,
+                   const AdditionalData          &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverBlockGMRES(SolverControl        &cn,
+                   const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear systems $Ax_j=b_j$ for all blocks $x_j$ of @p x and
+   * $b_j$ of @p b.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType         &A,
+        BlockVectorType          &x,
+        const BlockVectorType    &b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * A reference to the underlying SolverControl object, whose tolerance is
+   * used to decide when individual systems have converged.
+   */
+  SolverControl &solver_control;
+};
+
+/** @} */
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverBlockKrylovImplementation
+  {
+    template <typename OperatorType, typename BlockVectorType>
+    using vmult_blockwise_t =
+      decltype(std::declval<const OperatorType>().vmult_blockwise(
+        std::declval<BlockVectorType &>(),
+        std::declval<const BlockVectorType &>()));
+
+    template <typename OperatorType, typename BlockVectorType>
+    constexpr bool has_vmult_blockwise =
+      is_supported_operation<vmult_blockwise_t, OperatorType, BlockVectorType>;
+
+
+
+    /**
+     * Apply the given operator to all blocks of @p src, either at once if
+     * the operator supports it or block by block.
+     */
+    template <typename OperatorType, typename BlockVectorType>
+    void
+    vmult_blockwise(const OperatorType    &op,
+                    BlockVectorType       &dst,
+                    const BlockVectorType &src)
+    {
+      if constexpr (has_vmult_blockwise<OperatorType, BlockVectorType>)
+        op.vmult_blockwise(dst, src);
+      else
+        for (unsigned int b = 0; b < src.n_blocks(); ++b)
+          op.vmult(dst.block(b), src.block(b));
+    }
+
+
+
+    /**
+     * Reinitialize @p vector to @p n_blocks blocks with the layout of
+     * @p model.
+     */
+    template <typename BlockVectorType>
+    void
+    reinit_blocks(BlockVectorType                          &vector,
+                  const unsigned int                        n_blocks,
+                  const typename BlockVectorType::BlockType &model)
+    {
+      vector.reinit(n_blocks);
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        vector.block(b).reinit(model);
+      vector.collect_sizes();
+    }
+
+
+
+    /**
+     * Compute the matrix of inner products <code>result(i,j) =
+     * v.block(i) * w.block(j)</code>.
+     */
+    template <typename BlockVectorType>
+    void
+    compute_inner_products(
+      const BlockVectorType                            &v,
+      const BlockVectorType                            &w,
+      FullMatrix<typename BlockVectorType::value_type> &result,
+      const bool                                        symmetric)
+    {
+      result.reinit(v.n_blocks(), w.n_blocks());
+      for (unsigned int i = 0; i < v.n_blocks(); ++i)
+        for (unsigned int j = (symmetric ? i : 0); j < w.n_blocks(); ++j)
+          {
+            result(i, j) = v.block(i) * w.block(j);
+            if (symmetric)
+              result(j, i) = result(i, j);
+          }
+    }
+
+
+
+    /**
+     * Add the linear combinations <code>sum_i v.block(i) *
+     * coefficients(i,j)</code> to the blocks <code>block_indices[j]</code>
+     * of @p result.
+     */
+    template <typename BlockVectorType>
+    void
+    add_linear_combinations(
+      const BlockVectorType                                  &v,
+      const FullMatrix<typename BlockVectorType::value_type> &coefficients,
+      const std::vector<unsigned int>                        &block_indices,
+      const typename BlockVectorType::value_type              factor,
+      BlockVectorType                                        &result)
+    {
+      for (unsigned int j = 0; j < block_indices.size(); ++j)
+        for (unsigned int i = 0; i < v.n_blocks(); ++i)
+          result.block(block_indices[j])
+            .add(factor * coefficients(i, j), v.block(i));
+    }
+
+
+
+    /**
+     * Return the indices of the blocks of @p residual whose norm exceeds
+     * @p tolerance, and write the norms of all blocks into @p norms.
+     */
+    template <typename BlockVectorType>
+    std::vector<unsigned int>
+    unconverged_blocks(const BlockVectorType &residual,
+                       const double           tolerance,
+                       std::vector<double>   &norms)
+    {
+      std::vector<unsigned int> blocks;
+      norms.resize(residual.n_blocks());
+      for (unsigned int b = 0; b < residual.n_blocks(); ++b)
+        {
+          norms[b] = residual.block(b).l2_norm();
+          if (norms[b] > tolerance)
+            blocks.push_back(b);
+        }
+      return blocks;
+    }
+  } // namespace SolverBlockKrylovImplementation
+} // namespace internal
+
+
+
+template <typename BlockVectorType>
+SolverBlockCG<BlockVectorType>::SolverBlockCG(
+  SolverControl                 &cn,
+  VectorMemory<BlockVectorType> &mem,
+  const AdditionalData          &data)
+  : SolverBase<BlockVectorType>(cn, mem)
+  , additional_data(data)
+  , solver_control(cn)
+{}
+
+
+
+template <typename BlockVectorType>
+SolverBlockCG<BlockVectorType>::SolverBlockCG(SolverControl        &cn,
+                                              const AdditionalData &data)
+  : SolverBase<BlockVectorType>(cn)
+  , additional_data(data)
+  , solver_control(cn)
+{}
+
+
+
+template <typename BlockVectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverBlockCG<BlockVectorType>::solve(const MatrixType         &A,
+                                      BlockVectorType          &x,
+                                      const BlockVectorType    &b,
+                                      const PreconditionerType &preconditioner)
+{
+  using namespace internal::SolverBlockKrylovImplementation;
+  using number = typename BlockVectorType::value_type;
+
+  AssertDimension(x.n_blocks(), b.n_blocks());
+
+  LogStream::Prefix prefix("block_cg");
+
+  typename VectorMemory<BlockVectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer z_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer t_pointer(this->memory);
+
+  // r holds the residuals of all systems, whereas z, p, q, t only hold the
+  // ones that are still iterated on
+  BlockVectorType &r = *r_pointer;
+  BlockVectorType &z = *z_pointer;
+  BlockVectorType &p = *p_pointer;
+  BlockVectorType &q = *q_pointer;
+  BlockVectorType &t = *t_pointer;
+
+  r.reinit(x, true);
+  vmult_blockwise(A, r, x);
+  r.sadd(number(-1.), number(1.), b);
+
+  std::vector<double> residual_norms;
+  unconverged_blocks(r, 0., residual_norms);
+  double max_residual =
+    *std::max_element(residual_norms.begin(), residual_norms.end());
+  SolverControl::State solver_state =
+    this->iteration_status(0, max_residual, x);
+
+  FullMatrix<number> zr, zr_new, pq, coefficients;
+  unsigned int       it = 0;
+  while (solver_state == SolverControl::iterate)
+    {
+      // (re)start the block iteration with the systems that have not
+      // converged yet
+      const std::vector<unsigned int> active =
+        unconverged_blocks(r, solver_control.tolerance(), residual_norms);
+      const unsigned int n_active = active.size();
+      Assert(n_active > 0, ExcInternalError());
+
+      BlockVectorType r_active;
+      reinit_blocks(r_active, n_active, x.block(0));
+      for (unsigned int j = 0; j < n_active; ++j)
+        r_active.block(j) = r.block(active[j]);
+      reinit_blocks(z, n_active, x.block(0));
+      reinit_blocks(p, n_active, x.block(0));
+      reinit_blocks(q, n_active, x.block(0));
+      reinit_blocks(t, n_active, x.block(0));
+
+      vmult_blockwise(preconditioner, z, r_active);
+      p = z;
+      compute_inner_products(z, r_active, zr, false);
+
+      std::vector<unsigned int> identity(n_active);
+      for (unsigned int j = 0; j < n_active; ++j)
+        identity[j] = j;
+
+      bool restart = false;
+      while (solver_state == SolverControl::iterate && !restart)
+        {
+          vmult_blockwise(A, q, p);
+
+          // step length: solve (p^T A p) alpha = z^T r
+          compute_inner_products(p, q, pq, true);
+          pq.gauss_jordan();
+          coefficients.reinit(n_active, n_active);
+          pq.mmult(coefficients, zr);
+
+          add_linear_combinations(p, coefficients, active, number(1.), x);
+          add_linear_combinations(
+            q, coefficients, identity, number(-1.), r_active);
+
+          ++it;
+          max_residual = 0.;
+          for (unsigned int j = 0; j < n_active; ++j)
+            {
+              residual_norms[active[j]] = r_active.block(j).l2_norm();
+              max_residual = std::max(max_residual, residual_norms[active[j]]);
+              if (residual_norms[active[j]] <= solver_control.tolerance())
+                restart = true;
+            }
+          solver_state = this->iteration_status(it, max_residual, x);
+          if (solver_state != SolverControl::iterate || restart)
+            break;
+
+          // new search directions: p = z + p beta with
+          // beta = (z_old^T r_old)^{-1} z^T r
+          vmult_blockwise(preconditioner, z, r_active);
+          compute_inner_products(z, r_active, zr_new, false);
+          zr.gauss_jordan();
+          zr.mmult(coefficients, zr_new);
+          zr = zr_new;
+
+          t = z;
+          add_linear_combinations(p, coefficients, identity, number(1.), t);
+          p.swap(t);
+        }
+
+      for (unsigned int j = 0; j < n_active; ++j)
+        r.block(active[j]) = r_active.block(j);
+    }
+
+  AssertThrow(solver_state == SolverControl::success,
+              SolverControl::NoConvergence(it, max_residual));
+}
+
+
+
+template <typename BlockVectorType>
+inline SolverBlockGMRES<BlockVectorType>::AdditionalData::AdditionalData(
+  const unsigned int max_block_basis_size)
+  : max_block_basis_size(max_block_basis_size)
+{}
+
+
+
+template <typename BlockVectorType>
+SolverBlockGMRES<BlockVectorType>::SolverBlockGMRES(
+  SolverControl                 &cn,
+  VectorMemory<BlockVectorType> &mem,
+  const AdditionalData          &data)
+  : SolverBase<BlockVectorType>(cn, mem)
+  , additional_data(data)
+  , solver_control(cn)
+{}
+
+
+
+template <typename BlockVectorType>
+SolverBlockGMRES<BlockVectorType>::SolverBlockGMRES(SolverControl        &cn,
+                                                    const AdditionalData &data)
+  : SolverBase<BlockVectorType>(cn)
+  , additional_data(data)
+  , solver_control(cn)
+{}
+
+
+
+template <typename BlockVectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverBlockGMRES<BlockVectorType>::solve(
+  const MatrixType         &A,
+  BlockVectorType          &x,
+  const BlockVectorType    &b,
+  const PreconditionerType &preconditioner)
+{
+  using namespace internal::SolverBlockKrylovImplementation;
+  using number = typename BlockVectorType::value_type;
+
+  AssertDimension(x.n_blocks(), b.n_blocks());
+  Assert(additional_data.max_block_basis_size > 0,
+         ExcMessage("The basis must contain at least one block."));
+
+  LogStream::Prefix prefix("block_GMRES");
+
+  const unsigned int max_steps = additional_data.max_block_basis_size;
+
+  typename VectorMemory<BlockVectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<BlockVectorType>::Pointer t_pointer(this->memory);
+  BlockVectorType                                &r = *r_pointer;
+  BlockVectorType                                &t = *t_pointer;
+  r.reinit(x, true);
+
+  // the blocks of the basis, each of which holds one vector per system
+  std::vector<typename VectorMemory<BlockVectorType>::Pointer> basis;
+
+  // a Givens rotation acting on two consecutive rows
+  struct Rotation
+  {
+    unsigned int row;
+    number       c;
+    number       s;
+  };
+  const auto apply_rotation = [](const Rotation     &rotation,
+                                 FullMatrix<number> &matrix,
+                                 const unsigned int  column) {
+    const number a = matrix(rotation.row, column);
+    const number b = matrix(rotation.row + 1, column);
+    matrix(rotation.row, column)     = rotation.c * a + rotation.s * b;
+    matrix(rotation.row + 1, column) = -rotation.s * a + rotation.c * b;
+  };
+
+  std::vector<double>  residual_norms;
+  double               max_residual = 0.;
+  SolverControl::State solver_state = SolverControl::iterate;
+  unsigned int         it           = 0;
+  while (solver_state == SolverControl::iterate)
+    {
+      vmult_blockwise(A, r, x);
+      r.sadd(number(-1.), number(1.), b);
+
+      // check the true residual in the first cycle and whenever all
+      // systems have converged according to the true residual; otherwise,
+      // the convergence is checked with the residual estimates below
+      const std::vector<unsigned int> active =
+        unconverged_blocks(r,
+                           (it == 0 ? 0. : solver_control.tolerance()),
+                           residual_norms);
+      if (it == 0 || active.empty())
+        {
+          max_residual =
+            *std::max_element(residual_norms.begin(), residual_norms.end());
+          solver_state = this->iteration_status(it, max_residual, x);
+          if (solver_state != SolverControl::iterate)
+            break;
+        }
+      const unsigned int n_active = active.size();
+
+      // first basis block: orthonormalize the residuals of the active
+      // systems by the modified Gram-Schmidt method, r = v_0 s
+      FullMatrix<number> hessenberg((max_steps + 1) * n_active,
+                                    max_steps * n_active);
+      FullMatrix<number> rhs((max_steps + 1) * n_active, n_active);
+      std::vector<Rotation> rotations;
+
+      if (basis.empty())
+        basis.emplace_back(this->memory);
+      BlockVectorType &v0 = *basis[0];
+      reinit_blocks(v0, n_active, x.block(0));
+      for (unsigned int c = 0; c < n_active; ++c)
+        {
+          v0.block(c) = r.block(active[c]);
+          for (unsigned int d = 0; d < c; ++d)
+            {
+              rhs(d, c) = v0.block(d) * v0.block(c);
+              v0.block(c).add(-rhs(d, c), v0.block(d));
+            }
+          rhs(c, c) = v0.block(c).l2_norm();
+          AssertThrow(std::abs(rhs(c, c)) >
+                        1e-14 * residual_norms[active[c]],
+                      ExcMessage("The residuals of the systems to be solved "
+                                 "are linearly dependent."));
+          v0.block(c) /= rhs(c, c);
+        }
+
+      unsigned int n_steps = 0;
+      for (unsigned int step = 0; step < max_steps; ++step)
+        {
+          if (basis.size() < step + 2)
+            basis.emplace_back(this->memory);
+          const BlockVectorType &v = *basis[step];
+          BlockVectorType       &w = *basis[step + 1];
+          reinit_blocks(t, n_active, x.block(0));
+          reinit_blocks(w, n_active, x.block(0));
+
+          vmult_blockwise(preconditioner, t, v);
+          vmult_blockwise(A, w, t);
+
+          // orthogonalize against the previous basis blocks and among the
+          // new vectors, again with the modified Gram-Schmidt method
+          bool breakdown = false;
+          for (unsigned int c = 0; c < n_active; ++c)
+            {
+              const unsigned int column = step * n_active + c;
+              const double       norm_before = w.block(c).l2_norm();
+              for (unsigned int i = 0; i <= step + 1; ++i)
+                {
+                  const BlockVectorType &vi = *basis[i];
+                  for (unsigned int d = 0; d < (i <= step ? n_active : c); ++d)
+                    {
+                      const unsigned int row = i * n_active + d;
+                      hessenberg(row, column) = vi.block(d) * w.block(c);
+                      w.block(c).add(-hessenberg(row, column), vi.block(d));
+                    }
+                }
+              const unsigned int row  = (step + 1) * n_active + c;
+              const double       norm = w.block(c).l2_norm();
+              hessenberg(row, column) = norm;
+              if (norm > 1e-14 * norm_before)
+                w.block(c) /= norm;
+              else
+                {
+                  w.block(c) = number();
+                  breakdown  = true;
+                }
+            }
+
+          // transform the new columns to upper triangular form by Givens
+          // rotations, and apply the new rotations to the right hand sides
+          for (unsigned int c = 0; c < n_active; ++c)
+            {
+              const unsigned int column = step * n_active + c;
+              for (const Rotation &rotation : rotations)
+                apply_rotation(rotation, hessenberg, column);
+              for (unsigned int row = column + n_active; row > column; --row)
+                {
+                  const number a = hessenberg(row - 1, column);
+                  const number b = hessenberg(row, column);
+                  const number denominator = std::sqrt(a * a + b * b);
+                  Rotation     rotation{row - 1, number(1.), number(0.)};
+                  if (denominator != number())
+                    {
+                      rotation.c = a / denominator;
+                      rotation.s = b / denominator;
+                    }
+                  rotations.push_back(rotation);
+                  apply_rotation(rotation, hessenberg, column);
+                  for (unsigned int k = 0; k < n_active; ++k)
+                    apply_rotation(rotation, rhs, k);
+                }
+            }
+
+          // the residual of system c is the part of column c of the
+          // transformed right hand side below the triangular part
+          ++it;
+          ++n_steps;
+          max_residual = 0.;
+          for (unsigned int c = 0; c < n_active; ++c)
+            {
+              double sum = 0.;
+              for (unsigned int row = (step + 1) * n_active;
+                   row < (step + 2) * n_active;
+                   ++row)
+                sum += rhs(row, c) * rhs(row, c);
+              max_residual = std::max(max_residual, std::sqrt(sum));
+            }
+          solver_state = this->iteration_status(it, max_residual, x);
+          if (solver_state != SolverControl::iterate || breakdown)
+            break;
+        }
+
+      // solve the triangular system for the coefficients of the update and
+      // add the preconditioned linear combination of the basis to x
+      const unsigned int n = n_steps * n_active;
+      FullMatrix<number> coefficients(n, n_active);
+      for (unsigned int k = 0; k < n_active; ++k)
+        for (unsigned int i = n; i-- > 0;)
+          {
+            number sum = rhs(i, k);
+            for (unsigned int j = i + 1; j < n; ++j)
+              sum -= hessenberg(i, j) * coefficients(j, k);
+            coefficients(i, k) = sum / hessenberg(i, i);
+          }
+
+      BlockVectorType &u = *basis[n_steps];
+      reinit_blocks(u, n_active, x.block(0));
+      for (unsigned int step = 0; step < n_steps; ++step)
+        for (unsigned int c = 0; c < n_active; ++c)
+          for (unsigned int d = 0; d < n_active; ++d)
+            u.block(c).add(coefficients(step * n_active + d, c),
+                           basis[step]->block(d));
+      reinit_blocks(t, n_active, x.block(0));
+      vmult_blockwise(preconditioner, t, u);
+      for (unsigned int c = 0; c < n_active; ++c)
+        x.block(active[c]) += t.block(c);
+    }
+
+  AssertThrow(solver_state == SolverControl::success,
+              SolverControl::NoConvergence(it, max_residual));
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
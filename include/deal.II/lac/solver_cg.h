@@ -24,6 +24,7 @@
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/vectorization.h>
 
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
@@ -553,6 +554,103 @@ namespace internal
 
   namespace SolverCG
   {
+    // Update the solution and the residual by x += alpha p and r -= alpha v
+    // and return the square of the norm of the new residual. For general
+    // vector types, this uses the fused add_and_dot() operation of the
+    // vector class for the residual.
+    template <typename VectorType>
+    typename VectorType::value_type
+    update_solution_and_residual(const typename VectorType::value_type alpha,
+                                 const VectorType                     &p,
+                                 const VectorType                     &v,
+                                 VectorType                           &x,
+                                 VectorType                           &r)
+    {
+      x.add(alpha, p);
+      return r.add_and_dot(-alpha, v, r);
+    }
+
+    // For LinearAlgebra::distributed::Vector, do both updates and the inner
+    // product in a single sweep over the vector entries.
+    template <typename Number>
+    Number
+    update_solution_and_residual(
+      const Number                                                   alpha,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &p,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &v,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>       &x,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>       &r)
+    {
+      const Number *p_values = p.begin();
+      const Number *v_values = v.begin();
+      Number       *x_values = x.begin();
+      Number       *r_values = r.begin();
+
+      return LinearAlgebra::distributed::FusedOperations::run<1>(
+        x,
+        [&](const unsigned int     begin,
+            const unsigned int     end,
+            std::array<Number, 1> &sums) {
+          Number r_norm_square = 0;
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              x_values[i] += alpha * p_values[i];
+              const Number r_i = r_values[i] - alpha * v_values[i];
+              r_values[i]      = r_i;
+              r_norm_square += numbers::NumberTraits<Number>::abs_square(r_i);
+            }
+          sums[0] += r_norm_square;
+        })[0];
+    }
+
+
+
+    // Compute the inner products (r,v) and (r,z) that are needed in the
+    // flexible variant of the CG method.
+    template <typename VectorType>
+    std::array<typename VectorType::value_type, 2>
+    flexible_inner_products(const VectorType &r,
+                            const VectorType &v,
+                            const VectorType &z)
+    {
+      return {{r * v, r * z}};
+    }
+
+    // For LinearAlgebra::distributed::Vector, read the vector r only once
+    // and compute both inner products with a single global reduction.
+    template <typename Number>
+    std::array<Number, 2>
+    flexible_inner_products(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &r,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &v,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &z)
+    {
+      const Number *r_values = r.begin();
+      const Number *v_values = v.begin();
+      const Number *z_values = z.begin();
+
+      return LinearAlgebra::distributed::FusedOperations::run<2>(
+        r,
+        [&](const unsigned int     begin,
+            const unsigned int     end,
+            std::array<Number, 2> &sums) {
+          Number r_dot_v = 0, r_dot_z = 0;
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              r_dot_v +=
+                r_values[i] * numbers::NumberTraits<Number>::conjugate(
+                                v_values[i]);
+              r_dot_z +=
+                r_values[i] * numbers::NumberTraits<Number>::conjugate(
+                                z_values[i]);
+            }
+          sums[0] += r_dot_v;
+          sums[1] += r_dot_z;
+        });
+    }
+
+
+
     // This base class is used to select different variants of the conjugate
     // gradient solver. The default variant is used for standard matrix and
     // preconditioner arguments, as provided by the derived class
@@ -709,13 +807,26 @@ namespace internal
         const Number previous_r_dot_preconditioner_dot_r =
           r_dot_preconditioner_dot_r;
 
+        Number r_dot_z = Number();
         if (std::is_same_v<PreconditionerType, PreconditionIdentity> == false)
           {
             preconditioner.vmult(v, r);
-            r_dot_preconditioner_dot_r = r * v;
+            if (this->flexible && iteration_index > 1)
+              {
+                const std::array<Number, 2> products =
+                  flexible_inner_products(r, v, z);
+                r_dot_preconditioner_dot_r = products[0];
+                r_dot_z                    = products[1];
+              }
+            else
+              r_dot_preconditioner_dot_r = r * v;
           }
         else
-          r_dot_preconditioner_dot_r = residual_norm * residual_norm;
+          {
+            r_dot_preconditioner_dot_r = residual_norm * residual_norm;
+            if (this->flexible && iteration_index > 1)
+              r_dot_z = r * z;
+          }
 
         const VectorType &direction =
           std::is_same_v<PreconditionerType, PreconditionIdentity> ? r : v;
@@ -727,7 +838,7 @@ namespace internal
             beta =
               r_dot_preconditioner_dot_r / previous_r_dot_preconditioner_dot_r;
             if (this->flexible)
-              beta -= (r * z) / previous_r_dot_preconditioner_dot_r;
+              beta -= r_dot_z / previous_r_dot_preconditioner_dot_r;
             p.sadd(beta, 1., direction);
           }
         else
@@ -744,17 +855,18 @@ namespace internal
         this->previous_alpha = alpha;
         alpha                = r_dot_preconditioner_dot_r / p_dot_A_dot_p;
 
-        x.add(alpha, p);
-
         // compute the residual norm with implicit residual
         if (use_default_residual)
           {
-            residual_norm = std::sqrt(std::abs(r.add_and_dot(-alpha, v, r)));
+            residual_norm = std::sqrt(
+              std::abs(update_solution_and_residual(alpha, p, v, x, r)));
           }
         // compute the residual norm with the explicit residual, i.e.
         // compute l2 norm of Ax - b.
         else
           {
+            x.add(alpha, p);
+
             // compute the residual conjugate gradient update
             r.add(-alpha, v);
             // compute explicit residual
@@ -25,6 +25,7 @@
 
 #include <deal.II/lac/block_vector_base.h>
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
 #include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/orthogonalization.h>
 #include <deal.II/lac/solver.h>
@@ -1267,11 +1268,13 @@ namespace internal
 
 
 
-    // worker method for deal.II's vector types implemented in .cc file
+    // worker method for deal.II's vector types implemented in .cc file,
+    // working on the entries [begin, end) of the vectors
     template <bool delayed_reorthogonalization, typename Number>
     double
     do_subtract_and_norm(const unsigned int                 n_vectors,
-                         const std::size_t                  locally_owned_size,
+                         const std::size_t                  begin,
+                         const std::size_t                  end,
                          const std::vector<const Number *> &orthogonal_vectors,
                          const Vector<double>              &h,
                          Number                            *current_vector);
@@ -1298,16 +1301,30 @@ namespace internal
           for (unsigned int i = 0; i < n; ++i)
             vector_ptrs[i] = block(orthogonal_vectors[i], b).begin();
 
-          norm_vv_temp += do_subtract_and_norm<delayed_reorthogonalization>(
-            n,
-            block(vv, b).end() - block(vv, b).begin(),
-            vector_ptrs,
-            h,
-            block(vv, b).begin());
+          // subtract the projections and compute the norm in one sweep over
+          // cache-sized chunks, distributed to several threads
+          typename VectorType::value_type *current_vector =
+            block(vv, b).begin();
+          norm_vv_temp +=
+            LinearAlgebra::distributed::FusedOperations::run_local<1, double>(
+              block(vv, b).end() - block(vv, b).begin(),
+              [&](const unsigned int     begin,
+                  const unsigned int     end,
+                  std::array<double, 1> &sums) {
+                sums[0] += do_subtract_and_norm<delayed_reorthogonalization>(
+                  n, begin, end, vector_ptrs, h, current_vector);
+              })[0];
         }
 
-      return std::sqrt(
-        Utilities::MPI::sum(norm_vv_temp, block(vv, 0).get_mpi_communicator()));
+      // the delayed reorthogonalization computes the norm from the inner
+      // products of the next step, so we must not spend a global reduction
+      // here: the Arnoldi step then needs the single reduction in
+      // Tvmult_add()
+      if (delayed_reorthogonalization)
+        return std::numeric_limits<double>::signaling_NaN();
+      else
+        return std::sqrt(Utilities::MPI::sum(
+          norm_vv_temp, block(vv, 0).get_mpi_communicator()));
     }
 
 
@@ -1334,11 +1351,13 @@ namespace internal
 
 
 
-    // worker method for deal.II's vector types implemented in .cc file
+    // worker method for deal.II's vector types implemented in .cc file,
+    // working on the entries [begin, end) of the vectors
     template <typename Number>
     void
     do_add(const unsigned int                 n_vectors,
-           const std::size_t                  locally_owned_size,
+           const std::size_t                  begin,
+           const std::size_t                  end,
            const std::vector<const Number *> &tmp_vectors,
            const Vector<double>              &h,
            const bool                         zero_out,
@@ -1362,12 +1381,14 @@ namespace internal
           vector_ptrs.resize(n);
           for (unsigned int i = 0; i < n; ++i)
             vector_ptrs[i] = block(tmp_vectors[i], b).begin();
-          do_add(n,
-                 block(p, b).end() - block(p, b).begin(),
-                 vector_ptrs,
-                 h,
-                 zero_out,
-                 block(p, b).begin());
+          typename VectorType::value_type *output = block(p, b).begin();
+          LinearAlgebra::distributed::FusedOperations::run_local<0, double>(
+            block(p, b).end() - block(p, b).begin(),
+            [&](const unsigned int begin,
+                const unsigned int end,
+                std::array<double, 0> &) {
+              do_add(n, begin, end, vector_ptrs, h, zero_out, output);
+            });
         }
     }
 
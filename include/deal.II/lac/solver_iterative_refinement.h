@@ -0,0 +1,284 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_solver_iterative_refinement_h
+#define dealii_solver_iterative_refinement_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector_memory.h>
+
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Solvers
+ * @{
+ */
+
+/**
+ * Implementation of iterative refinement, also known as defect correction,
+ * with an inner solver that may work in a lower precision than the outer
+ * iteration. In each step, the residual $r_k = b - Ax_k$ is computed with the
+ * matrix and vectors of type @p VectorType, typically in double precision.
+ * The residual is then converted to the vector type of the inner solver,
+ * typically a vector in single precision, the correction equation $\tilde A
+ * c_k = r_k$ is solved approximately with the inner solver, matrix and
+ * preconditioner, and the correction is added to the solution in the outer
+ * precision, $x_{k+1} = x_k + c_k$. As long as the inner solver reduces the
+ * error by some fixed factor in each outer step, the iteration converges to
+ * the accuracy of the outer precision, while most of the work is done in the
+ * inner Krylov iterations in the lower precision, where the matrix and the
+ * vectors need only half of the memory transfer.
+ *
+ * The residual is scaled to unit norm before it is passed to the inner
+ * solver, and the correction is scaled back afterwards. This keeps the
+ * right hand side of the inner solve within the range of the lower
+ * precision also when the outer residual becomes small, and it makes an
+ * absolute tolerance in the SolverControl of the inner solver act as the
+ * relative reduction of the residual in each outer step. A typical choice is
+ * a tolerance between $10^{-2}$ and $10^{-4}$, since tolerances below the
+ * rounding error of the inner precision cannot be reached. If the inner
+ * solver throws a SolverControl::NoConvergence exception, e.g. because it
+ * uses an IterationNumberControl or a maximal number of iterations that is
+ * reached, the exception is ignored and the approximate correction computed
+ * so far is used: the convergence of the overall iteration is monitored by
+ * the SolverControl object of this class on the outer residual.
+ *
+ * The following example uses SolverCG on a copy of the matrix in single
+ * precision that shares the sparsity pattern of the double precision matrix,
+ * see also the documentation of the SparseMatrix class:
+ * @code
+ *   SparseMatrix<double> system_matrix(sparsity_pattern);
+ *   ... // assemble the system matrix
+ *   SparseMatrix<float> system_matrix_float(sparsity_pattern);
+ *   system_matrix_float.copy_from(system_matrix);
+ *   SparseILU<float> preconditioner;
+ *   preconditioner.initialize(system_matrix);
+ *
+ *   ReductionControl        inner_control(1000, 0., 1e-3);
+ *   SolverCG<Vector<float>> inner_solver(inner_control);
+ *
+ *   SolverControl control(100, 1e-12 * rhs.l2_norm());
+ *   SolverIterativeRefinement<Vector<double>> solver(control);
+ *   solver.solve(system_matrix,
+ *                solution,
+ *                rhs,
+ *                inner_solver,
+ *                system_matrix_float,
+ *                preconditioner);
+ * @endcode
+ * The same works with LinearAlgebra::distributed::Vector<double> as outer
+ * and LinearAlgebra::distributed::Vector<float> as inner vector type, for
+ * example with a matrix-free operator in double precision to compute the
+ * residual and an operator based on MatrixFree<dim,float> for the inner
+ * solver. The inner vectors are set up from the outer ones through the
+ * function <code>InnerVectorType::reinit(const VectorType &, bool)</code> and
+ * converted through <code>InnerVectorType::operator=(const VectorType
+ * &)</code> and vice versa.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence, based on the norm of the
+ * residual in the outer precision. This mechanism can also be used to
+ * observe the progress of the iteration. The iterations of the inner solver
+ * are reported through the SolverControl object of the inner solver.
+ */
+template <typename VectorType = Vector<double>>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+class SolverIterativeRefinement : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver. There is
+   * no data in here for iterative refinement, the parameters of the inner
+   * solve are set through the inner solver object.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverIterativeRefinement(SolverControl            &cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData     &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverIterativeRefinement(SolverControl        &cn,
+                            const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x. The residual is computed with the
+   * matrix @p A in the precision of @p VectorType, and the corrections are
+   * computed by calling <code>inner_solver.solve(inner_matrix, c, r,
+   * inner_preconditioner)</code> with vectors of the type
+   * <code>InnerSolverType::vector_type</code>. The @p inner_matrix is
+   * usually an approximation of @p A in lower precision, but it may also be
+   * a different approximation of @p A.
+   */
+  template <typename MatrixType,
+            typename InnerSolverType,
+            typename InnerMatrixType,
+            typename InnerPreconditionerType>
+  DEAL_II_CXX20_REQUIRES(
+    (concepts::is_linear_operator_on<MatrixType, VectorType> &&
+     concepts::is_linear_operator_on<InnerMatrixType,
+                                     typename InnerSolverType::vector_type> &&
+     concepts::is_linear_operator_on<InnerPreconditionerType,
+                                     typename InnerSolverType::vector_type>))
+  void solve(const MatrixType              &A,
+             VectorType                    &x,
+             const VectorType              &b,
+             InnerSolverType               &inner_solver,
+             const InnerMatrixType         &inner_matrix,
+             const InnerPreconditionerType &inner_preconditioner);
+
+protected:
+  /**
+   * Control parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/** @} */
+/*------------------ Implementation of iterative refinement -----------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+SolverIterativeRefinement<VectorType>::SolverIterativeRefinement(
+  SolverControl            &cn,
+  VectorMemory<VectorType> &mem,
+  const AdditionalData     &data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+SolverIterativeRefinement<VectorType>::SolverIterativeRefinement(
+  SolverControl        &cn,
+  const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+template <typename MatrixType,
+          typename InnerSolverType,
+          typename InnerMatrixType,
+          typename InnerPreconditionerType>
+DEAL_II_CXX20_REQUIRES(
+  (concepts::is_linear_operator_on<MatrixType, VectorType> &&
+   concepts::is_linear_operator_on<InnerMatrixType,
+                                   typename InnerSolverType::vector_type> &&
+   concepts::is_linear_operator_on<InnerPreconditionerType,
+                                   typename InnerSolverType::vector_type>))
+void SolverIterativeRefinement<VectorType>::solve(
+  const MatrixType              &A,
+  VectorType                    &x,
+  const VectorType              &b,
+  InnerSolverType               &inner_solver,
+  const InnerMatrixType         &inner_matrix,
+  const InnerPreconditionerType &inner_preconditioner)
+{
+  using InnerVectorType = typename InnerSolverType::vector_type;
+
+  SolverControl::State conv          = SolverControl::iterate;
+  double               residual_norm = std::numeric_limits<double>::lowest();
+
+  unsigned int iter = 0;
+
+  // Memory allocation.
+  // 'Vr' holds the residual and, after the inner solve, the correction in
+  // the outer precision, 'Vr_inner' and 'Vc_inner' the residual and the
+  // correction in the precision of the inner solver
+  typename VectorMemory<VectorType>::Pointer Vr(this->memory);
+  VectorType                                &r = *Vr;
+  r.reinit(x);
+
+  GrowingVectorMemory<InnerVectorType>            inner_memory;
+  typename VectorMemory<InnerVectorType>::Pointer Vr_inner(inner_memory);
+  typename VectorMemory<InnerVectorType>::Pointer Vc_inner(inner_memory);
+  InnerVectorType                                &r_inner = *Vr_inner;
+  InnerVectorType                                &c_inner = *Vc_inner;
+  r_inner.reinit(x, true);
+  c_inner.reinit(x, true);
+
+  LogStream::Prefix prefix("IterativeRefinement");
+
+  // Main loop
+  while (conv == SolverControl::iterate)
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+
+      residual_norm = r.l2_norm();
+      conv          = this->iteration_status(iter, residual_norm, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // solve for the correction with a residual of unit norm
+      r *= 1. / residual_norm;
+      r_inner = r;
+      c_inner = typename InnerVectorType::value_type();
+      try
+        {
+          inner_solver.solve(inner_matrix,
+                             c_inner,
+                             r_inner,
+                             inner_preconditioner);
+        }
+      catch (const SolverControl::NoConvergence &)
+        {
+          // use the correction computed so far, the convergence is checked
+          // on the outer residual in the next step
+        }
+
+      r = c_inner;
+      x.add(residual_norm, r);
+
+      ++iter;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(iter, residual_norm));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
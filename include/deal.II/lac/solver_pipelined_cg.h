@@ -0,0 +1,518 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_solver_pipelined_cg_h
+#define dealii_solver_pipelined_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <array>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+#endif
+
+
+/** @addtogroup Solvers */
+/** @{ */
+
+/**
+ * This class implements the pipelined variant of the preconditioned
+ * Conjugate Gradients method by Ghysels and Vanroose, see
+ * @cite Ghysels2014, for symmetric positive definite matrices and
+ * preconditioners.
+ *
+ * The classical CG method as implemented in SolverCG needs two global
+ * reductions (inner products) per iteration, each of which has to be
+ * completed before the algorithm can proceed. For parallel computations on
+ * many processes with a cheap matrix-vector product, e.g. with matrix-free
+ * operators, the latency of these reductions limits the scalability of the
+ * solver. The pipelined variant computes all inner products of an iteration
+ * in a single reduction and rearranges the algorithm by means of additional
+ * auxiliary vectors such that this reduction can be overlapped with one
+ * application of the preconditioner and one matrix-vector product. In exact
+ * arithmetic, the iterates are the same as the ones of SolverCG.
+ *
+ * The price to pay is that the algorithm needs nine vectors instead of four,
+ * and eight vector updates per iteration instead of three. Furthermore,
+ * since the residual is computed by recurrences that involve more terms,
+ * the maximal accuracy attainable is somewhat lower than for SolverCG. The
+ * solver is therefore only beneficial if the reductions are the bottleneck,
+ * i.e., on large numbers of MPI processes.
+ *
+ * Like all other solver classes, this class can work on any kind of vector
+ * and matrix that satisfy the requirements listed in the documentation of
+ * the Solver base class. In general, the inner products are computed by the
+ * functions of the vector class and are therefore blocking. If the vector
+ * type is LinearAlgebra::distributed::Vector with memory space
+ * MemorySpace::Host, the vector updates and the computation of the local
+ * parts of the three inner products are fused into a single loop over the
+ * vector entries, and the global sum is started with a non-blocking
+ * <code>MPI_Iallreduce</code> that only needs to be completed after the
+ * preconditioner and the matrix-vector product have been applied.
+ *
+ * The convergence criterion is based on the norm of the unpreconditioned
+ * residual, as for SolverCG. Since the residual norm of an iteration is
+ * only available after the next matrix-vector product has been started, the
+ * solver performs one application of the preconditioner and of the matrix
+ * more than SolverCG when it terminates.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. This mechanism can also be used
+ * to observe the progress of the iteration.
+ */
+template <typename VectorType = Vector<double>>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+class SolverPipelinedCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver. This
+   * solver does not need additional data yet.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl            &cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData     &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl        &cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  DEAL_II_CXX20_REQUIRES(
+    (concepts::is_linear_operator_on<MatrixType, VectorType> &&
+     concepts::is_linear_operator_on<PreconditionerType, VectorType>))
+  void solve(const MatrixType         &A,
+             VectorType               &x,
+             const VectorType         &b,
+             const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/** @} */
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverPipelinedCGImplementation
+  {
+    /**
+     * The vector operations of the pipelined CG method, for general vector
+     * types. The three inner products $(r,u)$, $(w,u)$, and $(r,r)$ are
+     * computed by the vector class as soon as the reduction is started.
+     */
+    template <typename VectorType>
+    class PipelinedOperations
+    {
+    public:
+      using number = typename VectorType::value_type;
+
+      void
+      start_reduction(const VectorType &r,
+                      const VectorType &u,
+                      const VectorType &w)
+      {
+        results[0] = r * u;
+        results[1] = w * u;
+        results[2] = r * r;
+      }
+
+      const std::array<number, 3> &
+      finish_reduction()
+      {
+        return results;
+      }
+
+      /**
+       * Compute the new search directions and update the solution and the
+       * residual vectors, then start the reduction for the next iteration.
+       */
+      void
+      update_and_start_reduction(const number      alpha,
+                                 const number      beta,
+                                 const VectorType &m,
+                                 const VectorType &n,
+                                 VectorType       &x,
+                                 VectorType       &r,
+                                 VectorType       &u,
+                                 VectorType       &w,
+                                 VectorType       &p,
+                                 VectorType       &q,
+                                 VectorType       &s,
+                                 VectorType       &z)
+      {
+        z.sadd(beta, number(1.), n);
+        q.sadd(beta, number(1.), m);
+        s.sadd(beta, number(1.), w);
+        p.sadd(beta, number(1.), u);
+        x.add(alpha, p);
+        r.add(-alpha, s);
+        u.add(-alpha, q);
+        w.add(-alpha, z);
+
+        start_reduction(r, u, w);
+      }
+
+    private:
+      std::array<number, 3> results;
+    };
+
+
+
+    /**
+     * The vector operations of the pipelined CG method for
+     * LinearAlgebra::distributed::Vector on the host. All vector updates of
+     * an iteration are done in one sweep over the locally owned entries with
+     * LinearAlgebra::distributed::FusedOperations, which also computes the
+     * local parts of the inner products. The global sum is computed with a
+     * non-blocking reduction.
+     */
+    template <typename Number>
+    class PipelinedOperations<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+    public:
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+      using number = Number;
+
+      ~PipelinedOperations()
+      {
+        // do not leave a reduction in flight if the solver is left by an
+        // exception
+#  ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          MPI_Wait(&request, MPI_STATUS_IGNORE);
+#  endif
+      }
+
+      void
+      start_reduction(const VectorType &r,
+                      const VectorType &u,
+                      const VectorType &w)
+      {
+        namespace FusedOperations =
+          LinearAlgebra::distributed::FusedOperations;
+
+        const Number *r_values = r.begin();
+        const Number *u_values = u.begin();
+        const Number *w_values = w.begin();
+
+        results = FusedOperations::run_local<3, Number>(
+          r.locally_owned_size(),
+          [&](const unsigned int     begin,
+              const unsigned int     end,
+              std::array<Number, 3> &sums) {
+            Number ru = 0, wu = 0, rr = 0;
+            for (unsigned int i = begin; i < end; ++i)
+              {
+                const Number u_conj =
+                  numbers::NumberTraits<Number>::conjugate(u_values[i]);
+                ru += r_values[i] * u_conj;
+                wu += w_values[i] * u_conj;
+                rr += numbers::NumberTraits<Number>::abs_square(r_values[i]);
+              }
+            sums[0] += ru;
+            sums[1] += wu;
+            sums[2] += rr;
+          });
+
+        post_reduction(r.get_mpi_communicator());
+      }
+
+      const std::array<Number, 3> &
+      finish_reduction()
+      {
+#  ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+#  endif
+        return results;
+      }
+
+      void
+      update_and_start_reduction(const Number      alpha,
+                                 const Number      beta,
+                                 const VectorType &m,
+                                 const VectorType &n,
+                                 VectorType       &x,
+                                 VectorType       &r,
+                                 VectorType       &u,
+                                 VectorType       &w,
+                                 VectorType       &p,
+                                 VectorType       &q,
+                                 VectorType       &s,
+                                 VectorType       &z)
+      {
+        namespace FusedOperations =
+          LinearAlgebra::distributed::FusedOperations;
+
+        const Number *m_values = m.begin();
+        const Number *n_values = n.begin();
+        Number       *x_values = x.begin();
+        Number       *r_values = r.begin();
+        Number       *u_values = u.begin();
+        Number       *w_values = w.begin();
+        Number       *p_values = p.begin();
+        Number       *q_values = q.begin();
+        Number       *s_values = s.begin();
+        Number       *z_values = z.begin();
+
+        results = FusedOperations::run_local<3, Number>(
+          x.locally_owned_size(),
+          [&](const unsigned int     begin,
+              const unsigned int     end,
+              std::array<Number, 3> &sums) {
+            Number ru = 0, wu = 0, rr = 0;
+            for (unsigned int i = begin; i < end; ++i)
+              {
+                const Number z_i = n_values[i] + beta * z_values[i];
+                const Number q_i = m_values[i] + beta * q_values[i];
+                const Number s_i = w_values[i] + beta * s_values[i];
+                const Number p_i = u_values[i] + beta * p_values[i];
+                const Number r_i = r_values[i] - alpha * s_i;
+                const Number u_i = u_values[i] - alpha * q_i;
+                const Number w_i = w_values[i] - alpha * z_i;
+                z_values[i]      = z_i;
+                q_values[i]      = q_i;
+                s_values[i]      = s_i;
+                p_values[i]      = p_i;
+                x_values[i] += alpha * p_i;
+                r_values[i] = r_i;
+                u_values[i] = u_i;
+                w_values[i] = w_i;
+
+                const Number u_conj =
+                  numbers::NumberTraits<Number>::conjugate(u_i);
+                ru += r_i * u_conj;
+                wu += w_i * u_conj;
+                rr += numbers::NumberTraits<Number>::abs_square(r_i);
+              }
+            sums[0] += ru;
+            sums[1] += wu;
+            sums[2] += rr;
+          });
+
+        post_reduction(x.get_mpi_communicator());
+      }
+
+    private:
+      /**
+       * Start the global sum of the local results if there is more than one
+       * process.
+       */
+      void
+      post_reduction(const MPI_Comm communicator)
+      {
+#  ifdef DEAL_II_WITH_MPI
+        Assert(request == MPI_REQUEST_NULL, ExcInternalError());
+        if (Utilities::MPI::job_supports_mpi() &&
+            Utilities::MPI::n_mpi_processes(communicator) > 1)
+          {
+            const int ierr =
+              MPI_Iallreduce(MPI_IN_PLACE,
+                             results.data(),
+                             results.size(),
+                             Utilities::MPI::mpi_type_id_for_type<Number>,
+                             MPI_SUM,
+                             communicator,
+                             &request);
+            AssertThrowMPI(ierr);
+          }
+#  else
+        (void)communicator;
+#  endif
+      }
+
+      std::array<Number, 3> results;
+
+      MPI_Request request = MPI_REQUEST_NULL;
+    };
+  } // namespace SolverPipelinedCGImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl            &cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData &data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl        &cn,
+                                                 const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+template <typename MatrixType, typename PreconditionerType>
+DEAL_II_CXX20_REQUIRES(
+  (concepts::is_linear_operator_on<MatrixType, VectorType> &&
+   concepts::is_linear_operator_on<PreconditionerType, VectorType>))
+void SolverPipelinedCG<VectorType>::solve(
+  const MatrixType         &A,
+  VectorType               &x,
+  const VectorType         &b,
+  const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  LogStream::Prefix prefix("pipelined_cg");
+
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  // the notation follows Algorithm 4 of Ghysels and Vanroose: r is the
+  // residual, u=P^{-1}r the preconditioned residual, w=Au, m=P^{-1}w, and
+  // n=Am. p is the search direction, and s=Ap, q=P^{-1}s, z=Aq are obtained
+  // by the same recurrences as p
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &z = *z_pointer;
+
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  p.reinit(x);
+  q.reinit(x);
+  s.reinit(x);
+  z.reinit(x);
+
+  internal::SolverPipelinedCGImplementation::PipelinedOperations<VectorType>
+    operations;
+
+  A.vmult(r, x);
+  r.sadd(number(-1.), number(1.), b);
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+  operations.start_reduction(r, u, w);
+
+  SolverControl::State solver_state  = SolverControl::iterate;
+  double               residual_norm = 0.;
+  number               alpha = 0., gamma_old = 0.;
+  unsigned int         it = 0;
+  while (true)
+    {
+      // the reduction is in flight while we apply the preconditioner and
+      // the matrix
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+
+      const std::array<number, 3> &results = operations.finish_reduction();
+      const number                 gamma   = results[0];
+      const number                 delta   = results[1];
+      residual_norm = std::sqrt(std::abs(results[2]));
+
+      solver_state = this->iteration_status(it, residual_norm, x);
+      if (solver_state != SolverControl::iterate)
+        break;
+
+      number beta = 0.;
+      if (it == 0)
+        alpha = gamma / delta;
+      else
+        {
+          beta  = gamma / gamma_old;
+          alpha = gamma / (delta - beta * gamma / alpha);
+        }
+      gamma_old = gamma;
+
+      operations.update_and_start_reduction(
+        alpha, beta, m, n, x, r, u, w, p, q, s, z);
+      ++it;
+    }
+
+  AssertThrow(solver_state == SolverControl::success,
+              SolverControl::NoConvergence(it, residual_norm));
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
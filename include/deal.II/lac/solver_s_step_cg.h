@@ -0,0 +1,665 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_solver_s_step_cg_h
+#define dealii_solver_s_step_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+#endif
+
+
+/** @addtogroup Solvers */
+/** @{ */
+
+/**
+ * This class implements the s-step variant of the preconditioned Conjugate
+ * Gradients method for symmetric positive definite matrices and
+ * preconditioners, in the block formulation of Chronopoulos and Gear,
+ * see @cite Chronopoulos1989.
+ *
+ * The classical CG method as implemented in SolverCG needs two global
+ * reductions (inner products) per iteration, and even SolverPipelinedCG
+ * needs one. On large numbers of MPI processes and with a cheap operator,
+ * e.g., a matrix-free operator whose ghost exchange is overlapped with the
+ * cell loop, the latency of these reductions limits the scalability. The
+ * s-step method instead generates a basis $z_0, \ldots, z_{s-1}$ of the
+ * Krylov space of dimension $s$ of the preconditioned operator $P^{-1}A$
+ * starting from the preconditioned residual $z_0 = P^{-1}r$, by $s$
+ * back-to-back applications of the matrix and the preconditioner without
+ * any inner product in between. All inner products between these basis
+ * vectors, the previous search directions and the residual are then
+ * computed in a single block reduction, from which the new block of $s$
+ * search directions, made $A$-conjugate to the previous block, and the
+ * step lengths are obtained as small dense $s\times s$ problems. In exact
+ * arithmetic, $s$ iterations of SolverCG correspond to one iteration of
+ * this method, so the number of global synchronizations is reduced by a
+ * factor of $s$.
+ *
+ * The matrix and the preconditioner are only accessed through their
+ * <code>vmult()</code> functions. The algorithm stores $4s+1$ auxiliary
+ * vectors.
+ *
+ *
+ * <h3>Choice of the basis</h3>
+ *
+ * The monomial basis $z_{j+1} = P^{-1}Az_j$ quickly becomes linearly
+ * dependent in finite precision, because the power iteration makes all
+ * vectors converge to the eigenvector of the largest eigenvalue. Therefore,
+ * the default basis is formed by the Chebyshev polynomials of the first
+ * kind transformed to an interval $[\lambda_{\min}, \lambda_{\max}]$ that
+ * encloses the spectrum of $P^{-1}A$, which keeps the basis well
+ * conditioned for larger $s$. The upper bound is estimated with a few
+ * steps of a power iteration, like in PreconditionChebyshev, unless it is
+ * given in the AdditionalData. If the basis becomes numerically dependent
+ * nevertheless, e.g. close to convergence, the dependent directions are
+ * detected in the Cholesky factorization of the small projected matrix and
+ * dropped for that step.
+ *
+ *
+ * <h3>Vector types</h3>
+ *
+ * Like all other solver classes, this class can work on any kind of vector
+ * and matrix that satisfy the requirements listed in the documentation of
+ * the Solver base class. In general, the inner products of a step are
+ * computed by separate calls to the inner product of the vector class. For
+ * Vector and for LinearAlgebra::distributed::Vector with memory space
+ * MemorySpace::Host, all of them are instead computed in a single sweep
+ * over the locally owned entries, split into blocks that are processed in
+ * parallel on several threads, followed by a single call to
+ * <code>MPI_Allreduce</code>.
+ *
+ * The convergence criterion is based on the norm of the unpreconditioned
+ * residual, as for SolverCG, and is checked once per block of $s$
+ * iterations. Since the residual norm is part of the block reduction, the
+ * solver builds one basis more than necessary before it terminates. The
+ * iteration count reported to the SolverControl object is the number of
+ * search directions, i.e., comparable to the iteration count of SolverCG.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. This mechanism can also be used
+ * to observe the progress of the iteration.
+ */
+template <typename VectorType = Vector<double>>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+class SolverSStepCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * An enum to select the polynomial basis of the Krylov space built in
+     * each step.
+     */
+    enum class BasisType
+    {
+      /**
+       * The monomial basis $z_{j+1} = P^{-1}Az_j$. Only stable for small
+       * values of $s$.
+       */
+      monomial,
+      /**
+       * The basis of Chebyshev polynomials on the interval
+       * $[\lambda_{\min}, \lambda_{\max}]$.
+       */
+      chebyshev
+    };
+
+    /**
+     * Constructor. By default, use blocks of 4 steps and the Chebyshev basis
+     * with an upper bound of the spectrum estimated by 10 steps of a power
+     * iteration.
+     */
+    explicit AdditionalData(
+      const unsigned int s                  = 4,
+      const BasisType    basis_type         = BasisType::chebyshev,
+      const double       max_eigenvalue     = 0.,
+      const double       min_eigenvalue     = 0.,
+      const unsigned int n_power_iterations = 10);
+
+    /**
+     * The number of basis vectors generated in each step, i.e., the number
+     * of steps of SolverCG that are combined into one.
+     */
+    unsigned int s;
+
+    /**
+     * The polynomial basis.
+     */
+    BasisType basis_type;
+
+    /**
+     * Upper bound of the spectrum of $P^{-1}A$ used for the Chebyshev basis.
+     * If zero, it is estimated with a power iteration and multiplied by a
+     * safety factor of 1.2.
+     */
+    double max_eigenvalue;
+
+    /**
+     * Lower bound of the spectrum of $P^{-1}A$ used for the Chebyshev basis.
+     */
+    double min_eigenvalue;
+
+    /**
+     * The number of steps of the power iteration to estimate the largest
+     * eigenvalue if @p max_eigenvalue is zero.
+     */
+    unsigned int n_power_iterations;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverSStepCG(SolverControl            &cn,
+                VectorMemory<VectorType> &mem,
+                const AdditionalData     &data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverSStepCG(SolverControl        &cn,
+                const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  DEAL_II_CXX20_REQUIRES(
+    (concepts::is_linear_operator_on<MatrixType, VectorType> &&
+     concepts::is_linear_operator_on<PreconditionerType, VectorType>))
+  void solve(const MatrixType         &A,
+             VectorType               &x,
+             const VectorType         &b,
+             const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/** @} */
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverSStepCGImplementation
+  {
+    /**
+     * Compute the inner products of the given pairs of vectors, for general
+     * vector types by separate calls to the inner product of the vector
+     * class.
+     */
+    template <typename VectorType>
+    void
+    inner_products(
+      const std::vector<std::pair<const VectorType *, const VectorType *>>
+                          &pairs,
+      std::vector<double> &results)
+    {
+      results.resize(pairs.size());
+      for (unsigned int i = 0; i < pairs.size(); ++i)
+        results[i] = (*pairs[i].first) * (*pairs[i].second);
+    }
+
+
+
+    /**
+     * Compute the local parts of the inner products of the given pairs of
+     * arrays in one sweep through memory: the arrays are processed in
+     * chunks small enough for all vectors to stay in cache while all
+     * products are accumulated.
+     *
+     * The chunks are grouped into blocks that are processed in parallel.
+     * The partial sums of the blocks are added in the order of the blocks
+     * at the end, so the result does not depend on the number of threads.
+     */
+    template <typename Number>
+    void
+    local_inner_products(
+      const std::size_t                                             size,
+      const std::vector<std::pair<const Number *, const Number *>> &pairs,
+      std::vector<double>                                          &results)
+    {
+      constexpr std::size_t chunk_size = 512;
+      constexpr std::size_t block_size = 16 * chunk_size;
+
+      const unsigned int  n_pairs  = pairs.size();
+      const std::size_t   n_blocks = (size + block_size - 1) / block_size;
+      std::vector<double> block_results(n_blocks * n_pairs, 0.);
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n_blocks,
+        [&](const std::size_t begin_block, const std::size_t end_block) {
+          for (std::size_t block = begin_block; block < end_block; ++block)
+            {
+              double *const     block_result = &block_results[block * n_pairs];
+              const std::size_t block_end =
+                std::min(size, (block + 1) * block_size);
+              for (std::size_t begin = block * block_size; begin < block_end;
+                   begin += chunk_size)
+                {
+                  const std::size_t end =
+                    std::min(block_end, begin + chunk_size);
+                  for (unsigned int p = 0; p < n_pairs; ++p)
+                    {
+                      const Number *a   = pairs[p].first;
+                      const Number *b   = pairs[p].second;
+                      double        sum = 0;
+                      DEAL_II_OPENMP_SIMD_PRAGMA
+                      for (std::size_t i = begin; i < end; ++i)
+                        sum += static_cast<double>(a[i]) *
+                               static_cast<double>(b[i]);
+                      block_result[p] += sum;
+                    }
+                }
+            }
+        },
+        1);
+
+      results.assign(n_pairs, 0.);
+      for (std::size_t block = 0; block < n_blocks; ++block)
+        for (unsigned int p = 0; p < n_pairs; ++p)
+          results[p] += block_results[block * n_pairs + p];
+    }
+
+
+
+    /**
+     * Compute the inner products of the given pairs of vectors for Vector
+     * in one sweep.
+     */
+    template <typename Number>
+    void
+    inner_products(
+      const std::vector<std::pair<const ::dealii::Vector<Number> *,
+                                  const ::dealii::Vector<Number> *>> &pairs,
+      std::vector<double>                                            &results)
+    {
+      if (pairs.empty())
+        return;
+
+      std::vector<std::pair<const Number *, const Number *>> pointers;
+      pointers.reserve(pairs.size());
+      for (const auto &pair : pairs)
+        pointers.emplace_back(pair.first->begin(), pair.second->begin());
+
+      local_inner_products(pairs[0].first->size(), pointers, results);
+    }
+
+
+
+    /**
+     * Compute the inner products of the given pairs of vectors for
+     * LinearAlgebra::distributed::Vector on the host in one sweep, followed
+     * by a single global reduction.
+     */
+    template <typename Number>
+    void
+    inner_products(
+      const std::vector<std::pair<
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> *,
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> *>>
+                          &pairs,
+      std::vector<double> &results)
+    {
+      if (pairs.empty())
+        return;
+
+      std::vector<std::pair<const Number *, const Number *>> pointers;
+      pointers.reserve(pairs.size());
+      for (const auto &pair : pairs)
+        pointers.emplace_back(pair.first->begin(), pair.second->begin());
+
+      local_inner_products(pairs[0].first->locally_owned_size(),
+                           pointers,
+                           results);
+      Utilities::MPI::sum(results,
+                          pairs[0].first->get_mpi_communicator(),
+                          results);
+    }
+
+
+
+    /**
+     * Compute the Cholesky factor $L$ of the leading block of the symmetric
+     * matrix @p matrix, stopping at the first column whose pivot indicates a
+     * numerically dependent direction, and return the number of columns of
+     * the factor.
+     */
+    inline unsigned int
+    truncated_cholesky(const FullMatrix<double> &matrix,
+                       FullMatrix<double>       &factor)
+    {
+      const unsigned int n = matrix.m();
+      factor.reinit(n, n);
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          double pivot = matrix(j, j);
+          for (unsigned int k = 0; k < j; ++k)
+            pivot -= factor(j, k) * factor(j, k);
+          if (!(pivot > 1e-12 * std::abs(matrix(j, j))))
+            return j;
+          factor(j, j) = std::sqrt(pivot);
+          for (unsigned int i = j + 1; i < n; ++i)
+            {
+              double sum = matrix(i, j);
+              for (unsigned int k = 0; k < j; ++k)
+                sum -= factor(i, k) * factor(j, k);
+              factor(i, j) = sum / factor(j, j);
+            }
+        }
+      return n;
+    }
+
+
+
+    /**
+     * Solve $LL^T y = f$ for the leading @p n entries of @p rhs in place.
+     */
+    inline void
+    cholesky_solve(const FullMatrix<double> &factor,
+                   const unsigned int        n,
+                   double                   *rhs)
+    {
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          for (unsigned int k = 0; k < i; ++k)
+            rhs[i] -= factor(i, k) * rhs[k];
+          rhs[i] /= factor(i, i);
+        }
+      for (int i = n - 1; i >= 0; --i)
+        {
+          for (unsigned int k = i + 1; k < n; ++k)
+            rhs[i] -= factor(k, i) * rhs[k];
+          rhs[i] /= factor(i, i);
+        }
+    }
+  } // namespace SolverSStepCGImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+inline SolverSStepCG<VectorType>::AdditionalData::AdditionalData(
+  const unsigned int s,
+  const BasisType    basis_type,
+  const double       max_eigenvalue,
+  const double       min_eigenvalue,
+  const unsigned int n_power_iterations)
+  : s(s)
+  , basis_type(basis_type)
+  , max_eigenvalue(max_eigenvalue)
+  , min_eigenvalue(min_eigenvalue)
+  , n_power_iterations(n_power_iterations)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+SolverSStepCG<VectorType>::SolverSStepCG(SolverControl            &cn,
+                                         VectorMemory<VectorType> &mem,
+                                         const AdditionalData     &data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+SolverSStepCG<VectorType>::SolverSStepCG(SolverControl        &cn,
+                                         const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+DEAL_II_CXX20_REQUIRES(concepts::is_vector_space_vector<VectorType>)
+template <typename MatrixType, typename PreconditionerType>
+DEAL_II_CXX20_REQUIRES(
+  (concepts::is_linear_operator_on<MatrixType, VectorType> &&
+   concepts::is_linear_operator_on<PreconditionerType, VectorType>))
+void SolverSStepCG<VectorType>::solve(const MatrixType         &A,
+                                      VectorType               &x,
+                                      const VectorType         &b,
+                                      const PreconditionerType &preconditioner)
+{
+  using number    = typename VectorType::value_type;
+  using BasisType = typename AdditionalData::BasisType;
+
+  const unsigned int s = additional_data.s;
+  Assert(s > 0, ExcMessage("The number of steps s must be positive."));
+
+  LogStream::Prefix prefix("s-step_cg");
+
+  // the notation follows Chronopoulos and Gear: R holds the basis of the
+  // Krylov space, S = A R, P the block of search directions, and Q = A P
+  std::vector<typename VectorMemory<VectorType>::Pointer> vector_pointers;
+  for (unsigned int i = 0; i < 4 * s + 1; ++i)
+    vector_pointers.emplace_back(this->memory);
+  std::vector<VectorType *> R(s), S(s), P(s), Q(s);
+  for (unsigned int i = 0; i < s; ++i)
+    {
+      R[i] = vector_pointers[i].get();
+      S[i] = vector_pointers[s + i].get();
+      P[i] = vector_pointers[2 * s + i].get();
+      Q[i] = vector_pointers[3 * s + i].get();
+      R[i]->reinit(x, true);
+      S[i]->reinit(x, true);
+      P[i]->reinit(x, true);
+      Q[i]->reinit(x, true);
+    }
+  VectorType &r = *vector_pointers[4 * s];
+  r.reinit(x, true);
+
+  // interval of the Chebyshev basis, estimating the largest eigenvalue of
+  // P^{-1}A if not given
+  double center = 0., half_width = 1.;
+  if (additional_data.basis_type == BasisType::chebyshev && s > 1)
+    {
+      double max_eigenvalue = additional_data.max_eigenvalue;
+      if (max_eigenvalue == 0.)
+        {
+          internal::set_initial_guess(*R[0]);
+          max_eigenvalue =
+            1.2 * internal::power_iteration(A,
+                                            *R[0],
+                                            preconditioner,
+                                            additional_data.n_power_iterations);
+        }
+      Assert(max_eigenvalue > additional_data.min_eigenvalue,
+             ExcMessage("The interval of the Chebyshev basis is empty."));
+      center     = 0.5 * (max_eigenvalue + additional_data.min_eigenvalue);
+      half_width = 0.5 * (max_eigenvalue - additional_data.min_eigenvalue);
+    }
+
+  A.vmult(r, x);
+  r.sadd(number(-1.), number(1.), b);
+
+  std::vector<std::pair<const VectorType *, const VectorType *>> pairs;
+  std::vector<double>                                            products;
+
+  FullMatrix<double>  G(s, s), C, B, W(s, s), factor, old_factor;
+  std::vector<double> residual_products(s), alpha(s);
+
+  SolverControl::State solver_state  = SolverControl::iterate;
+  double               residual_norm = 0.;
+  unsigned int         it            = 0;
+  unsigned int         n_old         = 0;
+  while (true)
+    {
+      // generate the basis of the Krylov space with s applications of the
+      // preconditioner and the matrix, without any inner product
+      preconditioner.vmult(*R[0], r);
+      for (unsigned int j = 0; j < s; ++j)
+        {
+          A.vmult(*S[j], *R[j]);
+          if (j + 1 == s)
+            break;
+          preconditioner.vmult(*R[j + 1], *S[j]);
+          if (additional_data.basis_type == BasisType::chebyshev)
+            {
+              R[j + 1]->add(number(-center), *R[j]);
+              if (j == 0)
+                *R[j + 1] *= number(1. / half_width);
+              else
+                R[j + 1]->sadd(number(2. / half_width), number(-1.), *R[j - 1]);
+            }
+        }
+
+      // all inner products of this step in one block reduction: R^T S, the
+      // products Q_old^T R for the conjugation against the previous block,
+      // R^T r, P_old^T r, and the residual norm
+      pairs.clear();
+      for (unsigned int i = 0; i < s; ++i)
+        for (unsigned int j = i; j < s; ++j)
+          pairs.emplace_back(R[i], S[j]);
+      for (unsigned int i = 0; i < n_old; ++i)
+        for (unsigned int j = 0; j < s; ++j)
+          pairs.emplace_back(Q[i], R[j]);
+      for (unsigned int j = 0; j < s; ++j)
+        pairs.emplace_back(R[j], &r);
+      for (unsigned int i = 0; i < n_old; ++i)
+        pairs.emplace_back(P[i], &r);
+      pairs.emplace_back(&r, &r);
+      internal::SolverSStepCGImplementation::inner_products(pairs, products);
+
+      residual_norm = std::sqrt(std::abs(products.back()));
+      solver_state  = this->iteration_status(it, residual_norm, x);
+      if (solver_state != SolverControl::iterate)
+        break;
+
+      unsigned int index = 0;
+      for (unsigned int i = 0; i < s; ++i)
+        for (unsigned int j = i; j < s; ++j, ++index)
+          G(i, j) = G(j, i) = products[index];
+
+      // the new directions P = R - P_old B are A-conjugate to the previous
+      // block for B = W_old^{-1} Q_old^T R, and their projected matrix is
+      // W = P^T A P = R^T A R - (Q_old^T R)^T B
+      W = G;
+      C.reinit(n_old, s);
+      B.reinit(n_old, s);
+      for (unsigned int i = 0; i < n_old; ++i)
+        for (unsigned int j = 0; j < s; ++j, ++index)
+          C(i, j) = B(i, j) = products[index];
+      std::vector<double> column(n_old);
+      for (unsigned int j = 0; j < s; ++j)
+        {
+          for (unsigned int i = 0; i < n_old; ++i)
+            column[i] = B(i, j);
+          internal::SolverSStepCGImplementation::cholesky_solve(old_factor,
+                                                                n_old,
+                                                                column.data());
+          for (unsigned int i = 0; i < n_old; ++i)
+            B(i, j) = column[i];
+        }
+      for (unsigned int i = 0; i < s; ++i)
+        for (unsigned int j = 0; j < s; ++j)
+          for (unsigned int k = 0; k < n_old; ++k)
+            W(i, j) -= C(k, i) * B(k, j);
+
+      // right hand side of the step lengths P^T r = R^T r - B^T P_old^T r
+      for (unsigned int j = 0; j < s; ++j)
+        residual_products[j] = products[index + j];
+      for (unsigned int j = 0; j < s; ++j)
+        for (unsigned int i = 0; i < n_old; ++i)
+          residual_products[j] -= B(i, j) * products[index + s + i];
+
+      // drop directions that are numerically dependent on the previous ones
+      const unsigned int n_new =
+        internal::SolverSStepCGImplementation::truncated_cholesky(W, factor);
+      AssertThrow(n_new > 0, SolverControl::NoConvergence(it, residual_norm));
+
+      for (unsigned int j = 0; j < n_new; ++j)
+        alpha[j] = residual_products[j];
+      internal::SolverSStepCGImplementation::cholesky_solve(factor,
+                                                            n_new,
+                                                            alpha.data());
+
+      // compute the new search directions in place of the basis vectors and
+      // update the solution and the residual
+      for (unsigned int j = 0; j < n_new; ++j)
+        {
+          for (unsigned int i = 0; i < n_old; ++i)
+            {
+              R[j]->add(number(-B(i, j)), *P[i]);
+              S[j]->add(number(-B(i, j)), *Q[i]);
+            }
+          x.add(number(alpha[j]), *R[j]);
+          r.add(number(-alpha[j]), *S[j]);
+        }
+      std::swap(R, P);
+      std::swap(S, Q);
+      std::swap(factor, old_factor);
+      n_old = n_new;
+      it += n_new;
+    }
+
+  AssertThrow(solver_state == SolverControl::success,
+              SolverControl::NoConvergence(it, residual_norm));
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -17,9 +17,12 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -93,6 +96,38 @@ DEAL_II_NAMESPACE_OPEN
  * <code>*use_this_sparsity</code> is used to store the decomposed matrix. For
  * restrictions on the sparsity see section `Fill-in' above).
  *
+ * 5/ By setting <code>use_level_scheduling=true</code>, the initialize()
+ * function groups the rows of the decomposition into levels such that the
+ * rows within one level do not depend on each other in the forward and
+ * backward substitutions, respectively. The substitutions in the vmult()
+ * functions of derived classes then work on the rows of one level in
+ * parallel, see the section on multithreading below.
+ *
+ *
+ * <h3>Multithreading</h3>
+ *
+ * The forward and backward substitutions applying the decomposition are
+ * inherently sequential: the result in one row in general depends on the
+ * results in all previous rows. However, the rows that actually couple to
+ * a given row are only those with a nonzero entry in the lower (or upper)
+ * triangular part of that row. Consequently, the rows can be sorted into
+ * <i>levels</i>, where the rows of level zero do not couple to any other
+ * row, and the rows of level $l$ only couple to rows on levels $l-1$ and
+ * below. All rows of one level can then be computed concurrently, one level
+ * after the other, using parallel::apply_to_subranges(). Since every row is
+ * still computed by the same sequence of operations, the results are
+ * identical to the ones of the sequential substitution.
+ *
+ * The number of levels, and consequently the available parallelism, depends
+ * on the numbering of the unknowns. For example, a Cuthill-McKee numbering
+ * leads to long chains of dependent rows and many levels with few rows each,
+ * whereas numberings that interleave independent parts of the domain, such
+ * as the ones produced by DoFRenumbering::random() or by coloring
+ * algorithms, lead to few but large levels (often at the price of a weaker
+ * preconditioner). Levels with fewer than
+ * internal::SparseMatrixImplementation::minimum_parallel_grain_size rows are
+ * processed sequentially.
+ *
  *
  * <h3>Particular implementations</h3>
  *
@@ -146,7 +181,8 @@ public:
     explicit AdditionalData(const double       strengthen_diagonal   = 0.,
                             const unsigned int extra_off_diagonals   = 0,
                             const bool         use_previous_sparsity = false,
-                            const SparsityPattern *use_this_sparsity = nullptr);
+                            const SparsityPattern *use_this_sparsity = nullptr,
+                            const bool use_level_scheduling          = false);
 
     /**
      * <code>strengthen_diag</code> times the sum of absolute row entries is
@@ -189,6 +225,18 @@ public:
      * matrix.
      */
     const SparsityPattern *use_this_sparsity;
+
+    /**
+     * If this flag is true, the initialize() function computes a level
+     * schedule of the rows of the decomposition that allows to run the
+     * forward and backward substitutions in the vmult() functions of derived
+     * classes in parallel. See the section on multithreading in the
+     * documentation of the SparseLUDecomposition class.
+     *
+     * Per default, this flag is false, i.e., the substitutions are run
+     * sequentially.
+     */
+    bool use_level_scheduling;
   };
 
   /**
@@ -284,6 +332,17 @@ protected:
   void
   copy_from(const SparseMatrix<somenumber> &matrix);
 
+  /**
+   * Take over ownership of the given @p sparsity pattern and reinitialize the
+   * underlying matrix with it. This function can be used by derived classes
+   * that compute the sparsity pattern of the decomposition themselves,
+   * instead of letting initialize() choose it. As in initialize(), all
+   * values of the matrix are zero afterwards and prebuild_lower_bound()
+   * needs to be called again.
+   */
+  void
+  initialize_with_own_sparsity(std::unique_ptr<SparsityPattern> sparsity);
+
   /**
    * Performs the strengthening loop. For each row calculates the sum of
    * absolute values of its elements, determines the strengthening factor
@@ -311,11 +370,11 @@ protected:
   double strengthen_diagonal;
 
   /**
-   * For every row in the underlying SparsityPattern, this array contains a
-   * pointer to the row's first afterdiagonal entry. Becomes available after
+   * For every row in the underlying SparsityPattern, this array contains the
+   * position of the row's first afterdiagonal entry. Becomes available after
    * invocation of prebuild_lower_bound().
    */
-  std::vector<const size_type *> prebuilt_lower_bound;
+  std::vector<std::size_t> prebuilt_lower_bound;
 
   /**
    * Fills the #prebuilt_lower_bound array.
@@ -323,7 +382,74 @@ protected:
   void
   prebuild_lower_bound();
 
+  /**
+   * Sort the rows into the levels of the forward and backward substitutions,
+   * see the section on multithreading in the class documentation. This
+   * function needs to be called after prebuild_lower_bound(), and its result
+   * is used by forward_substitution_loop() and backward_substitution_loop().
+   */
+  void
+  compute_level_sets();
+
+  /**
+   * Call <code>row_function(row)</code> for all rows of the matrix in an
+   * order that is compatible with a forward substitution, i.e., a row is
+   * only worked on once all rows it couples to in the strictly lower
+   * triangular part of the decomposition have been worked on. If
+   * compute_level_sets() has been called, the rows of one level are worked
+   * on in parallel, otherwise this function simply runs through the rows in
+   * ascending order.
+   *
+   * @p row_function may only write to data belonging to its @p row.
+   */
+  template <typename RowFunction>
+  void
+  forward_substitution_loop(const RowFunction &row_function) const;
+
+  /**
+   * Like forward_substitution_loop(), but for a backward substitution with
+   * the strictly upper triangular part of the decomposition. Without level
+   * sets, the rows are worked on in descending order.
+   */
+  template <typename RowFunction>
+  void
+  backward_substitution_loop(const RowFunction &row_function) const;
+
 private:
+  /**
+   * Call @p row_function for the rows of all levels described by
+   * @p level_start and @p level_rows, one level after the other.
+   */
+  template <typename RowFunction>
+  static void
+  loop_over_levels(const std::vector<size_type> &level_start,
+                   const std::vector<size_type> &level_rows,
+                   const RowFunction            &row_function);
+
+  /**
+   * The rows sorted by their level in the forward substitution, as computed
+   * by compute_level_sets(). The rows of level @p l are stored at positions
+   * <code>forward_level_start[l]</code> through
+   * <code>forward_level_start[l+1]-1</code> of #forward_level_rows. Both
+   * arrays are empty if no level sets have been computed.
+   */
+  std::vector<size_type> forward_level_start;
+
+  /**
+   * The rows sorted by their level in the forward substitution.
+   */
+  std::vector<size_type> forward_level_rows;
+
+  /**
+   * Like #forward_level_start, but for the backward substitution.
+   */
+  std::vector<size_type> backward_level_start;
+
+  /**
+   * The rows sorted by their level in the backward substitution.
+   */
+  std::vector<size_type> backward_level_rows;
+
   /**
    * In general this pointer is zero except for the case that no
    * SparsityPattern is given to this class. Then, a SparsityPattern is
@@ -407,6 +533,57 @@ SparseLUDecomposition<number>::Tvmult_add(OutVector      &dst,
   dst += tmp;
 }
 
+
+template <typename number>
+template <typename RowFunction>
+inline void
+SparseLUDecomposition<number>::loop_over_levels(
+  const std::vector<size_type> &level_start,
+  const std::vector<size_type> &level_rows,
+  const RowFunction            &row_function)
+{
+  for (size_type level = 0; level + 1 < level_start.size(); ++level)
+    parallel::apply_to_subranges(
+      level_start[level],
+      level_start[level + 1],
+      [&level_rows, &row_function](const size_type begin,
+                                   const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          row_function(level_rows[i]);
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename RowFunction>
+inline void
+SparseLUDecomposition<number>::forward_substitution_loop(
+  const RowFunction &row_function) const
+{
+  if (forward_level_start.empty())
+    for (size_type row = 0; row < this->m(); ++row)
+      row_function(row);
+  else
+    loop_over_levels(forward_level_start, forward_level_rows, row_function);
+}
+
+
+
+template <typename number>
+template <typename RowFunction>
+inline void
+SparseLUDecomposition<number>::backward_substitution_loop(
+  const RowFunction &row_function) const
+{
+  if (backward_level_start.empty())
+    for (size_type row = this->m(); row > 0;)
+      row_function(--row);
+  else
+    loop_over_levels(backward_level_start, backward_level_rows, row_function);
+}
+
 //---------------------------------------------------------------------------
 
 
@@ -415,11 +592,13 @@ SparseLUDecomposition<number>::AdditionalData::AdditionalData(
   const double           strengthen_diag,
   const unsigned int     extra_off_diag,
   const bool             use_prev_sparsity,
-  const SparsityPattern *use_this_spars)
+  const SparsityPattern *use_this_spars,
+  const bool             use_level_sched)
   : strengthen_diagonal(strengthen_diag)
   , extra_off_diagonals(extra_off_diag)
   , use_previous_sparsity(use_prev_sparsity)
   , use_this_sparsity(use_this_spars)
+  , use_level_scheduling(use_level_sched)
 {}
 
 
@@ -53,9 +53,14 @@ template <typename number>
 void
 SparseLUDecomposition<number>::clear()
 {
-  std::vector<const size_type *> tmp;
+  std::vector<std::size_t> tmp;
   tmp.swap(prebuilt_lower_bound);
 
+  forward_level_start.clear();
+  forward_level_rows.clear();
+  backward_level_start.clear();
+  backward_level_rows.clear();
+
   SparseMatrix<number>::clear();
 
   if (own_sparsity != nullptr)
@@ -120,6 +125,9 @@ SparseLUDecomposition<number>::initialize(
                                            2 * data.extra_off_diagonals,
                                          data.extra_off_diagonals);
       own_sparsity->compress();
+      // keep using narrow column indices if the matrix does
+      if (matrix_sparsity.has_narrow_column_indices())
+        own_sparsity->store_narrow_column_indices();
       sparsity_pattern_to_use = own_sparsity;
     }
 
@@ -129,33 +137,146 @@ SparseLUDecomposition<number>::initialize(
            "It is not possible to compute this matrix decomposition for "
            "matrices that are not square."));
   {
-    std::vector<const size_type *> tmp;
+    std::vector<std::size_t> tmp;
     tmp.swap(prebuilt_lower_bound);
   }
+  forward_level_start.clear();
+  forward_level_rows.clear();
+  backward_level_start.clear();
+  backward_level_rows.clear();
   SparseMatrix<number>::reinit(*sparsity_pattern_to_use);
 }
 
 
 
+template <typename number>
+void
+SparseLUDecomposition<number>::initialize_with_own_sparsity(
+  std::unique_ptr<SparsityPattern> sparsity)
+{
+  Assert(sparsity->n_rows() == sparsity->n_cols(),
+         ExcMessage(
+           "It is not possible to compute this matrix decomposition for "
+           "matrices that are not square."));
+
+  // release the previous sparsity before deleting it
+  SparseMatrix<number>::clear();
+  if (own_sparsity != nullptr)
+    delete own_sparsity;
+  own_sparsity = sparsity.release();
+
+  {
+    std::vector<std::size_t> tmp;
+    tmp.swap(prebuilt_lower_bound);
+  }
+  forward_level_start.clear();
+  forward_level_rows.clear();
+  backward_level_start.clear();
+  backward_level_rows.clear();
+  SparseMatrix<number>::reinit(*own_sparsity);
+}
+
+
+
 template <typename number>
 void
 SparseLUDecomposition<number>::prebuild_lower_bound()
 {
-  const size_type *const column_numbers =
-    this->get_sparsity_pattern().colnums.get();
-  const std::size_t *const rowstart_indices =
-    this->get_sparsity_pattern().rowstart.get();
-  const size_type N = this->m();
+  const SparsityPattern   &sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+  const size_type          N                = this->m();
 
   prebuilt_lower_bound.resize(N);
 
+  // the entries after the diagonal are sorted, so we can bisect
+  for (size_type row = 0; row < N; ++row)
+    {
+      std::size_t first = rowstart_indices[row] + 1;
+      std::size_t last  = rowstart_indices[row + 1];
+      while (first < last)
+        {
+          const std::size_t middle = first + (last - first) / 2;
+          if (sparsity.column_index(row, middle) < row)
+            first = middle + 1;
+          else
+            last = middle;
+        }
+      prebuilt_lower_bound[row] = first;
+    }
+}
+
+
+
+template <typename number>
+void
+SparseLUDecomposition<number>::compute_level_sets()
+{
+  Assert(prebuilt_lower_bound.size() == this->m(), ExcNotInitialized());
+
+  const SparsityPattern   &sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+  const size_type          N                = this->m();
+
+  // sort the rows by their level, keeping the rows of one level in
+  // ascending order
+  const auto sort_by_level = [N](const std::vector<size_type> &level,
+                                 const size_type               n_levels,
+                                 std::vector<size_type>       &level_start,
+                                 std::vector<size_type>       &level_rows) {
+    level_start.assign(n_levels + 1, 0);
+    for (size_type row = 0; row < N; ++row)
+      ++level_start[level[row] + 1];
+    for (size_type l = 0; l < n_levels; ++l)
+      level_start[l + 1] += level_start[l];
+
+    std::vector<size_type> next_position(level_start.begin(),
+                                         level_start.end() - 1);
+    level_rows.resize(N);
+    for (size_type row = 0; row < N; ++row)
+      level_rows[next_position[level[row]]++] = row;
+  };
+
+  std::vector<size_type> level(N);
+
+  // the level of a row in the forward substitution is one more than the
+  // largest level of the rows it couples to left of the diagonal. the
+  // diagonal is stored first, the entries left of the diagonal follow
+  size_type n_levels = 0;
   for (size_type row = 0; row < N; ++row)
     {
-      prebuilt_lower_bound[row] =
-        Utilities::lower_bound(&column_numbers[rowstart_indices[row] + 1],
-                               &column_numbers[rowstart_indices[row + 1]],
-                               row);
+      size_type row_level = 0;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        sparsity,
+        row,
+        rowstart_indices[row] + 1,
+        prebuilt_lower_bound[row],
+        [&](const std::size_t, const size_type column) {
+          row_level = std::max(row_level, level[column] + 1);
+        });
+      level[row] = row_level;
+      n_levels   = std::max(n_levels, row_level + 1);
+    }
+  sort_by_level(level, n_levels, forward_level_start, forward_level_rows);
+
+  // same for the backward substitution, with the entries right of the
+  // diagonal
+  n_levels = 0;
+  for (size_type row = N; row > 0;)
+    {
+      --row;
+      size_type row_level = 0;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        sparsity,
+        row,
+        prebuilt_lower_bound[row],
+        rowstart_indices[row + 1],
+        [&](const std::size_t, const size_type column) {
+          row_level = std::max(row_level, level[column] + 1);
+        });
+      level[row] = row_level;
+      n_levels   = std::max(n_levels, row_level + 1);
     }
+  sort_by_level(level, n_levels, backward_level_start, backward_level_rows);
 }
 
 template <typename number>
@@ -238,7 +359,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(forward_level_start) +
+          MemoryConsumption::memory_consumption(forward_level_rows) +
+          MemoryConsumption::memory_consumption(backward_level_start) +
+          MemoryConsumption::memory_consumption(backward_level_rows));
 }
 
 
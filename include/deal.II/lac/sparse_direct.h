@@ -122,11 +122,37 @@ public:
   using size_type = types::global_dof_index;
 
   /**
-   * Dummy class needed for the usual initialization interface of
-   * preconditioners.
+   * Standardized data struct to pipe additional parameters to the solver.
    */
   class AdditionalData
-  {};
+  {
+  public:
+    /**
+     * Constructor.
+     */
+    AdditionalData(const bool reuse_symbolic_factorization = false);
+
+    /**
+     * Keep the symbolic factorization computed by factorize() instead of
+     * freeing it after the numerical factorization. If factorize() is called
+     * again for a matrix with the same sparsity pattern, e.g., in each step
+     * of a Newton iteration or of a time stepping scheme, the symbolic
+     * factorization, i.e., the fill-reducing ordering and the analysis of the
+     * structure of the factors, is then reused and only the numerical
+     * factorization is computed. Whether the sparsity pattern has changed is
+     * determined by comparing the arrays of column indices of the two
+     * matrices, so matrices with a different sparsity pattern can still be
+     * passed to factorize(), which then computes a new symbolic
+     * factorization.
+     *
+     * Note that the reused symbolic factorization also fixes the ordering
+     * computed for the first matrix. If the entries of the matrix change so
+     * much that the pivoting strategy of UMFPACK would select a very
+     * different ordering, the factorization may become less accurate or need
+     * more memory than a fresh one.
+     */
+    bool reuse_symbolic_factorization;
+  };
 
 
   /**
@@ -161,7 +187,8 @@ public:
    * time if you want to invert several matrices with the same sparsity
    * pattern. However, note that the bulk of the computing time is actually
    * spent in the factorization, so this functionality may not always be of
-   * large benefit.
+   * large benefit, unless the symbolic factorization is reused, see
+   * AdditionalData::reuse_symbolic_factorization.
    *
    * In contrast to the other direct solver classes, the initialization method
    * does nothing. Therefore initialize is not automatically called by this
@@ -176,7 +203,7 @@ public:
   factorize(const Matrix &matrix);
 
   /**
-   * Initialize memory and call SparseDirectUMFPACK::factorize.
+   * Store the given additional data and call SparseDirectUMFPACK::factorize.
    */
   template <class Matrix>
   void
@@ -406,6 +433,11 @@ private:
   void *symbolic_decomposition;
   void *numeric_decomposition;
 
+  /**
+   * The parameters given to initialize().
+   */
+  AdditionalData additional_data;
+
   /**
    * Free all memory that hasn't been freed yet.
    */
@@ -0,0 +1,433 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparse_direct_cholesky_h
+#define dealii_sparse_direct_cholesky_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/enable_observer_pointer.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A sparse direct solver for symmetric positive definite matrices, based on
+ * a supernodal Cholesky factorization $PAP^T = LL^T$. In contrast to
+ * SparseDirectUMFPACK, which computes an LU factorization, this class
+ * exploits the symmetry of the matrix, which halves the memory needed for
+ * the factor and the work for the factorization, and it does not need any
+ * external library.
+ *
+ * The factorization proceeds in two steps:
+ * <ol>
+ * <li> The symbolic analysis only depends on the sparsity pattern of the
+ * matrix. It computes a fill-reducing permutation $P$ of the unknowns by
+ * nested dissection, i.e., by recursively splitting the graph of the matrix
+ * into two parts by a small separator that is numbered last, then the
+ * elimination tree, the nonzero pattern of the factor, and the
+ * <i>supernodes</i>, i.e., groups of consecutive columns of $L$ with the
+ * same nonzero pattern below the diagonal.
+ * <li> The numerical factorization is done by the multifrontal method: each
+ * supernode is assembled into a dense frontal matrix from the entries of the
+ * matrix and the update matrices of its children in the elimination tree,
+ * and then factorized with dense Cholesky and triangular solve kernels,
+ * using LAPACK if deal.II was configured with it. Since the subtrees of the
+ * elimination tree are independent of each other, they are factorized as
+ * separate tasks on several threads.
+ * </ol>
+ *
+ * The class implements the same interface as SparseDirectUMFPACK, i.e.,
+ * initialize(), factorize(), vmult(), and solve(), and can therefore be used
+ * as a drop-in replacement for symmetric positive definite matrices, e.g.,
+ * as coarse grid solver in multigrid.
+ *
+ * Only the entries of the lower triangle of the permuted matrix are read,
+ * so the matrix must be symmetric, both in its sparsity pattern and in its
+ * entries. If a pivot of the factorization is not positive, the matrix is
+ * not positive definite and an exception of type ExcNotPositiveDefinite is
+ * thrown.
+ *
+ * <h4>Instantiations</h4>
+ *
+ * There are instantiations of this class for SparseMatrix<double>,
+ * SparseMatrix<float>, and BlockSparseMatrix<double>.
+ *
+ * @ingroup Solvers Preconditioners
+ */
+class SparseDirectCholesky : public EnableObserverPointer
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional parameters to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * The fill-reducing orderings that can be selected.
+     */
+    enum class Ordering
+    {
+      /**
+       * Nested dissection based on level structures of the matrix graph.
+       */
+      nested_dissection,
+      /**
+       * Keep the numbering of the unknowns of the matrix, e.g., if they have
+       * already been renumbered to reduce the fill-in. Only a postordering
+       * of the elimination tree is applied, which does not change the
+       * fill-in.
+       */
+      identity
+    };
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(const Ordering ordering = Ordering::nested_dissection);
+
+    /**
+     * The ordering used in the symbolic analysis.
+     */
+    Ordering ordering;
+  };
+
+  /**
+   * Constructor.
+   */
+  SparseDirectCholesky();
+
+  /**
+   * Destructor.
+   */
+  ~SparseDirectCholesky() override;
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * @name Setting up a sparse factorization
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Perform the symbolic analysis for the sparsity pattern of the given
+   * matrix, with the ordering selected by @p additional_data. The entries of
+   * the matrix are not used.
+   */
+  template <class Matrix>
+  void
+  analyze(const Matrix         &matrix,
+          const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Factorize the matrix. If analyze() has been called before for a matrix
+   * with the same sparsity pattern, the symbolic analysis is reused, so this
+   * function may be called several times for different matrices with the
+   * same sparsity pattern at the cost of the numerical factorization only.
+   * Otherwise, analyze() is called first. Whether the sparsity pattern is
+   * the same is decided by comparing a hash of the column indices of all
+   * rows with the one computed by analyze().
+   *
+   * This function copies the contents of the matrix into its own storage;
+   * the matrix can therefore be deleted after this operation, even if
+   * subsequent solves are required.
+   */
+  template <class Matrix>
+  void
+  factorize(const Matrix &matrix);
+
+  /**
+   * Call analyze() and factorize().
+   */
+  template <class Matrix>
+  void
+  initialize(const Matrix         &matrix,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Functions that represent the inverse of a matrix
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Multiply with the inverse of the factorized matrix, i.e., solve
+   * $A\,\text{dst} = \text{src}$.
+   */
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Same as before, but for block vectors.
+   */
+  void
+  vmult(BlockVector<double> &dst, const BlockVector<double> &src) const;
+
+  /**
+   * Multiply with the transpose of the inverse. Since the matrix is
+   * symmetric, this is the same as vmult().
+   */
+  void
+  Tvmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Same as before, but for block vectors.
+   */
+  void
+  Tvmult(BlockVector<double> &dst, const BlockVector<double> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Functions that solve linear systems
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Solve for a certain right hand side vector, which is overwritten by the
+   * solution. This function may be called multiple times for different right
+   * hand side vectors after the matrix has been factorized.
+   *
+   * @pre You need to call factorize() before this function can be called.
+   */
+  void
+  solve(Vector<double> &rhs_and_solution) const;
+
+  /**
+   * Same as before, but for block vectors.
+   */
+  void
+  solve(BlockVector<double> &rhs_and_solution) const;
+
+  /**
+   * Call the two functions factorize() and solve() in that order.
+   */
+  template <class Matrix>
+  void
+  solve(const Matrix &matrix, Vector<double> &rhs_and_solution);
+
+  /**
+   * @}
+   */
+
+  /**
+   * Return the number of supernodes of the factor.
+   */
+  unsigned int
+  n_supernodes() const;
+
+  /**
+   * Return the number of entries stored for the lower triangular factor $L$,
+   * including the diagonal.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception thrown if a pivot of the factorization is not positive.
+   */
+  DeclException1(ExcNotPositiveDefinite,
+                 size_type,
+                 << "The matrix is not positive definite: the factorization "
+                 << "encountered a pivot that is not positive when "
+                 << "eliminating row " << arg1 << '.');
+
+private:
+  /**
+   * The symbolic analysis for the sparsity pattern of the matrix given in
+   * compressed row storage, with the entries of each row in the order of the
+   * row iterators of the matrix.
+   */
+  void
+  analyze_pattern(const std::vector<std::size_t> &row_start,
+                  const std::vector<size_type>   &columns);
+
+  /**
+   * Compute the nested dissection ordering of the graph given in compressed
+   * row storage, without the diagonal, and store it in #permutation.
+   */
+  void
+  compute_nested_dissection(const std::vector<std::size_t> &graph_start,
+                            const std::vector<size_type>   &graph);
+
+  /**
+   * Factorize the supernodes of the subtree with the given root, with the
+   * large subtrees of descendants as separate tasks. Return the row in which
+   * a pivot that is not positive has been encountered, or
+   * numbers::invalid_dof_index if the factorization succeeded.
+   */
+  size_type
+  factorize_subtree(const unsigned int                supernode,
+                    std::vector<std::vector<double>> &update_matrices);
+
+  /**
+   * Factorize the subtrees with the given roots, the large ones as separate
+   * tasks, with the same return value as factorize_subtree().
+   */
+  size_type
+  factorize_subtrees(const std::vector<unsigned int>  &roots,
+                     std::vector<std::vector<double>> &update_matrices);
+
+  /**
+   * Add the update matrices of the children to the given supernode,
+   * factorize its columns, and compute its own update matrix, with the same
+   * return value as factorize_subtree().
+   */
+  size_type
+  factorize_supernode(const unsigned int                supernode,
+                      std::vector<std::vector<double>> &update_matrices);
+
+  /**
+   * The size of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * A hash of the sparsity pattern of the matrix given to analyze(), used by
+   * factorize() to decide whether the symbolic analysis can be reused.
+   */
+  std::size_t sparsity_pattern_hash;
+
+  /**
+   * The parameters given to analyze().
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The fill-reducing permutation, i.e., the original index of each row of
+   * the permuted matrix.
+   */
+  std::vector<size_type> permutation;
+
+  /**
+   * For each entry of the matrix in the order of its row iterators, the
+   * position of the entry in #factor, or numbers::invalid_size_type for the
+   * entries that lie in the strict upper triangle of the permuted matrix.
+   */
+  std::vector<std::size_t> matrix_entry_positions;
+
+  /**
+   * The first column of each supernode, plus the end of the last one. The
+   * columns are numbered in a postorder of the elimination tree, so the
+   * supernodes of each subtree are numbered consecutively and before the
+   * root of the subtree.
+   */
+  std::vector<size_type> supernode_start;
+
+  /**
+   * The rows of each supernode in compressed storage, in ascending order.
+   * The first rows are the columns of the supernode itself.
+   */
+  std::vector<std::size_t> supernode_row_start;
+  std::vector<size_type>   supernode_rows;
+
+  /**
+   * The children of each supernode in the supernodal elimination tree in
+   * compressed storage, the first supernode of the subtree of each
+   * supernode, and the roots of the tree.
+   */
+  std::vector<std::size_t>  supernode_child_start;
+  std::vector<unsigned int> supernode_children;
+  std::vector<unsigned int> supernode_first_descendant;
+  std::vector<unsigned int> supernode_roots;
+
+  /**
+   * An estimate of the number of floating point operations to factorize the
+   * subtree of each supernode, used to decide which subtrees are worth a
+   * separate task.
+   */
+  std::vector<double> subtree_work;
+
+  /**
+   * The columns of the factor belonging to each supernode, stored as a
+   * dense column-major matrix whose number of rows is the number of rows of
+   * the supernode, one supernode after the other.
+   */
+  std::vector<std::size_t> factor_start;
+  std::vector<double>      factor;
+
+  /**
+   * Whether factorize() has been called for the current analysis.
+   */
+  bool is_factorized;
+};
+
+
+
+/* -------------------------- inline functions ------------------------- */
+
+inline SparseDirectCholesky::size_type
+SparseDirectCholesky::m() const
+{
+  return n_rows;
+}
+
+
+
+inline SparseDirectCholesky::size_type
+SparseDirectCholesky::n() const
+{
+  return n_rows;
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -42,6 +42,35 @@ DEAL_II_NAMESPACE_OPEN
  * second edition, in section 10.3.2.
  *
  *
+ * <h3>Fill-in determined by the decomposition</h3>
+ *
+ * By default, the sparsity pattern of the decomposition is the one of the
+ * matrix, possibly with extra off-diagonals, or one given by the user, see
+ * the documentation of SparseLUDecomposition. Through the
+ * AdditionalData::fill_in parameter, the class can instead determine the
+ * fill-in itself, using one of two strategies that are also described in
+ * section 10.3 of the book by Saad:
+ * - ILU(k), selected by AdditionalData::FillIn::level: Every entry of the
+ *   matrix has level zero, and an entry created in the elimination of row
+ *   $i$ by row $k$ at position $(i,j)$ has the level $\mathrm{lev}(i,k) +
+ *   \mathrm{lev}(k,j) + 1$. The decomposition keeps all entries with a level
+ *   of at most AdditionalData::fill_in_level. The sparsity pattern only
+ *   depends on the sparsity pattern of the matrix, so it can be reused
+ *   through AdditionalData::use_previous_sparsity when only the values of
+ *   the matrix change.
+ * - ILUT, selected by AdditionalData::FillIn::threshold: The decomposition
+ *   drops all entries that are smaller than AdditionalData::drop_tolerance
+ *   times the $l_2$ norm of the current row of the matrix. Since this
+ *   criterion depends on the values, the sparsity pattern is recomputed in
+ *   every call to initialize().
+ *
+ * In both cases, AdditionalData::max_fill_in_per_row limits the memory
+ * consumption of the decomposition: each row of the strictly lower and of
+ * the strictly upper triangular factor can have at most this many entries
+ * more than the corresponding part of the row of the matrix. ILU(k) keeps
+ * the entries with the lowest levels, ILUT keeps the largest ones.
+ *
+ *
  * <h3>Usage and state management</h3>
  *
  * Refer to SparseLUDecomposition documentation for suggested usage and state
@@ -73,10 +102,88 @@ public:
   SparseILU() = default;
 
   /**
-   * Make SparseLUDecomposition::AdditionalData accessible to this class as
-   * well.
+   * Parameters for SparseILU. In addition to the parameters of
+   * SparseLUDecomposition::AdditionalData, this class allows to select a
+   * decomposition that determines its own fill-in, see the section on
+   * fill-in in the class documentation.
    */
-  using AdditionalData = typename SparseLUDecomposition<number>::AdditionalData;
+  class AdditionalData : public SparseLUDecomposition<number>::AdditionalData
+  {
+  public:
+    /**
+     * The ways to determine the sparsity pattern of the decomposition.
+     */
+    enum class FillIn
+    {
+      /**
+       * Use the sparsity pattern of the matrix, possibly with extra
+       * off-diagonals, or the one given through
+       * SparseLUDecomposition::AdditionalData::use_this_sparsity, i.e.,
+       * compute an ILU(0) decomposition on that pattern.
+       */
+      pattern,
+      /**
+       * Compute the level-of-fill based ILU(k) decomposition with
+       * $k$=#fill_in_level.
+       */
+      level,
+      /**
+       * Compute the threshold based ILUT decomposition with the
+       * #drop_tolerance.
+       */
+      threshold
+    };
+
+    /**
+     * Constructor. For the parameters' description, see below and in the
+     * base class.
+     */
+    explicit AdditionalData(
+      const double           strengthen_diagonal   = 0.,
+      const unsigned int     extra_off_diagonals   = 0,
+      const bool             use_previous_sparsity = false,
+      const SparsityPattern *use_this_sparsity     = nullptr,
+      const bool             use_level_scheduling  = false,
+      const FillIn           fill_in               = FillIn::pattern,
+      const unsigned int     fill_in_level         = 1,
+      const double           drop_tolerance        = 1e-3,
+      const unsigned int max_fill_in_per_row = numbers::invalid_unsigned_int);
+
+    /**
+     * Constructor from the parameters of the base class, using the default
+     * values for all parameters of this class.
+     */
+    AdditionalData(
+      const typename SparseLUDecomposition<number>::AdditionalData &data);
+
+    /**
+     * How the sparsity pattern of the decomposition is determined. If this
+     * is not FillIn::pattern, the parameters
+     * SparseLUDecomposition::AdditionalData::extra_off_diagonals and
+     * SparseLUDecomposition::AdditionalData::use_this_sparsity are ignored.
+     */
+    FillIn fill_in;
+
+    /**
+     * The maximal level of the entries kept by ILU(k).
+     */
+    unsigned int fill_in_level;
+
+    /**
+     * The relative drop tolerance of ILUT. An entry is dropped if its
+     * magnitude is smaller than this value times the $l_2$ norm of the row
+     * of the matrix it is computed in.
+     */
+    double drop_tolerance;
+
+    /**
+     * The maximal number of entries each row of the strictly lower and the
+     * strictly upper triangular factor of ILU(k) and ILUT may have in
+     * addition to the entries of the matrix in the corresponding part of the
+     * row. The default value does not limit the fill-in.
+     */
+    unsigned int max_fill_in_per_row;
+  };
 
   /**
    * Perform the incomplete LU factorization of the given matrix.
@@ -91,7 +198,9 @@ public:
    * According to the @p parameters, this function creates a new
    * SparsityPattern or keeps the previous sparsity or takes the sparsity
    * given by the user to @p data. Then, this function performs the LU
-   * decomposition.
+   * decomposition. For the ILU(k) and ILUT variants selected by
+   * AdditionalData::fill_in, the sparsity pattern is computed by this
+   * function.
    *
    * After this function is called the preconditioner is ready to be used.
    */
@@ -172,11 +281,69 @@ public:
                     "you can set in the optional constructor argument of "
                     "this class.");
   /** @} */
+
+private:
+  /**
+   * Compute the sparsity pattern of the ILU(k) decomposition for a matrix
+   * with the given sparsity pattern, keeping at most @p max_fill_in_per_row
+   * additional entries in the lower and upper part of each row.
+   */
+  static std::unique_ptr<SparsityPattern>
+  create_level_of_fill_sparsity(const SparsityPattern &matrix_sparsity,
+                                const unsigned int     fill_in_level,
+                                const unsigned int     max_fill_in_per_row);
+
+  /**
+   * Compute the ILUT decomposition of @p matrix, including its sparsity
+   * pattern, and store it in this object in the same form as the other
+   * decompositions.
+   */
+  template <typename somenumber>
+  void
+  initialize_threshold(const SparseMatrix<somenumber> &matrix,
+                       const AdditionalData           &data);
 };
 
 /** @} */
 //---------------------------------------------------------------------------
 
+#ifndef DOXYGEN
+
+template <typename number>
+SparseILU<number>::AdditionalData::AdditionalData(
+  const double           strengthen_diagonal,
+  const unsigned int     extra_off_diagonals,
+  const bool             use_previous_sparsity,
+  const SparsityPattern *use_this_sparsity,
+  const bool             use_level_scheduling,
+  const FillIn           fill_in,
+  const unsigned int     fill_in_level,
+  const double           drop_tolerance,
+  const unsigned int     max_fill_in_per_row)
+  : SparseLUDecomposition<number>::AdditionalData(strengthen_diagonal,
+                                                  extra_off_diagonals,
+                                                  use_previous_sparsity,
+                                                  use_this_sparsity,
+                                                  use_level_scheduling)
+  , fill_in(fill_in)
+  , fill_in_level(fill_in_level)
+  , drop_tolerance(drop_tolerance)
+  , max_fill_in_per_row(max_fill_in_per_row)
+{}
+
+
+
+template <typename number>
+SparseILU<number>::AdditionalData::AdditionalData(
+  const typename SparseLUDecomposition<number>::AdditionalData &data)
+  : SparseLUDecomposition<number>::AdditionalData(data)
+  , fill_in(FillIn::pattern)
+  , fill_in_level(1)
+  , drop_tolerance(1e-3)
+  , max_fill_in_per_row(numbers::invalid_unsigned_int)
+{}
+
+#endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
 
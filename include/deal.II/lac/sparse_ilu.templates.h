@@ -19,11 +19,16 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparse_ilu.h>
 #include <deal.II/lac/vector.h>
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <map>
+#include <queue>
+#include <tuple>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -35,7 +40,29 @@ void
 SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
                               const AdditionalData           &data)
 {
-  SparseLUDecomposition<number>::initialize(matrix, data);
+  if (data.fill_in == AdditionalData::FillIn::threshold)
+    {
+      initialize_threshold(matrix, data);
+      return;
+    }
+
+  // for ILU(k), compute the sparsity pattern unless the one of the previous
+  // call is to be reused
+  if (data.fill_in == AdditionalData::FillIn::level &&
+      !(data.use_previous_sparsity && !this->empty() &&
+        (this->m() == matrix.m())))
+    {
+      Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+      std::unique_ptr<SparsityPattern> sparsity =
+        create_level_of_fill_sparsity(matrix.get_sparsity_pattern(),
+                                      data.fill_in_level,
+                                      data.max_fill_in_per_row);
+      if (matrix.get_sparsity_pattern().has_narrow_column_indices())
+        sparsity->store_narrow_column_indices();
+      this->initialize_with_own_sparsity(std::move(sparsity));
+    }
+  else
+    SparseLUDecomposition<number>::initialize(matrix, data);
 
   Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
   Assert(this->m() == this->n(), ExcNotQuadratic());
@@ -46,6 +73,8 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
   this->strengthen_diagonal = data.strengthen_diagonal;
   this->prebuild_lower_bound();
+  if (data.use_level_scheduling)
+    this->compute_level_sets();
   this->copy_from(matrix);
 
   if (data.strengthen_diagonal > 0)
@@ -56,7 +85,11 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
   // using the names of variables used there
   const SparsityPattern   &sparsity = this->get_sparsity_pattern();
   const std::size_t *const ia       = sparsity.rowstart.get();
-  const size_type *const   ja       = sparsity.colnums.get();
+
+  // the column index of the entry at position j, which is in the given row
+  const auto ja = [&sparsity](const size_type row, const std::size_t j) {
+    return sparsity.column_index(row, j);
+  };
 
   number *luval = this->SparseMatrix<number>::val.get();
 
@@ -70,7 +103,7 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
       const size_type j1 = ia[k], j2 = ia[k + 1] - 1;
 
       for (size_type j = j1; j <= j2; ++j)
-        iw[ja[j]] = j;
+        iw[ja(k, j)] = j;
 
       // the algorithm in the book works on the elements of row k left of the
       // diagonal. however, since we store the diagonal element at the first
@@ -85,7 +118,7 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
     label_150:
 
-      jrow = ja[j];
+      jrow = ja(k, j);
       if (jrow >= k)
         goto label_200;
 
@@ -96,11 +129,11 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
         // jj runs from just right of the diagonal to the end of the row
         size_type jj = ia[jrow] + 1;
-        while (ja[jj] < jrow)
+        while (ja(jrow, jj) < jrow)
           ++jj;
         for (; jj < ia[jrow + 1]; ++jj)
           {
-            const size_type jw = iw[ja[jj]];
+            const size_type jw = iw[ja(jrow, jj)];
             if (jw != numbers::invalid_size_type)
               luval[jw] -= t1 * luval[jj];
           }
@@ -126,8 +159,266 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
       luval[ia[k]] = 1. / luval[ia[k]];
 
       for (size_type j = j1; j <= j2; ++j)
-        iw[ja[j]] = numbers::invalid_size_type;
+        iw[ja(k, j)] = numbers::invalid_size_type;
+    }
+}
+
+
+
+template <typename number>
+std::unique_ptr<SparsityPattern>
+SparseILU<number>::create_level_of_fill_sparsity(
+  const SparsityPattern &matrix_sparsity,
+  const unsigned int     fill_in_level,
+  const unsigned int     max_fill_in_per_row)
+{
+  const size_type        N = matrix_sparsity.n_rows();
+  DynamicSparsityPattern dsp(N, N);
+
+  // the levels of the entries right of the diagonal of all rows worked on
+  // so far, which are needed for the elimination of the following rows
+  std::vector<std::vector<std::pair<size_type, unsigned int>>> upper_levels(
+    N);
+
+  // the levels of the entries of the current row, sorted by column
+  std::map<size_type, unsigned int> row_levels;
+
+  // the fill-in entries of the current row left and right of the diagonal,
+  // as pairs of level and column
+  std::vector<std::pair<unsigned int, size_type>> lower_fill, upper_fill;
+
+  for (size_type i = 0; i < N; ++i)
+    {
+      // all entries of the matrix have level zero
+      row_levels.clear();
+      row_levels[i] = 0;
+      for (SparsityPattern::iterator p = matrix_sparsity.begin(i);
+           p != matrix_sparsity.end(i);
+           ++p)
+        row_levels[p->column()] = 0;
+
+      // eliminate the entries left of the diagonal in ascending order. the
+      // entries created by the elimination with row k are right of column k,
+      // so the loop also visits the fill-in left of the diagonal, after its
+      // level has been determined
+      for (auto k = row_levels.begin(); k->first < i; ++k)
+        for (const auto &[j, level_kj] : upper_levels[k->first])
+          {
+            const unsigned int level = k->second + level_kj + 1;
+            if (level <= fill_in_level)
+              {
+                const auto entry = row_levels.try_emplace(j, level).first;
+                entry->second    = std::min(entry->second, level);
+              }
+          }
+
+      lower_fill.clear();
+      upper_fill.clear();
+      for (const auto &[j, level] : row_levels)
+        if (level == 0)
+          {
+            dsp.add(i, j);
+            if (j > i)
+              upper_levels[i].emplace_back(j, 0);
+          }
+        else if (j < i)
+          lower_fill.emplace_back(level, j);
+        else
+          upper_fill.emplace_back(level, j);
+
+      // if there is too much fill-in, keep the entries with the lowest level
+      // and, among those, the ones closest to the diagonal
+      const auto add_fill = [&](std::vector<std::pair<unsigned int, size_type>>
+                                  &fill) {
+        if (fill.size() > max_fill_in_per_row)
+          {
+            const auto is_preferred = [i](const auto &a, const auto &b) {
+              return std::make_tuple(a.first, std::max(a.second, i) -
+                                                std::min(a.second, i)) <
+                     std::make_tuple(b.first, std::max(b.second, i) -
+                                                std::min(b.second, i));
+            };
+            std::nth_element(fill.begin(),
+                             fill.begin() + max_fill_in_per_row,
+                             fill.end(),
+                             is_preferred);
+            fill.resize(max_fill_in_per_row);
+          }
+        for (const auto &[level, j] : fill)
+          {
+            dsp.add(i, j);
+            if (j > i)
+              upper_levels[i].emplace_back(j, level);
+          }
+      };
+      add_fill(lower_fill);
+      add_fill(upper_fill);
+    }
+
+  auto sparsity = std::make_unique<SparsityPattern>();
+  sparsity->copy_from(dsp);
+  return sparsity;
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SparseILU<number>::initialize_threshold(const SparseMatrix<somenumber> &matrix,
+                                        const AdditionalData           &data)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+  Assert(data.strengthen_diagonal >= 0,
+         ExcInvalidStrengthening(data.strengthen_diagonal));
+  Assert(data.drop_tolerance >= 0,
+         ExcMessage("The drop tolerance must not be negative."));
+
+  this->strengthen_diagonal = data.strengthen_diagonal;
+
+  // this is algorithm 10.6 (ILUT) in the book by Saad. the rows of the
+  // factors are computed one after the other in a dense work row, eliminating
+  // the entries left of the diagonal in ascending order with the rows of the
+  // upper factor computed before. as for ILU(0), the lower factor stores the
+  // multipliers, i.e., has an implicit unit diagonal
+  const size_type N = matrix.m();
+
+  std::vector<std::vector<std::pair<size_type, number>>> lower_rows(N),
+    upper_rows(N);
+  std::vector<number> diagonal(N);
+
+  std::vector<number>    w(N, number(0));
+  std::vector<bool>      is_nonzero(N, false);
+  std::vector<size_type> nonzero_columns;
+  std::priority_queue<size_type, std::vector<size_type>, std::greater<>>
+    lower_columns;
+
+  for (size_type i = 0; i < N; ++i)
+    {
+      const auto add_nonzero = [&](const size_type j) {
+        if (is_nonzero[j] == false)
+          {
+            is_nonzero[j] = true;
+            nonzero_columns.push_back(j);
+            if (j < i)
+              lower_columns.push(j);
+          }
+      };
+
+      // copy the row of the matrix into the work row
+      number       row_norm_sqr = 0, off_diagonal_sum = 0;
+      unsigned int n_lower = 0, n_upper = 0;
+      add_nonzero(i);
+      for (typename SparseMatrix<somenumber>::const_iterator p =
+             matrix.begin(i);
+           p != matrix.end(i);
+           ++p)
+        {
+          const size_type j = p->column();
+          w[j]              = p->value();
+          add_nonzero(j);
+          row_norm_sqr += w[j] * w[j];
+          if (j != i)
+            off_diagonal_sum += std::fabs(w[j]);
+          if (j < i)
+            ++n_lower;
+          else if (j > i)
+            ++n_upper;
+        }
+      if (data.strengthen_diagonal > 0)
+        w[i] += this->get_strengthen_diagonal(off_diagonal_sum, i) *
+                off_diagonal_sum;
+      const number tolerance = data.drop_tolerance * std::sqrt(row_norm_sqr);
+
+      // eliminate the entries left of the diagonal. fill-in created by row
+      // k is right of column k, so the queue stays sorted
+      while (!lower_columns.empty())
+        {
+          const size_type k = lower_columns.top();
+          lower_columns.pop();
+
+          w[k] /= diagonal[k];
+          if (std::fabs(w[k]) <= tolerance)
+            {
+              w[k] = 0;
+              continue;
+            }
+          for (const auto &[j, u_kj] : upper_rows[k])
+            {
+              add_nonzero(j);
+              w[j] -= w[k] * u_kj;
+            }
+        }
+
+      Assert(w[i] != number(0), ExcZeroPivot(i));
+      diagonal[i] = w[i];
+
+      for (const size_type j : nonzero_columns)
+        {
+          if ((j != i) && (std::fabs(w[j]) > tolerance))
+            (j < i ? lower_rows[i] : upper_rows[i]).emplace_back(j, w[j]);
+          w[j]          = 0;
+          is_nonzero[j] = false;
+        }
+      nonzero_columns.clear();
+
+      // if there is too much fill-in, keep the largest entries
+      const auto limit_fill_in =
+        [&data](std::vector<std::pair<size_type, number>> &row,
+                const unsigned int                          n_entries_matrix) {
+          if (data.max_fill_in_per_row == numbers::invalid_unsigned_int ||
+              row.size() <= n_entries_matrix + data.max_fill_in_per_row)
+            return;
+          std::nth_element(row.begin(),
+                           row.begin() + n_entries_matrix +
+                             data.max_fill_in_per_row,
+                           row.end(),
+                           [](const auto &a, const auto &b) {
+                             return std::fabs(a.second) > std::fabs(b.second);
+                           });
+          row.resize(n_entries_matrix + data.max_fill_in_per_row);
+        };
+      limit_fill_in(lower_rows[i], n_lower);
+      limit_fill_in(upper_rows[i], n_upper);
+    }
+
+  // build the sparsity pattern of the decomposition
+  DynamicSparsityPattern dsp(N, N);
+  for (size_type i = 0; i < N; ++i)
+    {
+      dsp.add(i, i);
+      for (const auto &entry : lower_rows[i])
+        dsp.add(i, entry.first);
+      for (const auto &entry : upper_rows[i])
+        dsp.add(i, entry.first);
+    }
+  auto sparsity = std::make_unique<SparsityPattern>();
+  sparsity->copy_from(dsp);
+  if (matrix.get_sparsity_pattern().has_narrow_column_indices())
+    sparsity->store_narrow_column_indices();
+  this->initialize_with_own_sparsity(std::move(sparsity));
+
+  // and copy the factors into it. the diagonal entry is stored first and
+  // inverted, followed by the other entries of the row in ascending order
+  const std::size_t *const rowstart =
+    this->get_sparsity_pattern().rowstart.get();
+  number *luval = this->SparseMatrix<number>::val.get();
+  for (size_type i = 0; i < N; ++i)
+    {
+      std::size_t index = rowstart[i];
+      luval[index++]    = number(1.) / diagonal[i];
+      for (auto *row : {&lower_rows[i], &upper_rows[i]})
+        {
+          std::sort(row->begin(), row->end());
+          for (const auto &entry : *row)
+            luval[index++] = entry.second;
+        }
+      Assert(index == rowstart[i + 1], ExcInternalError());
     }
+
+  this->prebuild_lower_bound();
+  if (data.use_level_scheduling)
+    this->compute_level_sets();
 }
 
 
@@ -142,11 +433,9 @@ SparseILU<number>::vmult(Vector<somenumber>       &dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
-  const std::size_t *const rowstart_indices =
-    this->get_sparsity_pattern().rowstart.get();
-  const size_type *const column_numbers =
-    this->get_sparsity_pattern().colnums.get();
+  const SparsityPattern   &sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+  const number *const      luval = this->SparseMatrix<number>::val.get();
 
   // solve LUx=b in two steps:
   // first Ly = b, then
@@ -160,26 +449,30 @@ SparseILU<number>::vmult(Vector<somenumber>       &dst,
   // we split the y_i = b_i off and
   // perform it at the outset of the
   // loop
+  //
+  // the rows are worked on in an order given by
+  // forward_substitution_loop(), which runs independent rows in parallel if
+  // level sets have been computed
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // get start of this row. skip the
-      // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-      dst(row) = dst_row;
-    }
+  this->forward_substitution_loop([&](const size_type row) {
+    // get start of this row. skip the
+    // diagonal element
+    const std::size_t rowstart = rowstart_indices[row] + 1;
+    // find the position where the part
+    // right of the diagonal starts
+    const std::size_t first_after_diagonal = this->prebuilt_lower_bound[row];
+
+    somenumber dst_row = dst(row);
+    internal::SparsityPatternTools::for_each_entry_in_row(
+      sparsity,
+      row,
+      rowstart,
+      first_after_diagonal,
+      [&](const std::size_t j, const size_type column) {
+        dst_row -= luval[j] * dst(column);
+      });
+    dst(row) = dst_row;
+  });
 
   // now the backward solve. same
   // procedure, but we need not set
@@ -189,28 +482,28 @@ SparseILU<number>::vmult(Vector<somenumber>       &dst,
   // note that we need to scale now,
   // since the diagonal is not equal to
   // one now
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-
-      // scale by the diagonal element.
-      // note that the diagonal element
-      // was stored inverted
-      dst(row) = dst_row * this->diag_element(row);
-    }
+  this->backward_substitution_loop([&](const size_type row) {
+    // get end of this row
+    const std::size_t rowend = rowstart_indices[row + 1];
+    // find the position where the part
+    // right of the diagonal starts
+    const std::size_t first_after_diagonal = this->prebuilt_lower_bound[row];
+
+    somenumber dst_row = dst(row);
+    internal::SparsityPatternTools::for_each_entry_in_row(
+      sparsity,
+      row,
+      first_after_diagonal,
+      rowend,
+      [&](const std::size_t j, const size_type column) {
+        dst_row -= luval[j] * dst(column);
+      });
+
+    // scale by the diagonal element.
+    // note that the diagonal element
+    // was stored inverted
+    dst(row) = dst_row * this->diag_element(row);
+  });
 }
 
 
@@ -225,10 +518,9 @@ SparseILU<number>::Tvmult(Vector<somenumber>       &dst,
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
   const size_type          N = dst.size();
-  const std::size_t *const rowstart_indices =
-    this->get_sparsity_pattern().rowstart.get();
-  const size_type *const column_numbers =
-    this->get_sparsity_pattern().colnums.get();
+  const SparsityPattern   &sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+  const number *const      luval = this->SparseMatrix<number>::val.get();
 
   // solve (LU)'x=b in two steps:
   // first U'y = b, then
@@ -250,19 +542,20 @@ SparseILU<number>::Tvmult(Vector<somenumber>       &dst,
       dst(row) *= this->diag_element(row);
 
       // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
+      const std::size_t rowend = rowstart_indices[row + 1];
       // find the position where the part
       // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
+      const std::size_t first_after_diagonal = this->prebuilt_lower_bound[row];
 
       const somenumber dst_row = dst(row);
-      const number    *luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        tmp(*col) += *luval * dst_row;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        sparsity,
+        row,
+        first_after_diagonal,
+        rowend,
+        [&](const std::size_t j, const size_type column) {
+          tmp(column) += luval[j] * dst_row;
+        });
     }
 
   // now the backward solve. same
@@ -280,19 +573,20 @@ SparseILU<number>::Tvmult(Vector<somenumber>       &dst,
 
       // get start of this row. skip the
       // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
+      const std::size_t rowstart = rowstart_indices[row] + 1;
       // find the position where the part
       // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
+      const std::size_t first_after_diagonal = this->prebuilt_lower_bound[row];
 
       const somenumber dst_row = dst(row);
-      const number    *luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        tmp(*col) += *luval * dst_row;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        sparsity,
+        row,
+        rowstart,
+        first_after_diagonal,
+        [&](const std::size_t j, const size_type column) {
+          tmp(column) += luval[j] * dst_row;
+        });
     }
 }
 
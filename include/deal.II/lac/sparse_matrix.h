@@ -507,6 +507,33 @@ DEAL_II_NAMESPACE_OPEN // Do not convert for module purposes
    * SparseMatrix::end) you will find that the elements are not sorted by column
    * index within each row whenever the matrix is square.
    *
+   * <h3>Matrices in reduced precision</h3>
+   *
+   * Since several matrices can be based on the same SparsityPattern, a copy
+   * of a matrix with its values stored in single precision needs no memory
+   * for the structure beyond the values themselves. Such a copy is useful
+   * for preconditioners, whose application is limited by the memory
+   * bandwidth and does not need the full precision of the system matrix:
+   * @code
+   *   SparseMatrix<double> system_matrix(sparsity_pattern);
+   *   // ... assemble system_matrix ...
+   *
+   *   SparseMatrix<float> preconditioner_matrix(sparsity_pattern);
+   *   preconditioner_matrix.copy_from(system_matrix);
+   *
+   *   PreconditionSSOR<SparseMatrix<float>> preconditioner;
+   *   preconditioner.initialize(preconditioner_matrix, 1.2);
+   *   solver.solve(system_matrix, solution, system_rhs, preconditioner);
+   * @endcode
+   * The matrix-vector products and the relaxation methods of this class
+   * accept vectors with a value type that differs from @p number. The
+   * stored values are then converted to the value type of the vectors on the
+   * fly, and all arithmetic is done in the precision of the vectors, so that
+   * the only loss of accuracy is the rounding of the matrix entries. The
+   * same applies to the factors of SparseILU<float> and SparseMIC<float>,
+   * which can be computed directly from a SparseMatrix<double> and then use
+   * its sparsity pattern.
+   *
    * @note Instantiations for this template are provided for <tt>@<float@> and
    * @<double@></tt>; others can be generated in application programs (see the
    * section on
@@ -1147,7 +1174,16 @@ public:
    * you want to multiply with BlockVector objects, you should consider using
    * a BlockSparseMatrix as well.
    *
+   * If the column-wise index map of the sparsity pattern has been built
+   * through SparsityPattern::store_column_index_map(), this function works
+   * on the columns of the matrix in parallel when run on more than one
+   * thread. Otherwise, it works sequentially. The map is never built
+   * implicitly, since it costs about 16 bytes per nonzero entry; see there.
+   * The results do not depend on the number of threads.
+   *
    * Source and destination must not be the same vector.
+   *
+   * @dealiiOperationIsMultithreaded
    */
   template <class OutVector, class InVector>
   void
@@ -1173,6 +1209,27 @@ public:
   void
   vmult_add(OutVector &dst, const InVector &src) const;
 
+  /**
+   * Matrix-vector multiplication with several vectors at once: let
+   * <tt>dst.block(b) = M*src.block(b)</tt> for all blocks of the block
+   * vectors @p dst and @p src, each of which has to have the size of this
+   * matrix.
+   *
+   * In contrast to calling vmult() for every block, the matrix is only read
+   * once for every group of up to eight blocks. Since a matrix-vector product
+   * is limited by the memory bandwidth needed to load the matrix entries,
+   * this is considerably faster when many vectors have to be multiplied by
+   * the same matrix, e.g., in the solvers for multiple right hand sides
+   * SolverBlockCG and SolverBlockGMRES.
+   *
+   * Source and destination must not be the same vector.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <class BlockVectorType>
+  void
+  vmult_blockwise(BlockVectorType &dst, const BlockVectorType &src) const;
+
   /**
    * Adding Matrix-vector multiplication. Add <i>M<sup>T</sup>*src</i> to
    * <i>dst</i> with <i>M</i> being this matrix. This function does the same
@@ -1186,7 +1243,16 @@ public:
    * you want to multiply with BlockVector objects, you should consider using
    * a BlockSparseMatrix as well.
    *
+   * If the column-wise index map of the sparsity pattern has been built
+   * through SparsityPattern::store_column_index_map(), this function works
+   * on the columns of the matrix in parallel when run on more than one
+   * thread. Otherwise, it works sequentially. The map is never built
+   * implicitly, since it costs about 16 bytes per nonzero entry; see there.
+   * The results do not depend on the number of threads.
+   *
    * Source and destination must not be the same vector.
+   *
+   * @dealiiOperationIsMultithreaded
    */
   template <class OutVector, class InVector>
   void
@@ -1311,6 +1377,26 @@ public:
          const Vector<number>        &V = Vector<number>(),
          const bool                   rebuild_sparsity_pattern = true) const;
 
+  /**
+   * Compute the Galerkin product <tt>C = P<sup>T</sup> * A * P</tt> of the
+   * calling matrix <tt>A</tt> with the matrix @p P, as needed for the coarse
+   * operators of algebraic multigrid methods. This is the same as computing
+   * <tt>AP = A * P</tt> with mmult() and then <tt>C = P<sup>T</sup> * AP</tt>
+   * with Tmmult(), except that the intermediate product is created and
+   * released internally.
+   *
+   * The optional flag @p rebuild_sparsity_pattern has the same meaning as
+   * for mmult(): if it is @p true, the sparsity pattern associated with @p C
+   * is replaced by the one of the product, so make sure that it is not used
+   * by any other matrix; otherwise, it has to contain all entries of the
+   * product already.
+   */
+  template <typename numberP, typename numberC>
+  void
+  PtAP(SparseMatrix<numberC>       &C,
+       const SparseMatrix<numberP> &P,
+       const bool                   rebuild_sparsity_pattern = true) const;
+
   /** @} */
   /**
    * @name Matrix norms
@@ -1763,6 +1849,60 @@ private:
    */
   std::size_t max_len;
 
+  /**
+   * Add the product of a left matrix and the matrix @p B to @p C, where the
+   * left matrix has @p n_left_rows rows and its entries are stored in
+   * @p left_values, and row $k$ of @p B is scaled by <tt>scaling[k]</tt>
+   * unless @p scaling is a null pointer. This is the implementation of
+   * mmult(), Tmmult(), and PtAP().
+   *
+   * The entries of row $i$ of the left matrix are visited by calling
+   * <tt>for_each_left_entry(i, f)</tt>, which must call <tt>f(k, column)</tt>
+   * for each entry of the row, where $k$ is the position of the entry in
+   * @p left_values. This way, the left matrix can be this matrix, whose
+   * sparsity pattern may store narrow column indices, or a transpose set up
+   * in compressed row storage.
+   *
+   * The rows of the product are computed in parallel, in two phases: If
+   * @p rebuild_sparsity_pattern is true, the number of entries in each row
+   * is counted first, which allows to set up the sparsity pattern of @p C
+   * directly and to fill in its column indices in parallel, rather than
+   * going through a DynamicSparsityPattern. The numerical phase then adds
+   * the products of each row directly into the entries of @p C, using an
+   * array that maps the columns of the current row to their position in
+   * @p C on each thread.
+   */
+  template <typename numberL,
+            typename numberB,
+            typename numberC,
+            typename LeftRowFunction>
+  static void
+  compute_product(SparseMatrix<numberC>       &C,
+                  const size_type              n_left_rows,
+                  const LeftRowFunction       &for_each_left_entry,
+                  const numberL               *left_values,
+                  const numberL               *scaling,
+                  const SparseMatrix<numberB> &B,
+                  const bool                   rebuild_sparsity_pattern);
+
+  /**
+   * Return whether Tvmult() and Tvmult_add() should work on the columns in
+   * parallel, which is the case if the sparsity pattern stores a
+   * column-wise index map, more than one thread is available, and the
+   * matrix has enough columns.
+   */
+  bool
+  Tvmult_in_parallel() const;
+
+  /**
+   * Compute or, if @p add is true, add the product of the transpose of this
+   * matrix with @p src into @p dst in parallel over the columns, using the
+   * column-wise index map of the sparsity pattern.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_on_columns(OutVector &dst, const InVector &src, const bool add) const;
+
   // make all other sparse matrices friends
   template <typename somenumber>
   friend class SparseMatrix;
@@ -2536,14 +2676,15 @@ SparseMatrix<number>::print(StreamType &out,
     {
       for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
         {
-          if (!diagonal_first && i == cols->colnums[j])
+          const size_type column = cols->column_index(i, j);
+          if (!diagonal_first && i == column)
             {
               diagonal         = val[j];
               hanging_diagonal = true;
             }
           else
             {
-              if (hanging_diagonal && cols->colnums[j] > i)
+              if (hanging_diagonal && column > i)
                 {
                   if (across)
                     out << ' ' << i << ',' << i << ':' << diagonal;
@@ -2553,9 +2694,9 @@ SparseMatrix<number>::print(StreamType &out,
                   hanging_diagonal = false;
                 }
               if (across)
-                out << ' ' << i << ',' << cols->colnums[j] << ':' << val[j];
+                out << ' ' << i << ',' << column << ':' << val[j];
               else
-                out << '(' << i << ',' << cols->colnums[j] << ") " << val[j]
+                out << '(' << i << ',' << column << ") " << val[j]
                     << std::endl;
             }
         }
@@ -18,8 +18,10 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -35,6 +37,7 @@
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <limits>
 #include <numeric>
 #include <ostream>
 #include <vector>
@@ -310,30 +313,26 @@ SparseMatrix<number>::symmetrize()
   for (size_type row = 0; row < n_rows; ++row)
     {
       // first skip diagonal entry
-      number *val_ptr = &val[cols->rowstart[row]];
-      if (m() == n())
-        ++val_ptr;
-      const size_type    *colnum_ptr = &cols->colnums[cols->rowstart[row] + 1];
-      const number *const val_end_of_row = &val[cols->rowstart[row + 1]];
+      std::size_t j = cols->rowstart[row] + 1;
 
       // treat lower left triangle
-      while ((val_ptr != val_end_of_row) && (*colnum_ptr < row))
+      for (; j < cols->rowstart[row + 1]; ++j)
         {
+          const size_type column = cols->column_index(row, j);
+          if (column >= row)
+            break;
+
           // compute the mean of this
           // and the transpose value
           const number mean_value =
-            (*val_ptr + val[(*cols)(*colnum_ptr, row)]) / number(2.0);
+            (val[j] + val[(*cols)(column, row)]) / number(2.0);
           // set this value and the
           // transpose one to the
           // mean
-          *val_ptr = mean_value;
-          set(*colnum_ptr, row, mean_value);
-
-          // advance pointers
-          ++val_ptr;
-          ++colnum_ptr;
-        };
-    };
+          val[j] = mean_value;
+          set(column, row, mean_value);
+        }
+    }
 }
 
 
@@ -455,39 +454,107 @@ namespace internal
      */
     template <typename number, typename InVector, typename OutVector>
     void
-    vmult_on_subrange(const size_type    begin_row,
-                      const size_type    end_row,
-                      const number      *values,
-                      const std::size_t *rowstart,
-                      const size_type   *colnums,
-                      const InVector    &src,
-                      OutVector         &dst,
-                      const bool         add)
+    vmult_on_subrange(const size_type        begin_row,
+                      const size_type        end_row,
+                      const number          *values,
+                      const std::size_t     *rowstart,
+                      const SparsityPattern &sparsity,
+                      const InVector        &src,
+                      OutVector             &dst,
+                      const bool             add)
     {
-      const number                *val_ptr    = &values[rowstart[begin_row]];
-      const size_type             *colnum_ptr = &colnums[rowstart[begin_row]];
-      typename OutVector::iterator dst_ptr    = dst.begin() + begin_row;
-
-      if (add == false)
-        for (size_type row = begin_row; row < end_row; ++row)
-          {
-            typename OutVector::value_type s   = 0.;
-            const number *const val_end_of_row = &values[rowstart[row + 1]];
-            while (val_ptr != val_end_of_row)
-              s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
-            *dst_ptr++ = s;
-          }
-      else
-        for (size_type row = begin_row; row < end_row; ++row)
-          {
-            typename OutVector::value_type s   = *dst_ptr;
-            const number *const val_end_of_row = &values[rowstart[row + 1]];
-            while (val_ptr != val_end_of_row)
-              s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
-            *dst_ptr++ = s;
-          }
+      typename OutVector::iterator dst_ptr = dst.begin() + begin_row;
+
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          typename OutVector::value_type s =
+            (add ? *dst_ptr : typename OutVector::value_type(0.));
+          internal::SparsityPatternTools::for_each_entry_in_row(
+            sparsity,
+            row,
+            rowstart[row],
+            rowstart[row + 1],
+            [&](const std::size_t j, const size_type column) {
+              s += typename OutVector::value_type(values[j]) *
+                   typename OutVector::value_type(src(column));
+            });
+          *dst_ptr++ = s;
+        }
+    }
+
+    /**
+     * Perform a Tvmult using the column-wise index map of a SparsityPattern,
+     * but only for a subinterval of the columns, i.e., of the entries of
+     * @p dst. The entries of each column are summed up in the order of their
+     * rows, as in a sequential Tvmult.
+     */
+    template <typename number, typename InVector, typename OutVector>
+    void
+    Tvmult_on_subrange(const size_type    begin_column,
+                       const size_type    end_column,
+                       const number      *values,
+                       const std::size_t *column_start,
+                       const std::size_t *column_positions,
+                       const size_type   *column_rows,
+                       const InVector    &src,
+                       OutVector         &dst,
+                       const bool         add)
+    {
+      typename OutVector::iterator dst_ptr = dst.begin() + begin_column;
+
+      for (size_type column = begin_column; column < end_column; ++column)
+        {
+          typename OutVector::value_type s =
+            (add ? *dst_ptr : typename OutVector::value_type(0.));
+          for (std::size_t k = column_start[column];
+               k < column_start[column + 1];
+               ++k)
+            s += typename OutVector::value_type(values[column_positions[k]]) *
+                 typename OutVector::value_type(src(column_rows[k]));
+          *dst_ptr++ = s;
+        }
+    }
+
+    /**
+     * Perform a vmult for several vectors at once on a subinterval of the
+     * rows, where @p src and @p dst point to the data of the @p n_vectors
+     * vectors. The vectors are worked on in groups of a fixed size, such
+     * that the sums of a row fit into registers and every matrix entry is
+     * loaded only once per group.
+     */
+    template <typename number, typename number2>
+    void
+    vmult_blockwise_on_subrange(const size_type        begin_row,
+                                const size_type        end_row,
+                                const number          *values,
+                                const std::size_t     *rowstart,
+                                const SparsityPattern &sparsity,
+                                const unsigned int     n_vectors,
+                                const number2 *const  *src,
+                                number2 *const        *dst)
+    {
+      constexpr unsigned int group_size = 8;
+      for (unsigned int first = 0; first < n_vectors; first += group_size)
+        {
+          const unsigned int n_in_group =
+            std::min(group_size, n_vectors - first);
+          for (size_type row = begin_row; row < end_row; ++row)
+            {
+              number2 sums[group_size] = {};
+              internal::SparsityPatternTools::for_each_entry_in_row(
+                sparsity,
+                row,
+                rowstart[row],
+                rowstart[row + 1],
+                [&](const std::size_t j, const size_type column) {
+                  const number2 value = number2(values[j]);
+                  for (unsigned int v = 0; v < n_in_group; ++v)
+                    sums[v] += value * src[first + v][column];
+                });
+              for (unsigned int v = 0; v < n_in_group; ++v)
+                dst[first + v][row] = sums[v];
+            }
+        }
     }
   } // namespace SparseMatrixImplementation
 } // namespace internal
@@ -524,14 +591,17 @@ SparseMatrix<number>::add(const size_type  row,
                      "List of indices is unsorted or contains duplicates."));
         }
 
-      const size_type *this_cols    = &cols->colnums[cols->rowstart[row]];
-      const size_type  row_length_1 = cols->row_length(row) - 1;
-      number          *val_ptr      = &val[cols->rowstart[row]];
+      const std::size_t row_start    = cols->rowstart[row];
+      const size_type   row_length_1 = cols->row_length(row) - 1;
+      number           *val_ptr      = &val[row_start];
+      const auto this_cols = [&](const size_type index) -> size_type {
+        return cols->column_index(row, row_start + index);
+      };
 
       if (m() == n())
         {
           // find diagonal and add it if found
-          Assert(this_cols[0] == row, ExcInternalError());
+          Assert(this_cols(0) == row, ExcInternalError());
           const size_type *diag_pos =
             Utilities::lower_bound(col_indices, col_indices + n_cols, row);
           const size_type diag      = diag_pos - col_indices;
@@ -544,18 +614,18 @@ SparseMatrix<number>::add(const size_type  row,
 
           // Add indices before diagonal. Because the input array
           // is sorted, and because the entries in this matrix row
-          // are sorted, we can just linearly walk the colnums array
+          // are sorted, we can just linearly walk the column indices
           // and the input array in parallel, stopping whenever the
           // former matches the column index of the next index in
           // the input array:
           size_type counter = 1;
           for (size_type i = 0; i < diag; ++i)
             {
-              while (this_cols[counter] < col_indices[i] &&
+              while (this_cols(counter) < col_indices[i] &&
                      counter < row_length_1)
                 ++counter;
 
-              Assert((this_cols[counter] == col_indices[i]) ||
+              Assert((this_cols(counter) == col_indices[i]) ||
                        (values[i] == number2()),
                      ExcInvalidIndex(row, col_indices[i]));
 
@@ -565,11 +635,11 @@ SparseMatrix<number>::add(const size_type  row,
           // Then do the same to add indices after the diagonal:
           for (size_type i = post_diag; i < n_cols; ++i)
             {
-              while (this_cols[counter] < col_indices[i] &&
+              while (this_cols(counter) < col_indices[i] &&
                      counter < row_length_1)
                 ++counter;
 
-              Assert((this_cols[counter] == col_indices[i]) ||
+              Assert((this_cols(counter) == col_indices[i]) ||
                        (values[i] == number2()),
                      ExcInvalidIndex(row, col_indices[i]));
 
@@ -588,11 +658,11 @@ SparseMatrix<number>::add(const size_type  row,
           size_type counter = 0;
           for (size_type i = 0; i < n_cols; ++i)
             {
-              while (this_cols[counter] < col_indices[i] &&
+              while (this_cols(counter) < col_indices[i] &&
                      counter < row_length_1)
                 ++counter;
 
-              Assert((this_cols[counter] == col_indices[i]) ||
+              Assert((this_cols(counter) == col_indices[i]) ||
                        (values[i] == number2()),
                      ExcInvalidIndex(row, col_indices[i]));
 
@@ -608,9 +678,8 @@ SparseMatrix<number>::add(const size_type  row,
   // unsorted case: first, search all the
   // indices to find out which values we
   // actually need to add.
-  const size_type *const my_cols        = cols->colnums.get();
-  size_type              index          = cols->rowstart[row];
-  const size_type        next_row_index = cols->rowstart[row + 1];
+  size_type       index          = cols->rowstart[row];
+  const size_type next_row_index = cols->rowstart[row + 1];
 
   for (size_type j = 0; j < n_cols; ++j)
     {
@@ -632,7 +701,8 @@ SparseMatrix<number>::add(const size_type  row,
       // the next present index in the sparsity
       // pattern (otherwise, do a binary
       // search)
-      if (index < next_row_index && my_cols[index] == col_indices[j])
+      if (index < next_row_index &&
+          cols->column_index(row, index) == col_indices[j])
         goto add_value;
 
       index = cols->operator()(row, col_indices[j]);
@@ -670,7 +740,6 @@ SparseMatrix<number>::set(const size_type  row,
   // First, search all the indices to find
   // out which values we actually need to
   // set.
-  const size_type  *my_cols = cols->colnums.get();
   std::size_t       index = cols->rowstart[row], next_index = index;
   const std::size_t next_row_index = cols->rowstart[row + 1];
 
@@ -688,7 +757,8 @@ SparseMatrix<number>::set(const size_type  row,
           // the next present index in the sparsity
           // pattern (otherwise, do a binary
           // search)
-          if (index != next_row_index && my_cols[index] == col_indices[j])
+          if (index != next_row_index &&
+              cols->column_index(row, index) == col_indices[j])
             goto set_value;
 
           next_index = cols->operator()(row, col_indices[j]);
@@ -717,7 +787,8 @@ SparseMatrix<number>::set(const size_type  row,
           const number value = number(values[j]);
           AssertIsFinite(value);
 
-          if (index != next_row_index && my_cols[index] == col_indices[j])
+          if (index != next_row_index &&
+              cols->column_index(row, index) == col_indices[j])
             goto set_value_checked;
 
           next_index = cols->operator()(row, col_indices[j]);
@@ -759,7 +830,7 @@ SparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
         end_row,
         val.get(),
         cols->rowstart.get(),
-        cols->colnums.get(),
+        *cols,
         src,
         dst,
         false);
@@ -769,6 +840,91 @@ SparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
 
 
 
+template <typename number>
+template <class BlockVectorType>
+void
+SparseMatrix<number>::vmult_blockwise(BlockVectorType       &dst,
+                                      const BlockVectorType &src) const
+{
+  Assert(cols != nullptr, ExcNeedsSparsityPattern());
+  Assert(val != nullptr, ExcNotInitialized());
+  Assert(dst.n_blocks() == src.n_blocks(),
+         ExcDimensionMismatch(dst.n_blocks(), src.n_blocks()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  using Number = typename BlockVectorType::value_type;
+  std::vector<const Number *> src_pointers(src.n_blocks());
+  std::vector<Number *>       dst_pointers(dst.n_blocks());
+  for (unsigned int b = 0; b < src.n_blocks(); ++b)
+    {
+      Assert(m() == dst.block(b).size(),
+             ExcDimensionMismatch(m(), dst.block(b).size()));
+      Assert(n() == src.block(b).size(),
+             ExcDimensionMismatch(n(), src.block(b).size()));
+      src_pointers[b] = src.block(b).begin();
+      dst_pointers[b] = dst.block(b).begin();
+    }
+
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    [&](const size_type begin_row, const size_type end_row) {
+      internal::SparseMatrixImplementation::vmult_blockwise_on_subrange(
+        begin_row,
+        end_row,
+        val.get(),
+        cols->rowstart.get(),
+        *cols,
+        src.n_blocks(),
+        src_pointers.data(),
+        dst_pointers.data());
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+bool
+SparseMatrix<number>::Tvmult_in_parallel() const
+{
+  return cols->has_column_index_map() && MultithreadInfo::n_threads() > 1 &&
+         n() > internal::SparseMatrixImplementation::minimum_parallel_grain_size;
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrix<number>::Tvmult_on_columns(OutVector      &dst,
+                                        const InVector &src,
+                                        const bool      add) const
+{
+  Assert(cols->has_column_index_map(), ExcInternalError());
+
+  parallel::apply_to_subranges(
+    0U,
+    n(),
+    [this, &src, &dst, add](const size_type begin_column,
+                            const size_type end_column) {
+      internal::SparseMatrixImplementation::Tvmult_on_subrange(
+        begin_column,
+        end_column,
+        val.get(),
+        cols->column_start.get(),
+        cols->column_positions.get(),
+        cols->column_rows.get(),
+        src,
+        dst,
+        add);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
 template <typename number>
 template <class OutVector, class InVector>
 void
@@ -781,17 +937,24 @@ SparseMatrix<number>::Tvmult(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
+  if (Tvmult_in_parallel())
+    {
+      Tvmult_on_columns(dst, src, false);
+      return;
+    }
+
   dst = 0;
 
   for (size_type i = 0; i < m(); ++i)
-    {
-      for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
-        {
-          const size_type p = cols->colnums[j];
-          dst(p) += typename OutVector::value_type(val[j]) *
-                    typename OutVector::value_type(src(i));
-        }
-    }
+    internal::SparsityPatternTools::for_each_entry_in_row(
+      *cols,
+      i,
+      cols->rowstart[i],
+      cols->rowstart[i + 1],
+      [&](const std::size_t j, const size_type p) {
+        dst(p) += typename OutVector::value_type(val[j]) *
+                  typename OutVector::value_type(src(i));
+      });
 }
 
 
@@ -817,7 +980,7 @@ SparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
         end_row,
         val.get(),
         cols->rowstart.get(),
-        cols->colnums.get(),
+        *cols,
         src,
         dst,
         true);
@@ -839,13 +1002,22 @@ SparseMatrix<number>::Tvmult_add(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
+  if (Tvmult_in_parallel())
+    {
+      Tvmult_on_columns(dst, src, true);
+      return;
+    }
+
   for (size_type i = 0; i < m(); ++i)
-    for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
-      {
-        const size_type p = cols->colnums[j];
+    internal::SparsityPatternTools::for_each_entry_in_row(
+      *cols,
+      i,
+      cols->rowstart[i],
+      cols->rowstart[i + 1],
+      [&](const std::size_t j, const size_type p) {
         dst(p) += typename OutVector::value_type(val[j]) *
                   typename OutVector::value_type(src(i));
-      }
+      });
 }
 
 
@@ -863,20 +1035,26 @@ namespace internal
      */
     template <typename number, typename InVector>
     typename InVector::value_type
-    matrix_norm_sqr_on_subrange(const size_type    begin_row,
-                                const size_type    end_row,
-                                const number      *values,
-                                const std::size_t *rowstart,
-                                const size_type   *colnums,
-                                const InVector    &v)
+    matrix_norm_sqr_on_subrange(const size_type        begin_row,
+                                const size_type        end_row,
+                                const number          *values,
+                                const std::size_t     *rowstart,
+                                const SparsityPattern &sparsity,
+                                const InVector        &v)
     {
       typename InVector::value_type norm_sqr = 0.;
 
       for (size_type i = begin_row; i < end_row; ++i)
         {
           typename InVector::value_type s = 0;
-          for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-            s += typename InVector::value_type(values[j]) * v(colnums[j]);
+          internal::SparsityPatternTools::for_each_entry_in_row(
+            sparsity,
+            i,
+            rowstart[i],
+            rowstart[i + 1],
+            [&](const std::size_t j, const size_type column) {
+              s += typename InVector::value_type(values[j]) * v(column);
+            });
           norm_sqr +=
             v(i) *
             numbers::NumberTraits<typename InVector::value_type>::conjugate(s);
@@ -905,7 +1083,7 @@ SparseMatrix<number>::matrix_norm_square(const Vector<somenumber> &v) const
         end_row,
         val.get(),
         cols->rowstart.get(),
-        cols->colnums.get(),
+        *cols,
         v);
     },
     0,
@@ -929,21 +1107,27 @@ namespace internal
      */
     template <typename number, typename InVector>
     typename InVector::value_type
-    matrix_scalar_product_on_subrange(const size_type    begin_row,
-                                      const size_type    end_row,
-                                      const number      *values,
-                                      const std::size_t *rowstart,
-                                      const size_type   *colnums,
-                                      const InVector    &u,
-                                      const InVector    &v)
+    matrix_scalar_product_on_subrange(const size_type        begin_row,
+                                      const size_type        end_row,
+                                      const number          *values,
+                                      const std::size_t     *rowstart,
+                                      const SparsityPattern &sparsity,
+                                      const InVector        &u,
+                                      const InVector        &v)
     {
       typename InVector::value_type norm_sqr = 0.;
 
       for (size_type i = begin_row; i < end_row; ++i)
         {
           typename InVector::value_type s = 0;
-          for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-            s += typename InVector::value_type(values[j]) * v(colnums[j]);
+          internal::SparsityPatternTools::for_each_entry_in_row(
+            sparsity,
+            i,
+            rowstart[i],
+            rowstart[i + 1],
+            [&](const std::size_t j, const size_type column) {
+              s += typename InVector::value_type(values[j]) * v(column);
+            });
           norm_sqr +=
             u(i) *
             numbers::NumberTraits<typename InVector::value_type>::conjugate(s);
@@ -973,7 +1157,7 @@ SparseMatrix<number>::matrix_scalar_product(const Vector<somenumber> &u,
                                           end_row,
                                           val.get(),
                                           cols->rowstart.get(),
-                                          cols->colnums.get(),
+                                          *cols,
                                           u,
                                           v);
     },
@@ -984,31 +1168,283 @@ SparseMatrix<number>::matrix_scalar_product(const Vector<somenumber> &u,
 
 
 
+namespace internal
+{
+  namespace SparseMatrixImplementation
+  {
+    /**
+     * Compute the transpose of a matrix with @p n_rows rows and @p n_cols
+     * columns given by its sparsity pattern and its @p values. The
+     * transpose is returned in compressed row storage, with the entries of
+     * each row sorted by their column index.
+     */
+    template <typename number>
+    void
+    transpose_compressed_rows(const size_type           n_rows,
+                              const size_type           n_cols,
+                              const std::size_t        *rowstart,
+                              const SparsityPattern    &sparsity,
+                              const number             *values,
+                              std::vector<std::size_t> &transpose_rowstart,
+                              std::vector<size_type>   &transpose_colnums,
+                              std::vector<number>      &transpose_values)
+    {
+      transpose_rowstart.assign(n_cols + 1, 0);
+      for (size_type row = 0; row < n_rows; ++row)
+        internal::SparsityPatternTools::for_each_entry_in_row(
+          sparsity,
+          row,
+          rowstart[row],
+          rowstart[row + 1],
+          [&](const std::size_t, const size_type column) {
+            ++transpose_rowstart[column + 1];
+          });
+      std::partial_sum(transpose_rowstart.begin(),
+                       transpose_rowstart.end(),
+                       transpose_rowstart.begin());
+
+      transpose_colnums.resize(transpose_rowstart[n_cols]);
+      transpose_values.resize(transpose_rowstart[n_cols]);
+      std::vector<std::size_t> next_entry(transpose_rowstart.begin(),
+                                          transpose_rowstart.end() - 1);
+      for (size_type row = 0; row < n_rows; ++row)
+        internal::SparsityPatternTools::for_each_entry_in_row(
+          sparsity,
+          row,
+          rowstart[row],
+          rowstart[row + 1],
+          [&](const std::size_t j, const size_type column) {
+            const std::size_t position  = next_entry[column]++;
+            transpose_colnums[position] = row;
+            transpose_values[position]  = values[j];
+          });
+    }
+
+
+
+    /**
+     * Count the number of entries in the rows of the product of a left and a
+     * right matrix, for the rows in the interval [begin_row, end_row), plus
+     * the diagonal entry if @p add_diagonal is set. The entries of a row of
+     * the left matrix are visited by @p for_each_left_entry as described
+     * for SparseMatrix::compute_product(), and the right matrix is given by
+     * its sparsity pattern. The array @p markers with one entry per column
+     * of the product records the last row in which a column has been seen,
+     * so it must not contain any of the rows of the interval on entry.
+     */
+    template <typename LeftRowFunction>
+    inline void
+    count_product_row_lengths(const size_type         begin_row,
+                              const size_type         end_row,
+                              const LeftRowFunction  &for_each_left_entry,
+                              const std::size_t      *right_rowstart,
+                              const SparsityPattern  &right_sparsity,
+                              const bool              add_diagonal,
+                              std::vector<size_type> &markers,
+                              unsigned int           *row_lengths)
+    {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          unsigned int row_length = 0;
+          if (add_diagonal)
+            {
+              markers[row] = row;
+              ++row_length;
+            }
+          for_each_left_entry(
+            row, [&](const std::size_t, const size_type inner) {
+              internal::SparsityPatternTools::for_each_entry_in_row(
+                right_sparsity,
+                inner,
+                right_rowstart[inner],
+                right_rowstart[inner + 1],
+                [&](const std::size_t, const size_type column) {
+                  if (markers[column] != row)
+                    {
+                      markers[column] = row;
+                      ++row_length;
+                    }
+                });
+            });
+          row_lengths[row] = row_length;
+        }
+    }
+
+
+
+    /**
+     * Fill in the column indices of the rows in the interval
+     * [begin_row, end_row) of the product of a left and a right matrix,
+     * given as for count_product_row_lengths(), in the space reserved by
+     * @p rowstart for the row lengths computed by that function. The column
+     * indices of each row are sorted, except for the diagonal, which is
+     * stored first if @p add_diagonal is set, as in any SparsityPattern of a
+     * square matrix.
+     */
+    template <typename LeftRowFunction>
+    inline void
+    fill_product_colnums(const size_type         begin_row,
+                         const size_type         end_row,
+                         const LeftRowFunction  &for_each_left_entry,
+                         const std::size_t      *right_rowstart,
+                         const SparsityPattern  &right_sparsity,
+                         const bool              add_diagonal,
+                         std::vector<size_type> &markers,
+                         const std::size_t      *rowstart,
+                         size_type              *colnums)
+    {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          size_type *const row_begin = colnums + rowstart[row];
+          size_type       *next      = row_begin;
+          if (add_diagonal)
+            {
+              markers[row] = row;
+              *next++      = row;
+            }
+          for_each_left_entry(
+            row, [&](const std::size_t, const size_type inner) {
+              internal::SparsityPatternTools::for_each_entry_in_row(
+                right_sparsity,
+                inner,
+                right_rowstart[inner],
+                right_rowstart[inner + 1],
+                [&](const std::size_t, const size_type column) {
+                  if (markers[column] != row)
+                    {
+                      markers[column] = row;
+                      *next++         = column;
+                    }
+                });
+            });
+          AssertDimension(next - row_begin,
+                          rowstart[row + 1] - rowstart[row]);
+          std::sort(row_begin + (add_diagonal ? 1 : 0), next);
+        }
+    }
+
+
+
+    /**
+     * Add the rows in the interval [begin_row, end_row) of the product of a
+     * left and a right matrix, given as for count_product_row_lengths()
+     * together with their values, to the entries @p values of a matrix with
+     * the given @p sparsity pattern. Row $k$ of the right matrix is scaled by
+     * <tt>scaling[k]</tt> unless @p scaling is a null pointer. The array
+     * @p positions with one entry per column of the product is used to look
+     * up the position of a column in the current row. Since entries that do
+     * not point into the current row are ignored, it only needs to be
+     * initialized once with invalid positions, not for every row.
+     */
+    template <typename numberL,
+              typename numberR,
+              typename numberC,
+              typename LeftRowFunction>
+    void
+    compute_product_values(const size_type           begin_row,
+                           const size_type           end_row,
+                           const LeftRowFunction    &for_each_left_entry,
+                           const numberL            *left_values,
+                           const numberL            *scaling,
+                           const std::size_t        *right_rowstart,
+                           const SparsityPattern    &right_sparsity,
+                           const numberR            *right_values,
+                           const std::size_t        *rowstart,
+                           const SparsityPattern    &sparsity,
+                           numberC                  *values,
+                           std::vector<std::size_t> &positions)
+    {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          internal::SparsityPatternTools::for_each_entry_in_row(
+            sparsity,
+            row,
+            rowstart[row],
+            rowstart[row + 1],
+            [&](const std::size_t p, const size_type column) {
+              positions[column] = p;
+            });
+
+          for_each_left_entry(
+            row, [&](const std::size_t k, const size_type inner) {
+              const numberC left_value = numberC(left_values[k]);
+              const numberC scale =
+                numberC(scaling != nullptr ? scaling[inner] : numberL(1));
+              internal::SparsityPatternTools::for_each_entry_in_row(
+                right_sparsity,
+                inner,
+                right_rowstart[inner],
+                right_rowstart[inner + 1],
+                [&](const std::size_t j, const size_type column) {
+                  const numberC product =
+                    left_value * numberC(right_values[j]) * scale;
+                  const std::size_t p = positions[column];
+
+                  // the entry might not exist in the sparsity pattern if it
+                  // has not been rebuilt, which is only allowed if the
+                  // product is zero
+                  if (p < rowstart[row] || p >= rowstart[row + 1])
+                    {
+                      Assert(product == numberC(),
+                             (typename SparseMatrix<numberC>::ExcInvalidIndex(
+                               row, column)));
+                      return;
+                    }
+                  values[p] += product;
+                });
+            });
+        }
+    }
+
+
+
+    /**
+     * Call <code>f(k, column)</code> for the entries of row @p row of a
+     * matrix given in compressed row storage by @p rowstart and
+     * @p colnums, where @p k is the position of the entry. This is the
+     * function that visits the entries of a transposed left matrix in
+     * SparseMatrix::compute_product().
+     */
+    template <typename Function>
+    inline void
+    for_each_entry_in_compressed_row(const std::vector<std::size_t> &rowstart,
+                                     const std::vector<size_type>   &colnums,
+                                     const size_type                 row,
+                                     const Function                 &f)
+    {
+      for (std::size_t k = rowstart[row]; k < rowstart[row + 1]; ++k)
+        f(k, colnums[k]);
+    }
+  } // namespace SparseMatrixImplementation
+} // namespace internal
+
+
+
 template <typename number>
-template <typename numberB, typename numberC>
+template <typename numberL,
+          typename numberB,
+          typename numberC,
+          typename LeftRowFunction>
 void
-SparseMatrix<number>::mmult(SparseMatrix<numberC>       &C,
-                            const SparseMatrix<numberB> &B,
-                            const Vector<number>        &V,
-                            const bool rebuild_sparsity_C) const
+SparseMatrix<number>::compute_product(
+  SparseMatrix<numberC>       &C,
+  const size_type              n_left_rows,
+  const LeftRowFunction       &for_each_left_entry,
+  const numberL               *left_values,
+  const numberL               *scaling,
+  const SparseMatrix<numberB> &B,
+  const bool                   rebuild_sparsity_pattern)
 {
-  const bool use_vector = V.size() == n() ? true : false;
-  Assert(n() == B.m(), ExcDimensionMismatch(n(), B.m()));
-  Assert(cols != nullptr, ExcNeedsSparsityPattern());
   Assert(B.cols != nullptr, ExcNeedsSparsityPattern());
   Assert(C.cols != nullptr, ExcNeedsSparsityPattern());
 
-  const SparsityPattern &sp_A = *cols;
-  const SparsityPattern &sp_B = *B.cols;
+  const SparsityPattern &sp_B   = *B.cols;
+  const size_type        n_cols = sp_B.n_cols();
 
-  // clear previous content of C
-  if (rebuild_sparsity_C == true)
+  if (rebuild_sparsity_pattern == true)
     {
       // we are about to change the sparsity pattern of C. this can not work
-      // if either A or B use the same sparsity pattern
-      Assert(&C.get_sparsity_pattern() != &this->get_sparsity_pattern(),
-             ExcMessage("Can't use the same sparsity pattern for "
-                        "different matrices if it is to be rebuilt."));
+      // if B uses the same sparsity pattern
       Assert(&C.get_sparsity_pattern() != &B.get_sparsity_pattern(),
              ExcMessage("Can't use the same sparsity pattern for "
                         "different matrices if it is to be rebuilt."));
@@ -1019,73 +1455,132 @@ SparseMatrix<number>::mmult(SparseMatrix<numberC>       &C,
       C.clear();
       sp_C.reinit(0, 0, 0);
 
-      // create a sparsity pattern for the matrix C.
+      // the symbolic phase: count the number of entries in each row of the
+      // product, which allows to allocate the sparsity pattern with the
+      // exact row lengths, and then fill in the column indices. each thread
+      // marks the columns it has already seen in the current row in its own
+      // array
+      const bool add_diagonal = (n_left_rows == n_cols);
+      std::vector<unsigned int> row_lengths(n_left_rows);
       {
-        DynamicSparsityPattern dsp;
-        dsp.compute_mmult_pattern(sp_A, sp_B);
-        sp_C.copy_from(dsp);
+        Threads::ThreadLocalStorage<std::vector<size_type>> markers(
+          std::vector<size_type>(n_cols, numbers::invalid_dof_index));
+        parallel::apply_to_subranges(
+          0U,
+          n_left_rows,
+          [&](const size_type begin_row, const size_type end_row) {
+            internal::SparseMatrixImplementation::count_product_row_lengths(
+              begin_row,
+              end_row,
+              for_each_left_entry,
+              sp_B.rowstart.get(),
+              sp_B,
+              add_diagonal,
+              markers.get(),
+              row_lengths.data());
+          },
+          internal::SparseMatrixImplementation::minimum_parallel_grain_size);
       }
 
+      sp_C.reinit(n_left_rows, n_cols, row_lengths);
+      if (n_left_rows > 0 && n_cols > 0)
+        {
+          Threads::ThreadLocalStorage<std::vector<size_type>> markers(
+            std::vector<size_type>(n_cols, numbers::invalid_dof_index));
+          parallel::apply_to_subranges(
+            0U,
+            n_left_rows,
+            [&](const size_type begin_row, const size_type end_row) {
+              internal::SparseMatrixImplementation::fill_product_colnums(
+                begin_row,
+                end_row,
+                for_each_left_entry,
+                sp_B.rowstart.get(),
+                sp_B,
+                add_diagonal,
+                markers.get(),
+                sp_C.rowstart.get(),
+                sp_C.colnums.get());
+            },
+            internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+          // all rows have been filled with sorted entries, so the pattern is
+          // already in the state compress() would bring it to
+          sp_C.compressed = true;
+        }
+      else
+        sp_C.compress();
+
       // reinit matrix C from that information
       C.reinit(sp_C);
     }
 
-  Assert(C.m() == m(), ExcDimensionMismatch(C.m(), m()));
-  Assert(C.n() == B.n(), ExcDimensionMismatch(C.n(), B.n()));
-
-  // create an array that caches some
-  // elements that are going to be written
-  // into the new matrix.
-  unsigned int max_n_cols_B = 0;
-  for (size_type i = 0; i < B.m(); ++i)
-    max_n_cols_B = std::max(max_n_cols_B, sp_B.row_length(i));
-  std::vector<numberC> new_entries(max_n_cols_B);
-
-  // now compute the actual entries: a matrix-matrix product involves three
-  // nested loops. One over the rows of A, for each row we then loop over all
-  // the columns, and then we need to multiply each element with all the
-  // elements in that row in B.
-  for (size_type i = 0; i < C.m(); ++i)
-    {
-      const size_type       *rows     = &sp_A.colnums[sp_A.rowstart[i]];
-      const size_type *const end_rows = &sp_A.colnums[sp_A.rowstart[i + 1]];
-      for (; rows != end_rows; ++rows)
-        {
-          const number     A_val = val[rows - &sp_A.colnums[sp_A.rowstart[0]]];
-          const size_type  col   = *rows;
-          const size_type *new_cols = (&sp_B.colnums[sp_B.rowstart[col]]);
+  Assert(C.m() == n_left_rows, ExcDimensionMismatch(C.m(), n_left_rows));
+  Assert(C.n() == n_cols, ExcDimensionMismatch(C.n(), n_cols));
 
-          // special treatment for diagonal
-          if (sp_B.n_rows() == sp_B.n_cols())
-            {
-              C.add(i,
-                    *new_cols,
-                    numberC(A_val) *
-                      numberC(
-                        B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]]) *
-                      numberC(use_vector ? V(col) : 1));
-              ++new_cols;
-            }
+  if (n_left_rows == 0 || n_cols == 0)
+    return;
 
-          // now the innermost loop that goes over all the elements in row
-          // 'col' of matrix B. Cache the elements, and then write them into C
-          // at once
-          numberC       *new_ptr = new_entries.data();
-          const numberB *B_val_ptr =
-            &B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]];
-          const numberB *const end_cols = &B.val[sp_B.rowstart[col + 1]];
-          for (; B_val_ptr != end_cols; ++B_val_ptr)
-            *new_ptr++ = numberC(A_val) * numberC(*B_val_ptr) *
-                         numberC(use_vector ? V(col) : 1);
-
-          C.add(i,
-                new_ptr - new_entries.data(),
-                new_cols,
-                new_entries.data(),
-                false,
-                true);
-        }
-    }
+  // the numerical phase: add the products of each row of the left matrix
+  // with the rows of B to the entries of C
+  const SparsityPattern &sp_C = *C.cols;
+  Threads::ThreadLocalStorage<std::vector<std::size_t>> positions(
+    std::vector<std::size_t>(n_cols,
+                             std::numeric_limits<std::size_t>::max()));
+  parallel::apply_to_subranges(
+    0U,
+    n_left_rows,
+    [&](const size_type begin_row, const size_type end_row) {
+      internal::SparseMatrixImplementation::compute_product_values(
+        begin_row,
+        end_row,
+        for_each_left_entry,
+        left_values,
+        scaling,
+        sp_B.rowstart.get(),
+        sp_B,
+        B.val.get(),
+        sp_C.rowstart.get(),
+        sp_C,
+        C.val.get(),
+        positions.get());
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename numberB, typename numberC>
+void
+SparseMatrix<number>::mmult(SparseMatrix<numberC>       &C,
+                            const SparseMatrix<numberB> &B,
+                            const Vector<number>        &V,
+                            const bool rebuild_sparsity_C) const
+{
+  const bool use_vector = V.size() == n() ? true : false;
+  Assert(n() == B.m(), ExcDimensionMismatch(n(), B.m()));
+  Assert(cols != nullptr, ExcNeedsSparsityPattern());
+
+  // we are about to change the sparsity pattern of C. this can not work if A
+  // uses the same sparsity pattern
+  Assert(rebuild_sparsity_C == false ||
+           &C.get_sparsity_pattern() != &this->get_sparsity_pattern(),
+         ExcMessage("Can't use the same sparsity pattern for "
+                    "different matrices if it is to be rebuilt."));
+
+  // the rows of C are the products of the rows of A with B
+  compute_product(
+    C,
+    m(),
+    [this](const size_type row, const auto &f) {
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols, row, cols->rowstart[row], cols->rowstart[row + 1], f);
+    },
+    val.get(),
+    use_vector ? V.begin() : nullptr,
+    B,
+    rebuild_sparsity_C);
 }
 
 
@@ -1101,98 +1596,103 @@ SparseMatrix<number>::Tmmult(SparseMatrix<numberC>       &C,
   const bool use_vector = V.size() == m() ? true : false;
   Assert(m() == B.m(), ExcDimensionMismatch(m(), B.m()));
   Assert(cols != nullptr, ExcNeedsSparsityPattern());
-  Assert(B.cols != nullptr, ExcNeedsSparsityPattern());
-  Assert(C.cols != nullptr, ExcNeedsSparsityPattern());
-
-  const SparsityPattern &sp_A = *cols;
-  const SparsityPattern &sp_B = *B.cols;
-
-  // clear previous content of C
-  if (rebuild_sparsity_C == true)
-    {
-      // we are about to change the sparsity pattern of C. this can not work
-      // if either A or B use the same sparsity pattern
-      Assert(&C.get_sparsity_pattern() != &this->get_sparsity_pattern(),
-             ExcMessage("Can't use the same sparsity pattern for "
-                        "different matrices if it is to be rebuilt."));
-      Assert(&C.get_sparsity_pattern() != &B.get_sparsity_pattern(),
-             ExcMessage("Can't use the same sparsity pattern for "
-                        "different matrices if it is to be rebuilt."));
-
-      // need to change the sparsity pattern of C, so cast away const-ness.
-      SparsityPattern &sp_C =
-        *(const_cast<SparsityPattern *>(&C.get_sparsity_pattern()));
-      C.clear();
-      sp_C.reinit(0, 0, 0);
-
-      // create a sparsity pattern for the matrix.
-      {
-        DynamicSparsityPattern dsp;
-        dsp.compute_Tmmult_pattern(sp_A, sp_B);
-        sp_C.copy_from(dsp);
-      }
 
-      // reinit matrix C from that information
-      C.reinit(sp_C);
-    }
+  // we are about to change the sparsity pattern of C. this can not work if A
+  // uses the same sparsity pattern
+  Assert(rebuild_sparsity_C == false ||
+           &C.get_sparsity_pattern() != &this->get_sparsity_pattern(),
+         ExcMessage("Can't use the same sparsity pattern for "
+                    "different matrices if it is to be rebuilt."));
+
+  // the rows of C are the products of the rows of the transpose of A with
+  // B, so set up the transpose first. Its entries are ordered by their
+  // column, which adds the contributions to each entry of C in the same
+  // order as mmult()
+  std::vector<std::size_t> transpose_rowstart;
+  std::vector<size_type>   transpose_colnums;
+  std::vector<number>      transpose_values;
+  internal::SparseMatrixImplementation::transpose_compressed_rows(
+    m(),
+    n(),
+    cols->rowstart.get(),
+    *cols,
+    val.get(),
+    transpose_rowstart,
+    transpose_colnums,
+    transpose_values);
+
+  compute_product(
+    C,
+    n(),
+    [&](const size_type row, const auto &f) {
+      internal::SparseMatrixImplementation::for_each_entry_in_compressed_row(
+        transpose_rowstart, transpose_colnums, row, f);
+    },
+    transpose_values.data(),
+    use_vector ? V.begin() : nullptr,
+    B,
+    rebuild_sparsity_C);
+}
 
-  Assert(C.m() == n(), ExcDimensionMismatch(C.m(), n()));
-  Assert(C.n() == B.n(), ExcDimensionMismatch(C.n(), B.n()));
-
-  // create an array that caches some
-  // elements that are going to be written
-  // into the new matrix.
-  unsigned int max_n_cols_B = 0;
-  for (size_type i = 0; i < B.m(); ++i)
-    max_n_cols_B = std::max(max_n_cols_B, sp_B.row_length(i));
-  std::vector<numberC> new_entries(max_n_cols_B);
-
-  // now compute the actual entries: a matrix-matrix product involves three
-  // nested loops. One over the rows of A, for each row we then loop over all
-  // the columns, and then we need to multiply each element with all the
-  // elements in that row in B.
-  for (size_type i = 0; i < m(); ++i)
-    {
-      const size_type       *rows     = &sp_A.colnums[sp_A.rowstart[i]];
-      const size_type *const end_rows = &sp_A.colnums[sp_A.rowstart[i + 1]];
-      const size_type       *new_cols = &sp_B.colnums[sp_B.rowstart[i]];
-      if (sp_B.n_rows() == sp_B.n_cols())
-        ++new_cols;
 
-      const numberB *const end_cols = &B.val[sp_B.rowstart[i + 1]];
 
-      for (; rows != end_rows; ++rows)
-        {
-          const size_type row   = *rows;
-          const number    A_val = val[rows - &sp_A.colnums[sp_A.rowstart[0]]];
-
-          // special treatment for diagonal
-          if (sp_B.n_rows() == sp_B.n_cols())
-            C.add(row,
-                  i,
-                  numberC(A_val) *
-                    numberC(
-                      B.val[new_cols - 1 - &sp_B.colnums[sp_B.rowstart[0]]]) *
-                    numberC(use_vector ? V(i) : 1));
-
-          // now the innermost loop that goes over all the elements in row
-          // 'col' of matrix B. Cache the elements, and then write them into C
-          // at once
-          numberC       *new_ptr = new_entries.data();
-          const numberB *B_val_ptr =
-            &B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]];
-          for (; B_val_ptr != end_cols; ++B_val_ptr)
-            *new_ptr++ = numberC(A_val) * numberC(*B_val_ptr) *
-                         numberC(use_vector ? V(i) : 1);
-
-          C.add(row,
-                new_ptr - new_entries.data(),
-                new_cols,
-                new_entries.data(),
-                false,
-                true);
-        }
-    }
+template <typename number>
+template <typename numberP, typename numberC>
+void
+SparseMatrix<number>::PtAP(SparseMatrix<numberC>       &C,
+                           const SparseMatrix<numberP> &P,
+                           const bool rebuild_sparsity_pattern) const
+{
+  Assert(n() == P.m(), ExcDimensionMismatch(n(), P.m()));
+  Assert(m() == P.m(), ExcDimensionMismatch(m(), P.m()));
+  Assert(cols != nullptr, ExcNeedsSparsityPattern());
+  Assert(P.cols != nullptr, ExcNeedsSparsityPattern());
+  Assert(rebuild_sparsity_pattern == false ||
+           (&C.get_sparsity_pattern() != &this->get_sparsity_pattern() &&
+            &C.get_sparsity_pattern() != &P.get_sparsity_pattern()),
+         ExcMessage("Can't use the same sparsity pattern for "
+                    "different matrices if it is to be rebuilt."));
+
+  // first the product AP = A * P
+  SparsityPattern       sparsity_AP;
+  SparseMatrix<numberC> AP(sparsity_AP);
+  compute_product(
+    AP,
+    m(),
+    [this](const size_type row, const auto &f) {
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols, row, cols->rowstart[row], cols->rowstart[row + 1], f);
+    },
+    val.get(),
+    static_cast<const number *>(nullptr),
+    P,
+    true);
+
+  // then C = P^T * AP, with the rows of P^T
+  std::vector<std::size_t> transpose_rowstart;
+  std::vector<size_type>   transpose_colnums;
+  std::vector<numberP>     transpose_values;
+  internal::SparseMatrixImplementation::transpose_compressed_rows(
+    P.m(),
+    P.n(),
+    P.cols->rowstart.get(),
+    *P.cols,
+    P.val.get(),
+    transpose_rowstart,
+    transpose_colnums,
+    transpose_values);
+
+  compute_product(
+    C,
+    P.n(),
+    [&](const size_type row, const auto &f) {
+      internal::SparseMatrixImplementation::for_each_entry_in_compressed_row(
+        transpose_rowstart, transpose_colnums, row, f);
+    },
+    transpose_values.data(),
+    static_cast<const numberP *>(nullptr),
+    AP,
+    rebuild_sparsity_pattern);
 }
 
 
@@ -1207,9 +1707,14 @@ SparseMatrix<number>::l1_norm() const
   Vector<real_type> column_sums(n());
   const size_type   n_rows = m();
   for (size_type row = 0; row < n_rows; ++row)
-    for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-      column_sums(cols->colnums[j]) +=
-        numbers::NumberTraits<number>::abs(val[j]);
+    internal::SparsityPatternTools::for_each_entry_in_row(
+      *cols,
+      row,
+      cols->rowstart[row],
+      cols->rowstart[row + 1],
+      [&](const std::size_t j, const size_type column) {
+        column_sums(column) += numbers::NumberTraits<number>::abs(val[j]);
+      });
 
   return column_sums.linfty_norm();
 }
@@ -1273,22 +1778,28 @@ namespace internal
      */
     template <typename number, typename InVector, typename OutVector>
     typename OutVector::value_type
-    residual_sqr_on_subrange(const size_type    begin_row,
-                             const size_type    end_row,
-                             const number      *values,
-                             const std::size_t *rowstart,
-                             const size_type   *colnums,
-                             const InVector    &u,
-                             const InVector    &b,
-                             OutVector         &dst)
+    residual_sqr_on_subrange(const size_type        begin_row,
+                             const size_type        end_row,
+                             const number          *values,
+                             const std::size_t     *rowstart,
+                             const SparsityPattern &sparsity,
+                             const InVector        &u,
+                             const InVector        &b,
+                             OutVector             &dst)
     {
       typename OutVector::value_type norm_sqr = 0.;
 
       for (size_type i = begin_row; i < end_row; ++i)
         {
           typename OutVector::value_type s = b(i);
-          for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-            s -= typename OutVector::value_type(values[j]) * u(colnums[j]);
+          internal::SparsityPatternTools::for_each_entry_in_row(
+            sparsity,
+            i,
+            rowstart[i],
+            rowstart[i + 1],
+            [&](const std::size_t j, const size_type column) {
+              s -= typename OutVector::value_type(values[j]) * u(column);
+            });
           dst(i) = s;
           norm_sqr +=
             s *
@@ -1322,7 +1833,7 @@ SparseMatrix<number>::residual(Vector<somenumber>       &dst,
         end_row,
         val.get(),
         cols->rowstart.get(),
-        cols->colnums.get(),
+        *cols,
         u,
         b,
         dst);
@@ -1454,15 +1965,19 @@ SparseMatrix<number>::precondition_SSOR(
             pos_right_of_diagonal[row];
           Assert(first_right_of_diagonal_index <= *(rowstart_ptr + 1),
                  ExcInternalError());
-          number s = 0;
-          for (size_type j = (*rowstart_ptr) + 1;
-               j < first_right_of_diagonal_index;
-               ++j)
-            s += val[j] * number(dst(cols->colnums[j]));
+          somenumber s = 0;
+          internal::SparsityPatternTools::for_each_entry_in_row(
+            *cols,
+            row,
+            (*rowstart_ptr) + 1,
+            first_right_of_diagonal_index,
+            [&](const std::size_t j, const size_type column) {
+              s += somenumber(val[j]) * dst(column);
+            });
 
           // divide by diagonal element
-          *dst_ptr -= s * omega;
-          *dst_ptr /= val[*rowstart_ptr];
+          *dst_ptr -= s * somenumber(omega);
+          *dst_ptr /= somenumber(val[*rowstart_ptr]);
         }
 
       rowstart_ptr = cols->rowstart.get();
@@ -1479,16 +1994,26 @@ SparseMatrix<number>::precondition_SSOR(
           const size_type end_row = *(rowstart_ptr + 1);
           const size_type first_right_of_diagonal_index =
             pos_right_of_diagonal[row];
-          number s = 0;
+          somenumber s = 0;
           // go through the column from the end towards the diagonal in order
           // to delay the use of the newly computed "dst" values on
           // out-of-order-execution hardware
-          for (size_type j = end_row - 1; j >= first_right_of_diagonal_index;
-               --j)
-            s += val[j] * number(dst(cols->colnums[j]));
+          if (cols->has_narrow_column_indices() &&
+              cols->narrow_row_base[row] != SparsityPattern::invalid_entry)
+            {
+              const size_type base = cols->narrow_row_base[row];
+              for (size_type j = end_row - 1;
+                   j >= first_right_of_diagonal_index;
+                   --j)
+                s += somenumber(val[j]) * dst(base + cols->narrow_colnums[j]);
+            }
+          else
+            for (size_type j = end_row - 1; j >= first_right_of_diagonal_index;
+                 --j)
+              s += somenumber(val[j]) * dst(cols->column_index(row, j));
 
-          *dst_ptr -= s * omega;
-          *dst_ptr /= val[*rowstart_ptr];
+          *dst_ptr -= s * somenumber(omega);
+          *dst_ptr /= somenumber(val[*rowstart_ptr]);
         };
       return;
     }
@@ -1496,6 +2021,25 @@ SparseMatrix<number>::precondition_SSOR(
   // case when we need to get the position
   // of the first element right of the
   // diagonal manually for each sweep.
+  // note: the first entry in each
+  // line denotes the diagonal element,
+  // which we need not check, and the
+  // other ones are sorted, so we can
+  // use a bisection search
+  const auto find_first_right_of_diagonal = [this](const size_type row) {
+    std::size_t first = cols->rowstart[row] + 1;
+    std::size_t last  = cols->rowstart[row + 1];
+    while (first < last)
+      {
+        const std::size_t middle = first + (last - first) / 2;
+        if (cols->column_index(row, middle) < row)
+          first = middle + 1;
+        else
+          last = middle;
+      }
+    return first;
+  };
+
   // forward sweep
   for (size_type row = 0; row < n; ++row, ++dst_ptr, ++rowstart_ptr)
     {
@@ -1504,24 +2048,23 @@ SparseMatrix<number>::precondition_SSOR(
       // which is on the right of the diagonal.
       // we need to precondition with the
       // elements on the left only.
-      // note: the first entry in each
-      // line denotes the diagonal element,
-      // which we need not check.
       const size_type first_right_of_diagonal_index =
-        (Utilities::lower_bound(cols->colnums.get() + *rowstart_ptr + 1,
-                                cols->colnums.get() + *(rowstart_ptr + 1),
-                                row) -
-         cols->colnums.get());
+        find_first_right_of_diagonal(row);
 
-      number s = 0;
-      for (size_type j = (*rowstart_ptr) + 1; j < first_right_of_diagonal_index;
-           ++j)
-        s += val[j] * number(dst(cols->colnums[j]));
+      somenumber s = 0;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols,
+        row,
+        (*rowstart_ptr) + 1,
+        first_right_of_diagonal_index,
+        [&](const std::size_t j, const size_type column) {
+          s += somenumber(val[j]) * dst(column);
+        });
 
       // divide by diagonal element
-      *dst_ptr -= s * omega;
+      *dst_ptr -= s * somenumber(omega);
       Assert(val[*rowstart_ptr] != number(), ExcDivideByZero());
-      *dst_ptr /= val[*rowstart_ptr];
+      *dst_ptr /= somenumber(val[*rowstart_ptr]);
     };
 
   rowstart_ptr = cols->rowstart.get();
@@ -1537,16 +2080,19 @@ SparseMatrix<number>::precondition_SSOR(
     {
       const size_type end_row = *(rowstart_ptr + 1);
       const size_type first_right_of_diagonal_index =
-        (Utilities::lower_bound(&cols->colnums[*rowstart_ptr + 1],
-                                &cols->colnums[end_row],
-                                static_cast<size_type>(row)) -
-         cols->colnums.get());
-      number s = 0;
-      for (size_type j = first_right_of_diagonal_index; j < end_row; ++j)
-        s += val[j] * number(dst(cols->colnums[j]));
-      *dst_ptr -= s * omega;
+        find_first_right_of_diagonal(row);
+      somenumber s = 0;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols,
+        row,
+        first_right_of_diagonal_index,
+        end_row,
+        [&](const std::size_t j, const size_type column) {
+          s += somenumber(val[j]) * dst(column);
+        });
+      *dst_ptr -= s * somenumber(omega);
       Assert(val[*rowstart_ptr] != number(), ExcDivideByZero());
-      *dst_ptr /= val[*rowstart_ptr];
+      *dst_ptr /= somenumber(val[*rowstart_ptr]);
     };
 }
 
@@ -1596,12 +2142,15 @@ SparseMatrix<number>::SOR(Vector<somenumber> &dst, const number omega) const
   for (size_type row = 0; row < m(); ++row)
     {
       somenumber s = dst(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          const size_type col = cols->colnums[j];
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols,
+        row,
+        cols->rowstart[row],
+        cols->rowstart[row + 1],
+        [&](const std::size_t j, const size_type col) {
           if (col < row)
             s -= somenumber(val[j]) * dst(col);
-        }
+        });
 
       dst(row) = s * somenumber(omega) / somenumber(val[cols->rowstart[row]]);
     }
@@ -1624,9 +2173,15 @@ SparseMatrix<number>::TSOR(Vector<somenumber> &dst, const number omega) const
   while (true)
     {
       somenumber s = dst(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        if (cols->colnums[j] > row)
-          s -= somenumber(val[j]) * dst(cols->colnums[j]);
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols,
+        row,
+        cols->rowstart[row],
+        cols->rowstart[row + 1],
+        [&](const std::size_t j, const size_type col) {
+          if (col > row)
+            s -= somenumber(val[j]) * dst(col);
+        });
 
       dst(row) = s * somenumber(omega) / somenumber(val[cols->rowstart[row]]);
 
@@ -1665,7 +2220,7 @@ SparseMatrix<number>::PSOR(Vector<somenumber>           &dst,
 
       for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
         {
-          const size_type col = cols->colnums[j];
+          const size_type col = cols->column_index(row, j);
           if (inverse_permutation[col] < urow)
             {
               s -= somenumber(val[j]) * dst(col);
@@ -1704,7 +2259,7 @@ SparseMatrix<number>::TPSOR(Vector<somenumber>           &dst,
       somenumber      s   = dst(row);
       for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
         {
-          const size_type col = cols->colnums[j];
+          const size_type col = cols->column_index(row, j);
           if (inverse_permutation[col] > urow)
             s -= somenumber(val[j]) * dst(col);
         }
@@ -1764,10 +2319,14 @@ SparseMatrix<number>::SOR_step(Vector<somenumber>       &v,
   for (size_type row = 0; row < m(); ++row)
     {
       somenumber s = b(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          s -= somenumber(val[j]) * v(cols->colnums[j]);
-        }
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols,
+        row,
+        cols->rowstart[row],
+        cols->rowstart[row + 1],
+        [&](const std::size_t j, const size_type column) {
+          s -= somenumber(val[j]) * v(column);
+        });
       v(row) += s * somenumber(omega) / somenumber(val[cols->rowstart[row]]);
     }
 }
@@ -1792,10 +2351,14 @@ SparseMatrix<number>::TSOR_step(Vector<somenumber>       &v,
   for (int row = m() - 1; row >= 0; --row)
     {
       somenumber s = b(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          s -= somenumber(val[j]) * v(cols->colnums[j]);
-        }
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *cols,
+        row,
+        cols->rowstart[row],
+        cols->rowstart[row + 1],
+        [&](const std::size_t j, const size_type column) {
+          s -= somenumber(val[j]) * v(column);
+        });
       v(row) += s * somenumber(omega) / somenumber(val[cols->rowstart[row]]);
     }
 }
@@ -1840,7 +2403,7 @@ SparseMatrix<number>::SSOR(Vector<somenumber> &dst, const number omega) const
       s = 0.;
       for (j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
         {
-          const size_type p = cols->colnums[j];
+          const size_type p = cols->column_index(i, j);
           if (p != SparsityPattern::invalid_entry)
             {
               if (i > j)
@@ -1857,7 +2420,7 @@ SparseMatrix<number>::SSOR(Vector<somenumber> &dst, const number omega) const
       s = 0.;
       for (j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
         {
-          const size_type p = cols->colnums[j];
+          const size_type p = cols->column_index(i, j);
           if (p != SparsityPattern::invalid_entry)
             {
               if (static_cast<size_type>(i) < j)
@@ -1969,7 +2532,7 @@ SparseMatrix<number>::print_as_numpy_arrays(std::ostream      &out,
       for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
         {
           rows.push_back(i);
-          columns.push_back(cols->colnums[j]);
+          columns.push_back(cols->column_index(i, j));
           values.push_back(val[j]);
         }
     }
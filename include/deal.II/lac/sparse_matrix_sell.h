@@ -0,0 +1,476 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/enable_observer_pointer.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/observer_pointer.h>
+#include <deal.II/base/types.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class Vector;
+template <typename number>
+class SparseMatrix;
+class SparsityPattern;
+#endif
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix stored in the sliced ELLPACK format with a local sorting
+ * scope, also known as SELL-C-$\sigma$.
+ *
+ * The SparseMatrix class stores its entries in the compressed row storage
+ * (CSR) format and computes matrix-vector products one row at a time. Since
+ * rows of finite element matrices are short and of varying length, this
+ * leaves the SIMD units of modern processors mostly idle. The SELL-C-$\sigma$
+ * format instead groups $C$ consecutive rows into a <i>slice</i> and stores
+ * the entries of these rows interleaved, i.e., the $j$th entries of all $C$
+ * rows of a slice are contiguous in memory. Rows of a slice that have fewer
+ * entries than the longest row of the slice are padded with explicit zeros.
+ * This allows to compute the matrix-vector product of a whole slice with
+ * VectorizedArray operations, i.e., $C$ rows are processed simultaneously.
+ * Here, $C$ is chosen as VectorizedArray<number>::size(), which makes the
+ * layout depend on the SIMD width the library was compiled for.
+ *
+ * In order to keep the amount of padding small, rows are sorted by their
+ * length within windows of $\sigma$ rows before they are grouped into
+ * slices. The parameter $\sigma$ is given by
+ * AdditionalData::sorting_scope; a value of one disables sorting.
+ * The permutation is purely internal: All vectors passed to the member
+ * functions of this class are indexed in the original numbering.
+ *
+ * Objects of this class are built from a SparsityPattern and are filled by
+ * copying the values of a SparseMatrix that is based on the same sparsity
+ * pattern, e.g., after assembly:
+ * @code
+ *   SparseMatrix<double>     system_matrix(sparsity_pattern);
+ *   // ... assemble system_matrix ...
+ *
+ *   SparseMatrixSELL<double> sell_matrix(sparsity_pattern);
+ *   sell_matrix.copy_from(system_matrix);
+ *
+ *   PreconditionSSOR<SparseMatrixSELL<double>> preconditioner;
+ *   preconditioner.initialize(sell_matrix);
+ *   solver.solve(sell_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ *
+ * The class offers the subset of the interface of SparseMatrix that is used
+ * by the iterative solvers and the relaxation preconditioners, namely
+ * vmult(), Tvmult(), residual(), precondition_Jacobi(), and
+ * precondition_SSOR(). It can therefore be used as a drop-in replacement in
+ * SolverCG, SolverGMRES, PreconditionJacobi, or PreconditionSSOR. The matrix
+ * cannot be modified after it has been filled other than by another call to
+ * copy_from().
+ *
+ * @note Instantiations for this template are provided for <tt>@<float@> and
+ * @<double@></tt>; others can be generated in application programs (see the
+ * section on
+ * @ref Instantiations
+ * in the manual).
+ */
+template <typename number>
+class SparseMatrixSELL : public virtual EnableObserverPointer
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries. This alias is analogous to
+   * <tt>value_type</tt> in the standard library containers.
+   */
+  using value_type = number;
+
+  /**
+   * The number of rows $C$ that form one slice. This is the number of lanes
+   * of VectorizedArray<number> on the current architecture.
+   */
+  static constexpr unsigned int slice_size = VectorizedArray<number>::size();
+
+  /**
+   * Parameters controlling the construction of the storage layout.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. The default value of the sorting scope sorts the rows
+     * within windows of 32 slices.
+     */
+    AdditionalData(const unsigned int sorting_scope = 32 * slice_size);
+
+    /**
+     * The number of consecutive rows $\sigma$ within which rows are sorted
+     * by decreasing length before being grouped into slices. A value of one
+     * keeps the original order of rows. Larger values reduce the amount of
+     * padding but make the access pattern into the destination vector less
+     * regular.
+     */
+    unsigned int sorting_scope;
+  };
+
+  /**
+   * Constructor; initializes the matrix to be empty, without any structure.
+   * You have to call reinit() before the object can be used.
+   */
+  SparseMatrixSELL();
+
+  /**
+   * Constructor. Build the storage layout for the given sparsity pattern,
+   * with all values set to zero. See reinit() for details.
+   */
+  explicit SparseMatrixSELL(const SparsityPattern &sparsity,
+                            const AdditionalData  &data = AdditionalData());
+
+  /**
+   * Build the storage layout for the given sparsity pattern and set all
+   * values to zero. The sparsity pattern must be compressed. Like for the
+   * SparseMatrix class, a pointer to the sparsity pattern is stored, so the
+   * pattern needs to live at least as long as this object.
+   */
+  void
+  reinit(const SparsityPattern &sparsity,
+         const AdditionalData  &data = AdditionalData());
+
+  /**
+   * Build the storage layout for the sparsity pattern of the given matrix
+   * and copy its values. Equivalent to calling reinit() with
+   * <tt>matrix.get_sparsity_pattern()</tt> followed by copy_from().
+   */
+  template <typename number2>
+  void
+  reinit(const SparseMatrix<number2> &matrix,
+         const AdditionalData        &data = AdditionalData());
+
+  /**
+   * Copy the values of the given matrix into the storage of this object.
+   * The matrix must be based on the same SparsityPattern object that was
+   * passed to reinit().
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the underlying sparsity
+   * pattern, i.e., not counting the entries added for padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of entries actually stored, including the explicit
+   * zeros added to pad the rows of a slice to equal length. The ratio of
+   * this number to n_nonzero_elements() measures the storage overhead of the
+   * format.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Return the main diagonal element in the <i>i</i>th row. The matrix must
+   * be quadratic.
+   */
+  number
+  diag_element(const size_type i) const;
+
+  /**
+   * Matrix-vector multiplication: let <i>dst = M*src</i> with <i>M</i>
+   * being this matrix.
+   *
+   * This function is run in parallel over the slices of the matrix if
+   * multithreading is enabled.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Matrix-vector multiplication: let <i>dst = M<sup>T</sup>*src</i> with
+   * <i>M</i> being this matrix. This function does the same as vmult() but
+   * takes the transposed matrix.
+   *
+   * The products of the matrix entries of a slice with the entries of
+   * @p src are computed with VectorizedArray arithmetic, but the results
+   * need to be added into the entries of @p dst one at a time, since the
+   * columns of the rows in a slice are unrelated. With several threads, the
+   * slices are split into one range per thread, and all but the first range
+   * add into temporary vectors of size n() that are summed into @p dst
+   * afterwards. The result therefore depends on the number of threads up
+   * to roundoff.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add <i>M*src</i> on <i>dst</i> with
+   * <i>M</i> being this matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add <i>M<sup>T</sup>*src</i> to
+   * <i>dst</i> with <i>M</i> being this matrix. See Tvmult() for how this
+   * function is vectorized and run in parallel.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Compute the residual of an equation <i>Mx=b</i>, where the residual is
+   * defined to be <i>r=b-Mx</i>. Write the residual into @p dst. The
+   * <i>l<sub>2</sub></i> norm of the residual vector is returned.
+   */
+  template <typename somenumber>
+  somenumber
+  residual(Vector<somenumber>       &dst,
+           const Vector<somenumber> &x,
+           const Vector<somenumber> &b) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * <tt>src</tt> vector by the inverse of the respective diagonal element and
+   * multiplies the result with the relaxation factor <tt>omega</tt>.
+   */
+  template <typename somenumber>
+  void
+  precondition_Jacobi(Vector<somenumber>       &dst,
+                      const Vector<somenumber> &src,
+                      const number              omega = 1.) const;
+
+  /**
+   * Apply SSOR preconditioning to <tt>src</tt> with damping <tt>omega</tt>.
+   *
+   * The last argument is only present for interface compatibility with
+   * SparseMatrix::precondition_SSOR() and is ignored: the positions of the
+   * first entry right of the diagonal are computed once in reinit().
+   */
+  template <typename somenumber>
+  void
+  precondition_SSOR(Vector<somenumber>             &dst,
+                    const Vector<somenumber>       &src,
+                    const number                    omega = 1.,
+                    const std::vector<std::size_t> &pos_right_of_diagonal =
+                      std::vector<std::size_t>()) const;
+
+  /**
+   * Return a reference to the underlying sparsity pattern of this matrix.
+   */
+  const SparsityPattern &
+  get_sparsity_pattern() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcDifferentSparsityPatterns,
+                   "The matrix passed to copy_from() is not based on the "
+                   "SparsityPattern object this matrix was initialized "
+                   "with.");
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+  /** @} */
+
+private:
+  /**
+   * Return the position of the first entry of the given row in the arrays
+   * #values and #column_indices. Subsequent entries of the row are located
+   * with a stride of #slice_size.
+   */
+  std::size_t
+  row_start(const size_type row) const;
+
+  /**
+   * Pointer to the sparsity pattern used for this matrix.
+   */
+  ObserverPointer<const SparsityPattern, SparseMatrixSELL<number>> cols;
+
+  /**
+   * The number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * The number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * The offset of each slice into #values and #column_indices, with one
+   * additional entry at the end that contains the total number of stored
+   * elements. All offsets are multiples of #slice_size.
+   */
+  std::vector<std::size_t> slice_start;
+
+  /**
+   * The original row index of each position within the slices. Positions
+   * beyond the number of rows in the last slice are marked by
+   * numbers::invalid_size_type.
+   */
+  std::vector<size_type> slot_to_row;
+
+  /**
+   * The position within the slices of each original row, i.e., the inverse
+   * of #slot_to_row.
+   */
+  std::vector<size_type> row_to_slot;
+
+  /**
+   * The number of nonzero entries of each original row.
+   */
+  std::vector<unsigned int> row_lengths;
+
+  /**
+   * For each row of a quadratic matrix, the index within the row of the
+   * first entry that is right of the diagonal. Used by the SSOR
+   * preconditioner.
+   */
+  std::vector<unsigned int> first_right_of_diagonal;
+
+  /**
+   * The matrix values in the interleaved slice layout, including zeros for
+   * padding.
+   */
+  AlignedVector<number> values;
+
+  /**
+   * The column indices in the interleaved slice layout. Padding entries
+   * repeat a valid column index of the same row, or point to column zero
+   * for rows that do not exist.
+   */
+  std::vector<size_type> column_indices;
+};
+
+/** @} */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_stored_elements() const
+{
+  return values.size();
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::row_start(const size_type row) const
+{
+  AssertIndexRange(row, n_rows);
+  const size_type slot = row_to_slot[row];
+  return slice_start[slot / slice_size] + slot % slice_size;
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::diag_element(const size_type i) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertDimension(n_rows, n_cols);
+  AssertIndexRange(i, n_rows);
+
+  // like for SparseMatrix, the diagonal element is stored first in each row
+  // of a quadratic matrix
+  return values[row_start(i)];
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
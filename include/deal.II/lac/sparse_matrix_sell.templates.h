@@ -0,0 +1,766 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_templates_h
+#define dealii_sparse_matrix_sell_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace SparseMatrixSELLImplementation
+  {
+    using size_type = types::global_dof_index;
+
+    /**
+     * Minimal number of slices to be worked on by a single task, analogous to
+     * the grain size used by the CSR kernels of SparseMatrix.
+     */
+    constexpr unsigned int minimum_parallel_grain_size = 64;
+
+    /**
+     * Compute the products of the rows within a subinterval of the slices
+     * with the vector @p src and pass each result together with its original
+     * row index to @p store.
+     *
+     * If the value type of the vector coincides with the matrix type, the
+     * rows of a slice are computed simultaneously with VectorizedArray
+     * arithmetic. Otherwise, the lanes are processed in a scalar loop with
+     * the same memory access pattern.
+     */
+    template <typename OutNumber,
+              typename number,
+              typename InVector,
+              typename StoreFunction>
+    void
+    apply_slices(const size_type      begin_slice,
+                 const size_type      end_slice,
+                 const number        *values,
+                 const size_type     *column_indices,
+                 const std::size_t   *slice_start,
+                 const size_type     *slot_to_row,
+                 const InVector      &src,
+                 const StoreFunction &store)
+    {
+      constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+      for (size_type slice = begin_slice; slice < end_slice; ++slice)
+        {
+          const std::size_t begin = slice_start[slice];
+          const std::size_t end   = slice_start[slice + 1];
+          const size_type  *rows  = slot_to_row + slice * n_lanes;
+
+          if constexpr (std::is_same_v<OutNumber, number>)
+            {
+              VectorizedArray<number> sum = number();
+              VectorizedArray<number> matrix_values, src_values;
+              for (std::size_t k = begin; k < end; k += n_lanes)
+                {
+                  matrix_values.load(values + k);
+                  for (unsigned int v = 0; v < n_lanes; ++v)
+                    src_values[v] = src(column_indices[k + v]);
+                  sum += matrix_values * src_values;
+                }
+
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                if (rows[v] != numbers::invalid_size_type)
+                  store(rows[v], sum[v]);
+            }
+          else
+            {
+              OutNumber sum[n_lanes] = {};
+              for (std::size_t k = begin; k < end; k += n_lanes)
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  sum[v] += OutNumber(values[k + v]) *
+                            OutNumber(src(column_indices[k + v]));
+
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                if (rows[v] != numbers::invalid_size_type)
+                  store(rows[v], sum[v]);
+            }
+        }
+    }
+
+
+
+    /**
+     * Perform a vmult using the SparseMatrixSELL data structures, but only
+     * using a subinterval of the slices.
+     */
+    template <typename number, typename InVector, typename OutVector>
+    void
+    vmult_on_subrange(const size_type    begin_slice,
+                      const size_type    end_slice,
+                      const number      *values,
+                      const size_type   *column_indices,
+                      const std::size_t *slice_start,
+                      const size_type   *slot_to_row,
+                      const InVector    &src,
+                      OutVector         &dst,
+                      const bool         add)
+    {
+      using OutNumber = typename OutVector::value_type;
+
+      if (add)
+        apply_slices<OutNumber>(
+          begin_slice,
+          end_slice,
+          values,
+          column_indices,
+          slice_start,
+          slot_to_row,
+          src,
+          [&dst](const size_type row, const OutNumber value) {
+            dst(row) += value;
+          });
+      else
+        apply_slices<OutNumber>(
+          begin_slice,
+          end_slice,
+          values,
+          column_indices,
+          slice_start,
+          slot_to_row,
+          src,
+          [&dst](const size_type row, const OutNumber value) {
+            dst(row) = value;
+          });
+    }
+
+
+
+    /**
+     * Compute the residual $b-Ax$ on a subinterval of the slices and return
+     * the square of its norm on these slices.
+     */
+    template <typename number, typename somenumber>
+    somenumber
+    residual_sqr_on_subrange(const size_type           begin_slice,
+                             const size_type           end_slice,
+                             const number             *values,
+                             const size_type          *column_indices,
+                             const std::size_t        *slice_start,
+                             const size_type          *slot_to_row,
+                             const Vector<somenumber> &u,
+                             const Vector<somenumber> &b,
+                             Vector<somenumber>       &dst)
+    {
+      somenumber norm_sqr = 0.;
+      apply_slices<somenumber>(
+        begin_slice,
+        end_slice,
+        values,
+        column_indices,
+        slice_start,
+        slot_to_row,
+        u,
+        [&](const size_type row, const somenumber value) {
+          const somenumber s = b(row) - value;
+          dst(row)           = s;
+          norm_sqr += s * numbers::NumberTraits<somenumber>::conjugate(s);
+        });
+      return norm_sqr;
+    }
+
+
+
+    /**
+     * Add the products of the transpose of the rows within a subinterval of
+     * the slices with the vector @p src by passing each product together
+     * with its column index to @p add.
+     *
+     * If the value type of the vector coincides with the matrix type, the
+     * entries of @p src belonging to the rows of a slice are gathered into a
+     * VectorizedArray once, and the products with the matrix entries are
+     * computed with VectorizedArray arithmetic, leaving only the scatter
+     * into the columns scalar. Padding entries have a zero value and add
+     * zero to the last column of their row.
+     */
+    template <typename OutNumber,
+              typename number,
+              typename InVector,
+              typename AddFunction>
+    void
+    Tvmult_add_on_subrange(const size_type    begin_slice,
+                           const size_type    end_slice,
+                           const number      *values,
+                           const size_type   *column_indices,
+                           const std::size_t *slice_start,
+                           const size_type   *slot_to_row,
+                           const InVector    &src,
+                           const AddFunction &add)
+    {
+      constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+      for (size_type slice = begin_slice; slice < end_slice; ++slice)
+        {
+          const std::size_t begin = slice_start[slice];
+          const std::size_t end   = slice_start[slice + 1];
+          const size_type  *rows  = slot_to_row + slice * n_lanes;
+
+          if constexpr (std::is_same_v<OutNumber, number>)
+            {
+              VectorizedArray<number> src_values, matrix_values, products;
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                src_values[v] =
+                  (rows[v] != numbers::invalid_size_type ? src(rows[v]) :
+                                                           number());
+              for (std::size_t k = begin; k < end; k += n_lanes)
+                {
+                  matrix_values.load(values + k);
+                  products = matrix_values * src_values;
+                  for (unsigned int v = 0; v < n_lanes; ++v)
+                    add(column_indices[k + v], products[v]);
+                }
+            }
+          else
+            {
+              OutNumber src_values[n_lanes];
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                src_values[v] =
+                  (rows[v] != numbers::invalid_size_type ?
+                     OutNumber(src(rows[v])) :
+                     OutNumber());
+              for (std::size_t k = begin; k < end; k += n_lanes)
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  add(column_indices[k + v],
+                      OutNumber(values[k + v]) * src_values[v]);
+            }
+        }
+    }
+  } // namespace SparseMatrixSELLImplementation
+} // namespace internal
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::AdditionalData::AdditionalData(
+  const unsigned int sorting_scope)
+  : sorting_scope(sorting_scope)
+{}
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL()
+  : cols(nullptr, "SparseMatrixSELL")
+  , n_rows(0)
+  , n_cols(0)
+{}
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL(const SparsityPattern &sparsity,
+                                           const AdditionalData  &data)
+  : SparseMatrixSELL()
+{
+  reinit(sparsity, data);
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::reinit(const SparsityPattern &sparsity,
+                                 const AdditionalData  &data)
+{
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  Assert(data.sorting_scope > 0, ExcMessage("The sorting scope must be >0."));
+
+  cols   = &sparsity;
+  n_rows = sparsity.n_rows();
+  n_cols = sparsity.n_cols();
+
+  row_lengths.resize(n_rows);
+  for (size_type row = 0; row < n_rows; ++row)
+    row_lengths[row] = sparsity.row_length(row);
+
+  // sort the rows within windows of the sorting scope by decreasing length;
+  // the sort is stable so that rows of equal length keep their relative
+  // order, which preserves locality for regular meshes
+  const size_type n_slices = (n_rows + slice_size - 1) / slice_size;
+  slot_to_row.assign(n_slices * slice_size, numbers::invalid_size_type);
+  std::iota(slot_to_row.begin(), slot_to_row.begin() + n_rows, size_type(0));
+  for (size_type begin = 0; begin < n_rows; begin += data.sorting_scope)
+    {
+      const size_type end = std::min<size_type>(begin + data.sorting_scope,
+                                                n_rows);
+      std::stable_sort(slot_to_row.begin() + begin,
+                       slot_to_row.begin() + end,
+                       [&](const size_type a, const size_type b) {
+                         return row_lengths[a] > row_lengths[b];
+                       });
+    }
+
+  row_to_slot.resize(n_rows);
+  for (size_type slot = 0; slot < n_rows; ++slot)
+    row_to_slot[slot_to_row[slot]] = slot;
+
+  // determine the offsets of the slices: each slice is as wide as its
+  // longest row
+  slice_start.resize(n_slices + 1);
+  slice_start[0] = 0;
+  for (size_type slice = 0; slice < n_slices; ++slice)
+    {
+      unsigned int width = 0;
+      for (unsigned int v = 0; v < slice_size; ++v)
+        {
+          const size_type row = slot_to_row[slice * slice_size + v];
+          if (row != numbers::invalid_size_type)
+            width = std::max(width, row_lengths[row]);
+        }
+      slice_start[slice + 1] =
+        slice_start[slice] + std::size_t(width) * slice_size;
+    }
+
+  // fill the column indices. padding entries repeat the last valid column
+  // index of their row in order to not touch additional cache lines of the
+  // source vector
+  values.resize_fast(slice_start[n_slices]);
+  column_indices.assign(slice_start[n_slices], 0);
+  first_right_of_diagonal.assign(n_rows == n_cols ? n_rows : 0, 0);
+  for (size_type slot = 0; slot < slot_to_row.size(); ++slot)
+    {
+      const size_type   slice    = slot / slice_size;
+      const std::size_t start    = slice_start[slice] + slot % slice_size;
+      const std::size_t n_stored = (slice_start[slice + 1] -
+                                    slice_start[slice]) /
+                                   slice_size;
+      const size_type   row      = slot_to_row[slot];
+      if (row == numbers::invalid_size_type)
+        continue;
+
+      unsigned int j = 0;
+      for (auto entry = sparsity.begin(row); entry != sparsity.end(row);
+           ++entry, ++j)
+        column_indices[start + j * slice_size] = entry->column();
+      for (; j < n_stored; ++j)
+        column_indices[start + j * slice_size] =
+          (row_lengths[row] > 0 ?
+             column_indices[start + (row_lengths[row] - 1) * slice_size] :
+             0);
+
+      if (n_rows == n_cols)
+        {
+          j = 1;
+          while (j < row_lengths[row] &&
+                 column_indices[start + j * slice_size] < row)
+            ++j;
+          first_right_of_diagonal[row] = j;
+        }
+    }
+
+  std::fill(values.begin(), values.end(), number());
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrixSELL<number>::reinit(const SparseMatrix<number2> &matrix,
+                                 const AdditionalData        &data)
+{
+  reinit(matrix.get_sparsity_pattern(), data);
+  copy_from(matrix);
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrixSELL<number>::copy_from(const SparseMatrix<number2> &matrix)
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(&matrix.get_sparsity_pattern() == &*cols,
+         ExcDifferentSparsityPatterns());
+
+  parallel::apply_to_subranges(
+    0U,
+    n_rows,
+    [this, &matrix](const size_type begin_row, const size_type end_row) {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          std::size_t index = row_start(row);
+          for (auto entry = matrix.begin(row); entry != matrix.end(row);
+               ++entry, index += slice_size)
+            values[index] = number(entry->value());
+        }
+    },
+    internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size *
+      slice_size);
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::clear()
+{
+  cols   = nullptr;
+  n_rows = 0;
+  n_cols = 0;
+  slice_start.clear();
+  slot_to_row.clear();
+  row_to_slot.clear();
+  row_lengths.clear();
+  first_right_of_diagonal.clear();
+  values.clear();
+  column_indices.clear();
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::n_nonzero_elements() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  return cols->n_nonzero_elements();
+}
+
+
+
+template <typename number>
+const SparsityPattern &
+SparseMatrixSELL<number>::get_sparsity_pattern() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  return *cols;
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult(OutVector &dst, const InVector &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    slice_start.size() - 1,
+    [this, &src, &dst](const size_type begin_slice,
+                       const size_type end_slice) {
+      internal::SparseMatrixSELLImplementation::vmult_on_subrange(
+        begin_slice,
+        end_slice,
+        values.data(),
+        column_indices.data(),
+        slice_start.data(),
+        slot_to_row.data(),
+        src,
+        dst,
+        false);
+    },
+    internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    slice_start.size() - 1,
+    [this, &src, &dst](const size_type begin_slice,
+                       const size_type end_slice) {
+      internal::SparseMatrixSELLImplementation::vmult_on_subrange(
+        begin_slice,
+        end_slice,
+        values.data(),
+        column_indices.data(),
+        slice_start.data(),
+        slot_to_row.data(),
+        src,
+        dst,
+        true);
+    },
+    internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult(OutVector &dst, const InVector &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  dst = 0;
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  using OutNumber = typename OutVector::value_type;
+
+  // the scatter into the columns cannot be split among threads working on
+  // the same vector. the first range of slices adds into dst directly,
+  // while the other ranges add into buffers that are summed into dst
+  // afterwards
+  const size_type    n_slices = slice_start.size() - 1;
+  const unsigned int n_ranges = std::max<size_type>(
+    1,
+    std::min<size_type>(
+      MultithreadInfo::n_threads(),
+      n_slices /
+        internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size));
+
+  std::vector<std::vector<OutNumber>> buffers(n_ranges - 1);
+  parallel::apply_to_subranges(
+    0U,
+    n_ranges,
+    [&](const unsigned int begin_range, const unsigned int end_range) {
+      for (unsigned int range = begin_range; range < end_range; ++range)
+        {
+          const size_type begin_slice = n_slices * range / n_ranges;
+          const size_type end_slice   = n_slices * (range + 1) / n_ranges;
+          if (range == 0)
+            internal::SparseMatrixSELLImplementation::Tvmult_add_on_subrange<
+              OutNumber>(begin_slice,
+                         end_slice,
+                         values.data(),
+                         column_indices.data(),
+                         slice_start.data(),
+                         slot_to_row.data(),
+                         src,
+                         [&dst](const size_type column, const OutNumber value) {
+                           dst(column) += value;
+                         });
+          else
+            {
+              std::vector<OutNumber> &buffer = buffers[range - 1];
+              buffer.resize(n_cols);
+              internal::SparseMatrixSELLImplementation::Tvmult_add_on_subrange<
+                OutNumber>(begin_slice,
+                           end_slice,
+                           values.data(),
+                           column_indices.data(),
+                           slice_start.data(),
+                           slot_to_row.data(),
+                           src,
+                           [&buffer](const size_type column,
+                                     const OutNumber value) {
+                             buffer[column] += value;
+                           });
+            }
+        }
+    },
+    1);
+
+  if (n_ranges > 1)
+    parallel::apply_to_subranges(
+      0U,
+      n_cols,
+      [&dst, &buffers](const size_type begin_column,
+                       const size_type end_column) {
+        for (const std::vector<OutNumber> &buffer : buffers)
+          for (size_type column = begin_column; column < end_column; ++column)
+            dst(column) += buffer[column];
+      },
+      internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size *
+        slice_size);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+somenumber
+SparseMatrixSELL<number>::residual(Vector<somenumber>       &dst,
+                                   const Vector<somenumber> &u,
+                                   const Vector<somenumber> &b) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(m() == b.size(), ExcDimensionMismatch(m(), b.size()));
+  Assert(n() == u.size(), ExcDimensionMismatch(n(), u.size()));
+
+  Assert(&u != &dst, ExcSourceEqualsDestination());
+
+  return std::sqrt(parallel::accumulate_from_subranges<somenumber>(
+    [this, &u, &b, &dst](const size_type begin_slice,
+                         const size_type end_slice) {
+      return internal::SparseMatrixSELLImplementation::residual_sqr_on_subrange(
+        begin_slice,
+        end_slice,
+        values.data(),
+        column_indices.data(),
+        slice_start.data(),
+        slot_to_row.data(),
+        u,
+        b,
+        dst);
+    },
+    0,
+    slice_start.size() - 1,
+    internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size));
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SparseMatrixSELL<number>::precondition_Jacobi(Vector<somenumber>       &dst,
+                                              const Vector<somenumber> &src,
+                                              const number omega) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertDimension(m(), n());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  parallel::apply_to_subranges(
+    0U,
+    n_rows,
+    [this, &src, &dst, omega](const size_type begin_row,
+                              const size_type end_row) {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          const number diagonal = values[row_start(row)];
+          Assert(diagonal != number(), ExcDivideByZero());
+          dst(row) = somenumber(omega) * src(row) / somenumber(diagonal);
+        }
+    },
+    internal::SparseMatrixSELLImplementation::minimum_parallel_grain_size *
+      slice_size);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SparseMatrixSELL<number>::precondition_SSOR(
+  Vector<somenumber>       &dst,
+  const Vector<somenumber> &src,
+  const number              omega,
+  const std::vector<std::size_t> &) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertDimension(m(), n());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  const size_type n = src.size();
+
+  // forward sweep. within a row, entries are located with a stride of the
+  // slice size, and the diagonal entry comes first
+  for (size_type row = 0; row < n; ++row)
+    {
+      const std::size_t start = row_start(row);
+      const std::size_t end_left =
+        start + std::size_t(first_right_of_diagonal[row]) * slice_size;
+
+      somenumber s = 0;
+      for (std::size_t k = start + slice_size; k < end_left; k += slice_size)
+        s += somenumber(values[k]) * dst(column_indices[k]);
+
+      Assert(values[start] != number(), ExcDivideByZero());
+      dst(row) = (src(row) - s * somenumber(omega)) / somenumber(values[start]);
+    }
+
+  for (size_type row = 0; row < n; ++row)
+    dst(row) *= somenumber(omega * (number(2.) - omega)) *
+                somenumber(values[row_start(row)]);
+
+  // backward sweep
+  for (size_type row = n; row-- > 0;)
+    {
+      const std::size_t start = row_start(row);
+      const std::size_t end_left =
+        start + std::size_t(first_right_of_diagonal[row]) * slice_size;
+      const std::size_t end_row =
+        start + std::size_t(row_lengths[row]) * slice_size;
+
+      somenumber s = 0;
+      for (std::size_t k = end_left; k < end_row; k += slice_size)
+        s += somenumber(values[k]) * dst(column_indices[k]);
+
+      dst(row) = (dst(row) - s * somenumber(omega)) / somenumber(values[start]);
+    }
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(slice_start) +
+         MemoryConsumption::memory_consumption(slot_to_row) +
+         MemoryConsumption::memory_consumption(row_to_slot) +
+         MemoryConsumption::memory_consumption(row_lengths) +
+         MemoryConsumption::memory_consumption(first_right_of_diagonal) +
+         values.memory_consumption() +
+         MemoryConsumption::memory_consumption(column_indices);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <deal.II/lac/sparse_decomposition.h>
 #include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/symmetric_sparse_matrix.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -96,6 +97,23 @@ public:
   initialize(const SparseMatrix<somenumber> &matrix,
              const AdditionalData           &parameters = AdditionalData());
 
+  /**
+   * Perform the decomposition of a matrix of which only the upper triangle
+   * is stored. The decomposition uses the sparsity pattern of @p matrix and
+   * is stored as a triangle as well, so it only needs about half the memory
+   * of a decomposition of the equivalent SparseMatrix, with the same result
+   * up to round-off. The forward substitution in vmult() then works with the
+   * columns of the stored triangle.
+   *
+   * Of the @p parameters, only the diagonal strengthening and the level
+   * scheduling are used, and the latter only for the backward substitution.
+   * Extra off-diagonals or other sparsity patterns are not supported.
+   */
+  template <typename somenumber>
+  void
+  initialize(const SymmetricSparseMatrix<somenumber> &matrix,
+             const AdditionalData &parameters = AdditionalData());
+
   /**
    * Apply the incomplete decomposition, i.e. do one forward-backward step
    * $dst=(LU)^{-1}src$.
@@ -168,6 +186,12 @@ private:
    */
   std::vector<number> inner_sums;
 
+  /**
+   * Whether the decomposition was computed from a SymmetricSparseMatrix and
+   * only stores the upper triangle.
+   */
+  bool upper_triangle_only = false;
+
   /**
    * Compute the row-th "inner sum".
    */
@@ -51,6 +51,7 @@ SparseMIC<number>::clear()
     std::vector<number> tmp;
     tmp.swap(inner_sums);
   }
+  upper_triangle_only = false;
 
   SparseLUDecomposition<number>::clear();
 }
@@ -67,8 +68,11 @@ SparseMIC<number>::initialize(const SparseMatrix<somenumber> &matrix,
          ExcInvalidStrengthening(data.strengthen_diagonal));
 
   SparseLUDecomposition<number>::initialize(matrix, data);
+  upper_triangle_only       = false;
   this->strengthen_diagonal = data.strengthen_diagonal;
   this->prebuild_lower_bound();
+  if (data.use_level_scheduling)
+    this->compute_level_sets();
   this->copy_from(matrix);
 
   Assert(this->m() == this->n(), ExcNotQuadratic());
@@ -116,6 +120,87 @@ SparseMIC<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
 
 
+template <typename number>
+template <typename somenumber>
+inline void
+SparseMIC<number>::initialize(const SymmetricSparseMatrix<somenumber> &matrix,
+                              const AdditionalData                    &data)
+{
+  Assert(data.strengthen_diagonal >= 0,
+         ExcInvalidStrengthening(data.strengthen_diagonal));
+  Assert(data.extra_off_diagonals == 0 && data.use_this_sparsity == nullptr,
+         ExcMessage("A decomposition of a SymmetricSparseMatrix uses the "
+                    "sparsity pattern of the matrix. Extra off-diagonals "
+                    "or other sparsity patterns are not supported."));
+
+  // use the sparsity pattern of the matrix, which only contains the upper
+  // triangle, and copy the values in the order they are stored
+  this->clear();
+  SparseMatrix<number>::reinit(matrix.get_sparsity_pattern());
+  upper_triangle_only       = true;
+  this->strengthen_diagonal = data.strengthen_diagonal;
+  this->prebuild_lower_bound();
+  if (data.use_level_scheduling)
+    this->compute_level_sets();
+
+  const size_type N = this->m();
+  {
+    std::size_t index = 0;
+    for (size_type row = 0; row < N; ++row)
+      for (typename SparseMatrix<number>::iterator p = this->begin(row);
+           p != this->end(row);
+           ++p, ++index)
+        p->value() = number(matrix.values[index]);
+  }
+
+  // the strengthening uses the sums over the full rows, which we get by
+  // adding each stored entry to the sums of both its row and its column
+  if (data.strengthen_diagonal > 0)
+    {
+      std::vector<number> rowsums(N);
+      for (size_type row = 0; row < N; ++row)
+        for (typename SparseMatrix<number>::const_iterator p =
+               this->begin(row) + 1;
+             p != this->end(row);
+             ++p)
+          {
+            rowsums[row] += std::fabs(p->value());
+            rowsums[p->column()] += std::fabs(p->value());
+          }
+      for (size_type row = 0; row < N; ++row)
+        this->begin(row)->value() +=
+          this->get_strengthen_diagonal(rowsums[row], row) * rowsums[row];
+    }
+
+  diag.resize(N);
+  inv_diag.resize(N);
+  inner_sums.resize(N);
+
+  for (size_type row = 0; row < N; ++row)
+    inner_sums[row] = get_rowsum(row);
+
+  // same as in the other initialize() function, but the sum over the lower
+  // left part of each row is accumulated in diag[] by adding the
+  // contribution of each row to the rows right of the diagonal once it is
+  // final. for each row, the terms are added in the same order as before
+  std::fill(diag.begin(), diag.end(), number());
+  for (size_type row = 0; row < N; ++row)
+    {
+      const number temp = this->begin(row)->value() - diag[row];
+      Assert(temp > 0, ExcStrengthenDiagonalTooSmall());
+      diag[row]     = temp;
+      inv_diag[row] = 1.0 / diag[row];
+
+      for (typename SparseMatrix<number>::const_iterator p =
+             this->begin(row) + 1;
+           p != this->end(row);
+           ++p)
+        diag[p->column()] += p->value() / diag[row] * inner_sums[row];
+    }
+}
+
+
+
 template <typename number>
 inline number
 SparseMIC<number>::get_rowsum(const size_type row) const
@@ -150,8 +235,23 @@ SparseMIC<number>::vmult(Vector<somenumber>       &dst,
   //
   // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
   dst = src;
-  for (size_type row = 0; row < N; ++row)
+  if (upper_triangle_only)
     {
+      // only the upper triangle is stored: once the value of a row is
+      // final, subtract its contribution from the rows right of the
+      // diagonal, which it couples to through the transposed entries
+      for (size_type row = 0; row < N; ++row)
+        {
+          dst(row) *= inv_diag[row];
+          for (typename SparseMatrix<number>::const_iterator p =
+                 this->begin(row) + 1;
+               p != this->end(row);
+               ++p)
+            dst(p->column()) -= p->value() * dst(row);
+        }
+    }
+  else
+    this->forward_substitution_loop([&](const size_type row) {
       // Now: (X-L)u = b
 
       // get start of this row. skip
@@ -163,25 +263,23 @@ SparseMIC<number>::vmult(Vector<somenumber>       &dst,
         dst(row) -= p->value() * dst(p->column());
 
       dst(row) *= inv_diag[row];
-    }
+    });
 
   // Now: v = Xu
   for (size_type row = 0; row < N; ++row)
     dst(row) *= diag[row];
 
   // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           p != this->end(row);
-           ++p)
-        if (p->column() > static_cast<size_type>(row))
-          dst(row) -= p->value() * dst(p->column());
+  this->backward_substitution_loop([&](const size_type row) {
+    // get end of this row
+    for (typename SparseMatrix<number>::const_iterator p = this->begin(row) + 1;
+         p != this->end(row);
+         ++p)
+      if (p->column() > row)
+        dst(row) -= p->value() * dst(p->column());
 
-      dst(row) *= inv_diag[row];
-    }
+    dst(row) *= inv_diag[row];
+  });
 }
 
 
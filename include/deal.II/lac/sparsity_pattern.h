@@ -36,8 +36,12 @@
 #include <boost/serialization/split_member.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -55,11 +59,27 @@ template <typename number>
 class SparseLUDecomposition;
 template <typename number>
 class SparseILU;
+template <typename number>
+class SymmetricSparseMatrix;
 
 namespace ChunkSparsityPatternIterators
 {
   class Accessor;
 }
+
+namespace internal
+{
+  namespace SparsityPatternTools
+  {
+    template <typename Function>
+    void
+    for_each_entry_in_row(const SparsityPattern        &sparsity,
+                          const types::global_dof_index row,
+                          const std::size_t             begin,
+                          const std::size_t             end,
+                          const Function               &f);
+  } // namespace SparsityPatternTools
+} // namespace internal
 #endif
 
 /**
@@ -237,6 +257,16 @@ namespace SparsityPatternIterators
      */
     std::size_t linear_index;
 
+    /**
+     * The row of the entry pointed to, if it has been determined already,
+     * or numbers::invalid_size_type. The column index of an entry of a
+     * sparsity pattern that stores narrow column indices can only be
+     * computed with the row known, so column() sets this variable and
+     * usually only needs to move it on to the next row as the accessor
+     * advances, rather than search for the row every time.
+     */
+    mutable size_type current_row;
+
     /**
      * Move the accessor to the next nonzero entry in the matrix.
      */
@@ -363,6 +393,16 @@ public:
    */
   static constexpr size_type invalid_entry = numbers::invalid_size_type;
 
+  /**
+   * The type used by store_narrow_column_indices() for the column indices
+   * relative to the first column of a row. It has half the width of
+   * size_type, i.e., 32 bits if deal.II is configured with
+   * <code>DEAL_II_WITH_64BIT_INDICES=ON</code> and 16 bits otherwise.
+   */
+  using narrow_index_type = std::conditional_t<sizeof(size_type) == 8,
+                                               std::uint32_t,
+                                               std::uint16_t>;
+
   /**
    * Typedef an iterator class that allows to walk over all nonzero elements
    * of a sparsity pattern.
@@ -591,6 +631,79 @@ public:
   void
   compress();
 
+  /**
+   * Replace the column indices of a compressed sparsity pattern by indices
+   * of a narrower integer type, in order to reduce both the memory used by
+   * this object and the memory traffic of the bandwidth-bound matrix-vector
+   * products and relaxation methods. The column indices of each row are
+   * stored as offsets relative to the smallest column index in that row,
+   * using the type #narrow_index_type that has half the width of
+   * size_type. Only rows whose entries span more columns than can be
+   * represented by this type keep their full column indices.
+   *
+   * After calling this function, all functions of this class, its
+   * iterators, and the classes built on it, such as SparseMatrix, read the
+   * column indices from this representation. The matrix-vector products
+   * and the SOR/SSOR relaxation methods of SparseMatrix as well as the
+   * forward and backward substitutions of SparseILU benefit most: these
+   * operations are limited by memory bandwidth and the column indices make
+   * up a large part of the data they read, so they become noticeably faster
+   * for well-numbered matrices, e.g., after DoFRenumbering::Cuthill_McKee().
+   * Functions that look up individual entries, e.g., SparseMatrix::add(),
+   * become slightly slower, so this function is best called once the
+   * matrix has been assembled.
+   *
+   * The narrow representation is kept until the structure of the object
+   * changes, e.g., through reinit() or block_read(), which set up full
+   * column indices again. block_write() and serialization write the full
+   * column indices, so this function needs to be called again after reading
+   * the object back in. Calling this function again on an object that
+   * already stores narrow column indices has no effect.
+   */
+  void
+  store_narrow_column_indices();
+
+  /**
+   * Store a column-wise index map of a compressed sparsity pattern, i.e.,
+   * for each column the positions of its entries in the array of column
+   * indices, which are also the positions of the values of a SparseMatrix
+   * based on this object, and the rows of these entries, sorted by row.
+   * This is the structure of the transpose in compressed column storage.
+   *
+   * SparseMatrix::Tvmult() and SparseMatrix::Tvmult_add() need this map to
+   * work on the columns in parallel, since the product with the transpose
+   * otherwise scatters the contributions of each row into arbitrary
+   * entries of the destination vector. They never build the map
+   * themselves: the products with the transpose of all matrices based on
+   * this object run in parallel only after this function has been called.
+   * The map needs the position and the row of each entry, i.e.,
+   * <tt>sizeof(std::size_t)+sizeof(size_type)</tt> bytes per nonzero entry
+   * (16 bytes with 64-bit indices), plus one index per column, which about
+   * doubles the memory consumption of this object. It should therefore only
+   * be stored for matrices whose product with the transpose is a
+   * significant part of the run time, and can be released again through
+   * clear_column_index_map().
+   *
+   * Since the map is a cache that does not change the sparsity pattern
+   * itself, this function is const. It may be called concurrently from
+   * several threads, e.g., by several matrices based on the same sparsity
+   * pattern, and only builds the map the first time it is called. The map
+   * is discarded whenever the structure of the object changes, e.g.,
+   * through reinit() or block_read().
+   */
+  void
+  store_column_index_map() const;
+
+  /**
+   * Release the memory of the column-wise index map built by
+   * store_column_index_map(), after which SparseMatrix::Tvmult() and
+   * SparseMatrix::Tvmult_add() work sequentially again. This function must
+   * not be called while a product with the transpose of a matrix based on
+   * this object is running on another thread.
+   */
+  void
+  clear_column_index_map() const;
+
 
   /**
    * This function can be used as a replacement for reinit(), subsequent calls
@@ -689,6 +802,24 @@ public:
   void
   copy_from(const SparsityPattern &sp);
 
+  /**
+   * Copy the upper triangle of a square DynamicSparsityPattern, i.e., for
+   * each row the diagonal entry and the entries right of it. Entries left of
+   * the diagonal are ignored. The diagonal entry is stored first in each row
+   * as for all square sparsity patterns, whether or not it is present in
+   * @p dsp. Previous content of this object is lost, and the sparsity
+   * pattern is in compressed mode afterwards.
+   *
+   * Sparsity patterns created this way are used by SymmetricSparseMatrix,
+   * which stores only one triangle of a symmetric matrix. Since it is
+   * usually simplest to build the full pattern with
+   * DoFTools::make_sparsity_pattern() and then drop the lower triangle, this
+   * function takes the same DynamicSparsityPattern that one would otherwise
+   * pass to copy_from().
+   */
+  void
+  copy_upper_triangle_from(const DynamicSparsityPattern &dsp);
+
   /**
    * Take a full matrix and use its nonzero entries to generate a sparse
    * matrix entry pattern for this object.
@@ -794,6 +925,22 @@ public:
   bool
   is_compressed() const;
 
+  /**
+   * Return whether store_narrow_column_indices() has been called since the
+   * last change to the structure of this object.
+   */
+  bool
+  has_narrow_column_indices() const;
+
+  /**
+   * Return whether store_column_index_map() has been called since the
+   * last change to the structure of this object. This function may be
+   * called while another thread builds the map, and only returns true once
+   * the map is complete.
+   */
+  bool
+  has_column_index_map() const;
+
   /**
    * Return the maximum number of entries per row. Before compression, this
    * equals the number given to the constructor, while after compression, it
@@ -1142,14 +1289,98 @@ private:
    * within each row (with possible exception of the diagonal element) are
    * sorted, such that finding whether an element exists and determining its
    * position can be done by a binary search.
+   *
+   * This array is released by store_narrow_column_indices(), which stores
+   * the column indices in #narrow_row_base, #narrow_colnums, and
+   * #wide_colnums instead, and sets #max_vec_len to zero. Functions that
+   * need the column index at a given position therefore use column_index()
+   * unless they know that this array is in use.
    */
   std::unique_ptr<size_type[]> colnums;
 
+  /**
+   * For each row, the column index relative to which the entries of
+   * #narrow_colnums of that row are stored, or #invalid_entry if the
+   * columns of the row span too large a range to be represented by
+   * #narrow_index_type and are stored in #wide_colnums instead. This array
+   * is only allocated by store_narrow_column_indices().
+   */
+  std::unique_ptr<size_type[]> narrow_row_base;
+
+  /**
+   * Column indices relative to #narrow_row_base, stored at the same
+   * positions as in #colnums. Entries of rows that are stored in
+   * #wide_colnums are unused.
+   */
+  std::unique_ptr<narrow_index_type[]> narrow_colnums;
+
+  /**
+   * The full column indices of the rows whose columns can not be stored in
+   * #narrow_colnums. These rows are listed in ascending order in
+   * #wide_rows, and the entries of the row <tt>wide_rows[k]</tt> are stored
+   * at the positions <tt>[wide_row_start[k], wide_row_start[k+1])</tt> of
+   * #wide_colnums. There are usually only few such rows, so these arrays are
+   * only as long as needed for them and are empty if there are none.
+   */
+  std::vector<size_type>   wide_rows;
+  std::vector<std::size_t> wide_row_start;
+  std::vector<size_type>   wide_colnums;
+
+  /**
+   * The column-wise index map built by store_column_index_map(): the
+   * entries of column $j$ are stored at the positions
+   * <tt>[column_start[j], column_start[j+1])</tt> of #column_positions,
+   * which holds their positions in #colnums, and of #column_rows, which
+   * holds their rows. These arrays are only allocated by
+   * store_column_index_map().
+   */
+  mutable std::unique_ptr<std::size_t[]> column_start;
+  mutable std::unique_ptr<std::size_t[]> column_positions;
+  mutable std::unique_ptr<size_type[]>   column_rows;
+
+  /**
+   * A mutex that guards the creation of the column-wise index map.
+   */
+  mutable std::mutex column_index_map_mutex;
+
+  /**
+   * Whether the arrays of the column-wise index map have been filled. This
+   * flag is set with release semantics only after the arrays are complete,
+   * and read with acquire semantics by has_column_index_map(), so a thread
+   * that finds it set also sees the contents of the arrays, even while
+   * another thread is still in store_column_index_map().
+   */
+  mutable std::atomic<bool> column_index_map_is_stored;
+
   /**
    * Store whether the compress() function was called for this object.
    */
   bool compressed;
 
+  /**
+   * Return the column index of the entry at position @p j of the index
+   * arrays, which must belong to row @p row. The index is read from
+   * #colnums if that array is in use, and from the narrow representation
+   * set up by store_narrow_column_indices() otherwise.
+   */
+  size_type
+  column_index(const size_type row, const std::size_t j) const;
+
+  /**
+   * Return a pointer to the full column indices in #wide_colnums of the row
+   * @p row, whose columns can not be stored in #narrow_colnums.
+   */
+  const size_type *
+  wide_row_columns(const size_type row) const;
+
+  /**
+   * Release the arrays set up by store_narrow_column_indices(). This
+   * function is called when the structure of the object changes, which also
+   * sets up #colnums again.
+   */
+  void
+  clear_narrow_column_indices();
+
   // Make all sparse matrices friends of this class.
   template <typename number>
   friend class SparseMatrix;
@@ -1159,14 +1390,26 @@ private:
   friend class SparseILU;
   template <typename number>
   friend class ChunkSparseMatrix;
+  template <typename number>
+  friend class SymmetricSparseMatrix;
 
   friend class ChunkSparsityPattern;
   friend class DynamicSparsityPattern;
+  friend class SparsityPatternBuilder;
 
   // Also give access to internal details to the iterator/accessor classes.
   friend class SparsityPatternIterators::Iterator;
   friend class SparsityPatternIterators::Accessor;
   friend class ChunkSparsityPatternIterators::Accessor;
+
+  template <typename Function>
+  friend void
+  internal::SparsityPatternTools::for_each_entry_in_row(
+    const SparsityPattern &sparsity,
+    const size_type        row,
+    const std::size_t      begin,
+    const std::size_t      end,
+    const Function        &f);
 };
 
 
@@ -1184,6 +1427,7 @@ namespace SparsityPatternIterators
                             const std::size_t      i)
     : container(sparsity_pattern)
     , linear_index(i)
+    , current_row(numbers::invalid_size_type)
   {}
 
 
@@ -1191,6 +1435,7 @@ namespace SparsityPatternIterators
   inline Accessor::Accessor(const SparsityPattern *sparsity_pattern)
     : container(sparsity_pattern)
     , linear_index(container->rowstart[container->rows])
+    , current_row(numbers::invalid_size_type)
   {}
 
 
@@ -1198,6 +1443,7 @@ namespace SparsityPatternIterators
   inline Accessor::Accessor()
     : container(nullptr)
     , linear_index(numbers::invalid_size_type)
+    , current_row(numbers::invalid_size_type)
   {}
 
 
@@ -1206,8 +1452,12 @@ namespace SparsityPatternIterators
   Accessor::is_valid_entry() const
   {
     Assert(container != nullptr, DummyAccessor());
+    // narrow column indices are only stored for compressed patterns, in which
+    // all entries are valid
     return (linear_index < container->rowstart[container->rows] &&
-            container->colnums[linear_index] != SparsityPattern::invalid_entry);
+            (container->narrow_row_base != nullptr ||
+             container->colnums[linear_index] !=
+               SparsityPattern::invalid_entry));
   }
 
 
@@ -1231,7 +1481,26 @@ namespace SparsityPatternIterators
   {
     Assert(is_valid_entry() == true, ExcInvalidIterator());
 
-    return (container->colnums[linear_index]);
+    if (container->narrow_row_base == nullptr)
+      return (container->colnums[linear_index]);
+
+    // the column index depends on the row. when iterating over the entries,
+    // the accessor is usually either still in the same row as last time or
+    // has moved on to the next one, so only search for the row otherwise
+    const std::size_t *const rowstart = container->rowstart.get();
+    if (current_row == numbers::invalid_size_type ||
+        linear_index < rowstart[current_row] ||
+        linear_index >= rowstart[current_row + 1])
+      {
+        if (current_row != numbers::invalid_size_type &&
+            current_row + 1 < container->rows &&
+            linear_index >= rowstart[current_row + 1] &&
+            linear_index < rowstart[current_row + 2])
+          ++current_row;
+        else
+          current_row = row();
+      }
+    return container->column_index(current_row, linear_index);
   }
 
 
@@ -1306,7 +1575,8 @@ SparsityPattern::n_nonzero_elements() const
 {
   Assert(compressed, ExcNotCompressed());
 
-  if ((rowstart != nullptr) && (colnums != nullptr))
+  if ((rowstart != nullptr) &&
+      ((colnums != nullptr) || (narrow_row_base != nullptr)))
     return rowstart[rows] - rowstart[0];
   else
     // the object is empty or has zero size
@@ -1323,6 +1593,22 @@ SparsityPattern::is_compressed() const
 
 
 
+inline bool
+SparsityPattern::has_narrow_column_indices() const
+{
+  return narrow_row_base != nullptr;
+}
+
+
+
+inline bool
+SparsityPattern::has_column_index_map() const
+{
+  return column_index_map_is_stored.load(std::memory_order_acquire);
+}
+
+
+
 inline bool
 SparsityPattern::stores_only_added_elements() const
 {
@@ -1347,7 +1633,30 @@ SparsityPattern::column_number(const size_type    row,
   AssertIndexRange(row, rows);
   AssertIndexRange(index, row_length(row));
 
-  return colnums[rowstart[row] + index];
+  return column_index(row, rowstart[row] + index);
+}
+
+
+
+inline SparsityPattern::size_type
+SparsityPattern::column_index(const size_type row, const std::size_t j) const
+{
+  if (narrow_row_base == nullptr)
+    return colnums[j];
+  else if (narrow_row_base[row] != invalid_entry)
+    return narrow_row_base[row] + narrow_colnums[j];
+  else
+    return wide_row_columns(row)[j - rowstart[row]];
+}
+
+
+
+inline const SparsityPattern::size_type *
+SparsityPattern::wide_row_columns(const size_type row) const
+{
+  const auto p = std::lower_bound(wide_rows.begin(), wide_rows.end(), row);
+  Assert((p != wide_rows.end()) && (*p == row), ExcInternalError());
+  return wide_colnums.data() + wide_row_start[p - wide_rows.begin()];
 }
 
 
@@ -1426,6 +1735,51 @@ namespace internal
     {
       return i.first;
     }
+
+
+
+    /**
+     * Call <code>f(j, column)</code> for all positions @p j in the range
+     * [@p begin, @p end) of the index arrays of @p sparsity that belong to
+     * the given @p row, where @p column is the column index stored at
+     * position @p j. Unlike SparsityPattern::column_index(), this function
+     * decides only once per row where the column indices are stored, i.e.,
+     * in the full column indices or in the narrow representation set up by
+     * SparsityPattern::store_narrow_column_indices().
+     *
+     * This function is used in the computational kernels of the classes that
+     * have access to the internal data of SparsityPattern.
+     */
+    template <typename Function>
+    inline void
+    for_each_entry_in_row(const SparsityPattern &sparsity,
+                          const size_type        row,
+                          const std::size_t      begin,
+                          const std::size_t      end,
+                          const Function        &f)
+    {
+      if (sparsity.narrow_row_base == nullptr)
+        {
+          const size_type *const colnums = sparsity.colnums.get();
+          for (std::size_t j = begin; j < end; ++j)
+            f(j, colnums[j]);
+        }
+      else if (sparsity.narrow_row_base[row] != SparsityPattern::invalid_entry)
+        {
+          const size_type base = sparsity.narrow_row_base[row];
+          const SparsityPattern::narrow_index_type *const narrow_colnums =
+            sparsity.narrow_colnums.get();
+          for (std::size_t j = begin; j < end; ++j)
+            f(j, base + narrow_colnums[j]);
+        }
+      else
+        {
+          const size_type *const row_colnums = sparsity.wide_row_columns(row);
+          const std::size_t row_begin = sparsity.rowstart[row];
+          for (std::size_t j = begin; j < end; ++j)
+            f(j, row_colnums[j - row_begin]);
+        }
+    }
   } // namespace SparsityPatternTools
 } // namespace internal
 
@@ -1489,14 +1843,33 @@ SparsityPattern::save(Archive &ar, const unsigned int) const
   // forward to serialization function in the base class.
   ar &boost::serialization::base_object<const EnableObserverPointer>(*this);
 
-  ar &max_dim &rows &cols &max_vec_len &max_row_length &compressed;
+  // the narrow column indices are not written, but the full column indices
+  // reconstructed from them
+  std::size_t n_column_indices =
+    (has_narrow_column_indices() ? rowstart[rows] : max_vec_len);
+  ar &max_dim &rows &cols &n_column_indices &max_row_length &compressed;
 
   if (max_dim != 0)
     ar &boost::serialization::make_array(rowstart.get(), max_dim + 1);
   else
     Assert(rowstart.get() == nullptr, ExcInternalError());
 
-  if (max_vec_len != 0)
+  if (has_narrow_column_indices())
+    {
+      std::vector<size_type> column_indices(n_column_indices);
+      for (size_type row = 0; row < rows; ++row)
+        internal::SparsityPatternTools::for_each_entry_in_row(
+          *this,
+          row,
+          rowstart[row],
+          rowstart[row + 1],
+          [&](const std::size_t j, const size_type column) {
+            column_indices[j] = column;
+          });
+      ar &boost::serialization::make_array(column_indices.data(),
+                                           n_column_indices);
+    }
+  else if (max_vec_len != 0)
     ar &boost::serialization::make_array(colnums.get(), max_vec_len);
   else
     Assert(colnums.get() == nullptr, ExcInternalError());
@@ -1514,6 +1887,9 @@ SparsityPattern::load(Archive &ar, const unsigned int)
 
   ar &max_dim &rows &cols &max_vec_len &max_row_length &compressed;
 
+  clear_narrow_column_indices();
+  clear_column_index_map();
+
   if (max_dim != 0)
     {
       rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
@@ -0,0 +1,257 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparsity_pattern_builder_h
+#define dealii_sparsity_pattern_builder_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/thread_local_storage.h>
+
+#include <deal.II/lac/sparsity_pattern_base.h>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+class DynamicSparsityPattern;
+class SparsityPattern;
+#endif
+
+/**
+ * @addtogroup Sparsity
+ * @{
+ */
+
+
+/**
+ * A class that collects the entries of a sparsity pattern from several
+ * threads at once and converts them into a SparsityPattern or a
+ * DynamicSparsityPattern at the end.
+ *
+ * Adding entries to a DynamicSparsityPattern is not thread-safe, since
+ * every row is a sorted array into which new entries have to be inserted.
+ * This class, on the other hand, simply appends the entries to a buffer of
+ * (row, column) pairs that is private to the calling thread. The functions
+ * add(), add_row_entries(), and add_entries() may therefore be called
+ * concurrently, for example from the worker function of WorkStream::run()
+ * or through AffineConstraints::add_entries_local_to_global(). To keep the
+ * memory consumption in check, a buffer is sorted and duplicate entries are
+ * removed from it whenever it has grown to twice its size after the last
+ * such step.
+ *
+ * Once all entries have been added, copy_to() merges the buffers of all
+ * threads: the entries are distributed to their rows, and the rows are
+ * sorted and made unique in parallel. When copying into a SparsityPattern,
+ * its arrays are filled directly without going through an intermediate
+ * DynamicSparsityPattern.
+ *
+ * A typical use looks as follows:
+ * @code
+ * SparsityPatternBuilder builder(dof_handler.n_dofs(), dof_handler.n_dofs());
+ *
+ * // on several threads, for different cells:
+ * constraints.add_entries_local_to_global(local_dof_indices, builder);
+ *
+ * // after all threads have finished:
+ * SparsityPattern sparsity_pattern;
+ * builder.copy_to(sparsity_pattern);
+ * @endcode
+ *
+ * In contrast to the other sparsity pattern classes, this class provides no
+ * means to query the entries added so far.
+ */
+class SparsityPatternBuilder : public SparsityPatternBase
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Default constructor. Initialize an empty object with zero rows and
+   * columns.
+   */
+  SparsityPatternBuilder();
+
+  /**
+   * Initialize an object with @p m rows and @p n columns and no entries.
+   */
+  SparsityPatternBuilder(const size_type m, const size_type n);
+
+  /**
+   * Copy constructor. Only allowed for objects without entries, like all
+   * other sparsity pattern classes.
+   */
+  SparsityPatternBuilder(const SparsityPatternBuilder &builder);
+
+  /**
+   * Reinitialize the object to @p m rows and @p n columns and delete all
+   * entries added so far.
+   */
+  void
+  reinit(const size_type m, const size_type n);
+
+  /**
+   * Add the entry (@p i, @p j). This function may be called concurrently
+   * from several threads.
+   */
+  void
+  add(const size_type i, const size_type j);
+
+  /**
+   * Add the entries in the given columns to row @p row. This function may
+   * be called concurrently from several threads.
+   */
+  virtual void
+  add_row_entries(const size_type                  &row,
+                  const ArrayView<const size_type> &columns,
+                  const bool indices_are_sorted = false) override;
+
+  /**
+   * Add the given (row, column) pairs. This function may be called
+   * concurrently from several threads.
+   */
+  virtual void
+  add_entries(const ArrayView<const std::pair<size_type, size_type>> &entries)
+    override;
+
+  /**
+   * Copy the entries collected by the object into @p sparsity_pattern,
+   * which is reinitialized to the size of this object and compressed. As
+   * for SparsityPattern::copy_from(), the diagonal entries of a square
+   * pattern are always added.
+   *
+   * This function must not be called while entries are being added.
+   */
+  void
+  copy_to(SparsityPattern &sparsity_pattern) const;
+
+  /**
+   * Add the entries collected by the object to @p sparsity_pattern, which
+   * must have the same size as this object. Entries already present in
+   * @p sparsity_pattern are kept, and entries in rows not stored by
+   * @p sparsity_pattern (see DynamicSparsityPattern::row_index_set()) are
+   * ignored.
+   *
+   * This function must not be called while entries are being added.
+   */
+  void
+  copy_to(DynamicSparsityPattern &sparsity_pattern) const;
+
+  /**
+   * Return the number of (row, column) pairs currently stored in the
+   * buffers of all threads. Since duplicate entries are only removed from
+   * time to time, this is an upper bound for the number of distinct entries
+   * that have been added.
+   */
+  std::size_t
+  n_buffered_entries() const;
+
+  /**
+   * Return an estimate of the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The entries collected by one thread.
+   */
+  struct Buffer
+  {
+    /**
+     * The (row, column) pairs in the order they were added, except for the
+     * first @p n_compressed ones, which are sorted and unique.
+     */
+    std::vector<std::pair<size_type, size_type>> entries;
+
+    /**
+     * The number of entries after the last time the buffer was sorted and
+     * duplicates were removed.
+     */
+    std::size_t n_compressed = 0;
+  };
+
+  /**
+   * Return the buffer of the calling thread, creating it if necessary.
+   */
+  Buffer &
+  get_buffer();
+
+  /**
+   * Sort the given buffer and remove duplicate entries if it has grown
+   * sufficiently since the last time this was done.
+   */
+  static void
+  compress_buffer_if_large(Buffer &buffer);
+
+  /**
+   * Merge the buffers of all threads into a compressed row storage. On
+   * return, the sorted and unique columns of row @p r are stored at
+   * positions <code>row_start[r]</code> to
+   * <code>row_start[r]+row_lengths[r]-1</code> of @p columns.
+   */
+  void
+  gather_rows(std::vector<std::size_t>  &row_start,
+              std::vector<unsigned int> &row_lengths,
+              std::vector<size_type>    &columns) const;
+
+  /**
+   * The buffers of the individual threads.
+   */
+  Threads::ThreadLocalStorage<Buffer> thread_buffers;
+
+  /**
+   * Pointers to all objects in @p thread_buffers, since
+   * Threads::ThreadLocalStorage does not provide a way to loop over them.
+   */
+  std::vector<Buffer *> buffers;
+
+  /**
+   * A mutex guarding the insertion of new buffers into @p buffers.
+   */
+  mutable std::mutex buffers_mutex;
+};
+
+/**
+ * @}
+ */
+
+/* ---------------------------- Inline functions ---------------------------- */
+
+#ifndef DOXYGEN
+
+inline void
+SparsityPatternBuilder::add(const size_type i, const size_type j)
+{
+  AssertIndexRange(i, n_rows());
+  AssertIndexRange(j, n_cols());
+
+  Buffer &buffer = get_buffer();
+  buffer.entries.emplace_back(i, j);
+  compress_buffer_if_large(buffer);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
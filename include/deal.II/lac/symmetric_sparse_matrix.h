@@ -0,0 +1,527 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_symmetric_sparse_matrix_h
+#define dealii_symmetric_sparse_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/enable_observer_pointer.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/observer_pointer.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class Vector;
+template <typename number>
+class SparseMatrix;
+template <typename number>
+class SparseMIC;
+#endif
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix that is symmetric and of which only the diagonal and the
+ * entries right of the diagonal, i.e., the upper triangle, are stored.
+ *
+ * The matrices arising from the discretization of self-adjoint problems,
+ * such as the Laplace equation or linear elasticity, are symmetric. The
+ * SparseMatrix class nevertheless stores both triangles, which doubles the
+ * memory used for values and column indices as well as the memory traffic of
+ * a matrix-vector product, the dominating cost of iterative solvers. This
+ * class instead only stores the upper triangle in the compressed row format
+ * and obtains the entries of the lower triangle by symmetry.
+ *
+ * The structure of the matrix is given by a SparsityPattern that contains
+ * only the upper triangle, with the diagonal element stored first in each
+ * row as for all square sparsity patterns. Such a pattern is most easily
+ * obtained by building the usual full pattern and then dropping the lower
+ * triangle with SparsityPattern::copy_upper_triangle_from():
+ * @code
+ *   DynamicSparsityPattern dsp(dof_handler.n_dofs());
+ *   DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+ *   sparsity_pattern.copy_upper_triangle_from(dsp);
+ *
+ *   SymmetricSparseMatrix<double> system_matrix(sparsity_pattern);
+ *   // ... assemble ...
+ *   constraints.distribute_local_to_global(cell_matrix,
+ *                                          cell_rhs,
+ *                                          local_dof_indices,
+ *                                          system_matrix,
+ *                                          system_rhs);
+ *
+ *   PreconditionSSOR<SymmetricSparseMatrix<double>> preconditioner;
+ *   preconditioner.initialize(system_matrix);
+ *   solver.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ *
+ * Entries may be written with set() and add() for any pair of indices.
+ * Entries left of the diagonal are silently ignored since they are
+ * determined by their counterparts right of the diagonal. Consequently, the
+ * full local matrix can be handed to add(), and
+ * AffineConstraints::distribute_local_to_global() only computes and
+ * transfers the entries of the upper triangle in the first place. Read
+ * access through operator()() and el() works for both triangles.
+ *
+ * The class offers the subset of the interface of SparseMatrix that is used
+ * by the iterative solvers and the relaxation preconditioners, namely
+ * vmult(), Tvmult(), residual(), precondition_Jacobi(), and
+ * precondition_SSOR(). It can therefore be used in SolverCG,
+ * PreconditionJacobi, or PreconditionSSOR, and SparseMIC can be initialized
+ * from it, in which case the decomposition is stored as a triangle as well.
+ *
+ * <h3>Parallelization of the matrix-vector product</h3>
+ *
+ * In a matrix-vector product, each stored entry $a_{ij}$ with $j>i$
+ * contributes to both $(Ax)_i$ and $(Ax)_j$. A row-wise split of the work
+ * among threads as done by SparseMatrix would therefore let different
+ * threads write into the same entries of the destination vector. This class
+ * instead splits the rows into blocks of fixed size and determines for each
+ * block the range of destination entries it writes to, which extends from
+ * its first row to the largest column index within the block. The blocks are
+ * then colored such that blocks of the same color write to disjoint ranges.
+ * The colors are processed one after the other, and the blocks of one color
+ * in parallel, without any synchronization. Since the blocks do not depend
+ * on the number of threads, the result does not either.
+ *
+ * @note Instantiations for this template are provided for <tt>@<float@> and
+ * @<double@></tt>; others can be generated in application programs (see the
+ * section on
+ * @ref Instantiations
+ * in the manual).
+ */
+template <typename number>
+class SymmetricSparseMatrix : public virtual EnableObserverPointer
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries. This alias is analogous to
+   * <tt>value_type</tt> in the standard library containers.
+   */
+  using value_type = number;
+
+  /**
+   * Constructor; initializes the matrix to be empty, without any structure.
+   * You have to call reinit() before the object can be used.
+   */
+  SymmetricSparseMatrix();
+
+  /**
+   * Constructor. Use the given sparsity pattern, which must only contain the
+   * upper triangle, and set all values to zero. See reinit() for details.
+   */
+  explicit SymmetricSparseMatrix(const SparsityPattern &sparsity);
+
+  /**
+   * Reinitialize the matrix with the given sparsity pattern and set all
+   * values to zero. The sparsity pattern must be square, compressed, and
+   * must not contain entries left of the diagonal, as created by
+   * SparsityPattern::copy_upper_triangle_from(). Like for the SparseMatrix
+   * class, a pointer to the sparsity pattern is stored, so the pattern needs
+   * to live at least as long as this object.
+   */
+  void
+  reinit(const SparsityPattern &sparsity);
+
+  /**
+   * Copy the upper triangle of the given matrix, which is assumed to be
+   * symmetric. All entries of the sparsity pattern of this object need to
+   * be present in the sparsity pattern of @p matrix.
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Set all stored entries to zero. The only value allowed for @p d is
+   * zero.
+   */
+  SymmetricSparseMatrix &
+  operator=(const double d);
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space. This is the same as m().
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of stored entries, i.e., the number of entries of the
+   * upper triangle including the diagonal.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Set the element (<i>i,j</i>) to @p value. If <i>j&lt;i</i>, the call is
+   * ignored since the entry is defined by the element (<i>j,i</i>). Throws
+   * an error if the entry is right of the diagonal but does not exist in the
+   * sparsity pattern.
+   */
+  void
+  set(const size_type i, const size_type j, const number value);
+
+  /**
+   * Add @p value to the element (<i>i,j</i>). If <i>j&lt;i</i>, the call is
+   * ignored since the entry is defined by the element (<i>j,i</i>). Throws
+   * an error if the entry is right of the diagonal but does not exist in the
+   * sparsity pattern.
+   */
+  void
+  add(const size_type i, const size_type j, const number value);
+
+  /**
+   * Add an array of values given by @p values in the given global matrix
+   * row at columns specified by @p col_indices. Columns left of the diagonal
+   * are ignored. The arguments are the same as for SparseMatrix::add(), and
+   * the shortcuts for sorted columns and zero values are used in the same
+   * way.
+   */
+  template <typename number2>
+  void
+  add(const size_type  row,
+      const size_type  n_cols,
+      const size_type *col_indices,
+      const number2   *values,
+      const bool       elide_zero_values      = true,
+      const bool       col_indices_are_sorted = false);
+
+  /**
+   * Return the value of the entry (<i>i,j</i>), which may be located in
+   * either triangle of the matrix. Throws an error if the entry does not
+   * exist in the sparsity pattern.
+   */
+  const number &
+  operator()(const size_type i, const size_type j) const;
+
+  /**
+   * Like operator()(), but return zero for entries that do not exist in
+   * the sparsity pattern.
+   */
+  number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Return the main diagonal element in the <i>i</i>th row.
+   */
+  number
+  diag_element(const size_type i) const;
+
+  /**
+   * Matrix-vector multiplication: let <i>dst = M*src</i> with <i>M</i>
+   * being this matrix.
+   *
+   * This function is run in parallel over blocks of rows if multithreading
+   * is enabled, see the general documentation of this class.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Matrix-vector multiplication with the transpose, which is the same as
+   * vmult() for a symmetric matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add <i>M*src</i> on <i>dst</i> with
+   * <i>M</i> being this matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication with the transpose, which is the
+   * same as vmult_add() for a symmetric matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Compute the residual of an equation <i>Mx=b</i>, where the residual is
+   * defined to be <i>r=b-Mx</i>. Write the residual into @p dst. The
+   * <i>l<sub>2</sub></i> norm of the residual vector is returned.
+   */
+  template <typename somenumber>
+  somenumber
+  residual(Vector<somenumber>       &dst,
+           const Vector<somenumber> &x,
+           const Vector<somenumber> &b) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * <tt>src</tt> vector by the inverse of the respective diagonal element and
+   * multiplies the result with the relaxation factor <tt>omega</tt>.
+   */
+  template <typename somenumber>
+  void
+  precondition_Jacobi(Vector<somenumber>       &dst,
+                      const Vector<somenumber> &src,
+                      const number              omega = 1.) const;
+
+  /**
+   * Apply SSOR preconditioning to <tt>src</tt> with damping <tt>omega</tt>,
+   * with the same result as SparseMatrix::precondition_SSOR() on the full
+   * matrix. The forward sweep with the lower triangle is done by scattering
+   * the entries of the rows of the upper triangle into the later rows.
+   *
+   * The last argument is only present for interface compatibility with
+   * SparseMatrix::precondition_SSOR() and is ignored since no entries are
+   * stored left of the diagonal.
+   */
+  template <typename somenumber>
+  void
+  precondition_SSOR(Vector<somenumber>             &dst,
+                    const Vector<somenumber>       &src,
+                    const number                    omega = 1.,
+                    const std::vector<std::size_t> &pos_right_of_diagonal =
+                      std::vector<std::size_t>()) const;
+
+  /**
+   * Return a reference to the underlying sparsity pattern of this matrix.
+   */
+  const SparsityPattern &
+  get_sparsity_pattern() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception
+   */
+  DeclException2(ExcInvalidIndex,
+                 int,
+                 int,
+                 << "You are trying to access the matrix entry with index <"
+                 << arg1 << ',' << arg2
+                 << ">, but this entry does not exist in the sparsity pattern "
+                    "of this matrix.");
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcNotUpperTriangular,
+                   "The sparsity pattern of a SymmetricSparseMatrix must be "
+                   "square and must not contain entries left of the "
+                   "diagonal. Use SparsityPattern::copy_upper_triangle_from() "
+                   "to create it.");
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+  /** @} */
+
+private:
+  /**
+   * Compute <i>dst += M*src</i> in parallel over the colored blocks.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_add_on_blocks(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Pointer to the sparsity pattern used for this matrix.
+   */
+  ObserverPointer<const SparsityPattern, SymmetricSparseMatrix<number>> cols;
+
+  /**
+   * The values of the entries in the upper triangle, in the order of the
+   * entries of the sparsity pattern.
+   */
+  AlignedVector<number> values;
+
+  /**
+   * The first row of each block of rows used by vmult(), with one
+   * additional entry at the end that contains the number of rows.
+   */
+  std::vector<size_type> block_start;
+
+  /**
+   * The blocks sorted by their color, such that the blocks of color
+   * <i>c</i> are located in the range given by <tt>color_start[c]</tt> and
+   * <tt>color_start[c+1]</tt>.
+   */
+  std::vector<unsigned int> color_blocks;
+
+  /**
+   * The start of each color in #color_blocks, with one additional entry at
+   * the end.
+   */
+  std::vector<unsigned int> color_start;
+
+  // SparseMIC reads the values directly when computing a decomposition that
+  // is stored as a triangle as well
+  template <typename>
+  friend class SparseMIC;
+};
+
+/** @} */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline typename SymmetricSparseMatrix<number>::size_type
+SymmetricSparseMatrix<number>::m() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  return cols->n_rows();
+}
+
+
+
+template <typename number>
+inline typename SymmetricSparseMatrix<number>::size_type
+SymmetricSparseMatrix<number>::n() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  return cols->n_cols();
+}
+
+
+
+template <typename number>
+inline void
+SymmetricSparseMatrix<number>::set(const size_type i,
+                                   const size_type j,
+                                   const number    value)
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertIsFinite(value);
+  if (j < i)
+    return;
+
+  const size_type index = cols->operator()(i, j);
+  if (index != SparsityPattern::invalid_entry)
+    values[index] = value;
+  else
+    Assert(value == number(), ExcInvalidIndex(i, j));
+}
+
+
+
+template <typename number>
+inline void
+SymmetricSparseMatrix<number>::add(const size_type i,
+                                   const size_type j,
+                                   const number    value)
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertIsFinite(value);
+  if (j < i || value == number())
+    return;
+
+  const size_type index = cols->operator()(i, j);
+  Assert(index != SparsityPattern::invalid_entry, ExcInvalidIndex(i, j));
+  values[index] += value;
+}
+
+
+
+template <typename number>
+inline const number &
+SymmetricSparseMatrix<number>::operator()(const size_type i,
+                                          const size_type j) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  const size_type index =
+    (j < i ? cols->operator()(j, i) : cols->operator()(i, j));
+  AssertThrow(index != SparsityPattern::invalid_entry, ExcInvalidIndex(i, j));
+  return values[index];
+}
+
+
+
+template <typename number>
+inline number
+SymmetricSparseMatrix<number>::el(const size_type i, const size_type j) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  const size_type index =
+    (j < i ? cols->operator()(j, i) : cols->operator()(i, j));
+  if (index != SparsityPattern::invalid_entry)
+    return values[index];
+  else
+    return number();
+}
+
+
+
+template <typename number>
+inline number
+SymmetricSparseMatrix<number>::diag_element(const size_type i) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertIndexRange(i, m());
+  return values[cols->rowstart[i]];
+}
+
+
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,513 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_symmetric_sparse_matrix_templates_h
+#define dealii_symmetric_sparse_matrix_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/symmetric_sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace SymmetricSparseMatrixImplementation
+  {
+    using size_type = types::global_dof_index;
+
+    /**
+     * The number of rows of a block in the colored matrix-vector product.
+     * The blocks do not depend on the number of threads, which keeps the
+     * result independent of it.
+     */
+    constexpr unsigned int rows_per_block = 256;
+
+    /**
+     * Add the product of the rows within the half-open range
+     * [@p begin_row, @p end_row) of the upper triangle and their transposes
+     * with @p src to @p dst. This touches the entries of @p dst from
+     * @p begin_row up to the largest column index of these rows.
+     */
+    template <typename number, typename InVector, typename OutVector>
+    void
+    vmult_add_on_subrange(const size_type        begin_row,
+                          const size_type        end_row,
+                          const number          *values,
+                          const std::size_t     *rowstart,
+                          const SparsityPattern &sparsity,
+                          const InVector        &src,
+                          OutVector             &dst)
+    {
+      using OutNumber = typename OutVector::value_type;
+
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          const OutNumber src_row = src(row);
+          OutNumber       s       = OutNumber(values[rowstart[row]]) * src_row;
+          SparsityPatternTools::for_each_entry_in_row(
+            sparsity,
+            row,
+            rowstart[row] + 1,
+            rowstart[row + 1],
+            [&](const std::size_t j, const size_type column) {
+              s += OutNumber(values[j]) * OutNumber(src(column));
+              dst(column) += OutNumber(values[j]) * src_row;
+            });
+          dst(row) += s;
+        }
+    }
+  } // namespace SymmetricSparseMatrixImplementation
+} // namespace internal
+
+
+
+template <typename number>
+SymmetricSparseMatrix<number>::SymmetricSparseMatrix()
+  : cols(nullptr, "SymmetricSparseMatrix")
+{}
+
+
+
+template <typename number>
+SymmetricSparseMatrix<number>::SymmetricSparseMatrix(
+  const SparsityPattern &sparsity)
+  : SymmetricSparseMatrix()
+{
+  reinit(sparsity);
+}
+
+
+
+template <typename number>
+void
+SymmetricSparseMatrix<number>::reinit(const SparsityPattern &sparsity)
+{
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  Assert(sparsity.n_rows() == sparsity.n_cols(), ExcNotUpperTriangular());
+
+  const size_type n_rows = sparsity.n_rows();
+  if constexpr (running_in_debug_mode())
+    {
+      for (size_type row = 0; row < n_rows; ++row)
+        for (std::size_t j = sparsity.rowstart[row] + 1;
+             j < sparsity.rowstart[row + 1];
+             ++j)
+          Assert(sparsity.column_index(row, j) > row,
+                 ExcNotUpperTriangular());
+    }
+
+  cols = &sparsity;
+  values.resize_fast(sparsity.n_nonzero_elements());
+  std::fill(values.begin(), values.end(), number());
+
+  // split the rows into blocks and determine for each block the last entry
+  // of the destination vector it writes to in vmult()
+  using internal::SymmetricSparseMatrixImplementation::rows_per_block;
+  const unsigned int n_blocks = (n_rows + rows_per_block - 1) / rows_per_block;
+  block_start.resize(n_blocks + 1);
+  std::vector<size_type> block_last_row(n_blocks);
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      block_start[block] = size_type(block) * rows_per_block;
+      const size_type end_row =
+        std::min<size_type>(block_start[block] + rows_per_block, n_rows);
+      size_type last_row = end_row - 1;
+      for (size_type row = block_start[block]; row < end_row; ++row)
+        if (sparsity.rowstart[row + 1] > sparsity.rowstart[row] + 1)
+          last_row = std::max(
+            last_row,
+            sparsity.column_index(row, sparsity.rowstart[row + 1] - 1));
+      block_last_row[block] = last_row;
+    }
+  block_start[n_blocks] = n_rows;
+
+  // color the blocks greedily. the blocks are sorted by their first row, so
+  // a block can get a color if the last range of that color ends before the
+  // block starts
+  std::vector<unsigned int> block_color(n_blocks);
+  std::vector<size_type>    color_last_row;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      unsigned int color = 0;
+      while (color < color_last_row.size() &&
+             color_last_row[color] >= block_start[block])
+        ++color;
+      if (color == color_last_row.size())
+        color_last_row.push_back(block_last_row[block]);
+      else
+        color_last_row[color] = block_last_row[block];
+      block_color[block] = color;
+    }
+
+  const unsigned int n_colors = color_last_row.size();
+  color_start.assign(n_colors + 1, 0);
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    ++color_start[block_color[block] + 1];
+  for (unsigned int color = 0; color < n_colors; ++color)
+    color_start[color + 1] += color_start[color];
+  std::vector<unsigned int> next_position(color_start.begin(),
+                                          color_start.end() - 1);
+  color_blocks.resize(n_blocks);
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    color_blocks[next_position[block_color[block]]++] = block;
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SymmetricSparseMatrix<number>::copy_from(const SparseMatrix<number2> &matrix)
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertDimension(matrix.m(), m());
+  AssertDimension(matrix.n(), n());
+
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    [this, &matrix](const size_type begin_row, const size_type end_row) {
+      for (size_type row = begin_row; row < end_row; ++row)
+        for (std::size_t j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          values[j] = number(matrix(row, cols->column_index(row, j)));
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+void
+SymmetricSparseMatrix<number>::clear()
+{
+  cols = nullptr;
+  values.clear();
+  block_start.clear();
+  color_blocks.clear();
+  color_start.clear();
+}
+
+
+
+template <typename number>
+SymmetricSparseMatrix<number> &
+SymmetricSparseMatrix<number>::operator=(const double d)
+{
+  (void)d;
+  Assert(d == 0, ExcScalarAssignmentOnlyForZeroValue());
+  Assert(cols != nullptr, ExcNotInitialized());
+
+  std::fill(values.begin(), values.end(), number());
+  return *this;
+}
+
+
+
+template <typename number>
+std::size_t
+SymmetricSparseMatrix<number>::n_nonzero_elements() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  return cols->n_nonzero_elements();
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SymmetricSparseMatrix<number>::add(const size_type  row,
+                                   const size_type  n_cols,
+                                   const size_type *col_indices,
+                                   const number2   *values_to_add,
+                                   const bool       elide_zero_values,
+                                   const bool       col_indices_are_sorted)
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertIndexRange(row, m());
+
+  const std::size_t row_begin = cols->rowstart[row];
+  const std::size_t row_end   = cols->rowstart[row + 1];
+
+  if (col_indices_are_sorted)
+    {
+      // skip the columns left of the diagonal and walk along the row,
+      // analogous to SparseMatrix::add()
+      size_type k = 0;
+      while (k < n_cols && col_indices[k] < row)
+        ++k;
+      std::size_t index = row_begin + 1;
+      for (; k < n_cols; ++k)
+        {
+          const size_type column = col_indices[k];
+          AssertIsFinite(values_to_add[k]);
+          if (elide_zero_values && values_to_add[k] == number2())
+            continue;
+          if (column == row)
+            {
+              values[row_begin] += number(values_to_add[k]);
+              continue;
+            }
+          while (index < row_end && cols->column_index(row, index) < column)
+            ++index;
+          Assert(index < row_end && cols->column_index(row, index) == column,
+                 ExcInvalidIndex(row, column));
+          values[index] += number(values_to_add[k]);
+        }
+    }
+  else
+    for (size_type k = 0; k < n_cols; ++k)
+      if (!elide_zero_values || values_to_add[k] != number2())
+        add(row, col_indices[k], number(values_to_add[k]));
+}
+
+
+
+template <typename number>
+const SparsityPattern &
+SymmetricSparseMatrix<number>::get_sparsity_pattern() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  return *cols;
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SymmetricSparseMatrix<number>::vmult_add_on_blocks(OutVector      &dst,
+                                                   const InVector &src) const
+{
+  // the blocks of one color write to disjoint ranges of the destination
+  // vector, so they can be worked on concurrently. colors are processed one
+  // after the other
+  for (unsigned int color = 0; color + 1 < color_start.size(); ++color)
+    parallel::apply_to_subranges(
+      color_start[color],
+      color_start[color + 1],
+      [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+        for (unsigned int b = begin; b < end; ++b)
+          {
+            const unsigned int block = color_blocks[b];
+            internal::SymmetricSparseMatrixImplementation::
+              vmult_add_on_subrange(block_start[block],
+                                    block_start[block + 1],
+                                    values.data(),
+                                    cols->rowstart.get(),
+                                    *cols,
+                                    src,
+                                    dst);
+          }
+      },
+      1);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SymmetricSparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  dst = 0;
+  vmult_add_on_blocks(dst, src);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SymmetricSparseMatrix<number>::Tvmult(OutVector &dst, const InVector &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SymmetricSparseMatrix<number>::vmult_add(OutVector      &dst,
+                                         const InVector &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  vmult_add_on_blocks(dst, src);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SymmetricSparseMatrix<number>::Tvmult_add(OutVector      &dst,
+                                          const InVector &src) const
+{
+  vmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+somenumber
+SymmetricSparseMatrix<number>::residual(Vector<somenumber>       &dst,
+                                        const Vector<somenumber> &u,
+                                        const Vector<somenumber> &b) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(m() == b.size(), ExcDimensionMismatch(m(), b.size()));
+  Assert(n() == u.size(), ExcDimensionMismatch(n(), u.size()));
+
+  Assert(&u != &dst, ExcSourceEqualsDestination());
+
+  // the contributions to a row are only complete after all colors have been
+  // processed, so compute the product first and the residual afterwards
+  vmult(dst, u);
+  dst.sadd(-1., 1., b);
+  return dst.l2_norm();
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SymmetricSparseMatrix<number>::precondition_Jacobi(
+  Vector<somenumber>       &dst,
+  const Vector<somenumber> &src,
+  const number              omega) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    [this, &src, &dst, omega](const size_type begin_row,
+                              const size_type end_row) {
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          const number diagonal = values[cols->rowstart[row]];
+          Assert(diagonal != number(), ExcDivideByZero());
+          dst(row) = somenumber(omega) * src(row) / somenumber(diagonal);
+        }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SymmetricSparseMatrix<number>::precondition_SSOR(
+  Vector<somenumber>       &dst,
+  const Vector<somenumber> &src,
+  const number              omega,
+  const std::vector<std::size_t> &) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  const size_type          n        = src.size();
+  const SparsityPattern   &sparsity = *cols;
+  const std::size_t *const rowstart = sparsity.rowstart.get();
+
+  // forward sweep with the lower triangle, i.e., the transpose of the stored
+  // upper triangle: once the value of a row is final, subtract its
+  // contribution from the later rows it couples to
+  dst = src;
+  for (size_type row = 0; row < n; ++row)
+    {
+      Assert(values[rowstart[row]] != number(), ExcDivideByZero());
+      dst(row) /= somenumber(values[rowstart[row]]);
+      const somenumber scaled_dst_row = somenumber(omega) * dst(row);
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        sparsity,
+        row,
+        rowstart[row] + 1,
+        rowstart[row + 1],
+        [&](const std::size_t j, const size_type column) {
+          dst(column) -= somenumber(values[j]) * scaled_dst_row;
+        });
+    }
+
+  for (size_type row = 0; row < n; ++row)
+    dst(row) *= somenumber(omega * (number(2.) - omega)) *
+                somenumber(values[rowstart[row]]);
+
+  // backward sweep with the stored upper triangle
+  for (size_type row = n; row-- > 0;)
+    {
+      somenumber s = 0;
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        sparsity,
+        row,
+        rowstart[row] + 1,
+        rowstart[row + 1],
+        [&](const std::size_t j, const size_type column) {
+          s += somenumber(values[j]) * dst(column);
+        });
+
+      dst(row) = (dst(row) - s * somenumber(omega)) /
+                 somenumber(values[rowstart[row]]);
+    }
+}
+
+
+
+template <typename number>
+std::size_t
+SymmetricSparseMatrix<number>::memory_consumption() const
+{
+  return sizeof(*this) + values.memory_consumption() +
+         MemoryConsumption::memory_consumption(block_start) +
+         MemoryConsumption::memory_consumption(color_blocks) +
+         MemoryConsumption::memory_consumption(color_start);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
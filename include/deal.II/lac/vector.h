@@ -321,6 +321,14 @@ public:
    * If @p omit_zeroing_entries is false, the vector is filled by zeros.
    * Otherwise, the elements are left an unspecified state.
    *
+   * Newly allocated memory is not touched by this function other than for
+   * filling it with zeros, which is done in parallel with the same
+   * partitioning among threads as the other vector operations. On machines
+   * with several NUMA domains, the operating system then places each memory
+   * page close to the thread that later works on it ("first touch"). The
+   * same holds if @p omit_zeroing_entries is true and the first operation on
+   * the vector is a vector operation running in parallel.
+   *
    * This function is virtual in order to allow for derived classes to handle
    * memory separately.
    */
@@ -1453,8 +1461,8 @@ Vector<Number>::reinit(const Vector<Number2> &v,
   // the vector, else there is nothing to be done
   if (!omit_zeroing_entries || size() != v.size())
     {
-      do_reinit(v.size(), omit_zeroing_entries, false);
       thread_loop_partitioner = v.thread_loop_partitioner;
+      do_reinit(v.size(), omit_zeroing_entries, false);
     }
 }
 
@@ -1081,12 +1081,21 @@ Vector<Number>::do_reinit(const size_type new_size,
                           const bool      omit_zeroing_entries,
                           const bool      reset_partitioner)
 {
+  // if the memory needs to grow, release the old entries first rather than
+  // letting AlignedVector copy them into the new memory, as they are
+  // overwritten anyway
+  if (new_size > values.capacity())
+    values.clear();
   values.resize_fast(new_size);
-  if (!omit_zeroing_entries)
-    values.fill();
 
   if (reset_partitioner)
     maybe_reset_thread_partitioner();
+
+  // set the entries to zero with the same partitioning among threads as the
+  // vector operations, such that each memory page is first touched, and
+  // hence placed on the NUMA domain, by the thread that later works on it
+  if (!omit_zeroing_entries)
+    *this = Number();
 }
 
 
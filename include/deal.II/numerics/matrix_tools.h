@@ -26,6 +26,7 @@
 #include <deal.II/numerics/matrix_creator.h>
 
 #include <map>
+#include <vector>
 
 #ifdef DEAL_II_WITH_PETSC
 #  include <petscsys.h>
@@ -46,6 +47,7 @@ template <typename number>
 class FullMatrix;
 template <typename number>
 class SparseMatrix;
+class SparsityPattern;
 
 template <typename number>
 class BlockSparseMatrix;
@@ -223,7 +225,12 @@ namespace TrilinosWrappers
  * composed, but the general principle is the same. Alternatively, one can
  * use the constrained_linear_operator() function. In its documentation you can
  * also find a formal (mathematical) description of the process of modifying the
- * matrix and right hand side vectors for boundary values.
+ * matrix and right hand side vectors for boundary values. If the system matrix
+ * is re-initialized from the unmodified matrix in each time step and the set of
+ * boundary degrees of freedom does not change, the class
+ * MatrixTools::BoundaryValueElimination can be used to find the matrix entries
+ * affected by the elimination only once, and to apply the boundary values in
+ * each time step with a cost proportional to the number of these entries.
  *
  *
  * <h3>Local elimination</h3>
@@ -325,6 +332,139 @@ namespace MatrixTools
     Vector<number>                                  &right_hand_side,
     const bool                                       eliminate_columns = true);
 
+  /**
+   * A class that stores the matrix entries that need to be changed when
+   * applying Dirichlet boundary conditions to a SparseMatrix with a given
+   * sparsity pattern and a given set of boundary degrees of freedom, in order
+   * to apply the boundary conditions repeatedly, for example in every time
+   * step of a time-dependent problem in which the system matrix is
+   * re-initialized from an unmodified matrix. The result of apply() is the
+   * same as the one of the apply_boundary_values() function for SparseMatrix
+   * objects, which uses this class internally.
+   *
+   * The constructor, or reinit(), determines the rows of the matrix that have
+   * entries in the columns of boundary degrees of freedom, along with the
+   * positions of these entries within the rows, by scanning these rows once.
+   * The function apply() then visits only these entries and the rows of the
+   * boundary degrees of freedom, without searching for the transposed entries
+   * in the sparsity pattern. Both the rows of the boundary degrees of freedom
+   * and the rows with entries to be eliminated are processed in parallel with
+   * the threads available to deal.II.
+   * The work and memory of reinit() are proportional to the number of entries
+   * in these rows, up to a logarithmic factor, and do not depend on the total
+   * size of the matrix, so that the apply_boundary_values() function that
+   * creates a temporary object of this class remains cheap for few boundary
+   * degrees of freedom.
+   *
+   * The following code applies boundary values in each time step:
+   * @code
+   *   MatrixTools::BoundaryValueElimination elimination(boundary_values,
+   *                                                     sparsity_pattern);
+   *   for (unsigned int step = 0; step < n_steps; ++step)
+   *     {
+   *       system_matrix.copy_from(unmodified_matrix);
+   *       ... // assemble system_rhs, compute boundary_values for this step
+   *       elimination.apply(boundary_values,
+   *                         system_matrix,
+   *                         solution,
+   *                         system_rhs);
+   *       ... // solve
+   *     }
+   * @endcode
+   */
+  class BoundaryValueElimination
+  {
+  public:
+    /**
+     * Default constructor. Call reinit() before using the object.
+     */
+    BoundaryValueElimination() = default;
+
+    /**
+     * Constructor, calling reinit() with the given arguments.
+     */
+    template <typename number>
+    BoundaryValueElimination(
+      const std::map<types::global_dof_index, number> &boundary_values,
+      const SparsityPattern                           &sparsity_pattern,
+      const bool eliminate_columns = true);
+
+    /**
+     * Determine the matrix entries affected by applying boundary conditions
+     * on the degrees of freedom given as the keys of @p boundary_values to a
+     * matrix using @p sparsity_pattern. The values of the map are not used,
+     * since they may change between calls to apply(). The argument
+     * @p eliminate_columns has the same meaning as for
+     * apply_boundary_values(). As in that function, the elimination of
+     * columns requires a symmetric sparsity pattern.
+     */
+    template <typename number>
+    void
+    reinit(const std::map<types::global_dof_index, number> &boundary_values,
+           const SparsityPattern                           &sparsity_pattern,
+           const bool eliminate_columns = true);
+
+    /**
+     * Apply the boundary values to the system matrix and vectors as
+     * apply_boundary_values() does. The @p matrix must use the sparsity
+     * pattern given to reinit(), and @p boundary_values must contain the
+     * same degrees of freedom as the map given to reinit().
+     */
+    template <typename number>
+    void
+    apply(const std::map<types::global_dof_index, number> &boundary_values,
+          SparseMatrix<number>                            &matrix,
+          Vector<number>                                  &solution,
+          Vector<number> &right_hand_side) const;
+
+    /**
+     * Return an estimate of the memory consumption of this object in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The sparsity pattern given to reinit(), only used to check that
+     * apply() is called with a matching matrix.
+     */
+    const SparsityPattern *sparsity_pattern = nullptr;
+
+    /**
+     * Whether the columns of the boundary degrees of freedom are eliminated.
+     */
+    bool eliminate_columns = true;
+
+    /**
+     * The boundary degrees of freedom, in ascending order.
+     */
+    std::vector<types::global_dof_index> boundary_dofs;
+
+    /**
+     * The rows that are not boundary degrees of freedom, but have entries in
+     * the columns of boundary degrees of freedom, in ascending order.
+     */
+    std::vector<types::global_dof_index> eliminated_rows;
+
+    /**
+     * The start of the entries of each row of #eliminated_rows in the
+     * arrays #entry_positions and #entry_boundary_indices, with one
+     * additional element for the end of the last row.
+     */
+    std::vector<std::size_t> eliminated_row_starts;
+
+    /**
+     * The positions of the entries to be eliminated within their rows.
+     */
+    std::vector<unsigned int> entry_positions;
+
+    /**
+     * The index within #boundary_dofs of the column of each entry to be
+     * eliminated.
+     */
+    std::vector<types::global_dof_index> entry_boundary_indices;
+  };
+
   /**
    * Apply Dirichlet boundary conditions to the system matrix and vectors as
    * described in the general documentation of this namespace. This function
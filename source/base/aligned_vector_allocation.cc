@@ -0,0 +1,211 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/aligned_vector_allocation.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef __linux__
+#  include <sys/mman.h>
+#endif
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace AlignedVectorAllocation
+{
+  void *
+  Standard::allocate(const std::size_t n_bytes, const std::size_t alignment)
+  {
+    void *ptr;
+    Utilities::System::posix_memalign(&ptr, alignment, n_bytes);
+    return ptr;
+  }
+
+
+
+  void
+  Standard::deallocate(void *ptr, const std::size_t, const std::size_t)
+  {
+    std::free(ptr);
+  }
+
+
+
+  HugePages::HugePages(const std::size_t threshold)
+    : threshold(threshold)
+  {}
+
+
+
+  void *
+  HugePages::allocate(const std::size_t n_bytes, const std::size_t alignment)
+  {
+    void *ptr;
+    if (n_bytes < std::max<std::size_t>(threshold, 1))
+      Utilities::System::posix_memalign(&ptr, alignment, n_bytes);
+    else
+      {
+        // round up to full huge pages, as the kernel can only back entire
+        // aligned 2 MB ranges by a huge page
+        const std::size_t n_bytes_rounded =
+          (n_bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+        Utilities::System::posix_memalign(&ptr,
+                                          std::max(alignment, huge_page_size),
+                                          n_bytes_rounded);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        // this is only a hint to the kernel, which can fail if transparent
+        // huge pages are disabled, so ignore the return value
+        (void)madvise(ptr, n_bytes_rounded, MADV_HUGEPAGE);
+#endif
+      }
+    return ptr;
+  }
+
+
+
+  void
+  HugePages::deallocate(void *ptr, const std::size_t, const std::size_t)
+  {
+    std::free(ptr);
+  }
+
+
+
+  Pool::Pool(const std::shared_ptr<Allocator> &underlying,
+             const std::size_t                 max_pooled_bytes)
+    : underlying(underlying ? underlying : std::make_shared<Standard>())
+    , max_pooled_bytes(max_pooled_bytes)
+    , pooled_bytes(0)
+  {}
+
+
+
+  Pool::~Pool()
+  {
+    release_unused_memory();
+  }
+
+
+
+  void *
+  Pool::allocate(const std::size_t n_bytes, const std::size_t alignment)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto entry = free_blocks.find(std::make_pair(n_bytes, alignment));
+      if (entry != free_blocks.end())
+        {
+          void *ptr = entry->second;
+          free_blocks.erase(entry);
+          pooled_bytes -= n_bytes;
+          return ptr;
+        }
+    }
+
+    // no block of the right size available, so allocate a new one outside
+    // the lock
+    return underlying->allocate(n_bytes, alignment);
+  }
+
+
+
+  void
+  Pool::deallocate(void             *ptr,
+                   const std::size_t n_bytes,
+                   const std::size_t alignment)
+  {
+    if (ptr == nullptr)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (n_bytes <= max_pooled_bytes - pooled_bytes)
+        {
+          free_blocks.emplace(std::make_pair(n_bytes, alignment), ptr);
+          pooled_bytes += n_bytes;
+          return;
+        }
+    }
+
+    underlying->deallocate(ptr, n_bytes, alignment);
+  }
+
+
+
+  void
+  Pool::release_unused_memory()
+  {
+    std::multimap<std::pair<std::size_t, std::size_t>, void *> blocks;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      blocks.swap(free_blocks);
+      pooled_bytes = 0;
+    }
+
+    for (const auto &block : blocks)
+      underlying->deallocate(block.second,
+                             block.first.first,
+                             block.first.second);
+  }
+
+
+
+  std::size_t
+  Pool::n_pooled_bytes() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pooled_bytes;
+  }
+
+
+
+  namespace
+  {
+    std::mutex                 default_allocator_mutex;
+    std::shared_ptr<Allocator> default_allocator;
+  } // namespace
+
+
+
+  namespace internal
+  {
+    std::atomic<bool> default_allocator_is_set(false);
+  } // namespace internal
+
+
+
+  void
+  set_default_allocator(const std::shared_ptr<Allocator> &allocator)
+  {
+    std::lock_guard<std::mutex> lock(default_allocator_mutex);
+    default_allocator = allocator;
+    internal::default_allocator_is_set = (allocator != nullptr);
+  }
+
+
+
+  std::shared_ptr<Allocator>
+  get_default_allocator()
+  {
+    std::lock_guard<std::mutex> lock(default_allocator_mutex);
+    return default_allocator;
+  }
+} // namespace AlignedVectorAllocation
+
+
+DEAL_II_NAMESPACE_CLOSE
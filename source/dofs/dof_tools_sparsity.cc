@@ -12,10 +12,12 @@
 //
 // ------------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria_base.h>
@@ -39,7 +41,9 @@
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
+#include <deal.II/lac/sparsity_pattern_builder.h>
 #include <deal.II/lac/vector.h>
 
 #include <algorithm>
@@ -51,6 +55,102 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace DoFTools
 {
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * Scratch arrays for the functions that add the couplings of a cell
+       * to a sparsity pattern.
+       */
+      struct SparsityScratchData
+      {
+        std::vector<types::global_dof_index> dofs_on_this_cell;
+        std::vector<types::global_dof_index> dofs_on_other_cell;
+      };
+
+
+
+      /**
+       * The functions that add the couplings of a cell to a sparsity
+       * pattern do not need to copy anything, so this class is empty.
+       */
+      struct SparsityCopyData
+      {};
+
+
+
+      /**
+       * Call @p cell_worker for all locally owned active cells of @p dof
+       * that belong to the subdomain @p subdomain_id (or all of them if
+       * @p subdomain_id equals numbers::invalid_subdomain_id), together with
+       * the sparsity pattern to which the worker adds the couplings of the
+       * cell.
+       *
+       * If @p sparsity is a DynamicSparsityPattern and more than one thread
+       * is available, the cells are worked on in parallel using
+       * WorkStream::run(). Since adding entries to a DynamicSparsityPattern
+       * is not thread-safe, the workers then add to a SparsityPatternBuilder
+       * whose entries are copied into @p sparsity at the end. Otherwise, the
+       * cells are worked on one after the other and add to @p sparsity
+       * directly.
+       */
+      template <int dim, int spacedim, typename CellWorker>
+      void
+      loop_over_owned_cells(const DoFHandler<dim, spacedim> &dof,
+                            const types::subdomain_id        subdomain_id,
+                            SparsityPatternBase             &sparsity,
+                            const CellWorker                &cell_worker)
+      {
+        using active_cell_iterator =
+          typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+        // In case we work with a distributed sparsity pattern of Trilinos
+        // type, we only have to do the work if the current cell is owned by
+        // the calling processor. Otherwise, just continue.
+        const auto cell_is_relevant =
+          [subdomain_id](const active_cell_iterator &cell) {
+            return ((subdomain_id == numbers::invalid_subdomain_id) ||
+                    (subdomain_id == cell->subdomain_id())) &&
+                   cell->is_locally_owned();
+          };
+
+        SparsityScratchData scratch_data;
+        scratch_data.dofs_on_this_cell.reserve(
+          dof.get_fe_collection().max_dofs_per_cell());
+        scratch_data.dofs_on_other_cell.reserve(
+          dof.get_fe_collection().max_dofs_per_cell());
+
+        auto *dynamic_sparsity =
+          dynamic_cast<DynamicSparsityPattern *>(&sparsity);
+        if (dynamic_sparsity != nullptr && MultithreadInfo::n_threads() > 1)
+          {
+            SparsityPatternBuilder builder(sparsity.n_rows(),
+                                           sparsity.n_cols());
+            WorkStream::run(
+              dof.begin_active(),
+              active_cell_iterator(dof.end()),
+              [&](const active_cell_iterator &cell,
+                  SparsityScratchData        &scratch,
+                  SparsityCopyData &) {
+                if (cell_is_relevant(cell))
+                  cell_worker(cell, scratch, builder);
+              },
+              std::function<void(const SparsityCopyData &)>(),
+              scratch_data,
+              SparsityCopyData());
+            builder.copy_to(*dynamic_sparsity);
+          }
+        else
+          for (const auto &cell : dof.active_cell_iterators())
+            if (cell_is_relevant(cell))
+              cell_worker(cell, scratch_data, sparsity);
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
   template <int dim, int spacedim, typename number>
   void
   make_sparsity_pattern(const DoFHandler<dim, spacedim> &dof,
@@ -89,35 +189,33 @@ namespace DoFTools
         fe_dof_mask[f] = fe_collection[f].get_local_dof_sparsity_pattern();
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          const types::fe_index fe_index = cell->active_fe_index();
-          if (fe_dof_mask[fe_index].empty())
-            constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                    sparsity,
-                                                    keep_constrained_dofs);
-          else
-            constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                    sparsity,
-                                                    keep_constrained_dofs,
-                                                    fe_dof_mask[fe_index]);
-        }
+    internal::loop_over_owned_cells(
+      dof,
+      subdomain_id,
+      sparsity,
+      [&](const auto                    &cell,
+          internal::SparsityScratchData &scratch_data,
+          SparsityPatternBase           &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
+        dofs_on_this_cell.resize(dofs_per_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        const types::fe_index fe_index = cell->active_fe_index();
+        if (fe_dof_mask[fe_index].empty())
+          constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                  cell_sparsity,
+                                                  keep_constrained_dofs);
+        else
+          constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                  cell_sparsity,
+                                                  keep_constrained_dofs,
+                                                  fe_dof_mask[fe_index]);
+      });
   }
 
 
@@ -188,33 +286,31 @@ namespace DoFTools
               bool_dof_mask[f](i, j) = true;
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell(
-      fe_collection.max_dofs_per_cell());
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const types::fe_index fe_index = cell->active_fe_index();
-          const unsigned int    dofs_per_cell =
-            fe_collection[fe_index].n_dofs_per_cell();
-
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs,
-                                                  bool_dof_mask[fe_index]);
-        }
+    internal::loop_over_owned_cells(
+      dof,
+      subdomain_id,
+      sparsity,
+      [&](const auto                    &cell,
+          internal::SparsityScratchData &scratch_data,
+          SparsityPatternBase           &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        const types::fe_index fe_index = cell->active_fe_index();
+        const unsigned int    dofs_per_cell =
+          fe_collection[fe_index].n_dofs_per_cell();
+
+        dofs_on_this_cell.resize(dofs_per_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs,
+                                                bool_dof_mask[fe_index]);
+      });
   }
 
 
@@ -580,139 +676,137 @@ namespace DoFTools
                  "locally owned one does not make sense."));
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    std::vector<types::global_dof_index> dofs_on_other_cell;
-    dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-    dofs_on_other_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-
     // TODO: in an old implementation, we used user flags before to tag
     // faces that were already touched. this way, we could reduce the work
     // a little bit. now, we instead add only data from one side. this
     // should be OK, but we need to actually verify it.
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const unsigned int n_dofs_on_this_cell =
-            cell->get_fe().n_dofs_per_cell();
-          dofs_on_this_cell.resize(n_dofs_on_this_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs);
-
-          for (const unsigned int face : cell->face_indices())
-            {
-              typename DoFHandler<dim, spacedim>::face_iterator cell_face =
-                cell->face(face);
-              const bool periodic_neighbor = cell->has_periodic_neighbor(face);
-              if (!cell->at_boundary(face) || periodic_neighbor)
-                {
-                  typename DoFHandler<dim, spacedim>::level_cell_iterator
-                    neighbor = cell->neighbor_or_periodic_neighbor(face);
-
-                  // in 1d, we do not need to worry whether the neighbor
-                  // might have children and then loop over those children.
-                  // rather, we may as well go straight to the cell behind
-                  // this particular cell's most terminal child
-                  if (dim == 1)
-                    while (neighbor->has_children())
-                      neighbor = neighbor->child(face == 0 ? 1 : 0);
-
-                  if (neighbor->has_children())
-                    {
-                      for (unsigned int sub_nr = 0;
-                           sub_nr != cell_face->n_active_descendants();
-                           ++sub_nr)
-                        {
-                          const typename DoFHandler<dim, spacedim>::
-                            level_cell_iterator sub_neighbor =
-                              periodic_neighbor ?
-                                cell->periodic_neighbor_child_on_subface(
-                                  face, sub_nr) :
-                                cell->neighbor_child_on_subface(face, sub_nr);
-
-                          const unsigned int n_dofs_on_neighbor =
-                            sub_neighbor->get_fe().n_dofs_per_cell();
-                          dofs_on_other_cell.resize(n_dofs_on_neighbor);
-                          sub_neighbor->get_dof_indices(dofs_on_other_cell);
-
-                          constraints.add_entries_local_to_global(
-                            dofs_on_this_cell,
-                            dofs_on_other_cell,
-                            sparsity,
-                            keep_constrained_dofs);
+    internal::loop_over_owned_cells(
+      dof,
+      subdomain_id,
+      sparsity,
+      [&](const auto                    &cell,
+          internal::SparsityScratchData &scratch_data,
+          SparsityPatternBase           &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        std::vector<types::global_dof_index> &dofs_on_other_cell =
+          scratch_data.dofs_on_other_cell;
+
+        const unsigned int n_dofs_on_this_cell =
+          cell->get_fe().n_dofs_per_cell();
+        dofs_on_this_cell.resize(n_dofs_on_this_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs);
+
+        for (const unsigned int face : cell->face_indices())
+          {
+            typename DoFHandler<dim, spacedim>::face_iterator cell_face =
+              cell->face(face);
+            const bool periodic_neighbor = cell->has_periodic_neighbor(face);
+            if (!cell->at_boundary(face) || periodic_neighbor)
+              {
+                typename DoFHandler<dim, spacedim>::level_cell_iterator
+                  neighbor = cell->neighbor_or_periodic_neighbor(face);
+
+                // in 1d, we do not need to worry whether the neighbor
+                // might have children and then loop over those children.
+                // rather, we may as well go straight to the cell behind
+                // this particular cell's most terminal child
+                if (dim == 1)
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                if (neighbor->has_children())
+                  {
+                    for (unsigned int sub_nr = 0;
+                         sub_nr != cell_face->n_active_descendants();
+                         ++sub_nr)
+                      {
+                        const typename DoFHandler<dim, spacedim>::
+                          level_cell_iterator sub_neighbor =
+                            periodic_neighbor ?
+                              cell->periodic_neighbor_child_on_subface(
+                                face, sub_nr) :
+                              cell->neighbor_child_on_subface(face, sub_nr);
+
+                        const unsigned int n_dofs_on_neighbor =
+                          sub_neighbor->get_fe().n_dofs_per_cell();
+                        dofs_on_other_cell.resize(n_dofs_on_neighbor);
+                        sub_neighbor->get_dof_indices(dofs_on_other_cell);
+
+                        constraints.add_entries_local_to_global(
+                          dofs_on_this_cell,
+                          dofs_on_other_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        constraints.add_entries_local_to_global(
+                          dofs_on_other_cell,
+                          dofs_on_this_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        // only need to add this when the neighbor is not
+                        // owned by the current processor, otherwise we add
+                        // the entries for the neighbor there
+                        if (sub_neighbor->subdomain_id() !=
+                            cell->subdomain_id())
                           constraints.add_entries_local_to_global(
                             dofs_on_other_cell,
-                            dofs_on_this_cell,
-                            sparsity,
+                            cell_sparsity,
                             keep_constrained_dofs);
-                          // only need to add this when the neighbor is not
-                          // owned by the current processor, otherwise we add
-                          // the entries for the neighbor there
-                          if (sub_neighbor->subdomain_id() !=
-                              cell->subdomain_id())
-                            constraints.add_entries_local_to_global(
-                              dofs_on_other_cell,
-                              sparsity,
-                              keep_constrained_dofs);
-                        }
-                    }
-                  else
-                    {
-                      // Refinement edges are taken care of by coarser
-                      // cells
-                      if ((!periodic_neighbor &&
-                           cell->neighbor_is_coarser(face)) ||
-                          (periodic_neighbor &&
-                           cell->periodic_neighbor_is_coarser(face)))
-                        if (neighbor->subdomain_id() == cell->subdomain_id())
-                          continue;
-
-                      const unsigned int n_dofs_on_neighbor =
-                        neighbor->get_fe().n_dofs_per_cell();
-                      dofs_on_other_cell.resize(n_dofs_on_neighbor);
-
-                      neighbor->get_dof_indices(dofs_on_other_cell);
-
-                      constraints.add_entries_local_to_global(
-                        dofs_on_this_cell,
-                        dofs_on_other_cell,
-                        sparsity,
-                        keep_constrained_dofs);
-
-                      // only need to add these in case the neighbor cell
-                      // is not locally owned - otherwise, we touch each
-                      // face twice and hence put the indices the other way
-                      // around
-                      if (!cell->neighbor_or_periodic_neighbor(face)
-                             ->is_active() ||
-                          (neighbor->subdomain_id() != cell->subdomain_id()))
-                        {
+                      }
+                  }
+                else
+                  {
+                    // Refinement edges are taken care of by coarser
+                    // cells
+                    if ((!periodic_neighbor &&
+                         cell->neighbor_is_coarser(face)) ||
+                        (periodic_neighbor &&
+                         cell->periodic_neighbor_is_coarser(face)))
+                      if (neighbor->subdomain_id() == cell->subdomain_id())
+                        continue;
+
+                    const unsigned int n_dofs_on_neighbor =
+                      neighbor->get_fe().n_dofs_per_cell();
+                    dofs_on_other_cell.resize(n_dofs_on_neighbor);
+
+                    neighbor->get_dof_indices(dofs_on_other_cell);
+
+                    constraints.add_entries_local_to_global(
+                      dofs_on_this_cell,
+                      dofs_on_other_cell,
+                      cell_sparsity,
+                      keep_constrained_dofs);
+
+                    // only need to add these in case the neighbor cell
+                    // is not locally owned - otherwise, we touch each
+                    // face twice and hence put the indices the other way
+                    // around
+                    if (!cell->neighbor_or_periodic_neighbor(face)
+                           ->is_active() ||
+                        (neighbor->subdomain_id() != cell->subdomain_id()))
+                      {
+                        constraints.add_entries_local_to_global(
+                          dofs_on_other_cell,
+                          dofs_on_this_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        if (neighbor->subdomain_id() != cell->subdomain_id())
                           constraints.add_entries_local_to_global(
                             dofs_on_other_cell,
-                            dofs_on_this_cell,
-                            sparsity,
+                            cell_sparsity,
                             keep_constrained_dofs);
-                          if (neighbor->subdomain_id() != cell->subdomain_id())
-                            constraints.add_entries_local_to_global(
-                              dofs_on_other_cell,
-                              sparsity,
-                              keep_constrained_dofs);
-                        }
-                    }
-                }
-            }
-        }
+                      }
+                  }
+              }
+          }
+      });
   }
 
 
@@ -0,0 +1,492 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/numbers.h>
+
+#include <deal.II/lac/precondition_amg.h>
+
+#include <algorithm>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  /**
+   * The largest size of the coarsest matrix that is inverted as a
+   * FullMatrix, unless AdditionalData::max_coarse_size is larger.
+   */
+  constexpr unsigned int max_direct_coarse_size = 1000;
+
+  /**
+   * Coarsening is stopped if a level has more than this fraction of the
+   * unknowns of the next finer level.
+   */
+  constexpr double min_coarsening_ratio = 0.9;
+
+
+
+  /**
+   * Return an upper bound for the largest eigenvalue of $D^{-1}A$ by the
+   * Gershgorin circle theorem.
+   */
+  double
+  gershgorin_bound(const SparseMatrix<double> &matrix)
+  {
+    double bound = 0;
+    for (types::global_dof_index row = 0; row < matrix.m(); ++row)
+      {
+        double row_sum = 0;
+        for (auto entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+          row_sum += std::abs(entry->value());
+        bound = std::max(bound, row_sum / std::abs(matrix.diag_element(row)));
+      }
+    return bound;
+  }
+
+
+
+  /**
+   * Group the unknowns of the given matrix into aggregates of strongly
+   * coupled unknowns with the three phases of the algorithm by Vanek, Mandel
+   * and Brezina. Return the number of aggregates, and in @p aggregate the
+   * aggregate each unknown belongs to, or numbers::invalid_unsigned_int for
+   * unknowns without strong couplings.
+   */
+  unsigned int
+  compute_aggregates(const SparseMatrix<double> &matrix,
+                     const double                strong_threshold,
+                     std::vector<unsigned int>  &aggregate)
+  {
+    using size_type               = types::global_dof_index;
+    const size_type    n          = matrix.m();
+    const unsigned int unassigned = numbers::invalid_unsigned_int;
+
+    // collect the strong couplings of each row, together with their
+    // strength relative to the diagonal entries
+    std::vector<std::size_t> strong_start(n + 1, 0);
+    std::vector<size_type>   strong_columns;
+    std::vector<double>      strong_values;
+    for (size_type row = 0; row < n; ++row)
+      {
+        const double diagonal = std::abs(matrix.diag_element(row));
+        for (auto entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+          {
+            const size_type column = entry->column();
+            if (column == row || entry->value() == 0.)
+              continue;
+            const double strength =
+              std::abs(entry->value()) /
+              std::sqrt(diagonal * std::abs(matrix.diag_element(column)));
+            if (strength >= strong_threshold)
+              {
+                strong_columns.push_back(column);
+                strong_values.push_back(strength);
+              }
+          }
+        strong_start[row + 1] = strong_columns.size();
+      }
+
+    const auto is_isolated = [&](const size_type row) {
+      return strong_start[row] == strong_start[row + 1];
+    };
+
+    aggregate.assign(n, unassigned);
+    unsigned int n_aggregates = 0;
+
+    // phase 1: form an aggregate from each unknown whose strong neighbors
+    // are all still unassigned
+    for (size_type row = 0; row < n; ++row)
+      {
+        if (is_isolated(row) || aggregate[row] != unassigned)
+          continue;
+
+        bool neighbors_unassigned = true;
+        for (std::size_t k = strong_start[row]; k < strong_start[row + 1]; ++k)
+          if (aggregate[strong_columns[k]] != unassigned)
+            {
+              neighbors_unassigned = false;
+              break;
+            }
+
+        if (neighbors_unassigned)
+          {
+            aggregate[row] = n_aggregates;
+            for (std::size_t k = strong_start[row]; k < strong_start[row + 1];
+                 ++k)
+              aggregate[strong_columns[k]] = n_aggregates;
+            ++n_aggregates;
+          }
+      }
+
+    // phase 2: add the remaining unknowns to the aggregate of phase 1 they
+    // are most strongly coupled to
+    const std::vector<unsigned int> first_aggregates = aggregate;
+    for (size_type row = 0; row < n; ++row)
+      {
+        if (is_isolated(row) || aggregate[row] != unassigned)
+          continue;
+
+        double strongest = 0;
+        for (std::size_t k = strong_start[row]; k < strong_start[row + 1]; ++k)
+          if (first_aggregates[strong_columns[k]] != unassigned &&
+              strong_values[k] > strongest)
+            {
+              aggregate[row] = first_aggregates[strong_columns[k]];
+              strongest      = strong_values[k];
+            }
+      }
+
+    // phase 3: form new aggregates from the unknowns that are still left,
+    // together with their unassigned strong neighbors
+    for (size_type row = 0; row < n; ++row)
+      {
+        if (is_isolated(row) || aggregate[row] != unassigned)
+          continue;
+
+        aggregate[row] = n_aggregates;
+        for (std::size_t k = strong_start[row]; k < strong_start[row + 1]; ++k)
+          if (aggregate[strong_columns[k]] == unassigned)
+            aggregate[strong_columns[k]] = n_aggregates;
+        ++n_aggregates;
+      }
+
+    return n_aggregates;
+  }
+
+
+
+  /**
+   * Compute the smoothed prolongation $(I - \omega D^{-1} A) P_\text{tent}$
+   * from the given aggregates.
+   */
+  void
+  compute_prolongation(const SparseMatrix<double>      &matrix,
+                       const std::vector<unsigned int> &aggregate,
+                       const unsigned int               n_aggregates,
+                       const double                     max_eigenvalue_bound,
+                       SparseMatrix<double>            &prolongation)
+  {
+    using size_type   = types::global_dof_index;
+    const size_type n = matrix.m();
+
+    // the tentative prolongation injects the constant function on each
+    // aggregate, normalized to unit length
+    std::vector<unsigned int> aggregate_sizes(n_aggregates, 0);
+    for (const unsigned int a : aggregate)
+      if (a != numbers::invalid_unsigned_int)
+        ++aggregate_sizes[a];
+
+    SparsityPattern tentative_sparsity(n, n_aggregates, 1);
+    for (size_type row = 0; row < n; ++row)
+      if (aggregate[row] != numbers::invalid_unsigned_int)
+        tentative_sparsity.add(row, aggregate[row]);
+    tentative_sparsity.compress();
+
+    SparseMatrix<double> tentative(tentative_sparsity);
+    for (size_type row = 0; row < n; ++row)
+      if (aggregate[row] != numbers::invalid_unsigned_int)
+        tentative.set(row,
+                      aggregate[row],
+                      1. / std::sqrt(aggregate_sizes[aggregate[row]]));
+
+    // then apply one step of damped Jacobi. the product A P_tent contains
+    // the entries of P_tent because the diagonal of A is nonzero
+    matrix.mmult(prolongation, tentative);
+
+    const double omega = 4. / (3. * max_eigenvalue_bound);
+    for (size_type row = 0; row < n; ++row)
+      {
+        const double scaling = -omega / matrix.diag_element(row);
+        for (auto entry = prolongation.begin(row);
+             entry != prolongation.end(row);
+             ++entry)
+          entry->value() *= scaling;
+
+        if (aggregate[row] != numbers::invalid_unsigned_int)
+          prolongation.add(row,
+                           aggregate[row],
+                           1. / std::sqrt(aggregate_sizes[aggregate[row]]));
+      }
+  }
+} // namespace
+
+
+
+PreconditionAMG::AdditionalData::AdditionalData(
+  const double       strong_threshold,
+  const unsigned int max_coarse_size,
+  const unsigned int max_n_levels,
+  const SmootherType smoother_type,
+  const unsigned int smoother_sweeps,
+  const double       smoothing_range)
+  : strong_threshold(strong_threshold)
+  , max_coarse_size(max_coarse_size)
+  , max_n_levels(max_n_levels)
+  , smoother_type(smoother_type)
+  , smoother_sweeps(smoother_sweeps)
+  , smoothing_range(smoothing_range)
+{}
+
+
+
+PreconditionAMG::PreconditionAMG() = default;
+
+
+
+PreconditionAMG::~PreconditionAMG() = default;
+
+
+
+void
+PreconditionAMG::initialize(const SparseMatrix<double> &matrix,
+                            const AdditionalData       &additional_data)
+{
+  AssertDimension(matrix.m(), matrix.n());
+  Assert(additional_data.max_n_levels > 0,
+         ExcMessage("The hierarchy needs at least one level."));
+
+  clear();
+  this->additional_data = additional_data;
+
+  levels.push_back(std::make_unique<Level>());
+  levels.back()->matrix = &matrix;
+
+  while (true)
+    {
+      Level                      &level = *levels.back();
+      const SparseMatrix<double> &A     = *level.matrix;
+
+      level.solution.reinit(A.m());
+      level.rhs.reinit(A.m());
+
+      const double max_eigenvalue_bound = gershgorin_bound(A);
+
+      std::vector<unsigned int> aggregate;
+      unsigned int              n_aggregates = 0;
+      if (A.m() > additional_data.max_coarse_size &&
+          levels.size() < additional_data.max_n_levels)
+        n_aggregates =
+          compute_aggregates(A, additional_data.strong_threshold, aggregate);
+
+      // stop if the level is small enough or if the aggregation does not
+      // make the matrix smaller any more, and set up the coarse solver
+      if (n_aggregates == 0 || n_aggregates > min_coarsening_ratio * A.m())
+        {
+          if (A.m() <= std::max(additional_data.max_coarse_size,
+                                max_direct_coarse_size))
+            {
+              coarse_inverse.copy_from(A);
+              coarse_inverse.gauss_jordan();
+            }
+          else
+            setup_smoother(level, max_eigenvalue_bound);
+          break;
+        }
+
+      setup_smoother(level, max_eigenvalue_bound);
+      level.residual.reinit(A.m());
+
+      level.prolongation.reinit(level.prolongation_sparsity);
+      compute_prolongation(
+        A, aggregate, n_aggregates, max_eigenvalue_bound, level.prolongation);
+
+      // the Galerkin product P^T A P for the next coarser level
+      auto coarse = std::make_unique<Level>();
+      coarse->coarse_matrix.reinit(coarse->coarse_sparsity);
+      A.PtAP(coarse->coarse_matrix, level.prolongation);
+      coarse->matrix = &coarse->coarse_matrix;
+      levels.push_back(std::move(coarse));
+    }
+}
+
+
+
+void
+PreconditionAMG::setup_smoother(Level       &level,
+                                const double max_eigenvalue_bound) const
+{
+  const SparseMatrix<double> &A = *level.matrix;
+
+  if (additional_data.smoother_type == AdditionalData::SmootherType::chebyshev)
+    {
+      using ChebyshevType =
+        PreconditionChebyshev<SparseMatrix<double>,
+                              Vector<double>,
+                              DiagonalMatrix<Vector<double>>>;
+      ChebyshevType::AdditionalData data;
+      data.degree          = additional_data.smoother_sweeps;
+      data.smoothing_range = additional_data.smoothing_range;
+
+      // use the eigenvalue bound rather than an estimate by the Lanczos
+      // method, which needs LAPACK and would run during the first vmult()
+      data.eig_cg_n_iterations = 0;
+      data.max_eigenvalue      = max_eigenvalue_bound;
+      data.preconditioner = std::make_shared<DiagonalMatrix<Vector<double>>>();
+      Vector<double> &inverse_diagonal = data.preconditioner->get_vector();
+      inverse_diagonal.reinit(A.m());
+      for (types::global_dof_index i = 0; i < A.m(); ++i)
+        inverse_diagonal(i) = 1. / A.diag_element(i);
+
+      level.chebyshev = std::make_unique<ChebyshevType>();
+      level.chebyshev->initialize(A, data);
+    }
+  else
+    {
+      level.jacobi =
+        std::make_unique<PreconditionJacobi<SparseMatrix<double>>>();
+      level.jacobi->initialize(
+        A,
+        PreconditionJacobi<SparseMatrix<double>>::AdditionalData(
+          4. / (3. * max_eigenvalue_bound), additional_data.smoother_sweeps));
+    }
+}
+
+
+
+void
+PreconditionAMG::clear()
+{
+  levels.clear();
+  coarse_inverse.reinit(0, 0);
+}
+
+
+
+void
+PreconditionAMG::v_cycle(const unsigned int l) const
+{
+  const Level &level = *levels[l];
+
+  if (l == levels.size() - 1 && level.chebyshev == nullptr &&
+      level.jacobi == nullptr)
+    {
+      coarse_inverse.vmult(level.solution, level.rhs);
+      return;
+    }
+
+  // pre-smoothing with zero starting guess
+  if (level.chebyshev)
+    level.chebyshev->vmult(level.solution, level.rhs);
+  else
+    level.jacobi->vmult(level.solution, level.rhs);
+
+  if (l == levels.size() - 1)
+    return;
+
+  // coarse grid correction
+  const Level &coarse = *levels[l + 1];
+  level.matrix->residual(level.residual, level.solution, level.rhs);
+  level.prolongation.Tvmult(coarse.rhs, level.residual);
+  v_cycle(l + 1);
+  level.prolongation.vmult_add(level.solution, coarse.solution);
+
+  // post-smoothing
+  if (level.chebyshev)
+    level.chebyshev->step(level.solution, level.rhs);
+  else
+    level.jacobi->step(level.solution, level.rhs);
+}
+
+
+
+void
+PreconditionAMG::vmult(Vector<double> &dst, const Vector<double> &src) const
+{
+  Assert(!levels.empty(), ExcNotInitialized());
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+
+  levels[0]->rhs = src;
+  v_cycle(0);
+  dst = levels[0]->solution;
+}
+
+
+
+void
+PreconditionAMG::Tvmult(Vector<double> &dst, const Vector<double> &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+PreconditionAMG::size_type
+PreconditionAMG::m() const
+{
+  Assert(!levels.empty(), ExcNotInitialized());
+  return levels[0]->matrix->m();
+}
+
+
+
+PreconditionAMG::size_type
+PreconditionAMG::n() const
+{
+  Assert(!levels.empty(), ExcNotInitialized());
+  return levels[0]->matrix->n();
+}
+
+
+
+unsigned int
+PreconditionAMG::n_levels() const
+{
+  return levels.size();
+}
+
+
+
+const SparseMatrix<double> &
+PreconditionAMG::get_matrix(const unsigned int level) const
+{
+  AssertIndexRange(level, levels.size());
+  return *levels[level]->matrix;
+}
+
+
+
+double
+PreconditionAMG::operator_complexity() const
+{
+  Assert(!levels.empty(), ExcNotInitialized());
+
+  std::size_t n_nonzero_elements = 0;
+  for (const auto &level : levels)
+    n_nonzero_elements += level->matrix->n_nonzero_elements();
+  return static_cast<double>(n_nonzero_elements) /
+         levels[0]->matrix->n_nonzero_elements();
+}
+
+
+
+std::size_t
+PreconditionAMG::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) + coarse_inverse.memory_consumption();
+  for (const auto &level : levels)
+    memory += sizeof(Level) + level->coarse_sparsity.memory_consumption() +
+              level->coarse_matrix.memory_consumption() +
+              level->prolongation_sparsity.memory_consumption() +
+              level->prolongation.memory_consumption() +
+              level->solution.memory_consumption() +
+              level->rhs.memory_consumption() +
+              level->residual.memory_consumption();
+  return memory;
+}
+
+DEAL_II_NAMESPACE_CLOSE
@@ -244,13 +244,16 @@ namespace internal
     template <bool delayed_reorthogonalization, typename Number>
     double
     do_subtract_and_norm(const unsigned int                 n_vectors,
-                         const std::size_t                  locally_owned_size,
+                         const std::size_t                  begin,
+                         const std::size_t                  end,
                          const std::vector<const Number *> &orthogonal_vectors,
                          const Vector<double>              &h,
                          Number                            *current_vector)
     {
       double norm_vv_temp = 0;
 
+      const std::size_t size = end - begin;
+
       Number *previous_vector =
         const_cast<Number *>(orthogonal_vectors[n_vectors - 1]);
       const double inverse_norm_previous =
@@ -272,16 +275,16 @@ namespace internal
       // As for the do_Tvmult_add loop above, we perform loop blocking on both
       // the 'i' and 'c' variable to help hardware prefetchers to perform
       // adequately, and get three nested loops here plus the inner loops. See
-      // the extensive comments above for the full rationale.
-      unsigned int       j = 0;
-      unsigned int       c = 0;
-      const unsigned int loop_length_c =
-        locally_owned_size / n_lanes / inner_batch_size;
+      // the extensive comments above for the full rationale. The index j
+      // runs over the entries [begin, end) the function is called for.
+      std::size_t        j             = begin;
+      unsigned int       c             = 0;
+      const unsigned int loop_length_c = size / n_lanes / inner_batch_size;
       const unsigned int loop_length_i = (n_vectors + 7) / 8;
       for (unsigned int c_block = 0; c_block < (loop_length_c + 63) / 64;
            ++c_block)
         for (unsigned int i_block = 0; i_block < (n_vectors + 7) / 8; ++i_block)
-          for (c = c_block * 64, j = c * n_lanes * inner_batch_size;
+          for (c = c_block * 64, j = begin + c * n_lanes * inner_batch_size;
                c < std::min(loop_length_c, (c_block + 1) * 64);
                ++c, j += n_lanes * inner_batch_size)
             {
@@ -345,7 +348,7 @@ namespace internal
             }
 
       c *= inner_batch_size;
-      for (; c < locally_owned_size / n_lanes; ++c, j += n_lanes)
+      for (; c < size / n_lanes; ++c, j += n_lanes)
         {
           VectorizedArray<double> temp, prev_vector;
           temp.load(current_vector + j);
@@ -380,7 +383,7 @@ namespace internal
       if (!delayed_reorthogonalization)
         norm_vv_temp += norm_vv_temp_vectorized.sum();
 
-      for (; j < locally_owned_size; ++j)
+      for (; j < end; ++j)
         {
           double temp        = current_vector[j];
           double prev_vector = previous_vector[j];
@@ -415,7 +418,8 @@ namespace internal
     template <typename Number>
     void
     do_add(const unsigned int                 n_vectors,
-           const std::size_t                  locally_owned_size,
+           const std::size_t                  begin,
+           const std::size_t                  end,
            const std::vector<const Number *> &tmp_vectors,
            const Vector<double>              &h,
            const bool                         zero_out,
@@ -424,9 +428,10 @@ namespace internal
       static constexpr unsigned int n_lanes = VectorizedArray<double>::size();
       constexpr unsigned int        inner_batch_size = 12;
 
-      unsigned int j = 0;
-      unsigned int c = 0;
-      for (; c < locally_owned_size / n_lanes / inner_batch_size;
+      const std::size_t size = end - begin;
+      std::size_t       j    = begin;
+      unsigned int      c    = 0;
+      for (; c < size / n_lanes / inner_batch_size;
            ++c, j += n_lanes * inner_batch_size)
         {
           VectorizedArray<double> temp[inner_batch_size];
@@ -453,7 +458,7 @@ namespace internal
         }
 
       c *= inner_batch_size;
-      for (; c < locally_owned_size / n_lanes; ++c, j += n_lanes)
+      for (; c < size / n_lanes; ++c, j += n_lanes)
         {
           VectorizedArray<double> temp = {};
           if (!zero_out)
@@ -469,7 +474,7 @@ namespace internal
           temp.store(output + j);
         }
 
-      for (; j < locally_owned_size; ++j)
+      for (; j < end; ++j)
         {
           double temp = zero_out ? 0.0 : output[j];
           for (unsigned int i = 0; i < n_vectors; ++i)
@@ -71,6 +71,13 @@ namespace
 } // namespace
 
 
+SparseDirectUMFPACK::AdditionalData::AdditionalData(
+  const bool reuse_symbolic_factorization)
+  : reuse_symbolic_factorization(reuse_symbolic_factorization)
+{}
+
+
+
 SparseDirectUMFPACK::~SparseDirectUMFPACK()
 {
   clear();
@@ -267,10 +274,28 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
 {
   Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
 
-  clear();
-
   using number = typename Matrix::value_type;
 
+  // if the symbolic factorization of a previous matrix was kept, hold on
+  // to it together with the sparsity pattern it was computed for, so that
+  // we can reuse it below if the new matrix has the same sparsity pattern
+  void *previous_symbolic_decomposition = nullptr;
+  bool  previous_is_complex             = false;
+
+  std::vector<types::suitesparse_index> previous_Ap;
+  std::vector<types::suitesparse_index> previous_Ai;
+  if (additional_data.reuse_symbolic_factorization &&
+      symbolic_decomposition != nullptr)
+    {
+      previous_symbolic_decomposition = symbolic_decomposition;
+      symbolic_decomposition          = nullptr;
+      previous_Ap.swap(Ap);
+      previous_Ai.swap(Ai);
+      previous_is_complex = (Az.size() != 0);
+    }
+
+  clear();
+
   n_rows = matrix.m();
   n_cols = matrix.n();
 
@@ -339,28 +364,42 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // different function
   sort_arrays(matrix);
 
+  // reuse the previous symbolic factorization if the sorted index arrays
+  // are the same, and compute a new one otherwise
+  if (previous_symbolic_decomposition != nullptr)
+    {
+      if (previous_is_complex == numbers::NumberTraits<number>::is_complex &&
+          previous_Ap == Ap && previous_Ai == Ai)
+        symbolic_decomposition = previous_symbolic_decomposition;
+      else
+        umfpack_dl_free_symbolic(&previous_symbolic_decomposition);
+    }
+
   int status;
-  if (numbers::NumberTraits<number>::is_complex == false)
-    status = umfpack_dl_symbolic(N,
-                                 N,
-                                 Ap.data(),
-                                 Ai.data(),
-                                 Ax.data(),
-                                 &symbolic_decomposition,
-                                 control.data(),
-                                 nullptr);
-  else
-    status = umfpack_zl_symbolic(N,
-                                 N,
-                                 Ap.data(),
-                                 Ai.data(),
-                                 Ax.data(),
-                                 Az.data(),
-                                 &symbolic_decomposition,
-                                 control.data(),
-                                 nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_symbolic", status));
+  if (symbolic_decomposition == nullptr)
+    {
+      if (numbers::NumberTraits<number>::is_complex == false)
+        status = umfpack_dl_symbolic(N,
+                                     N,
+                                     Ap.data(),
+                                     Ai.data(),
+                                     Ax.data(),
+                                     &symbolic_decomposition,
+                                     control.data(),
+                                     nullptr);
+      else
+        status = umfpack_zl_symbolic(N,
+                                     N,
+                                     Ap.data(),
+                                     Ai.data(),
+                                     Ax.data(),
+                                     Az.data(),
+                                     &symbolic_decomposition,
+                                     control.data(),
+                                     nullptr);
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_symbolic", status));
+    }
 
   if (numbers::NumberTraits<number>::is_complex == false)
     status = umfpack_dl_numeric(Ap.data(),
@@ -380,8 +419,10 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                                 control.data(),
                                 nullptr);
 
-  // Clean up before we deal with the error code from the calls above:
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
+  // Clean up before we deal with the error code from the calls above,
+  // unless the symbolic factorization is to be reused:
+  if (additional_data.reuse_symbolic_factorization == false)
+    umfpack_dl_free_symbolic(&symbolic_decomposition);
   if (status == UMFPACK_WARNING_singular_matrix)
     {
       // UMFPACK sometimes warns that the matrix is singular, but that a
@@ -816,8 +857,10 @@ SparseDirectUMFPACK::solve(const Matrix &,
 
 template <class Matrix>
 void
-SparseDirectUMFPACK::initialize(const Matrix &M, const AdditionalData)
+SparseDirectUMFPACK::initialize(const Matrix        &M,
+                                const AdditionalData additional_data)
 {
+  this->additional_data = additional_data;
   this->factorize(M);
 }
 
@@ -0,0 +1,1070 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/lapack_support.h>
+#include <deal.II/lac/lapack_templates.h>
+#include <deal.II/lac/sparse_direct_cholesky.h>
+#include <deal.II/lac/sparse_matrix.h>
+
+#include <algorithm>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace
+{
+  /**
+   * The maximal number of nodes of the subgraphs that are not split any
+   * further by the nested dissection.
+   */
+  constexpr unsigned int nested_dissection_leaf_size = 64;
+
+  /**
+   * The estimated number of floating point operations of a subtree of the
+   * elimination tree above which it is factorized as a separate task.
+   */
+  constexpr double minimal_task_work = 1e6;
+
+
+
+  /**
+   * Compute a hash of the sparsity pattern of @p matrix from its size and
+   * the column indices of each row, in the order of the row iterators.
+   */
+  template <class Matrix>
+  std::size_t
+  compute_sparsity_pattern_hash(const Matrix &matrix)
+  {
+    const auto combine = [](std::size_t &hash, const std::size_t value) {
+      hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+
+    std::size_t hash = 0;
+    combine(hash, matrix.m());
+    for (types::global_dof_index row = 0; row < matrix.m(); ++row)
+      {
+        std::size_t row_length = 0;
+        for (typename Matrix::const_iterator p = matrix.begin(row);
+             p != matrix.end(row);
+             ++p, ++row_length)
+          combine(hash, p->column());
+        combine(hash, row_length);
+      }
+    return hash;
+  }
+
+
+
+  /**
+   * Perform a breadth-first search from @p root in the subgraph of the
+   * nodes whose entry in @p part_marker equals @p part, and return the
+   * visited nodes sorted by their distance from @p root, as well as the
+   * start of each level in the returned vector.
+   */
+  template <typename size_type>
+  std::pair<std::vector<size_type>, std::vector<std::size_t>>
+  level_structure(const std::vector<std::size_t>  &graph_start,
+                  const std::vector<size_type>    &graph,
+                  const std::vector<unsigned int> &part_marker,
+                  const unsigned int               part,
+                  const size_type                  root,
+                  std::vector<unsigned int>       &visit_marker,
+                  unsigned int                    &visit)
+  {
+    ++visit;
+    std::vector<size_type>   nodes(1, root);
+    std::vector<std::size_t> level_start(1, 0);
+    visit_marker[root] = visit;
+    while (level_start.back() < nodes.size())
+      {
+        const std::size_t level_end = nodes.size();
+        for (std::size_t i = level_start.back(); i < level_end; ++i)
+          for (std::size_t k = graph_start[nodes[i]];
+               k < graph_start[nodes[i] + 1];
+               ++k)
+            if (part_marker[graph[k]] == part &&
+                visit_marker[graph[k]] != visit)
+              {
+                visit_marker[graph[k]] = visit;
+                nodes.push_back(graph[k]);
+              }
+        level_start.push_back(level_end);
+      }
+    return {nodes, level_start};
+  }
+} // namespace
+
+
+
+SparseDirectCholesky::AdditionalData::AdditionalData(const Ordering ordering)
+  : ordering(ordering)
+{}
+
+
+
+SparseDirectCholesky::SparseDirectCholesky()
+  : n_rows(0)
+  , sparsity_pattern_hash(0)
+  , is_factorized(false)
+{}
+
+
+
+SparseDirectCholesky::~SparseDirectCholesky() = default;
+
+
+
+void
+SparseDirectCholesky::clear()
+{
+  n_rows                = 0;
+  sparsity_pattern_hash = 0;
+  permutation.clear();
+  matrix_entry_positions.clear();
+  supernode_start.clear();
+  supernode_row_start.clear();
+  supernode_rows.clear();
+  supernode_child_start.clear();
+  supernode_children.clear();
+  supernode_first_descendant.clear();
+  supernode_roots.clear();
+  subtree_work.clear();
+  factor_start.clear();
+  factor.clear();
+  is_factorized = false;
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectCholesky::analyze(const Matrix         &matrix,
+                              const AdditionalData &additional_data)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  clear();
+  this->additional_data = additional_data;
+  n_rows                = matrix.m();
+
+  std::vector<std::size_t> row_start(n_rows + 1, 0);
+  std::vector<size_type>   columns;
+  for (size_type row = 0; row < n_rows; ++row)
+    {
+      for (typename Matrix::const_iterator p = matrix.begin(row);
+           p != matrix.end(row);
+           ++p)
+        columns.push_back(p->column());
+      row_start[row + 1] = columns.size();
+    }
+
+  analyze_pattern(row_start, columns);
+  sparsity_pattern_hash = compute_sparsity_pattern_hash(matrix);
+}
+
+
+
+void
+SparseDirectCholesky::analyze_pattern(const std::vector<std::size_t> &row_start,
+                                      const std::vector<size_type>   &columns)
+{
+  // the graph of the symmetrized sparsity pattern without the diagonal
+  std::vector<std::size_t> graph_start(n_rows + 1, 0);
+  for (size_type row = 0; row < n_rows; ++row)
+    for (std::size_t k = row_start[row]; k < row_start[row + 1]; ++k)
+      if (columns[k] != row)
+        {
+          ++graph_start[row + 1];
+          ++graph_start[columns[k] + 1];
+        }
+  for (size_type row = 0; row < n_rows; ++row)
+    graph_start[row + 1] += graph_start[row];
+  std::vector<size_type> graph(graph_start.back());
+  {
+    std::vector<std::size_t> next(graph_start.begin(), graph_start.end() - 1);
+    for (size_type row = 0; row < n_rows; ++row)
+      for (std::size_t k = row_start[row]; k < row_start[row + 1]; ++k)
+        if (columns[k] != row)
+          {
+            graph[next[row]++]        = columns[k];
+            graph[next[columns[k]]++] = row;
+          }
+  }
+  {
+    // sort the neighbors and remove the duplicates from symmetric entries
+    std::size_t n_entries = 0;
+    for (size_type row = 0; row < n_rows; ++row)
+      {
+        const std::size_t begin = graph_start[row];
+        const std::size_t end   = graph_start[row + 1];
+        std::sort(graph.begin() + begin, graph.begin() + end);
+        graph_start[row] = n_entries;
+        for (std::size_t k = begin; k < end; ++k)
+          if (k == begin || graph[k] != graph[k - 1])
+            graph[n_entries++] = graph[k];
+      }
+    graph_start[n_rows] = n_entries;
+    graph.resize(n_entries);
+  }
+
+  if (additional_data.ordering ==
+      AdditionalData::Ordering::nested_dissection)
+    compute_nested_dissection(graph_start, graph);
+  else
+    {
+      permutation.resize(n_rows);
+      for (size_type i = 0; i < n_rows; ++i)
+        permutation[i] = i;
+    }
+
+  // compute the elimination tree of the permuted matrix with Liu's algorithm
+  // with path compression
+  const size_type        invalid = numbers::invalid_dof_index;
+  std::vector<size_type> inverse_permutation(n_rows);
+  for (size_type i = 0; i < n_rows; ++i)
+    inverse_permutation[permutation[i]] = i;
+  std::vector<size_type> parent(n_rows, invalid);
+  {
+    std::vector<size_type> ancestor(n_rows, invalid);
+    for (size_type j = 0; j < n_rows; ++j)
+      for (std::size_t k = graph_start[permutation[j]];
+           k < graph_start[permutation[j] + 1];
+           ++k)
+        {
+          size_type i = inverse_permutation[graph[k]];
+          if (i >= j)
+            continue;
+          while (ancestor[i] != invalid && ancestor[i] != j)
+            {
+              const size_type next = ancestor[i];
+              ancestor[i]          = j;
+              i                    = next;
+            }
+          if (ancestor[i] == invalid)
+            {
+              ancestor[i] = j;
+              parent[i]   = j;
+            }
+        }
+  }
+
+  // renumber the columns in a postorder of the elimination tree, which
+  // keeps the fill-in but numbers the columns of each subtree consecutively
+  {
+    std::vector<size_type> first_child(n_rows, invalid);
+    std::vector<size_type> next_sibling(n_rows, invalid);
+    for (size_type j = n_rows; j-- > 0;)
+      if (parent[j] != invalid)
+        {
+          next_sibling[j]        = first_child[parent[j]];
+          first_child[parent[j]] = j;
+        }
+
+    std::vector<size_type> postorder;
+    postorder.reserve(n_rows);
+    std::vector<size_type> stack;
+    for (size_type root = 0; root < n_rows; ++root)
+      if (parent[root] == invalid)
+        {
+          stack.push_back(root);
+          while (!stack.empty())
+            {
+              const size_type j = stack.back();
+              if (first_child[j] != invalid)
+                {
+                  // descend into the first child and remove it from the list
+                  // of children, so the node is visited again once the
+                  // subtree of that child is done
+                  stack.push_back(first_child[j]);
+                  first_child[j] = next_sibling[first_child[j]];
+                }
+              else
+                {
+                  postorder.push_back(j);
+                  stack.pop_back();
+                }
+            }
+        }
+
+    std::vector<size_type> new_index(n_rows);
+    for (size_type i = 0; i < n_rows; ++i)
+      new_index[postorder[i]] = i;
+    std::vector<size_type> new_parent(n_rows, invalid);
+    std::vector<size_type> new_permutation(n_rows);
+    for (size_type j = 0; j < n_rows; ++j)
+      {
+        if (parent[j] != invalid)
+          new_parent[new_index[j]] = new_index[parent[j]];
+        new_permutation[new_index[j]] = permutation[j];
+      }
+    parent.swap(new_parent);
+    permutation.swap(new_permutation);
+    for (size_type i = 0; i < n_rows; ++i)
+      inverse_permutation[permutation[i]] = i;
+  }
+
+  // compute the structure of the columns of the factor: the structure of a
+  // column is the union of the structure of the lower triangle of the matrix
+  // in that column and the structures of its children in the elimination
+  // tree. consecutive columns j and j+1 with the same structure apart from
+  // the diagonal are grouped into supernodes
+  {
+    std::vector<std::vector<size_type>> child_structures(n_rows);
+    std::vector<size_type>              marker(n_rows, invalid);
+    std::vector<size_type>              previous_structure;
+    std::vector<size_type>              structure;
+    supernode_row_start.push_back(0);
+    for (size_type j = 0; j < n_rows; ++j)
+      {
+        structure.clear();
+        structure.push_back(j);
+        marker[j] = j;
+        for (std::size_t k = graph_start[permutation[j]];
+             k < graph_start[permutation[j] + 1];
+             ++k)
+          {
+            const size_type i = inverse_permutation[graph[k]];
+            if (i > j && marker[i] != j)
+              {
+                marker[i] = j;
+                structure.push_back(i);
+              }
+          }
+        for (const size_type i : child_structures[j])
+          if (marker[i] != j)
+            {
+              marker[i] = j;
+              structure.push_back(i);
+            }
+        std::vector<size_type>().swap(child_structures[j]);
+        std::sort(structure.begin(), structure.end());
+
+        if (parent[j] != invalid)
+          child_structures[parent[j]].insert(child_structures[parent[j]].end(),
+                                             structure.begin() + 1,
+                                             structure.end());
+
+        if (j == 0 || parent[j - 1] != j ||
+            previous_structure.size() != structure.size() + 1)
+          {
+            supernode_start.push_back(j);
+            supernode_rows.insert(supernode_rows.end(),
+                                  structure.begin(),
+                                  structure.end());
+            supernode_row_start.push_back(supernode_rows.size());
+          }
+        previous_structure.swap(structure);
+      }
+    supernode_start.push_back(n_rows);
+  }
+
+  // set up the supernodal elimination tree, the layout of the factor, and
+  // the work estimates
+  const unsigned int n_supernodes = supernode_start.size() - 1;
+  std::vector<unsigned int> column_to_supernode(n_rows);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    for (size_type j = supernode_start[s]; j < supernode_start[s + 1]; ++j)
+      column_to_supernode[j] = s;
+
+  std::vector<unsigned int> supernode_parent(n_supernodes,
+                                             numbers::invalid_unsigned_int);
+  supernode_child_start.assign(n_supernodes + 1, 0);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    if (parent[supernode_start[s + 1] - 1] != invalid)
+      {
+        supernode_parent[s] =
+          column_to_supernode[parent[supernode_start[s + 1] - 1]];
+        ++supernode_child_start[supernode_parent[s] + 1];
+      }
+    else
+      supernode_roots.push_back(s);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    supernode_child_start[s + 1] += supernode_child_start[s];
+  supernode_children.resize(supernode_child_start.back());
+  {
+    std::vector<std::size_t> next(supernode_child_start.begin(),
+                                  supernode_child_start.end() - 1);
+    for (unsigned int s = 0; s < n_supernodes; ++s)
+      if (supernode_parent[s] != numbers::invalid_unsigned_int)
+        supernode_children[next[supernode_parent[s]]++] = s;
+  }
+
+  supernode_first_descendant.resize(n_supernodes);
+  subtree_work.resize(n_supernodes);
+  factor_start.resize(n_supernodes + 1);
+  factor_start[0] = 0;
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      const double n_columns = supernode_start[s + 1] - supernode_start[s];
+      const double n_updated =
+        supernode_row_start[s + 1] - supernode_row_start[s] - n_columns;
+      subtree_work[s] += n_columns * n_columns * n_columns / 3. +
+                         n_columns * n_columns * n_updated +
+                         n_columns * n_updated * n_updated;
+      if (supernode_parent[s] != numbers::invalid_unsigned_int)
+        subtree_work[supernode_parent[s]] += subtree_work[s];
+
+      supernode_first_descendant[s] =
+        supernode_child_start[s] < supernode_child_start[s + 1] ?
+          supernode_first_descendant
+            [supernode_children[supernode_child_start[s]]] :
+          s;
+
+      factor_start[s + 1] =
+        factor_start[s] +
+        (supernode_row_start[s + 1] - supernode_row_start[s]) *
+          (supernode_start[s + 1] - supernode_start[s]);
+    }
+
+  // find the position of the entries of the lower triangle of the permuted
+  // matrix in the factor
+  matrix_entry_positions.resize(columns.size());
+  for (size_type row = 0; row < n_rows; ++row)
+    for (std::size_t k = row_start[row]; k < row_start[row + 1]; ++k)
+      {
+        const size_type i = inverse_permutation[row];
+        const size_type j = inverse_permutation[columns[k]];
+        if (i < j)
+          matrix_entry_positions[k] = numbers::invalid_size_type;
+        else
+          {
+            const unsigned int s = column_to_supernode[j];
+            const auto         rows_begin =
+              supernode_rows.begin() + supernode_row_start[s];
+            const auto rows_end =
+              supernode_rows.begin() + supernode_row_start[s + 1];
+            const auto position = std::lower_bound(rows_begin, rows_end, i);
+            Assert(position != rows_end && *position == i, ExcInternalError());
+            matrix_entry_positions[k] =
+              factor_start[s] +
+              (j - supernode_start[s]) * (rows_end - rows_begin) +
+              (position - rows_begin);
+          }
+      }
+}
+
+
+
+void
+SparseDirectCholesky::compute_nested_dissection(
+  const std::vector<std::size_t> &graph_start,
+  const std::vector<size_type>   &graph)
+{
+  permutation.resize(n_rows);
+
+  // the subgraphs still to be ordered, together with the first position
+  // they occupy in the permutation
+  std::vector<std::pair<std::vector<size_type>, size_type>> parts;
+  if (n_rows > 0)
+    {
+      parts.emplace_back(std::vector<size_type>(n_rows), 0);
+      for (size_type i = 0; i < n_rows; ++i)
+        parts.back().first[i] = i;
+    }
+
+  std::vector<unsigned int> part_marker(n_rows, 0);
+  std::vector<unsigned int> visit_marker(n_rows, 0);
+  unsigned int              part  = 0;
+  unsigned int              visit = 0;
+  while (!parts.empty())
+    {
+      std::vector<size_type> nodes          = std::move(parts.back().first);
+      const size_type        first_position = parts.back().second;
+      parts.pop_back();
+
+      if (nodes.size() <= nested_dissection_leaf_size)
+        {
+          std::sort(nodes.begin(), nodes.end());
+          std::copy(nodes.begin(),
+                    nodes.end(),
+                    permutation.begin() + first_position);
+          continue;
+        }
+
+      ++part;
+      for (const size_type i : nodes)
+        part_marker[i] = part;
+
+      // find a pseudo-peripheral node by repeatedly starting the search from
+      // a node of minimal degree in the last level, as long as the number of
+      // levels grows
+      size_type root = *std::min_element(nodes.begin(), nodes.end());
+      auto      levels =
+        level_structure(graph_start,
+                        graph,
+                        part_marker,
+                        part,
+                        root,
+                        visit_marker,
+                        visit);
+
+      if (levels.first.size() < nodes.size())
+        {
+          // the subgraph is not connected: order the component of the root
+          // and the remaining nodes separately
+          std::vector<size_type> remainder;
+          for (const size_type i : nodes)
+            if (visit_marker[i] != visit)
+              remainder.push_back(i);
+          const size_type component_size = levels.first.size();
+          parts.emplace_back(std::move(levels.first), first_position);
+          parts.emplace_back(std::move(remainder),
+                             first_position + component_size);
+          continue;
+        }
+
+      for (unsigned int iteration = 0; iteration < 5; ++iteration)
+        {
+          const auto last_level_begin =
+            levels.first.begin() + levels.second[levels.second.size() - 2];
+          const size_type candidate = *std::min_element(
+            last_level_begin,
+            levels.first.end(),
+            [&](const size_type a, const size_type b) {
+              return graph_start[a + 1] - graph_start[a] <
+                     graph_start[b + 1] - graph_start[b];
+            });
+          auto candidate_levels = level_structure(graph_start,
+                                                  graph,
+                                                  part_marker,
+                                                  part,
+                                                  candidate,
+                                                  visit_marker,
+                                                  visit);
+          if (candidate_levels.second.size() <= levels.second.size())
+            break;
+          root   = candidate;
+          levels = std::move(candidate_levels);
+        }
+
+      const std::vector<size_type>   &level_nodes = levels.first;
+      const std::vector<std::size_t> &level_start = levels.second;
+      const unsigned int              n_levels    = level_start.size() - 1;
+      if (n_levels < 3)
+        {
+          // the graph is too dense to be split by a level
+          std::sort(nodes.begin(), nodes.end());
+          std::copy(nodes.begin(),
+                    nodes.end(),
+                    permutation.begin() + first_position);
+          continue;
+        }
+
+      // the separator is the level that splits the nodes into two halves,
+      // excluding the first and the last level
+      unsigned int separator_level = 1;
+      while (separator_level < n_levels - 2 &&
+             level_start[separator_level + 1] < nodes.size() / 2)
+        ++separator_level;
+
+      // mark the nodes behind the separator to find the nodes of the
+      // separator without a neighbor behind it, which are moved to the part
+      // before the separator
+      ++part;
+      for (std::size_t k = level_start[separator_level + 1];
+           k < level_nodes.size();
+           ++k)
+        part_marker[level_nodes[k]] = part;
+
+      std::vector<size_type> first_part(level_nodes.begin(),
+                                        level_nodes.begin() +
+                                          level_start[separator_level]);
+      std::vector<size_type> separator;
+      for (std::size_t k = level_start[separator_level];
+           k < level_start[separator_level + 1];
+           ++k)
+        {
+          const size_type i = level_nodes[k];
+          bool            has_neighbor_behind = false;
+          for (std::size_t l = graph_start[i]; l < graph_start[i + 1]; ++l)
+            if (part_marker[graph[l]] == part)
+              {
+                has_neighbor_behind = true;
+                break;
+              }
+          if (has_neighbor_behind)
+            separator.push_back(i);
+          else
+            first_part.push_back(i);
+        }
+      std::vector<size_type> second_part(level_nodes.begin() +
+                                           level_start[separator_level + 1],
+                                         level_nodes.end());
+
+      std::sort(separator.begin(), separator.end());
+      std::copy(separator.begin(),
+                separator.end(),
+                permutation.begin() + first_position + first_part.size() +
+                  second_part.size());
+      const size_type first_part_size = first_part.size();
+      parts.emplace_back(std::move(first_part), first_position);
+      parts.emplace_back(std::move(second_part),
+                         first_position + first_part_size);
+    }
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectCholesky::factorize(const Matrix &matrix)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  // only reuse the symbolic analysis if the sparsity pattern is the same
+  // as the one it was computed for, not just the size and number of entries
+  if (matrix.m() != n_rows || supernode_start.empty() ||
+      compute_sparsity_pattern_hash(matrix) != sparsity_pattern_hash)
+    analyze(matrix, additional_data);
+  AssertDimension(matrix.n_nonzero_elements(), matrix_entry_positions.size());
+
+  factor.assign(factor_start.back(), 0.);
+  std::size_t index = 0;
+  for (size_type row = 0; row < n_rows; ++row)
+    for (typename Matrix::const_iterator p = matrix.begin(row);
+         p != matrix.end(row);
+         ++p, ++index)
+      if (matrix_entry_positions[index] != numbers::invalid_size_type)
+        factor[matrix_entry_positions[index]] += p->value();
+
+  std::vector<std::vector<double>> update_matrices(supernode_start.size() -
+                                                   1);
+  const size_type failed_row =
+    factorize_subtrees(supernode_roots, update_matrices);
+  AssertThrow(failed_row == numbers::invalid_dof_index,
+              ExcNotPositiveDefinite(failed_row));
+
+  is_factorized = true;
+}
+
+
+
+SparseDirectCholesky::size_type
+SparseDirectCholesky::factorize_subtrees(
+  const std::vector<unsigned int>  &roots,
+  std::vector<std::vector<double>> &update_matrices)
+{
+  Threads::TaskGroup<size_type> tasks;
+  size_type                     failed_row = numbers::invalid_dof_index;
+  for (const unsigned int root : roots)
+    if (subtree_work[root] >= minimal_task_work &&
+        MultithreadInfo::n_threads() > 1)
+      tasks += Threads::new_task([this, root, &update_matrices]() {
+        return factorize_subtree(root, update_matrices);
+      });
+    else
+      failed_row =
+        std::min(failed_row, factorize_subtree(root, update_matrices));
+
+  for (const size_type row : tasks.return_values())
+    failed_row = std::min(failed_row, row);
+  return failed_row;
+}
+
+
+
+SparseDirectCholesky::size_type
+SparseDirectCholesky::factorize_subtree(
+  const unsigned int                supernode,
+  std::vector<std::vector<double>> &update_matrices)
+{
+  // small subtrees are factorized in the order of the supernodes, which is
+  // a postorder of the tree
+  if (subtree_work[supernode] < minimal_task_work ||
+      MultithreadInfo::n_threads() == 1)
+    {
+      for (unsigned int s = supernode_first_descendant[supernode];
+           s <= supernode;
+           ++s)
+        {
+          const size_type failed_row =
+            factorize_supernode(s, update_matrices);
+          if (failed_row != numbers::invalid_dof_index)
+            return failed_row;
+        }
+      return numbers::invalid_dof_index;
+    }
+
+  // follow the path of supernodes with a single large child, which has to
+  // be processed sequentially, until the first supernode with several large
+  // children or none at all. the small children along the path and the
+  // large children at its end are factorized first, the latter as separate
+  // tasks
+  std::vector<unsigned int> path(1, supernode);
+  std::vector<unsigned int> subtrees;
+  while (true)
+    {
+      const unsigned int        s = path.back();
+      std::vector<unsigned int> large_children;
+      for (std::size_t c = supernode_child_start[s];
+           c < supernode_child_start[s + 1];
+           ++c)
+        if (subtree_work[supernode_children[c]] >= minimal_task_work)
+          large_children.push_back(supernode_children[c]);
+        else
+          subtrees.push_back(supernode_children[c]);
+      if (large_children.size() == 1)
+        path.push_back(large_children[0]);
+      else
+        {
+          subtrees.insert(subtrees.end(),
+                          large_children.begin(),
+                          large_children.end());
+          break;
+        }
+    }
+
+  size_type failed_row = factorize_subtrees(subtrees, update_matrices);
+  for (auto s = path.rbegin();
+       s != path.rend() && failed_row == numbers::invalid_dof_index;
+       ++s)
+    failed_row = factorize_supernode(*s, update_matrices);
+  return failed_row;
+}
+
+
+
+SparseDirectCholesky::size_type
+SparseDirectCholesky::factorize_supernode(
+  const unsigned int                supernode,
+  std::vector<std::vector<double>> &update_matrices)
+{
+  const std::size_t n_columns =
+    supernode_start[supernode + 1] - supernode_start[supernode];
+  const std::size_t n_rows_supernode =
+    supernode_row_start[supernode + 1] - supernode_row_start[supernode];
+  const std::size_t n_updated = n_rows_supernode - n_columns;
+  const size_type *rows =
+    supernode_rows.data() + supernode_row_start[supernode];
+  double *panel = factor.data() + factor_start[supernode];
+
+  std::vector<double> &update = update_matrices[supernode];
+  update.assign(n_updated * n_updated, 0.);
+
+  // add the update matrices of the children, whose rows are a subset of
+  // the rows of this supernode, to the panel and the update matrix
+  std::vector<std::size_t> local_rows;
+  for (std::size_t c = supernode_child_start[supernode];
+       c < supernode_child_start[supernode + 1];
+       ++c)
+    {
+      const unsigned int child = supernode_children[c];
+      const std::size_t  child_n_columns =
+        supernode_start[child + 1] - supernode_start[child];
+      const std::size_t child_n_updated =
+        supernode_row_start[child + 1] - supernode_row_start[child] -
+        child_n_columns;
+      const size_type *child_rows =
+        supernode_rows.data() + supernode_row_start[child] + child_n_columns;
+
+      local_rows.resize(child_n_updated);
+      for (std::size_t i = 0, l = 0; i < child_n_updated; ++i)
+        {
+          while (rows[l] != child_rows[i])
+            ++l;
+          local_rows[i] = l;
+        }
+
+      const std::vector<double> &child_update = update_matrices[child];
+      for (std::size_t j = 0; j < child_n_updated; ++j)
+        {
+          const double     *source = child_update.data() + j * child_n_updated;
+          const std::size_t column = local_rows[j];
+          if (column < n_columns)
+            for (std::size_t i = j; i < child_n_updated; ++i)
+              panel[column * n_rows_supernode + local_rows[i]] += source[i];
+          else
+            for (std::size_t i = j; i < child_n_updated; ++i)
+              update[(column - n_columns) * n_updated + local_rows[i] -
+                     n_columns] += source[i];
+        }
+      std::vector<double>().swap(update_matrices[child]);
+    }
+
+#ifdef DEAL_II_WITH_LAPACK
+  // factorize the diagonal block, compute the off-diagonal block by a
+  // triangular solve on its transpose, and subtract its outer product from
+  // the update matrix
+  const types::blas_int n     = n_columns;
+  const types::blas_int m     = n_rows_supernode;
+  const types::blas_int n_upd = n_updated;
+  types::blas_int       info  = 0;
+  potrf(&LAPACKSupport::L, &n, panel, &m, &info);
+  if (info != 0)
+    return permutation[supernode_start[supernode] + info - 1];
+
+  if (n_updated > 0)
+    {
+      std::vector<double> transpose(n_columns * n_updated);
+      for (std::size_t j = 0; j < n_columns; ++j)
+        for (std::size_t i = 0; i < n_updated; ++i)
+          transpose[i * n_columns + j] =
+            panel[j * n_rows_supernode + n_columns + i];
+      trtrs(&LAPACKSupport::L,
+            &LAPACKSupport::N,
+            &LAPACKSupport::N,
+            &n,
+            &n_upd,
+            panel,
+            &m,
+            transpose.data(),
+            &n,
+            &info);
+      AssertThrow(info == 0, LAPACKSupport::ExcErrorCode("trtrs", info));
+      for (std::size_t j = 0; j < n_columns; ++j)
+        for (std::size_t i = 0; i < n_updated; ++i)
+          panel[j * n_rows_supernode + n_columns + i] =
+            transpose[i * n_columns + j];
+
+      const double minus_one = -1.;
+      const double one       = 1.;
+      syrk(&LAPACKSupport::L,
+           &LAPACKSupport::N,
+           &n_upd,
+           &n,
+           &minus_one,
+           panel + n_columns,
+           &m,
+           &one,
+           update.data(),
+           &n_upd);
+    }
+#else
+  // right-looking Cholesky factorization of the whole panel, followed by
+  // the update with the outer product of the off-diagonal block
+  for (std::size_t j = 0; j < n_columns; ++j)
+    {
+      double *column = panel + j * n_rows_supernode;
+      if (!(column[j] > 0.))
+        return permutation[supernode_start[supernode] + j];
+      const double diagonal = std::sqrt(column[j]);
+      column[j]             = diagonal;
+      const double inverse  = 1. / diagonal;
+      for (std::size_t i = j + 1; i < n_rows_supernode; ++i)
+        column[i] *= inverse;
+      for (std::size_t k = j + 1; k < n_columns; ++k)
+        {
+          double      *target = panel + k * n_rows_supernode;
+          const double multiplier = column[k];
+          for (std::size_t i = k; i < n_rows_supernode; ++i)
+            target[i] -= column[i] * multiplier;
+        }
+    }
+  for (std::size_t j = 0; j < n_columns; ++j)
+    {
+      const double *column = panel + j * n_rows_supernode + n_columns;
+      for (std::size_t k = 0; k < n_updated; ++k)
+        {
+          double      *target = update.data() + k * n_updated;
+          const double multiplier = column[k];
+          for (std::size_t i = k; i < n_updated; ++i)
+            target[i] -= column[i] * multiplier;
+        }
+    }
+#endif
+
+  return numbers::invalid_dof_index;
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectCholesky::initialize(const Matrix         &matrix,
+                                 const AdditionalData &additional_data)
+{
+  analyze(matrix, additional_data);
+  factorize(matrix);
+}
+
+
+
+void
+SparseDirectCholesky::solve(Vector<double> &rhs_and_solution) const
+{
+  Assert(is_factorized,
+         ExcMessage("You have to call factorize() before you can solve."));
+  AssertDimension(rhs_and_solution.size(), n_rows);
+
+  Vector<double> permuted(n_rows);
+  for (size_type i = 0; i < n_rows; ++i)
+    permuted[i] = rhs_and_solution[permutation[i]];
+
+  // forward substitution with L
+  const unsigned int n_supernodes = supernode_start.size() - 1;
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      const std::size_t n_rows_supernode =
+        supernode_row_start[s + 1] - supernode_row_start[s];
+      const size_type *rows  = supernode_rows.data() + supernode_row_start[s];
+      const double    *panel = factor.data() + factor_start[s];
+      for (size_type j = 0; j < supernode_start[s + 1] - supernode_start[s];
+           ++j)
+        {
+          const double *column = panel + j * n_rows_supernode;
+          const double  value  = permuted[rows[j]] / column[j];
+          permuted[rows[j]]    = value;
+          for (std::size_t i = j + 1; i < n_rows_supernode; ++i)
+            permuted[rows[i]] -= column[i] * value;
+        }
+    }
+
+  // backward substitution with L^T
+  for (unsigned int s = n_supernodes; s-- > 0;)
+    {
+      const std::size_t n_rows_supernode =
+        supernode_row_start[s + 1] - supernode_row_start[s];
+      const size_type *rows  = supernode_rows.data() + supernode_row_start[s];
+      const double    *panel = factor.data() + factor_start[s];
+      for (size_type j = supernode_start[s + 1] - supernode_start[s]; j-- > 0;)
+        {
+          const double *column = panel + j * n_rows_supernode;
+          double        value  = permuted[rows[j]];
+          for (std::size_t i = j + 1; i < n_rows_supernode; ++i)
+            value -= column[i] * permuted[rows[i]];
+          permuted[rows[j]] = value / column[j];
+        }
+    }
+
+  for (size_type i = 0; i < n_rows; ++i)
+    rhs_and_solution[permutation[i]] = permuted[i];
+}
+
+
+
+void
+SparseDirectCholesky::solve(BlockVector<double> &rhs_and_solution) const
+{
+  // copy the data into a regular vector and back, as the solve works on a
+  // permuted copy anyway
+  Vector<double> tmp(rhs_and_solution.size());
+  tmp = rhs_and_solution;
+  solve(tmp);
+  rhs_and_solution = tmp;
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectCholesky::solve(const Matrix   &matrix,
+                            Vector<double> &rhs_and_solution)
+{
+  factorize(matrix);
+  solve(rhs_and_solution);
+}
+
+
+
+void
+SparseDirectCholesky::vmult(Vector<double>       &dst,
+                            const Vector<double> &src) const
+{
+  dst = src;
+  solve(dst);
+}
+
+
+
+void
+SparseDirectCholesky::vmult(BlockVector<double>       &dst,
+                            const BlockVector<double> &src) const
+{
+  dst = src;
+  solve(dst);
+}
+
+
+
+void
+SparseDirectCholesky::Tvmult(Vector<double>       &dst,
+                             const Vector<double> &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+void
+SparseDirectCholesky::Tvmult(BlockVector<double>       &dst,
+                             const BlockVector<double> &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+unsigned int
+SparseDirectCholesky::n_supernodes() const
+{
+  return supernode_start.empty() ? 0 : supernode_start.size() - 1;
+}
+
+
+
+std::size_t
+SparseDirectCholesky::n_nonzero_elements() const
+{
+  // the panels also store the upper triangle of the diagonal blocks
+  std::size_t n_entries = factor_start.empty() ? 0 : factor_start.back();
+  for (unsigned int s = 0; s < n_supernodes(); ++s)
+    {
+      const std::size_t n_columns = supernode_start[s + 1] - supernode_start[s];
+      n_entries -= n_columns * (n_columns - 1) / 2;
+    }
+  return n_entries;
+}
+
+
+
+std::size_t
+SparseDirectCholesky::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(permutation) +
+         MemoryConsumption::memory_consumption(matrix_entry_positions) +
+         MemoryConsumption::memory_consumption(supernode_start) +
+         MemoryConsumption::memory_consumption(supernode_row_start) +
+         MemoryConsumption::memory_consumption(supernode_rows) +
+         MemoryConsumption::memory_consumption(supernode_child_start) +
+         MemoryConsumption::memory_consumption(supernode_children) +
+         MemoryConsumption::memory_consumption(supernode_first_descendant) +
+         MemoryConsumption::memory_consumption(supernode_roots) +
+         MemoryConsumption::memory_consumption(subtree_work) +
+         MemoryConsumption::memory_consumption(factor_start) +
+         MemoryConsumption::memory_consumption(factor);
+}
+
+
+
+// explicit instantiations
+#define InstantiateCholesky(MatrixType)                                      \
+  template void SparseDirectCholesky::analyze(const MatrixType &,            \
+                                              const AdditionalData &);       \
+  template void SparseDirectCholesky::factorize(const MatrixType &);         \
+  template void SparseDirectCholesky::initialize(const MatrixType &,         \
+                                                 const AdditionalData &);    \
+  template void SparseDirectCholesky::solve(const MatrixType &,              \
+                                            Vector<double> &);
+
+InstantiateCholesky(SparseMatrix<double>);
+InstantiateCholesky(SparseMatrix<float>);
+InstantiateCholesky(BlockSparseMatrix<double>);
+
+DEAL_II_NAMESPACE_CLOSE
@@ -24,6 +24,9 @@ template void
 SparseMIC<double>::initialize<double>(const SparseMatrix<double> &,
                                       const AdditionalData &data);
 template void
+SparseMIC<double>::initialize<double>(const SymmetricSparseMatrix<double> &,
+                                      const AdditionalData &data);
+template void
 SparseMIC<double>::vmult<double>(Vector<double> &,
                                  const Vector<double> &) const;
 template void
@@ -33,6 +36,9 @@ template void
 SparseMIC<double>::initialize<float>(const SparseMatrix<float> &,
                                      const AdditionalData &data);
 template void
+SparseMIC<double>::initialize<float>(const SymmetricSparseMatrix<float> &,
+                                     const AdditionalData &data);
+template void
 SparseMIC<double>::vmult<float>(Vector<float> &, const Vector<float> &) const;
 template void
 SparseMIC<double>::Tvmult<float>(Vector<float> &, const Vector<float> &) const;
@@ -42,6 +48,9 @@ template void
 SparseMIC<float>::initialize<double>(const SparseMatrix<double> &,
                                      const AdditionalData &data);
 template void
+SparseMIC<float>::initialize<double>(const SymmetricSparseMatrix<double> &,
+                                     const AdditionalData &data);
+template void
 SparseMIC<float>::vmult<double>(Vector<double> &, const Vector<double> &) const;
 template void
 SparseMIC<float>::Tvmult<double>(Vector<double> &,
@@ -50,6 +59,9 @@ template void
 SparseMIC<float>::initialize<float>(const SparseMatrix<float> &,
                                     const AdditionalData &data);
 template void
+SparseMIC<float>::initialize<float>(const SymmetricSparseMatrix<float> &,
+                                    const AdditionalData &data);
+template void
 SparseMIC<float>::vmult<float>(Vector<float> &, const Vector<float> &) const;
 template void
 SparseMIC<float>::Tvmult<float>(Vector<float> &, const Vector<float> &) const;
@@ -13,6 +13,7 @@
 // ------------------------------------------------------------------------
 
 
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -25,6 +26,7 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -40,6 +42,7 @@ SparsityPattern::SparsityPattern()
   , max_dim(0)
   , max_vec_len(0)
   , max_row_length(0)
+  , column_index_map_is_stored(false)
   , compressed(false)
 {
   reinit(0, 0, 0);
@@ -110,6 +113,7 @@ SparsityPattern::SparsityPattern(const SparsityPattern &original,
   reinit(original.n_rows(), original.n_cols(), max_per_row);
 
   // now copy the entries from the other object
+  std::vector<size_type> original_columns;
   for (size_type row = 0; row < original.rows; ++row)
     {
       // copy the elements of this row of the other object
@@ -122,12 +126,23 @@ SparsityPattern::SparsityPattern(const SparsityPattern &original,
       // the first side-diagonal one which is to be filled in. then we insert
       // the side-diagonals, finally copy the rest from that element onwards
       // which is not a side-diagonal any more.
-      const size_type *const original_row_start =
-        &original.colnums[original.rowstart[row]] + 1;
-      // the following requires that @p{original} be compressed since
-      // otherwise there might be invalid_entry's
+      //
+      // the column indices of @p{original} may be stored in narrow form, so
+      // copy them to a contiguous array first. the following requires that
+      // @p{original} be compressed since otherwise there might be
+      // invalid_entry's
+      original_columns.clear();
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        original,
+        row,
+        original.rowstart[row] + 1,
+        original.rowstart[row + 1],
+        [&](const std::size_t, const size_type column) {
+          original_columns.push_back(column);
+        });
+      const size_type *const original_row_start = original_columns.data();
       const size_type *const original_row_end =
-        &original.colnums[original.rowstart[row + 1]];
+        original_columns.data() + original_columns.size();
 
       // find pointers before and after extra off-diagonals. if at top or
       // bottom of matrix, then set these pointers such that no copying is
@@ -204,6 +219,11 @@ SparsityPattern::reinit(const size_type                      m,
   AssertDimension(row_lengths.size(), m);
   resize(m, n);
 
+  // the structure changes, so the narrow column indices and the
+  // column-wise index map become invalid
+  clear_narrow_column_indices();
+  clear_column_index_map();
+
   // delete empty matrices
   if ((m == 0) || (n == 0))
     {
@@ -429,6 +449,150 @@ SparsityPattern::compress()
 
 
 
+void
+SparsityPattern::store_narrow_column_indices()
+{
+  Assert(compressed, ExcNotCompressed());
+
+  // nothing to do for an empty object or if the column indices are already
+  // stored in narrow form
+  if ((rowstart == nullptr) || has_narrow_column_indices())
+    return;
+
+  auto row_base = std::make_unique<size_type[]>(rows);
+  auto offsets  = std::make_unique<narrow_index_type[]>(rowstart[rows]);
+  std::vector<size_type> full_columns;
+
+  for (size_type row = 0; row < rows; ++row)
+    {
+      if (rowstart[row] == rowstart[row + 1])
+        {
+          row_base[row] = 0;
+          continue;
+        }
+
+      // the entries of a row are sorted, except for the diagonal entry which
+      // is stored first in square matrices, so look at the whole row
+      const auto [min_col, max_col] =
+        std::minmax_element(&colnums[rowstart[row]],
+                            &colnums[rowstart[row + 1]]);
+      if (*max_col - *min_col >
+          std::numeric_limits<narrow_index_type>::max())
+        {
+          row_base[row] = invalid_entry;
+          full_columns.insert(full_columns.end(),
+                              &colnums[rowstart[row]],
+                              &colnums[rowstart[row + 1]]);
+          continue;
+        }
+
+      row_base[row] = *min_col;
+      for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+        offsets[j] = static_cast<narrow_index_type>(colnums[j] - *min_col);
+    }
+
+  // the rows that do not fit keep their full column indices, stored one
+  // after the other
+  for (size_type row = 0; row < rows; ++row)
+    if (row_base[row] == invalid_entry)
+      {
+        if (wide_row_start.empty())
+          wide_row_start.push_back(0);
+        wide_rows.push_back(row);
+        wide_row_start.push_back(wide_row_start.back() + rowstart[row + 1] -
+                                 rowstart[row]);
+      }
+  wide_colnums = std::move(full_columns);
+
+  narrow_row_base = std::move(row_base);
+  narrow_colnums  = std::move(offsets);
+  colnums.reset();
+  max_vec_len = 0;
+}
+
+
+
+void
+SparsityPattern::clear_narrow_column_indices()
+{
+  narrow_row_base.reset();
+  narrow_colnums.reset();
+  wide_rows.clear();
+  wide_rows.shrink_to_fit();
+  wide_row_start.clear();
+  wide_row_start.shrink_to_fit();
+  wide_colnums.clear();
+  wide_colnums.shrink_to_fit();
+}
+
+
+
+void
+SparsityPattern::store_column_index_map() const
+{
+  Assert(compressed, ExcNotCompressed());
+
+  std::lock_guard<std::mutex> lock(column_index_map_mutex);
+  if (column_index_map_is_stored.load(std::memory_order_relaxed))
+    return;
+
+  auto start = std::make_unique<std::size_t[]>(cols + 1);
+  std::fill_n(start.get(), cols + 1, 0);
+  const std::size_t n_entries = (rowstart != nullptr ? rowstart[rows] : 0);
+  if (n_entries > 0)
+    for (size_type row = 0; row < rows; ++row)
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *this,
+        row,
+        rowstart[row],
+        rowstart[row + 1],
+        [&](const std::size_t, const size_type column) {
+          ++start[column + 1];
+        });
+  std::partial_sum(start.get(), start.get() + cols + 1, start.get());
+
+  // go through the rows in ascending order, so the entries of each column
+  // are sorted by row
+  auto positions   = std::make_unique<std::size_t[]>(n_entries);
+  auto entry_rows  = std::make_unique<size_type[]>(n_entries);
+  auto next_in_col = std::make_unique<std::size_t[]>(cols);
+  std::copy_n(start.get(), cols, next_in_col.get());
+  if (n_entries > 0)
+    for (size_type row = 0; row < rows; ++row)
+      internal::SparsityPatternTools::for_each_entry_in_row(
+        *this,
+        row,
+        rowstart[row],
+        rowstart[row + 1],
+        [&](const std::size_t j, const size_type column) {
+          const std::size_t position = next_in_col[column]++;
+          positions[position]        = j;
+          entry_rows[position]       = row;
+        });
+
+  column_positions = std::move(positions);
+  column_rows      = std::move(entry_rows);
+  column_start     = std::move(start);
+
+  // publish the map only now that it is complete: threads that find the
+  // flag set in has_column_index_map() also see the arrays written above
+  column_index_map_is_stored.store(true, std::memory_order_release);
+}
+
+
+
+void
+SparsityPattern::clear_column_index_map() const
+{
+  std::lock_guard<std::mutex> lock(column_index_map_mutex);
+  column_index_map_is_stored.store(false, std::memory_order_relaxed);
+  column_start.reset();
+  column_positions.reset();
+  column_rows.reset();
+}
+
+
+
 void
 SparsityPattern::copy_from(const SparsityPattern &sp)
 {
@@ -537,6 +701,46 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 
 
 
+void
+SparsityPattern::copy_upper_triangle_from(const DynamicSparsityPattern &dsp)
+{
+  AssertDimension(dsp.n_rows(), dsp.n_cols());
+  const auto &row_index_set = dsp.row_index_set();
+
+  // every row contains the diagonal entry, whether or not it is present in
+  // the dynamic sparsity pattern, plus the entries right of the diagonal
+  std::vector<unsigned int> row_lengths(dsp.n_rows(), 1);
+  for (size_type row = 0; row < dsp.n_rows(); ++row)
+    if (row_index_set.size() == 0 || row_index_set.is_element(row))
+      {
+        const unsigned int row_length = dsp.row_length(row);
+        for (unsigned int index = 0; index < row_length; ++index)
+          if (dsp.column_number(row, index) > row)
+            ++row_lengths[row];
+      }
+  reinit(dsp.n_rows(), dsp.n_cols(), row_lengths);
+
+  if (n_rows() != 0 && n_cols() != 0)
+    for (size_type row = 0; row < dsp.n_rows(); ++row)
+      if (row_index_set.size() == 0 || row_index_set.is_element(row))
+        {
+          size_type         *cols       = &colnums[rowstart[row]] + 1;
+          const unsigned int row_length = dsp.row_length(row);
+          for (unsigned int index = 0; index < row_length; ++index)
+            {
+              const size_type col = dsp.column_number(row, index);
+              if (col > row)
+                *cols++ = col;
+            }
+        }
+
+  // the column indices of a DynamicSparsityPattern are sorted, so we do not
+  // need to compress
+  compressed = true;
+}
+
+
+
 template <typename number>
 void
 SparsityPattern::copy_from(const FullMatrix<number> &matrix)
@@ -628,7 +832,9 @@ SparsityPattern::empty() const
 SparsityPattern::size_type
 SparsityPattern::operator()(const size_type i, const size_type j) const
 {
-  Assert((rowstart != nullptr) && (colnums != nullptr), ExcEmptyObject());
+  Assert((rowstart != nullptr) &&
+           ((colnums != nullptr) || has_narrow_column_indices()),
+         ExcEmptyObject());
   AssertIndexRange(i, n_rows());
   AssertIndexRange(j, n_cols());
   Assert(compressed, ExcNotCompressed());
@@ -648,17 +854,38 @@ SparsityPattern::operator()(const size_type i, const size_type j) const
   // fail for non-compressed sparsity patterns; however, that is why the
   // Assertion is at the top of this function, so it may not be called for
   // noncompressed structures.
-  const size_type *sorted_region_start =
-    (store_diagonal_first_in_row ? &colnums[rowstart[i] + 1] :
-                                   &colnums[rowstart[i]]);
-  const size_type *const p =
-    Utilities::lower_bound<const size_type *>(sorted_region_start,
-                                              &colnums[rowstart[i + 1]],
-                                              j);
-  if ((p != &colnums[rowstart[i + 1]]) && (*p == j))
-    return (p - colnums.get());
+  //
+  // the column indices of the row are either stored in full or, after
+  // store_narrow_column_indices(), as offsets relative to a base column,
+  // so search for the respective value in the array that stores the row
+  const std::size_t first_sorted = (store_diagonal_first_in_row ? 1 : 0);
+  const std::size_t row_length   = rowstart[i + 1] - rowstart[i];
+  const auto        find_in_row  = [&](const auto *const row_columns,
+                                 const auto        column) -> size_type {
+    const auto *const end = row_columns + row_length;
+    const auto *const p =
+      Utilities::lower_bound(row_columns + first_sorted, end, column);
+    if ((p != end) && (*p == column))
+      return rowstart[i] + (p - row_columns);
+    else
+      return invalid_entry;
+  };
+
+  if (has_narrow_column_indices() == false)
+    return find_in_row(&colnums[rowstart[i]], j);
+  else if (narrow_row_base[i] != invalid_entry)
+    {
+      // columns outside of the range covered by the offsets can not be in
+      // this row
+      const size_type base = narrow_row_base[i];
+      if ((j < base) ||
+          (j - base > std::numeric_limits<narrow_index_type>::max()))
+        return invalid_entry;
+      return find_in_row(&narrow_colnums[rowstart[i]],
+                         static_cast<narrow_index_type>(j - base));
+    }
   else
-    return invalid_entry;
+    return find_in_row(wide_row_columns(i), j);
 }
 
 
@@ -666,14 +893,16 @@ SparsityPattern::operator()(const size_type i, const size_type j) const
 bool
 SparsityPattern::exists(const size_type i, const size_type j) const
 {
-  Assert((rowstart != nullptr) && (colnums != nullptr), ExcEmptyObject());
+  Assert((rowstart != nullptr) &&
+           ((colnums != nullptr) || has_narrow_column_indices()),
+         ExcEmptyObject());
   AssertIndexRange(i, n_rows());
   AssertIndexRange(j, n_cols());
 
   for (size_type k = rowstart[i]; k < rowstart[i + 1]; ++k)
     {
       // entry already exists
-      if (colnums[k] == j)
+      if (column_index(i, k) == j)
         return true;
     }
   return false;
@@ -695,9 +924,9 @@ SparsityPattern::matrix_position(const std::size_t global_index) const
     (std::upper_bound(rowstart.get(), rowstart.get() + rows, global_index) -
      rowstart.get() - 1);
 
-  // now, the column index is simple since that is what the colnums array
-  // stores:
-  const size_type col = colnums[global_index];
+  // now, the column index is simple since that is what the index arrays
+  // store:
+  const size_type col = column_index(row, global_index);
 
   // so return the respective pair
   return std::make_pair(row, col);
@@ -708,14 +937,16 @@ SparsityPattern::matrix_position(const std::size_t global_index) const
 SparsityPattern::size_type
 SparsityPattern::row_position(const size_type i, const size_type j) const
 {
-  Assert((rowstart != nullptr) && (colnums != nullptr), ExcEmptyObject());
+  Assert((rowstart != nullptr) &&
+           ((colnums != nullptr) || has_narrow_column_indices()),
+         ExcEmptyObject());
   AssertIndexRange(i, n_rows());
   AssertIndexRange(j, n_cols());
 
   for (size_type k = rowstart[i]; k < rowstart[i + 1]; ++k)
     {
       // entry exists
-      if (colnums[k] == j)
+      if (column_index(i, k) == j)
         return k - rowstart[i];
     }
   return numbers::invalid_size_type;
@@ -726,19 +957,24 @@ SparsityPattern::row_position(const size_type i, const size_type j) const
 SparsityPattern::size_type
 SparsityPattern::bandwidth() const
 {
-  Assert((rowstart != nullptr) && (colnums != nullptr), ExcEmptyObject());
+  Assert((rowstart != nullptr) &&
+           ((colnums != nullptr) || has_narrow_column_indices()),
+         ExcEmptyObject());
   size_type b = 0;
   for (size_type i = 0; i < n_rows(); ++i)
     for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-      if (colnums[j] != invalid_entry)
-        {
-          if (static_cast<size_type>(
-                std::abs(static_cast<int>(i - colnums[j]))) > b)
-            b = std::abs(static_cast<signed int>(i - colnums[j]));
-        }
-      else
-        // leave if at the end of the entries of this line
-        break;
+      {
+        const size_type column = column_index(i, j);
+        if (column != invalid_entry)
+          {
+            if (static_cast<size_type>(
+                  std::abs(static_cast<int>(i - column))) > b)
+              b = std::abs(static_cast<signed int>(i - column));
+          }
+        else
+          // leave if at the end of the entries of this line
+          break;
+      }
   return b;
 }
 
@@ -906,9 +1142,10 @@ SparsityPattern::operator==(const SparsityPattern &sp2) const
         if (rowstart[i] != sp2.rowstart[i])
           return false;
 
-      for (size_type i = 0; i < rowstart[rows]; ++i)
-        if (colnums[i] != sp2.colnums[i])
-          return false;
+      for (size_type row = 0; row < rows; ++row)
+        for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+          if (column_index(row, j) != sp2.column_index(row, j))
+            return false;
     }
 
   return true;
@@ -919,7 +1156,9 @@ SparsityPattern::operator==(const SparsityPattern &sp2) const
 void
 SparsityPattern::print(std::ostream &out) const
 {
-  Assert((rowstart != nullptr) && (colnums != nullptr), ExcEmptyObject());
+  Assert((rowstart != nullptr) &&
+           ((colnums != nullptr) || has_narrow_column_indices()),
+         ExcEmptyObject());
 
   AssertThrow(out.fail() == false, ExcIO());
 
@@ -927,8 +1166,8 @@ SparsityPattern::print(std::ostream &out) const
     {
       out << '[' << i;
       for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-        if (colnums[j] != invalid_entry)
-          out << ',' << colnums[j];
+        if (column_index(i, j) != invalid_entry)
+          out << ',' << column_index(i, j);
       out << ']' << std::endl;
     }
 
@@ -940,17 +1179,20 @@ SparsityPattern::print(std::ostream &out) const
 void
 SparsityPattern::print_gnuplot(std::ostream &out) const
 {
-  Assert((rowstart != nullptr) && (colnums != nullptr), ExcEmptyObject());
+  Assert((rowstart != nullptr) &&
+           ((colnums != nullptr) || has_narrow_column_indices()),
+         ExcEmptyObject());
 
   AssertThrow(out.fail() == false, ExcIO());
 
   for (size_type i = 0; i < n_rows(); ++i)
     for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-      if (colnums[j] != invalid_entry)
+      if (column_index(i, j) != invalid_entry)
         // while matrix entries are usually written (i,j), with i vertical and
         // j horizontal, gnuplot output is x-y, that is we have to exchange
         // the order of output
-        out << colnums[j] << " " << -static_cast<signed int>(i) << std::endl;
+        out << column_index(i, j) << " " << -static_cast<signed int>(i)
+            << std::endl;
 
   AssertThrow(out.fail() == false, ExcIO());
 }
@@ -995,18 +1237,39 @@ SparsityPattern::block_write(std::ostream &out) const
 {
   AssertThrow(out.fail() == false, ExcIO());
 
+  // the narrow column indices are not written, but the full column indices
+  // reconstructed from them
+  std::vector<size_type> column_indices;
+  if (has_narrow_column_indices())
+    {
+      column_indices.resize(rowstart[rows]);
+      for (size_type row = 0; row < rows; ++row)
+        internal::SparsityPatternTools::for_each_entry_in_row(
+          *this,
+          row,
+          rowstart[row],
+          rowstart[row + 1],
+          [&](const std::size_t j, const size_type column) {
+            column_indices[j] = column;
+          });
+    }
+  const size_type *const column_data =
+    (has_narrow_column_indices() ? column_indices.data() : colnums.get());
+  const std::size_t n_column_indices =
+    (has_narrow_column_indices() ? column_indices.size() : max_vec_len);
+
   // first the simple objects, bracketed in [...]
   out << '[' << max_dim << ' ' << n_rows() << ' ' << n_cols() << ' '
-      << max_vec_len << ' ' << max_row_length << ' ' << compressed << ' '
+      << n_column_indices << ' ' << max_row_length << ' ' << compressed << ' '
       << store_diagonal_first_in_row << "][";
   // then write out real data
   out.write(reinterpret_cast<const char *>(rowstart.get()),
             reinterpret_cast<const char *>(rowstart.get() + max_dim + 1) -
               reinterpret_cast<const char *>(rowstart.get()));
   out << "][";
-  out.write(reinterpret_cast<const char *>(colnums.get()),
-            reinterpret_cast<const char *>(colnums.get() + max_vec_len) -
-              reinterpret_cast<const char *>(colnums.get()));
+  out.write(reinterpret_cast<const char *>(column_data),
+            reinterpret_cast<const char *>(column_data + n_column_indices) -
+              reinterpret_cast<const char *>(column_data));
   out << ']';
 
   AssertThrow(out.fail() == false, ExcIO());
@@ -1027,6 +1290,9 @@ SparsityPattern::block_read(std::istream &in)
   in >> max_dim >> rows >> cols >> max_vec_len >> max_row_length >>
     compressed >> store_diagonal_first_in_row;
 
+  clear_narrow_column_indices();
+  clear_column_index_map();
+
   in >> c;
   AssertThrow(c == ']', ExcIO());
   in >> c;
@@ -1057,7 +1323,18 @@ std::size_t
 SparsityPattern::memory_consumption() const
 {
   return (max_dim * sizeof(size_type) + sizeof(*this) +
-          max_vec_len * sizeof(size_type));
+          max_vec_len * sizeof(size_type) +
+          (has_narrow_column_indices() ?
+             rows * sizeof(size_type) +
+               rowstart[rows] * sizeof(narrow_index_type) +
+               MemoryConsumption::memory_consumption(wide_rows) +
+               MemoryConsumption::memory_consumption(wide_row_start) +
+               MemoryConsumption::memory_consumption(wide_colnums) :
+             0) +
+          (has_column_index_map() ?
+             (cols + 1) * sizeof(std::size_t) +
+               rowstart[rows] * (sizeof(std::size_t) + sizeof(size_type)) :
+             0));
 }
 
 
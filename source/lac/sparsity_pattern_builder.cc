@@ -0,0 +1,310 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern_builder.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  /**
+   * The minimal number of rows worked on by one task when sorting the rows
+   * and copying them into the final sparsity pattern.
+   */
+  constexpr unsigned int minimum_parallel_grain_size = 512;
+
+  /**
+   * The number of entries below which a buffer is never compressed, to
+   * avoid sorting tiny arrays over and over.
+   */
+  constexpr std::size_t minimum_compression_size = 1 << 16;
+} // namespace
+
+
+
+SparsityPatternBuilder::SparsityPatternBuilder()
+  : SparsityPatternBase(0, 0)
+{}
+
+
+
+SparsityPatternBuilder::SparsityPatternBuilder(const size_type m,
+                                               const size_type n)
+  : SparsityPatternBase(m, n)
+{}
+
+
+
+SparsityPatternBuilder::SparsityPatternBuilder(
+  const SparsityPatternBuilder &builder)
+  : SparsityPatternBase(builder.n_rows(), builder.n_cols())
+{
+  Assert(builder.n_buffered_entries() == 0,
+         ExcMessage("This constructor can only be called if the provided "
+                    "argument is an empty sparsity pattern builder."));
+}
+
+
+
+void
+SparsityPatternBuilder::reinit(const size_type m, const size_type n)
+{
+  resize(m, n);
+
+  thread_buffers.clear();
+  buffers.clear();
+}
+
+
+
+SparsityPatternBuilder::Buffer &
+SparsityPatternBuilder::get_buffer()
+{
+  bool    exists = false;
+  Buffer &buffer = thread_buffers.get(exists);
+  if (exists == false)
+    {
+      std::lock_guard<std::mutex> lock(buffers_mutex);
+      buffers.push_back(&buffer);
+    }
+  return buffer;
+}
+
+
+
+void
+SparsityPatternBuilder::compress_buffer_if_large(Buffer &buffer)
+{
+  if (buffer.entries.size() <
+      std::max(2 * buffer.n_compressed, minimum_compression_size))
+    return;
+
+  std::sort(buffer.entries.begin(), buffer.entries.end());
+  buffer.entries.erase(std::unique(buffer.entries.begin(),
+                                   buffer.entries.end()),
+                       buffer.entries.end());
+  buffer.n_compressed = buffer.entries.size();
+}
+
+
+
+void
+SparsityPatternBuilder::add_row_entries(
+  const size_type                  &row,
+  const ArrayView<const size_type> &columns,
+  const bool)
+{
+  AssertIndexRange(row, n_rows());
+
+  Buffer &buffer = get_buffer();
+  for (const size_type column : columns)
+    {
+      AssertIndexRange(column, n_cols());
+      buffer.entries.emplace_back(row, column);
+    }
+  compress_buffer_if_large(buffer);
+}
+
+
+
+void
+SparsityPatternBuilder::add_entries(
+  const ArrayView<const std::pair<size_type, size_type>> &entries)
+{
+  Buffer &buffer = get_buffer();
+  for (const auto &entry : entries)
+    {
+      AssertIndexRange(entry.first, n_rows());
+      AssertIndexRange(entry.second, n_cols());
+      buffer.entries.push_back(entry);
+    }
+  compress_buffer_if_large(buffer);
+}
+
+
+
+void
+SparsityPatternBuilder::gather_rows(std::vector<std::size_t>  &row_start,
+                                    std::vector<unsigned int> &row_lengths,
+                                    std::vector<size_type>    &columns) const
+{
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+
+  // distribute the entries of all buffers to their rows by a counting
+  // sort. this is a single pass through the data that is limited by memory
+  // bandwidth, so we do it sequentially
+  row_start.assign(n_rows() + 1, 0);
+  for (const Buffer *buffer : buffers)
+    for (const auto &entry : buffer->entries)
+      ++row_start[entry.first + 1];
+  for (size_type row = 0; row < n_rows(); ++row)
+    row_start[row + 1] += row_start[row];
+
+  columns.resize(row_start[n_rows()]);
+  {
+    std::vector<std::size_t> next_position(row_start.begin(),
+                                           row_start.end() - 1);
+    for (const Buffer *buffer : buffers)
+      for (const auto &entry : buffer->entries)
+        columns[next_position[entry.first]++] = entry.second;
+  }
+
+  // then sort the rows and remove duplicates, which is the expensive part
+  // and independent for each row
+  row_lengths.resize(n_rows());
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_rows(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        {
+          const auto row_begin = columns.begin() + row_start[row];
+          const auto row_end   = columns.begin() + row_start[row + 1];
+          std::sort(row_begin, row_end);
+          row_lengths[row] = std::unique(row_begin, row_end) - row_begin;
+        }
+    },
+    minimum_parallel_grain_size);
+}
+
+
+
+void
+SparsityPatternBuilder::copy_to(SparsityPattern &sparsity_pattern) const
+{
+  std::vector<std::size_t>  row_start;
+  std::vector<unsigned int> row_lengths;
+  std::vector<size_type>    columns;
+  gather_rows(row_start, row_lengths, columns);
+
+  // reserve space for the diagonal entries of square patterns, which the
+  // SparsityPattern stores first in each row
+  const bool                do_diag_optimize = (n_rows() == n_cols());
+  std::vector<unsigned int> entries_per_row(row_lengths);
+  if (do_diag_optimize)
+    for (size_type row = 0; row < n_rows(); ++row)
+      {
+        const auto row_begin = columns.begin() + row_start[row];
+        if (!std::binary_search(row_begin, row_begin + row_lengths[row], row))
+          ++entries_per_row[row];
+      }
+
+  sparsity_pattern.reinit(n_rows(), n_cols(), entries_per_row);
+
+  // the diagonal entries have been set by reinit(), so only copy the other
+  // entries behind them
+  if (n_rows() != 0 && n_cols() != 0)
+    parallel::apply_to_subranges(
+      size_type(0),
+      n_rows(),
+      [&](const size_type begin, const size_type end) {
+        for (size_type row = begin; row < end; ++row)
+          {
+            size_type *cols =
+              &sparsity_pattern.colnums[sparsity_pattern.rowstart[row]] +
+              (do_diag_optimize ? 1 : 0);
+            for (std::size_t j = row_start[row];
+                 j < row_start[row] + row_lengths[row];
+                 ++j)
+              if ((columns[j] != row) || !do_diag_optimize)
+                *cols++ = columns[j];
+          }
+      },
+      minimum_parallel_grain_size);
+
+  sparsity_pattern.compressed = true;
+}
+
+
+
+void
+SparsityPatternBuilder::copy_to(DynamicSparsityPattern &sparsity_pattern) const
+{
+  AssertDimension(sparsity_pattern.n_rows(), n_rows());
+  AssertDimension(sparsity_pattern.n_cols(), n_cols());
+
+  std::vector<std::size_t>  row_start;
+  std::vector<unsigned int> row_lengths;
+  std::vector<size_type>    columns;
+  gather_rows(row_start, row_lengths, columns);
+
+  // DynamicSparsityPattern::add_entries() marks the object as non-empty
+  // the first time entries are added. do this for the first nonempty row
+  // stored by the object before going parallel, so that the rows can then
+  // be filled independently of each other
+  const IndexSet &rowset    = sparsity_pattern.row_index_set();
+  size_type       first_row = 0;
+  while (first_row < n_rows() &&
+         (row_lengths[first_row] == 0 ||
+          (rowset.size() > 0 && !rowset.is_element(first_row))))
+    ++first_row;
+  if (first_row == n_rows())
+    return;
+  sparsity_pattern.add_entries(first_row,
+                               columns.begin() + row_start[first_row],
+                               columns.begin() + row_start[first_row] +
+                                 row_lengths[first_row],
+                               true);
+
+  parallel::apply_to_subranges(
+    first_row + 1,
+    n_rows(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        sparsity_pattern.add_entries(row,
+                                     columns.begin() + row_start[row],
+                                     columns.begin() + row_start[row] +
+                                       row_lengths[row],
+                                     true);
+    },
+    minimum_parallel_grain_size);
+}
+
+
+
+std::size_t
+SparsityPatternBuilder::n_buffered_entries() const
+{
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+
+  std::size_t n_entries = 0;
+  for (const Buffer *buffer : buffers)
+    n_entries += buffer->entries.size();
+  return n_entries;
+}
+
+
+
+std::size_t
+SparsityPatternBuilder::memory_consumption() const
+{
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+
+  std::size_t memory = sizeof(*this) + MemoryConsumption::memory_consumption(
+                                         buffers);
+  for (const Buffer *buffer : buffers)
+    memory += sizeof(*buffer) + buffer->entries.capacity() *
+                                  sizeof(std::pair<size_type, size_type>);
+  return memory;
+}
+
+DEAL_II_NAMESPACE_CLOSE
@@ -14,6 +14,8 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/work_stream.h>
 
@@ -68,30 +70,142 @@ namespace MatrixTools
     }
   } // namespace
 
-  // TODO:[WB] I don't think that the optimized storage of diagonals is needed
-  // (GK)
+  template <typename number>
+  BoundaryValueElimination::BoundaryValueElimination(
+    const std::map<types::global_dof_index, number> &boundary_values,
+    const SparsityPattern                           &sparsity_pattern,
+    const bool                                       eliminate_columns)
+  {
+    reinit(boundary_values, sparsity_pattern, eliminate_columns);
+  }
+
+
+
   template <typename number>
   void
-  apply_boundary_values(
+  BoundaryValueElimination::reinit(
+    const std::map<types::global_dof_index, number> &boundary_values,
+    const SparsityPattern                           &sparsity_pattern,
+    const bool                                       eliminate_columns)
+  {
+    Assert(sparsity_pattern.n_rows() == sparsity_pattern.n_cols(),
+           ExcDimensionMismatch(sparsity_pattern.n_rows(),
+                                sparsity_pattern.n_cols()));
+
+    const types::global_dof_index n_dofs = sparsity_pattern.n_rows();
+
+    this->sparsity_pattern  = &sparsity_pattern;
+    this->eliminate_columns = eliminate_columns;
+
+    boundary_dofs.clear();
+    boundary_dofs.reserve(boundary_values.size());
+    for (const auto &boundary_value : boundary_values)
+      {
+        AssertIndexRange(boundary_value.first, n_dofs);
+        boundary_dofs.push_back(boundary_value.first);
+      }
+
+    eliminated_rows.clear();
+    eliminated_row_starts.assign(1, 0);
+    entry_positions.clear();
+    entry_boundary_indices.clear();
+
+    if (eliminate_columns == false || boundary_dofs.empty())
+      return;
+
+    // we need to eliminate the entries in the columns of boundary dofs in all
+    // other rows. if the sparsity pattern is symmetric, then we can get these
+    // rows by looking at the column numbers of the rows of the boundary dofs.
+    // boundary dofs are found by a binary search in the sorted array
+    // boundary_dofs, so that the work does not depend on the total number of
+    // dofs
+    const auto is_boundary_dof = [&](const types::global_dof_index dof) {
+      return std::binary_search(boundary_dofs.begin(),
+                                boundary_dofs.end(),
+                                dof);
+    };
+    std::size_t n_expected_entries = 0;
+    for (const types::global_dof_index dof : boundary_dofs)
+      for (SparsityPattern::iterator entry = sparsity_pattern.begin(dof);
+           entry != sparsity_pattern.end(dof);
+           ++entry)
+        if (is_boundary_dof(entry->column()) == false)
+          {
+            eliminated_rows.push_back(entry->column());
+            ++n_expected_entries;
+          }
+    std::sort(eliminated_rows.begin(), eliminated_rows.end());
+    eliminated_rows.erase(std::unique(eliminated_rows.begin(),
+                                      eliminated_rows.end()),
+                          eliminated_rows.end());
+
+    // then scan these rows once for their entries in the columns of boundary
+    // dofs and record their positions, which avoids searching for each of
+    // them later. the entries of each row are sorted by their column, except
+    // for the diagonal entry that comes first and that is not in a boundary
+    // column, so the entries of a row are eliminated in the order of the
+    // boundary dofs
+    eliminated_row_starts.reserve(eliminated_rows.size() + 1);
+    entry_positions.reserve(n_expected_entries);
+    entry_boundary_indices.reserve(n_expected_entries);
+    for (const types::global_dof_index row : eliminated_rows)
+      {
+        unsigned int position = 0;
+        for (SparsityPattern::iterator entry = sparsity_pattern.begin(row);
+             entry != sparsity_pattern.end(row);
+             ++entry, ++position)
+          {
+            const auto boundary_dof = std::lower_bound(boundary_dofs.begin(),
+                                                       boundary_dofs.end(),
+                                                       entry->column());
+            if (boundary_dof != boundary_dofs.end() &&
+                *boundary_dof == entry->column())
+              {
+                entry_positions.push_back(position);
+                entry_boundary_indices.push_back(boundary_dof -
+                                                 boundary_dofs.begin());
+              }
+          }
+        eliminated_row_starts.push_back(entry_positions.size());
+      }
+
+    // there should be exactly one entry for each of the entries found in
+    // the rows of the boundary dofs, since we have assumed that the sparsity
+    // pattern is symmetric
+    Assert(entry_positions.size() == n_expected_entries,
+           ExcMessage(
+             "This function is trying to access an element of the "
+             "matrix that doesn't seem to exist. Are you using a "
+             "nonsymmetric sparsity pattern? If so, you are not "
+             "allowed to set the eliminate_column argument of this "
+             "function, see the documentation."));
+  }
+
+
+
+  template <typename number>
+  void
+  BoundaryValueElimination::apply(
     const std::map<types::global_dof_index, number> &boundary_values,
     SparseMatrix<number>                            &matrix,
     Vector<number>                                  &solution,
-    Vector<number>                                  &right_hand_side,
-    const bool                                       eliminate_columns)
+    Vector<number>                                  &right_hand_side) const
   {
+    Assert(sparsity_pattern != nullptr, ExcNotInitialized());
+    Assert(&matrix.get_sparsity_pattern() == sparsity_pattern,
+           ExcMessage("The matrix must use the sparsity pattern given to "
+                      "BoundaryValueElimination::reinit()."));
     Assert(matrix.n() == right_hand_side.size(),
            ExcDimensionMismatch(matrix.n(), right_hand_side.size()));
     Assert(matrix.n() == solution.size(),
            ExcDimensionMismatch(matrix.n(), solution.size()));
-    Assert(matrix.n() == matrix.m(),
-           ExcDimensionMismatch(matrix.n(), matrix.m()));
+    AssertDimension(boundary_values.size(), boundary_dofs.size());
 
     // if no boundary values are to be applied
     // simply return
-    if (boundary_values.empty())
+    if (boundary_dofs.empty())
       return;
 
-
     const types::global_dof_index n_dofs = matrix.m();
 
     // if a diagonal entry is zero
@@ -108,125 +222,138 @@ namespace MatrixTools
           break;
         }
 
-
-    typename std::map<types::global_dof_index, number>::const_iterator
-      dof  = boundary_values.begin(),
-      endd = boundary_values.end();
-    for (; dof != endd; ++dof)
+    // copy the boundary values to an array for access from several threads
+    std::vector<number> values;
+    values.reserve(boundary_dofs.size());
+    for (const auto &boundary_value : boundary_values)
       {
-        Assert(dof->first < n_dofs, ExcInternalError());
-
-        const types::global_dof_index dof_number = dof->first;
-        // for each boundary dof:
-
-        // set entries of this line to zero except for the diagonal
-        // entry
-        for (typename SparseMatrix<number>::iterator p =
-               matrix.begin(dof_number);
-             p != matrix.end(dof_number);
-             ++p)
-          if (p->column() != dof_number)
-            p->value() = 0.;
+        Assert(boundary_value.first == boundary_dofs[values.size()],
+               ExcMessage("The boundary values must be given for the same "
+                          "degrees of freedom as in the call to "
+                          "BoundaryValueElimination::reinit()."));
+        values.push_back(boundary_value.second);
+      }
 
-        // set right hand side to
-        // wanted value: if main diagonal
-        // entry nonzero, don't touch it
-        // and scale rhs accordingly. If
-        // zero, take the first main
-        // diagonal entry we can find, or
-        // one if no nonzero main diagonal
-        // element exists. Normally, however,
-        // the main diagonal entry should
-        // not be zero.
-        //
-        // store the new rhs entry to make
-        // the gauss step more efficient
-        number new_rhs;
-        if (matrix.diag_element(dof_number) != number())
-          {
-            new_rhs = dof->second * matrix.diag_element(dof_number);
-            right_hand_side(dof_number) = new_rhs;
-          }
-        else
+    // for each boundary dof, set the entries of its row to zero except for
+    // the diagonal entry. set the right hand side to the wanted value: if
+    // the main diagonal entry is nonzero, don't touch it and scale the rhs
+    // accordingly. if zero, take the first main diagonal entry we can find,
+    // or one if no nonzero main diagonal element exists. normally, however,
+    // the main diagonal entry should not be zero. store the diagonal entry
+    // and the new rhs entry for the Gauss elimination step below
+    std::vector<number> diagonal_entries(boundary_dofs.size());
+    std::vector<number> new_rhs_values(boundary_dofs.size());
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      boundary_dofs.size(),
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
           {
-            matrix.set(dof_number, dof_number, first_nonzero_diagonal_entry);
-            new_rhs = dof->second * first_nonzero_diagonal_entry;
-            right_hand_side(dof_number) = new_rhs;
-          }
+            const types::global_dof_index dof_number = boundary_dofs[i];
 
+            for (typename SparseMatrix<number>::iterator p =
+                   matrix.begin(dof_number);
+                 p != matrix.end(dof_number);
+                 ++p)
+              if (p->column() != dof_number)
+                p->value() = 0.;
 
-        // if the user wants to have
-        // the symmetry of the matrix
-        // preserved, and if the
-        // sparsity pattern is
-        // symmetric, then do a Gauss
-        // elimination step with the
-        // present row
-        if (eliminate_columns)
-          {
-            // store the only nonzero entry
-            // of this line for the Gauss
-            // elimination step
-            const number diagonal_entry = matrix.diag_element(dof_number);
-
-            // we have to loop over all rows of the matrix which have
-            // a nonzero entry in the column which we work in
-            // presently. if the sparsity pattern is symmetric, then
-            // we can get the positions of these rows cheaply by
-            // looking at the nonzero column numbers of the present
-            // row. we need not look at the first entry of each row,
-            // since that is the diagonal element and thus the present
-            // row
-            for (typename SparseMatrix<number>::iterator q =
-                   matrix.begin(dof_number) + 1;
-                 q != matrix.end(dof_number);
-                 ++q)
+            number new_rhs;
+            if (matrix.diag_element(dof_number) != number())
+              new_rhs = values[i] * matrix.diag_element(dof_number);
+            else
               {
-                const types::global_dof_index row = q->column();
-
-                // find the position of
-                // element
-                // (row,dof_number)
-                bool (*comp)(
-                  const typename SparseMatrix<number>::iterator::value_type p,
-                  const unsigned int column) =
-                  &column_less_than<typename SparseMatrix<number>::iterator>;
-                const typename SparseMatrix<number>::iterator p =
-                  Utilities::lower_bound(matrix.begin(row) + 1,
-                                         matrix.end(row),
-                                         dof_number,
-                                         comp);
-
-                // check whether this line has an entry in the
-                // regarding column (check for ==dof_number and !=
-                // next_row, since if row==dof_number-1, *p is a
-                // past-the-end pointer but points to dof_number
-                // anyway...)
-                //
-                // there should be such an entry! we know this because
-                // we have assumed that the sparsity pattern is
-                // symmetric and we only walk over those rows for
-                // which the current row has a column entry
-                Assert((p != matrix.end(row)) && (p->column() == dof_number),
-                       ExcMessage(
-                         "This function is trying to access an element of the "
-                         "matrix that doesn't seem to exist. Are you using a "
-                         "nonsymmetric sparsity pattern? If so, you are not "
-                         "allowed to set the eliminate_column argument of this "
-                         "function, see the documentation."));
-
-                // correct right hand side
-                right_hand_side(row) -=
-                  static_cast<number>(p->value()) / diagonal_entry * new_rhs;
-
-                // set matrix entry to zero
-                p->value() = 0.;
+                matrix.diag_element(dof_number) = first_nonzero_diagonal_entry;
+                new_rhs = values[i] * first_nonzero_diagonal_entry;
               }
+            right_hand_side(dof_number) = new_rhs;
+
+            diagonal_entries[i] = matrix.diag_element(dof_number);
+            new_rhs_values[i]   = new_rhs;
+
+            // preset solution vector
+            solution(dof_number) = values[i];
           }
+      },
+      64);
+
+    // if the user wants to have the symmetry of the matrix preserved, do a
+    // Gauss elimination step with the rows of the boundary dofs, visiting the
+    // entries in the columns of boundary dofs that we have found in reinit().
+    // the rows of boundary dofs have already been treated above
+    if (eliminate_columns)
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        eliminated_rows.size(),
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t r = begin; r < end; ++r)
+            {
+              const types::global_dof_index row = eliminated_rows[r];
+              const typename SparseMatrix<number>::iterator row_begin =
+                matrix.begin(row);
+              for (std::size_t e = eliminated_row_starts[r];
+                   e < eliminated_row_starts[r + 1];
+                   ++e)
+                {
+                  const typename SparseMatrix<number>::iterator p =
+                    row_begin + entry_positions[e];
+                  const types::global_dof_index i = entry_boundary_indices[e];
+
+                  // correct right hand side
+                  right_hand_side(row) -= static_cast<number>(p->value()) /
+                                          diagonal_entries[i] *
+                                          new_rhs_values[i];
+
+                  // set matrix entry to zero
+                  p->value() = 0.;
+                }
+            }
+        },
+        64);
+  }
 
-        // preset solution vector
-        solution(dof_number) = dof->second;
-      }
+
+
+  std::size_t
+  BoundaryValueElimination::memory_consumption() const
+  {
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(boundary_dofs) +
+           MemoryConsumption::memory_consumption(eliminated_rows) +
+           MemoryConsumption::memory_consumption(eliminated_row_starts) +
+           MemoryConsumption::memory_consumption(entry_positions) +
+           MemoryConsumption::memory_consumption(entry_boundary_indices);
+  }
+
+
+
+  // TODO:[WB] I don't think that the optimized storage of diagonals is needed
+  // (GK)
+  template <typename number>
+  void
+  apply_boundary_values(
+    const std::map<types::global_dof_index, number> &boundary_values,
+    SparseMatrix<number>                            &matrix,
+    Vector<number>                                  &solution,
+    Vector<number>                                  &right_hand_side,
+    const bool                                       eliminate_columns)
+  {
+    Assert(matrix.n() == right_hand_side.size(),
+           ExcDimensionMismatch(matrix.n(), right_hand_side.size()));
+    Assert(matrix.n() == solution.size(),
+           ExcDimensionMismatch(matrix.n(), solution.size()));
+    Assert(matrix.n() == matrix.m(),
+           ExcDimensionMismatch(matrix.n(), matrix.m()));
+
+    // if no boundary values are to be applied
+    // simply return
+    if (boundary_values.empty())
+      return;
+
+    const BoundaryValueElimination elimination(boundary_values,
+                                               matrix.get_sparsity_pattern(),
+                                               eliminate_columns);
+    elimination.apply(boundary_values, matrix, solution, right_hand_side);
   }
 
 
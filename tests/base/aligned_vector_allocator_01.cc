@@ -0,0 +1,196 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// test AlignedVector with allocators set for individual objects and as
+// default allocator, and the HugePages and Pool allocation strategies
+
+#include <deal.II/base/aligned_vector.h>
+
+#include <cstdint>
+
+#include "../tests.h"
+
+
+// an allocator that counts the allocations and the currently allocated bytes
+class CountingAllocator : public AlignedVectorAllocation::Standard
+{
+public:
+  virtual void *
+  allocate(const std::size_t n_bytes, const std::size_t alignment) override
+  {
+    ++n_allocations;
+    allocated_bytes += n_bytes;
+    return Standard::allocate(n_bytes, alignment);
+  }
+
+  virtual void
+  deallocate(void             *ptr,
+             const std::size_t n_bytes,
+             const std::size_t alignment) override
+  {
+    if (ptr != nullptr)
+      {
+        ++n_deallocations;
+        allocated_bytes -= n_bytes;
+      }
+    Standard::deallocate(ptr, n_bytes, alignment);
+  }
+
+  unsigned int n_allocations   = 0;
+  unsigned int n_deallocations = 0;
+  std::size_t  allocated_bytes = 0;
+};
+
+
+
+void
+print(const std::string &name, const CountingAllocator &allocator)
+{
+  deallog << name << ": allocations " << allocator.n_allocations
+          << ", deallocations " << allocator.n_deallocations
+          << ", bytes in use " << allocator.allocated_bytes << std::endl;
+}
+
+
+
+void
+test_object_allocator()
+{
+  auto allocator = std::make_shared<CountingAllocator>();
+  {
+    AlignedVector<double> a(4, 1.);
+    a.set_allocator(allocator);
+    deallog << "Has allocator: " << (a.get_allocator() == allocator)
+            << ", values " << a[0] << ' ' << a[3] << std::endl;
+    print("After set_allocator", *allocator);
+
+    for (unsigned int i = 0; i < 20; ++i)
+      a.push_back(i);
+    deallog << "Size " << a.size() << ", last value " << a.back()
+            << std::endl;
+    print("After push_back", *allocator);
+
+    a.clear();
+    print("After clear", *allocator);
+    a.resize(10, 2.);
+    print("After resize", *allocator);
+
+    // copies use the default allocator
+    AlignedVector<double> b(a);
+    deallog << "Copy has allocator: " << (b.get_allocator() != nullptr)
+            << std::endl;
+    print("After copy", *allocator);
+
+    // moves transfer the memory along with its allocator
+    AlignedVector<double> c(std::move(a));
+    deallog << "Moved-to object has allocator: "
+            << (c.get_allocator() == allocator) << std::endl;
+    b.swap(c);
+    deallog << "Swapped object has allocator: "
+            << (b.get_allocator() == allocator) << ", value " << b[9]
+            << std::endl;
+
+    // unset the allocator, which moves the memory back to the default
+    b.set_allocator({});
+    deallog << "Has allocator: " << (b.get_allocator() != nullptr)
+            << ", value " << b[9] << std::endl;
+    print("After unsetting", *allocator);
+  }
+  print("After destruction", *allocator);
+}
+
+
+
+void
+test_default_allocator()
+{
+  auto allocator = std::make_shared<CountingAllocator>();
+  AlignedVectorAllocation::set_default_allocator(allocator);
+  {
+    AlignedVector<int> a(100);
+    AlignedVector<int> b(a);
+
+    // objects can opt out of the default allocator
+    AlignedVector<int> c;
+    c.set_allocator(std::make_shared<AlignedVectorAllocation::Standard>());
+    c.resize(100);
+    print("Default allocator", *allocator);
+
+    // memory is returned to the allocator it came from
+    AlignedVectorAllocation::set_default_allocator({});
+  }
+  print("After destruction", *allocator);
+}
+
+
+
+void
+test_huge_pages()
+{
+  auto allocator = std::make_shared<AlignedVectorAllocation::HugePages>();
+  AlignedVector<double> small, large;
+  small.set_allocator(allocator);
+  large.set_allocator(allocator);
+  small.resize(100, 1.);
+  large.resize(1000000, 1.);
+  const std::uintptr_t huge_page_size =
+    AlignedVectorAllocation::HugePages::huge_page_size;
+  deallog << "Small vector aligned: "
+          << (reinterpret_cast<std::uintptr_t>(small.data()) % 64 == 0)
+          << ", large vector on huge page boundary: "
+          << (reinterpret_cast<std::uintptr_t>(large.data()) %
+                huge_page_size ==
+              0)
+          << ", values " << small[99] << ' ' << large[999999] << std::endl;
+}
+
+
+
+void
+test_pool()
+{
+  auto pool = std::make_shared<AlignedVectorAllocation::Pool>();
+  const double *first_data;
+  {
+    AlignedVector<double> a;
+    a.set_allocator(pool);
+    a.resize(1000);
+    first_data = a.data();
+  }
+  deallog << "Pooled bytes: " << pool->n_pooled_bytes() << std::endl;
+  {
+    AlignedVector<double> a;
+    a.set_allocator(pool);
+    a.resize(1000);
+    deallog << "Memory reused: " << (a.data() == first_data)
+            << ", pooled bytes: " << pool->n_pooled_bytes() << std::endl;
+  }
+  pool->release_unused_memory();
+  deallog << "Pooled bytes after release: " << pool->n_pooled_bytes()
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_object_allocator();
+  test_default_allocator();
+  test_huge_pages();
+  test_pool();
+}
@@ -0,0 +1,177 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check MatrixTools::BoundaryValueElimination, applied repeatedly with
+// changing boundary values, and MatrixTools::apply_boundary_values for
+// SparseMatrix against a straightforward implementation of the elimination
+// that searches for each entry in the columns of boundary dofs
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+void
+reference_apply(const std::map<types::global_dof_index, double> &values,
+                SparseMatrix<double>                            &matrix,
+                Vector<double>                                  &solution,
+                Vector<double>                                  &rhs,
+                const bool eliminate_columns)
+{
+  double first_nonzero_diagonal_entry = 1;
+  for (unsigned int i = 0; i < matrix.m(); ++i)
+    if (matrix.diag_element(i) != 0.)
+      {
+        first_nonzero_diagonal_entry = matrix.diag_element(i);
+        break;
+      }
+
+  for (const auto &value : values)
+    {
+      const types::global_dof_index dof = value.first;
+      for (auto p = matrix.begin(dof); p != matrix.end(dof); ++p)
+        if (p->column() != dof)
+          p->value() = 0.;
+      if (matrix.diag_element(dof) == 0.)
+        matrix.diag_element(dof) = first_nonzero_diagonal_entry;
+      const double new_rhs = value.second * matrix.diag_element(dof);
+      rhs(dof)             = new_rhs;
+      solution(dof)        = value.second;
+
+      if (eliminate_columns)
+        for (auto q = matrix.get_sparsity_pattern().begin(dof);
+             q != matrix.get_sparsity_pattern().end(dof);
+             ++q)
+          {
+            const types::global_dof_index row = q->column();
+            if (row == dof)
+              continue;
+            const double entry = matrix.el(row, dof);
+            rhs(row) -= entry / matrix.diag_element(dof) * new_rhs;
+            matrix.set(row, dof, 0.);
+          }
+    }
+}
+
+
+
+bool
+is_equal(const SparseMatrix<double> &a, const SparseMatrix<double> &b)
+{
+  for (unsigned int row = 0; row < a.m(); ++row)
+    for (auto p = a.begin(row), q = b.begin(row); p != a.end(row); ++p, ++q)
+      if (p->value() != q->value())
+        return false;
+  return true;
+}
+
+
+
+void
+test(const bool eliminate_columns)
+{
+  deallog << "eliminate_columns=" << eliminate_columns << std::endl;
+
+  const unsigned int size = 20;
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    sparsity(size * size, size * size, 9);
+  testproblem.nine_point_structure(sparsity);
+  sparsity.compress();
+  SparseMatrix<double> unmodified(sparsity);
+  testproblem.nine_point(unmodified);
+  // a zero diagonal entry, replaced by the first nonzero one
+  unmodified.diag_element(3) = 0.;
+
+  // constrain every fifth dof
+  std::map<types::global_dof_index, double> boundary_values;
+  for (unsigned int i = 3; i < sparsity.n_rows(); i += 5)
+    boundary_values[i] = 0.;
+
+  const MatrixTools::BoundaryValueElimination elimination(boundary_values,
+                                                          sparsity,
+                                                          eliminate_columns);
+
+  SparseMatrix<double> matrix(sparsity), reference(sparsity);
+  Vector<double>       solution(sparsity.n_rows());
+  Vector<double>       rhs(sparsity.n_rows());
+  Vector<double>       reference_solution(sparsity.n_rows());
+  Vector<double>       reference_rhs(sparsity.n_rows());
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      for (auto &value : boundary_values)
+        value.second = std::sin(value.first + step);
+      for (unsigned int i = 0; i < rhs.size(); ++i)
+        rhs(i) = std::cos(i * (step + 1.));
+      solution = 0.;
+      matrix.copy_from(unmodified);
+
+      reference.copy_from(matrix);
+      reference_solution = solution;
+      reference_rhs      = rhs;
+      reference_apply(boundary_values,
+                      reference,
+                      reference_solution,
+                      reference_rhs,
+                      eliminate_columns);
+
+      elimination.apply(boundary_values, matrix, solution, rhs);
+
+      deallog << "Step " << step << ": matrix "
+              << (is_equal(matrix, reference) ? "equal" : "different")
+              << ", solution "
+              << (solution == reference_solution ? "equal" : "different")
+              << ", rhs " << (rhs == reference_rhs ? "equal" : "different")
+              << ", rhs norm " << rhs.l2_norm() << std::endl;
+    }
+
+  // the function for SparseMatrix gives the same result
+  matrix.copy_from(unmodified);
+  solution = 0.;
+  rhs      = 1.;
+  MatrixTools::apply_boundary_values(
+    boundary_values, matrix, solution, rhs, eliminate_columns);
+  reference.copy_from(unmodified);
+  reference_solution = 0.;
+  reference_rhs      = 1.;
+  reference_apply(boundary_values,
+                  reference,
+                  reference_solution,
+                  reference_rhs,
+                  eliminate_columns);
+  deallog << "apply_boundary_values: matrix "
+          << (is_equal(matrix, reference) ? "equal" : "different")
+          << ", solution "
+          << (solution == reference_solution ? "equal" : "different")
+          << ", rhs " << (rhs == reference_rhs ? "equal" : "different")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(true);
+  test(false);
+}
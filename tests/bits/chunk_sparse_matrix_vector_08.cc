@@ -0,0 +1,98 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check ChunkSparseMatrix::vmult and ChunkSparseMatrix::vmult_add against
+// SparseMatrix for the chunk sizes that use kernels with a chunk size fixed
+// at compile time and for some that do not, both for matrices whose size is
+// a multiple of the chunk size, like the ones of vector-valued problems with
+// the components of each support point numbered consecutively, and for
+// matrices with padding in the last chunk row and column
+
+#include <deal.II/lac/chunk_sparse_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int chunk_size, const unsigned int n_rows)
+{
+  // couple each row to the rows of the same chunk and of two neighboring
+  // chunks, plus some entries farther away
+  DynamicSparsityPattern dsp(n_rows, n_rows);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    {
+      const unsigned int chunk = i / chunk_size;
+      for (unsigned int j = (chunk > 0 ? chunk - 1 : 0) * chunk_size;
+           j < std::min((chunk + 2) * chunk_size, n_rows);
+           ++j)
+        dsp.add(i, j);
+      dsp.add(i, (7 * i + 3) % n_rows);
+    }
+
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  ChunkSparsityPattern chunk_sparsity;
+  chunk_sparsity.copy_from(dsp, chunk_size);
+
+  SparseMatrix<double>      A(sparsity);
+  ChunkSparseMatrix<double> B(chunk_sparsity);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (auto entry = dsp.begin(i); entry != dsp.end(i); ++entry)
+      {
+        const double value = std::sin(1. + i + 0.3 * entry->column());
+        A.set(i, entry->column(), value);
+        B.set(i, entry->column(), value);
+      }
+
+  Vector<double> src(n_rows), dst_A(n_rows), dst_B(n_rows);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    src(i) = std::cos(0.7 * i);
+
+  A.vmult(dst_A, src);
+  B.vmult(dst_B, src);
+  dst_B -= dst_A;
+  const double error_vmult = dst_B.linfty_norm() / dst_A.linfty_norm();
+
+  A.vmult(dst_A, src);
+  dst_B = dst_A;
+  A.vmult_add(dst_A, src);
+  B.vmult_add(dst_B, src);
+  dst_B -= dst_A;
+  const double error_vmult_add = dst_B.linfty_norm() / dst_A.linfty_norm();
+
+  deallog << "chunk size " << chunk_size << ", size " << n_rows << ": "
+          << (error_vmult < 1e-14 && error_vmult_add < 1e-14 ? "OK" :
+                                                               "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const unsigned int chunk_size : {1, 2, 3, 4, 5, 6, 7})
+    for (const unsigned int n_chunks : {1, 10, 3000})
+      {
+        test(chunk_size, n_chunks * chunk_size);
+        test(chunk_size, n_chunks * chunk_size + 1);
+      }
+}
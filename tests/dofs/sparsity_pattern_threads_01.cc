@@ -0,0 +1,132 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that DoFTools::make_sparsity_pattern and
+// DoFTools::make_flux_sparsity_pattern build the same DynamicSparsityPattern
+// with several threads, where the cells are worked on in parallel, as with
+// a single thread
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+// build the sparsity pattern by the given function once with the default
+// number of threads and once with a single thread and compare the results
+template <typename Function>
+void
+compare(const std::string &name, const unsigned int n_dofs, const Function &f)
+{
+  SparsityPattern sparsity[2];
+  for (unsigned int single_thread = 0; single_thread < 2; ++single_thread)
+    {
+      MultithreadInfo::set_thread_limit(
+        single_thread == 1 ? 1 : testing_max_num_threads());
+
+      DynamicSparsityPattern dsp(n_dofs, n_dofs);
+      f(dsp);
+      sparsity[single_thread].copy_from(dsp);
+    }
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  deallog << name << ": "
+          << (sparsity[0] == sparsity[1] ? "identical" : "differ")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      unsigned int index = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (index++ % 3 == 0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  {
+    FESystem<dim>   fe(FE_Q<dim>(2), 2);
+    DoFHandler<dim> dof(tria);
+    dof.distribute_dofs(fe);
+
+    AffineConstraints<double> constraints;
+    DoFTools::make_hanging_node_constraints(dof, constraints);
+    constraints.close();
+
+    compare("make_sparsity_pattern", dof.n_dofs(), [&](auto &dsp) {
+      DoFTools::make_sparsity_pattern(dof, dsp, constraints, false);
+    });
+
+    Table<2, DoFTools::Coupling> couplings(2, 2);
+    couplings.fill(DoFTools::always);
+    couplings(0, 1) = DoFTools::none;
+    compare("make_sparsity_pattern with couplings",
+            dof.n_dofs(),
+            [&](auto &dsp) {
+              DoFTools::make_sparsity_pattern(
+                dof, couplings, dsp, constraints, true);
+            });
+  }
+
+  {
+    FE_DGQ<dim>     fe(1);
+    DoFHandler<dim> dof(tria);
+    dof.distribute_dofs(fe);
+
+    compare("make_flux_sparsity_pattern", dof.n_dofs(), [&](auto &dsp) {
+      DoFTools::make_flux_sparsity_pattern(dof, dsp);
+    });
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,185 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that AffineConstraints::distribute_local_to_global() with a
+// Threads::StripedMutex, called from the copiers of
+// WorkStream::run_with_concurrent_copiers(), produces the same matrix and
+// vector as the sequential assembly. the "mesh" is a structured grid of
+// quadrilaterals with bilinear elements, with some hanging-node-like and
+// inhomogeneous constraints
+
+#include <deal.II/base/mutex.h>
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+const unsigned int n_cells_1d = 60;
+const unsigned int n_nodes_1d = n_cells_1d + 1;
+
+
+std::vector<types::global_dof_index>
+cell_dofs(const unsigned int cell)
+{
+  const unsigned int i = cell % n_cells_1d, j = cell / n_cells_1d;
+  return {j * n_nodes_1d + i,
+          j * n_nodes_1d + i + 1,
+          (j + 1) * n_nodes_1d + i,
+          (j + 1) * n_nodes_1d + i + 1};
+}
+
+
+struct ScratchData
+{};
+
+struct CopyData
+{
+  FullMatrix<double>                   cell_matrix;
+  Vector<double>                       cell_rhs;
+  std::vector<types::global_dof_index> local_dof_indices;
+};
+
+
+void
+local_assemble(const unsigned int &cell, ScratchData &, CopyData &copy_data)
+{
+  // a Laplace-like element matrix, scaled differently on every cell, and
+  // some right hand side
+  const double coefficient = 1. + 0.1 * (cell % 7);
+  copy_data.cell_matrix.reinit(4, 4);
+  copy_data.cell_rhs.reinit(4);
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      for (unsigned int j = 0; j < 4; ++j)
+        copy_data.cell_matrix(i, j) =
+          coefficient * (i == j ? 4. : (i + j == 3 ? -1. : -1.5)) / 6.;
+      copy_data.cell_rhs(i) = coefficient * (1. + 0.01 * i);
+    }
+  copy_data.local_dof_indices = cell_dofs(cell);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int n_dofs  = n_nodes_1d * n_nodes_1d;
+  const unsigned int n_cells = n_cells_1d * n_cells_1d;
+
+  // boundary values on the left, and every other node on the right is tied
+  // to its two neighbors
+  AffineConstraints<double> constraints;
+  for (unsigned int j = 0; j < n_nodes_1d; ++j)
+    {
+      constraints.add_line(j * n_nodes_1d);
+      constraints.set_inhomogeneity(j * n_nodes_1d, 1. + 0.1 * j);
+    }
+  for (unsigned int j = 1; j < n_nodes_1d - 1; j += 2)
+    {
+      const types::global_dof_index row = j * n_nodes_1d + n_nodes_1d - 1;
+      constraints.add_line(row);
+      constraints.add_entry(row, row - n_nodes_1d, 0.5);
+      constraints.add_entry(row, row + n_nodes_1d, 0.5);
+    }
+  constraints.close();
+
+  DynamicSparsityPattern dsp(n_dofs, n_dofs);
+  for (unsigned int cell = 0; cell < n_cells; ++cell)
+    constraints.add_entries_local_to_global(cell_dofs(cell), dsp, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> reference_matrix(sparsity), matrix(sparsity);
+  Vector<double>       reference_rhs(n_dofs), rhs(n_dofs);
+
+  {
+    ScratchData scratch;
+    CopyData    copy_data;
+    for (unsigned int cell = 0; cell < n_cells; ++cell)
+      {
+        local_assemble(cell, scratch, copy_data);
+        constraints.distribute_local_to_global(copy_data.cell_matrix,
+                                               copy_data.cell_rhs,
+                                               copy_data.local_dof_indices,
+                                               reference_matrix,
+                                               reference_rhs,
+                                               true);
+      }
+  }
+
+  Threads::StripedMutex row_mutexes(64);
+  WorkStream::run_with_concurrent_copiers(
+    0u,
+    n_cells,
+    &local_assemble,
+    [&](const CopyData &copy_data) {
+      constraints.distribute_local_to_global(copy_data.cell_matrix,
+                                             copy_data.cell_rhs,
+                                             copy_data.local_dof_indices,
+                                             matrix,
+                                             rhs,
+                                             true,
+                                             row_mutexes);
+    },
+    ScratchData(),
+    CopyData());
+
+  deallog << "Matrix norm: " << reference_matrix.frobenius_norm()
+          << ", rhs norm: " << reference_rhs.l2_norm() << std::endl;
+
+  matrix.add(-1., reference_matrix);
+  rhs.add(-1., reference_rhs);
+  deallog << "Matrix difference: "
+          << (matrix.frobenius_norm() < 1e-12 * reference_matrix.frobenius_norm() ?
+                "ok" :
+                "too large")
+          << std::endl;
+  deallog << "Vector difference: "
+          << (rhs.l2_norm() < 1e-12 * reference_rhs.l2_norm() ? "ok" :
+                                                                "too large")
+          << std::endl;
+
+  // the same for the matrix only, with a single mutex for all rows
+  Threads::StripedMutex single_mutex(1);
+  matrix = 0;
+  WorkStream::run_with_concurrent_copiers(
+    0u,
+    n_cells,
+    &local_assemble,
+    [&](const CopyData &copy_data) {
+      constraints.distribute_local_to_global(copy_data.cell_matrix,
+                                             copy_data.local_dof_indices,
+                                             matrix,
+                                             single_mutex);
+    },
+    ScratchData(),
+    CopyData());
+  matrix.add(-1., reference_matrix);
+  deallog << "Matrix-only difference: "
+          << (matrix.frobenius_norm() < 1e-12 * reference_matrix.frobenius_norm() ?
+                "ok" :
+                "too large")
+          << std::endl;
+}
@@ -0,0 +1,96 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// invert matrices of different sizes with BatchedGaussJordan, with numbers of
+// matrices that do not fill the last batch and with matrices that need row
+// interchanges in the pivot search, and compare with FullMatrix::invert()
+
+#include <deal.II/lac/batched_gauss_jordan.h>
+#include <deal.II/lac/full_matrix.h>
+
+#include "../tests.h"
+
+
+template <typename Number>
+void
+test()
+{
+  const unsigned int sizes[]  = {1, 3, 5, 8};
+  const unsigned int n_blocks = 23;
+
+  std::vector<FullMatrix<Number>> matrices, inverses;
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      const unsigned int n = sizes[b % 4];
+      FullMatrix<Number> matrix(n, n);
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n; ++j)
+          matrix(i, j) = random_value<Number>();
+      // make every other matrix diagonally dominant, and give the others
+      // zero diagonal entries that need pivoting
+      for (unsigned int i = 0; i < n; ++i)
+        matrix(i, i) = (b % 2 == 0) ? Number(n) : Number(0.);
+      if (n == 1)
+        matrix(0, 0) = Number(2.);
+      matrices.push_back(matrix);
+      inverses.emplace_back(n, n);
+    }
+
+  BatchedGaussJordan<Number> batched_inverse;
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    batched_inverse.add(matrices[b], inverses[b]);
+  batched_inverse.flush();
+
+  double max_difference = 0., max_identity_error = 0.;
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      const unsigned int n = matrices[b].m();
+      FullMatrix<Number> reference(n, n);
+      reference.invert(matrices[b]);
+      reference.add(Number(-1.), inverses[b]);
+      max_difference = std::max<double>(max_difference,
+                                        reference.frobenius_norm() /
+                                          inverses[b].frobenius_norm());
+
+      FullMatrix<Number> product(n, n);
+      matrices[b].mmult(product, inverses[b]);
+      for (unsigned int i = 0; i < n; ++i)
+        product(i, i) -= Number(1.);
+      max_identity_error =
+        std::max<double>(max_identity_error, product.frobenius_norm());
+    }
+
+  const double tolerance = 100. * std::numeric_limits<Number>::epsilon();
+  deallog << "Difference to FullMatrix::invert(): "
+          << (max_difference < tolerance ? "ok" : "wrong")
+          << ", A * A^{-1} = I: "
+          << (max_identity_error < tolerance ? "ok" : "wrong") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("double");
+  test<double>();
+  deallog.pop();
+  deallog.push("float");
+  test<float>();
+  deallog.pop();
+}
@@ -0,0 +1,215 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check LinearAlgebra::distributed::FusedOperations: compare fused updates
+// and inner products, also composed from several kernels, with the
+// respective vector operations, check that the results do not depend on the
+// number of threads, and check SolverCG, which uses the fused operations for
+// LinearAlgebra::distributed::Vector, against the same solver on Vector
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_parallel_vector_fused_operations.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+namespace FusedOperations = LinearAlgebra::distributed::FusedOperations;
+
+
+
+void
+fill(VectorType &v, const unsigned int seed)
+{
+  for (unsigned int i = 0; i < v.locally_owned_size(); ++i)
+    v.local_element(i) = std::sin(1. + seed + 0.37 * i * (seed + 1));
+}
+
+
+
+void
+test_operations(const unsigned int size)
+{
+  deallog << "Size " << size << std::endl;
+
+  VectorType x(size), r(size), p(size), v(size);
+  fill(x, 0);
+  fill(r, 1);
+  fill(p, 2);
+  fill(v, 3);
+  const double alpha = 0.7;
+
+  VectorType x_ref(x), r_ref(r);
+  x_ref.add(alpha, p);
+  const double r_norm_square_ref = r_ref.add_and_dot(-alpha, v, r_ref);
+  const double p_dot_v_ref       = p * v;
+
+  // update x and r and compute (r,r) and (p,v) with two separate kernels
+  // that are composed into one sweep
+  double       *x_values = x.begin();
+  double       *r_values = r.begin();
+  const double *p_values = p.begin();
+  const double *v_values = v.begin();
+
+  const auto update_solution = [&](const unsigned int     begin,
+                                   const unsigned int     end,
+                                   std::array<double, 2> &sums) {
+    double p_dot_v = 0;
+    for (unsigned int i = begin; i < end; ++i)
+      {
+        x_values[i] += alpha * p_values[i];
+        p_dot_v += p_values[i] * v_values[i];
+      }
+    sums[1] += p_dot_v;
+  };
+  const auto update_residual = [&](const unsigned int     begin,
+                                   const unsigned int     end,
+                                   std::array<double, 2> &sums) {
+    double r_norm_square = 0;
+    for (unsigned int i = begin; i < end; ++i)
+      {
+        r_values[i] -= alpha * v_values[i];
+        r_norm_square += r_values[i] * r_values[i];
+      }
+    sums[0] += r_norm_square;
+  };
+
+  const std::array<double, 2> sums =
+    FusedOperations::run<2>(x, update_solution, update_residual);
+
+  x -= x_ref;
+  r -= r_ref;
+  deallog << "Error x: " << x.linfty_norm() << std::endl;
+  deallog << "Error r: " << r.linfty_norm() << std::endl;
+  deallog << "Error (r,r): "
+          << (std::abs(sums[0] - r_norm_square_ref) < 1e-12 * size ? "ok" :
+                                                                     "wrong")
+          << std::endl;
+  deallog << "Error (p,v): "
+          << (std::abs(sums[1] - p_dot_v_ref) < 1e-12 * size ? "ok" : "wrong")
+          << std::endl;
+
+  // a pure update without inner products
+  FusedOperations::run<0>(
+    x, [&](const unsigned int begin, const unsigned int end, auto &) {
+      for (unsigned int i = begin; i < end; ++i)
+        x_values[i] = 2. * p_values[i];
+    });
+  x.add(-2., p);
+  deallog << "Update without sums: " << x.linfty_norm() << std::endl;
+
+  // the sums must be identical with a single thread and with several threads
+  std::array<double, 1> thread_sums[2];
+  for (unsigned int single_thread = 0; single_thread < 2; ++single_thread)
+    {
+      MultithreadInfo::set_thread_limit(
+        single_thread == 1 ? 1 : testing_max_num_threads());
+      thread_sums[single_thread] = FusedOperations::run_local<1, double>(
+        size,
+        [&](const unsigned int     begin,
+            const unsigned int     end,
+            std::array<double, 1> &sums) {
+          for (unsigned int i = begin; i < end; ++i)
+            sums[0] += p_values[i] * v_values[i];
+        });
+    }
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  deallog << "Independent of threads: "
+          << (thread_sums[0][0] == thread_sums[1][0] ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+template <typename SolverVectorType>
+unsigned int
+solve(const SparseMatrix<double> &A, const bool flexible)
+{
+  SolverVectorType x(A.m()), b(A.m());
+  b = 1.;
+
+  DiagonalMatrix<SolverVectorType> preconditioner;
+  preconditioner.get_vector().reinit(x);
+  for (unsigned int i = 0; i < A.m(); ++i)
+    preconditioner.get_vector()(i) = 1. / A.diag_element(i);
+
+  SolverControl      control(1000, 1e-10);
+  const unsigned int previous_depth = deallog.depth_file(0);
+  if (flexible)
+    {
+      SolverFlexibleCG<SolverVectorType> solver(control);
+      solver.solve(A, x, b, preconditioner);
+    }
+  else
+    {
+      SolverCG<SolverVectorType> solver(control);
+      solver.solve(A, x, b, preconditioner);
+    }
+  deallog.depth_file(previous_depth);
+
+  SolverVectorType residual(A.m());
+  A.vmult(residual, x);
+  residual -= b;
+  deallog << "Residual: " << (residual.l2_norm() < 1e-9 ? "ok" : "too large")
+          << std::endl;
+  return control.last_step();
+}
+
+
+
+void
+test_solver()
+{
+  const unsigned int size = 100;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  for (unsigned int flexible = 0; flexible < 2; ++flexible)
+    {
+      const unsigned int steps_fused  = solve<VectorType>(A, flexible);
+      const unsigned int steps_vector = solve<Vector<double>>(A, flexible);
+      deallog << (flexible ? "SolverFlexibleCG" : "SolverCG")
+              << " same number of iterations: "
+              << (steps_fused == steps_vector ? "yes" : "no") << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_operations(1);
+  test_operations(1000);
+  test_operations(100000);
+
+  test_solver();
+}
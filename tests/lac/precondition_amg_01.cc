@@ -0,0 +1,110 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check PreconditionAMG on the five-point stencil of the Laplacian on
+// successively finer grids with both smoothers: the number of CG
+// iterations must stay bounded, and the preconditioner must be symmetric.
+// also check its use as coarse solver of a geometric multigrid
+
+#include <deal.II/lac/precondition_amg.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+
+void
+test(const unsigned int                                   size,
+     const PreconditionAMG::AdditionalData::SmootherType smoother_type)
+{
+  const unsigned int dim = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionAMG::AdditionalData data;
+  data.smoother_type   = smoother_type;
+  data.max_coarse_size = 50;
+
+  PreconditionAMG preconditioner;
+  preconditioner.initialize(A, data);
+
+  deallog << "Size " << dim << ", levels:";
+  for (unsigned int l = 0; l < preconditioner.n_levels(); ++l)
+    deallog << ' ' << preconditioner.get_matrix(l).m();
+  deallog << std::endl;
+
+  Vector<double> x(dim), y(dim), Px(dim), Py(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      x(i) = std::sin(0.3 * i);
+      y(i) = std::cos(0.7 * i);
+    }
+  preconditioner.vmult(Px, x);
+  preconditioner.vmult(Py, y);
+  deallog << "Symmetric: "
+          << (std::abs(Px * y - x * Py) < 1e-12 * Px.l2_norm() * y.l2_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  MGCoarseGridApplyOperator<Vector<double>, PreconditionAMG> coarse(
+    preconditioner);
+  Vector<double> coarse_result(dim);
+  coarse(0, coarse_result, x);
+  coarse_result -= Px;
+  deallog << "Coarse grid solver: " << coarse_result.l2_norm() << std::endl;
+
+  Vector<double> solution(dim), rhs(dim);
+  rhs = 1.;
+  SolverControl            control(100, 1e-8 * rhs.l2_norm());
+  SolverCG<Vector<double>> solver(control);
+  check_solver_within_range(solver.solve(A, solution, rhs, preconditioner),
+                            control.last_step(),
+                            3,
+                            20);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const auto smoother_type :
+       {PreconditionAMG::AdditionalData::SmootherType::chebyshev,
+        PreconditionAMG::AdditionalData::SmootherType::jacobi})
+    {
+      deallog.push(smoother_type ==
+                       PreconditionAMG::AdditionalData::SmootherType::chebyshev ?
+                     "chebyshev" :
+                     "jacobi");
+      for (const unsigned int size : {32, 64, 128})
+        test(size, smoother_type);
+      deallog.pop();
+    }
+}
@@ -0,0 +1,154 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// use preconditioners based on a copy of the system matrix in single
+// precision that shares the sparsity pattern of the double precision matrix,
+// and decompositions in single precision computed from the double precision
+// matrix, with vectors in double precision. check that the preconditioners
+// only differ by the rounding of the matrix entries and that CG needs the
+// same number of iterations as with the double precision preconditioners
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+template <typename PreconditionerDouble, typename PreconditionerFloat>
+void
+check(const std::string          &name,
+      const SparseMatrix<double> &A,
+      const PreconditionerDouble &preconditioner_double,
+      const PreconditionerFloat  &preconditioner_float)
+{
+  const unsigned int n = A.m();
+  Vector<double>     src(n), dst_double(n), dst_float(n);
+  for (unsigned int i = 0; i < n; ++i)
+    src(i) = std::cos(0.7 * i);
+
+  preconditioner_double.vmult(dst_double, src);
+  preconditioner_float.vmult(dst_float, src);
+  dst_float -= dst_double;
+  const double difference = dst_float.l2_norm() / dst_double.l2_norm();
+
+  Vector<double> rhs(n), solution_double(n), solution_float(n);
+  rhs = 1.;
+  SolverControl control_double(200, 1e-10), control_float(200, 1e-10);
+  SolverCG<>    solver_double(control_double), solver_float(control_float);
+  solver_double.solve(A, solution_double, rhs, preconditioner_double);
+  solver_float.solve(A, solution_float, rhs, preconditioner_float);
+  solution_float -= solution_double;
+
+  deallog << name << ": difference "
+          << (difference < 1e-6 ? "of the order of float rounding" : "large")
+          << ", CG iterations " << control_double.last_step() << " and "
+          << control_float.last_step() << ", same solution: "
+          << (solution_float.l2_norm() < 1e-8 * solution_double.l2_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  // the copy in single precision uses the same sparsity pattern
+  SparseMatrix<float> A_float(structure);
+  A_float.copy_from(A);
+  deallog << "Memory of the values: "
+          << (A_float.memory_consumption() < A.memory_consumption() ?
+                "less" :
+                "not less")
+          << std::endl;
+
+  {
+    PreconditionJacobi<SparseMatrix<double>> jacobi_double;
+    jacobi_double.initialize(A, 0.8);
+    PreconditionJacobi<SparseMatrix<float>> jacobi_float;
+    jacobi_float.initialize(A_float, 0.8);
+    check("Jacobi", A, jacobi_double, jacobi_float);
+  }
+
+  {
+    PreconditionSSOR<SparseMatrix<double>> ssor_double;
+    ssor_double.initialize(A, 1.2);
+    PreconditionSSOR<SparseMatrix<float>> ssor_float;
+    ssor_float.initialize(A_float, 1.2);
+    check("SSOR", A, ssor_double, ssor_float);
+  }
+
+  {
+    using ChebyshevDouble =
+      PreconditionChebyshev<SparseMatrix<double>, Vector<double>>;
+    using ChebyshevFloat =
+      PreconditionChebyshev<SparseMatrix<float>, Vector<double>>;
+    ChebyshevDouble::AdditionalData data_double;
+    data_double.degree              = 3;
+    data_double.smoothing_range     = 30.;
+    data_double.max_eigenvalue      = 8.;
+    data_double.eig_cg_n_iterations = 0;
+    ChebyshevFloat::AdditionalData data_float;
+    data_float.degree              = data_double.degree;
+    data_float.smoothing_range     = data_double.smoothing_range;
+    data_float.max_eigenvalue      = data_double.max_eigenvalue;
+    data_float.eig_cg_n_iterations = 0;
+
+    ChebyshevDouble chebyshev_double;
+    chebyshev_double.initialize(A, data_double);
+    ChebyshevFloat chebyshev_float;
+    chebyshev_float.initialize(A_float, data_float);
+    check("Chebyshev", A, chebyshev_double, chebyshev_float);
+  }
+
+  // decompositions in single precision computed directly from the double
+  // precision matrix, using its sparsity pattern
+  {
+    SparseILU<double> ilu_double;
+    ilu_double.initialize(A);
+    SparseILU<float> ilu_float;
+    ilu_float.initialize(A);
+    check("ILU", A, ilu_double, ilu_float);
+  }
+
+  {
+    SparseMIC<double> mic_double;
+    mic_double.initialize(A);
+    SparseMIC<float> mic_float;
+    mic_float.initialize(A);
+    check("MIC", A, mic_double, mic_float);
+  }
+}
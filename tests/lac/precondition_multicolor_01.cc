@@ -0,0 +1,140 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// test PreconditionMulticolorSOR and PreconditionMulticolorSSOR: the
+// five-point stencil gets a red-black coloring, the preconditioners agree
+// with the sequential ones on the matrix renumbered color by color, and
+// they can be used in iterative solvers
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  // the red-black numbering of the grid points, which has to agree with the
+  // coloring computed by the preconditioners
+  std::vector<types::global_dof_index> new_index(dim);
+  {
+    unsigned int next = 0;
+    for (unsigned int color = 0; color < 2; ++color)
+      for (unsigned int i = 0; i < dim; ++i)
+        if ((i % (size - 1) + i / (size - 1)) % 2 == color)
+          new_index[i] = next++;
+  }
+  SparsityPattern renumbered_structure(dim, dim, 5);
+  for (unsigned int i = 0; i < dim; ++i)
+    for (auto p = structure.begin(i); p != structure.end(i); ++p)
+      renumbered_structure.add(new_index[i], new_index[p->column()]);
+  renumbered_structure.compress();
+  SparseMatrix<double> B(renumbered_structure);
+  for (unsigned int i = 0; i < dim; ++i)
+    for (auto p = A.begin(i); p != A.end(i); ++p)
+      B.set(new_index[i], new_index[p->column()], p->value());
+
+  Vector<double> src(dim), dst(dim), dst_renumbered(dim), src_renumbered(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      src(i)                       = random_value<double>();
+      src_renumbered(new_index[i]) = src(i);
+    }
+
+  const auto compare = [&](const std::string &name) {
+    double error = 0;
+    for (unsigned int i = 0; i < dim; ++i)
+      error = std::max(error, std::abs(dst(i) - dst_renumbered(new_index[i])));
+    deallog << name << " difference to renumbered matrix: "
+            << (error < 1e-12 * dst.linfty_norm() ? "ok" : "too large")
+            << std::endl;
+  };
+
+  {
+    PreconditionMulticolorSOR<SparseMatrix<double>> sor;
+    sor.initialize(A, PreconditionMulticolorSOR<>::AdditionalData(1.2));
+    deallog << "Number of colors: " << sor.n_colors() << std::endl;
+
+    sor.vmult(dst, src);
+    B.precondition_SOR(dst_renumbered, src_renumbered, 1.2);
+    compare("SOR");
+
+    sor.Tvmult(dst, src);
+    B.precondition_TSOR(dst_renumbered, src_renumbered, 1.2);
+    compare("TSOR");
+
+    PreconditionMulticolorSSOR<SparseMatrix<double>> ssor;
+    ssor.initialize(A, PreconditionMulticolorSSOR<>::AdditionalData(1.2));
+    ssor.vmult(dst, src);
+    // a symmetric Gauss-Seidel step differs from precondition_SSOR by the
+    // relaxation factor
+    B.precondition_SSOR(dst_renumbered, src_renumbered, 1.2);
+    dst_renumbered *= 1.2;
+    compare("SSOR");
+  }
+
+  // solve with the preconditioners, both with one and with several
+  // relaxation steps per application
+  Vector<double> x(dim), b(dim);
+  b = 1.;
+  for (const unsigned int n_iterations : {1, 3})
+    {
+      SolverControl control(1000, 1e-10);
+
+      PreconditionMulticolorSSOR<SparseMatrix<double>> ssor;
+      ssor.initialize(A,
+                      PreconditionMulticolorSSOR<>::AdditionalData(
+                        1.2, n_iterations));
+      x = 0;
+      SolverCG<Vector<double>> cg(control);
+      cg.solve(A, x, b, ssor);
+      deallog << "CG with multicolor SSOR, " << n_iterations
+              << " sweeps: " << control.last_step() << " iterations"
+              << std::endl;
+
+      PreconditionMulticolorSOR<SparseMatrix<double>> sor;
+      sor.initialize(A,
+                     PreconditionMulticolorSOR<>::AdditionalData(1.2,
+                                                                 n_iterations));
+      x = 0;
+      SolverGMRES<Vector<double>> gmres(control);
+      gmres.solve(A, x, b, sor);
+      deallog << "GMRES with multicolor SOR, " << n_iterations
+              << " sweeps: " << control.last_step() << " iterations"
+              << std::endl;
+    }
+}
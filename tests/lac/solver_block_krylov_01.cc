@@ -0,0 +1,140 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparseMatrix::vmult_blockwise(), and that SolverBlockCG and
+// SolverBlockGMRES solve for several right hand sides at once, comparing
+// with the solutions of SolverCG and SolverGMRES for each right hand side
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_block_krylov.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename BlockVectorType>
+void
+fill_right_hand_sides(BlockVectorType &b)
+{
+  for (unsigned int j = 0; j < b.n_blocks(); ++j)
+    for (unsigned int i = 0; i < b.block(j).size(); ++i)
+      b.block(j)(i) = 1. + std::sin(0.1 * (j + 1) * i);
+}
+
+
+
+template <typename BlockVectorType,
+          typename SingleSolverType,
+          typename BlockSolverType,
+          typename PreconditionerType>
+void
+test(const std::string          &name,
+     const SparseMatrix<double> &A,
+     const PreconditionerType   &preconditioner,
+     const unsigned int          n_rhs)
+{
+  BlockVectorType b(n_rhs, A.m()), x(n_rhs, A.m());
+  fill_right_hand_sides(b);
+
+  SolverControl   control(1000, 1e-10);
+  BlockSolverType solver(control);
+  solver.solve(A, x, b, preconditioner);
+  deallog << name << " with " << n_rhs << " right hand sides converged in "
+          << (control.last_step() < 1000 ? "less" : "more")
+          << " than 1000 steps" << std::endl;
+
+  unsigned int max_single_steps = 0;
+  double       error            = 0;
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    {
+      typename BlockVectorType::BlockType x_single(A.m());
+      SolverControl                       control_single(1000, 1e-10);
+      SingleSolverType                    solver_single(control_single);
+      solver_single.solve(A, x_single, b.block(j), preconditioner);
+      max_single_steps = std::max(max_single_steps, control_single.last_step());
+      x_single -= x.block(j);
+      error = std::max(error, x_single.linfty_norm());
+    }
+  deallog << name << " iterations at most as for single solves: "
+          << (control.last_step() <= max_single_steps ? "yes" : "no")
+          << std::endl;
+  deallog << name << " difference to single solves: "
+          << (error < 1e-7 ? "ok" : "too large") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure), B(structure);
+  testproblem.five_point(A);
+  testproblem.five_point(B, true);
+
+  {
+    BlockVector<double> src(11, dim), dst(11, dim);
+    fill_right_hand_sides(src);
+    A.vmult_blockwise(dst, src);
+    double error = 0;
+    for (unsigned int j = 0; j < src.n_blocks(); ++j)
+      {
+        Vector<double> result(dim);
+        A.vmult(result, src.block(j));
+        result -= dst.block(j);
+        error = std::max(error, result.linfty_norm());
+      }
+    deallog << "vmult_blockwise difference to vmult: "
+            << (error < 1e-12 ? "ok" : "too large") << std::endl;
+  }
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+  PreconditionIdentity identity;
+
+  for (const unsigned int n_rhs : {1, 4})
+    {
+      test<BlockVector<double>,
+           SolverCG<Vector<double>>,
+           SolverBlockCG<BlockVector<double>>>("Block CG", A, ssor, n_rhs);
+      test<LinearAlgebra::distributed::BlockVector<double>,
+           SolverCG<LinearAlgebra::distributed::Vector<double>>,
+           SolverBlockCG<LinearAlgebra::distributed::BlockVector<double>>>(
+        "Block CG, distributed vector", A, identity, n_rhs);
+      test<BlockVector<double>,
+           SolverGMRES<Vector<double>>,
+           SolverBlockGMRES<BlockVector<double>>>("Block GMRES",
+                                                  B,
+                                                  identity,
+                                                  n_rhs);
+    }
+}
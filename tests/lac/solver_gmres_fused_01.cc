@@ -0,0 +1,108 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// check that SolverGMRES with the classical and the delayed classical
+// Gram-Schmidt orthogonalization gives the same result for Vector, whose
+// orthogonalization and solution update run through FusedOperations on
+// several chunks, and for BlockVector, which uses the generic vector
+// operations, and that the result for Vector does not depend on the number
+// of threads
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType>
+unsigned int
+solve(const SparseMatrix<double>                     &A,
+      const LinearAlgebra::OrthogonalizationStrategy strategy,
+      VectorType                                     &x)
+{
+  VectorType b;
+  b.reinit(x);
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = 1. + 0.01 * (i % 13);
+  x = 0.;
+
+  SolverControl control(1000, 1e-10 * b.l2_norm());
+  typename SolverGMRES<VectorType>::AdditionalData data;
+  data.max_basis_size             = 40;
+  data.orthogonalization_strategy = strategy;
+  SolverGMRES<VectorType> solver(control, data);
+  solver.solve(A, x, b, PreconditionIdentity());
+  return control.last_step();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // a matrix with 3969 rows, i.e., several chunks of FusedOperations
+  const unsigned int size = 64;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  for (const auto strategy :
+       {LinearAlgebra::OrthogonalizationStrategy::classical_gram_schmidt,
+        LinearAlgebra::OrthogonalizationStrategy::
+          delayed_classical_gram_schmidt})
+    {
+      deallog.push(
+        strategy ==
+            LinearAlgebra::OrthogonalizationStrategy::classical_gram_schmidt ?
+          "CGS" :
+          "DCGS");
+
+      Vector<double>     x(dim);
+      const unsigned int n_iterations = solve(A, strategy, x);
+
+      BlockVector<double> x_block(1, dim);
+      const unsigned int  n_iterations_block = solve(A, strategy, x_block);
+      x_block.block(0) -= x;
+      deallog << "Same as BlockVector: "
+              << (n_iterations == n_iterations_block &&
+                      x_block.linfty_norm() < 1e-8 * x.linfty_norm() ?
+                    "yes" :
+                    "no")
+              << std::endl;
+
+      MultithreadInfo::set_thread_limit(1);
+      Vector<double> x_serial(dim);
+      solve(A, strategy, x_serial);
+      MultithreadInfo::set_thread_limit(testing_max_num_threads());
+      x_serial -= x;
+      deallog << "Independent of threads: "
+              << (x_serial.linfty_norm() == 0. ? "yes" : "no") << std::endl;
+
+      deallog.pop();
+    }
+}
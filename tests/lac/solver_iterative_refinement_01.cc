@@ -0,0 +1,117 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// solve a system with SolverIterativeRefinement, using SolverCG in single
+// precision as inner solver, and check that the solution reaches an accuracy
+// beyond single precision. use inner solvers that converge and inner solvers
+// that stop after a fixed number of iterations
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_iterative_refinement.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+template <typename InnerControlType, typename InnerPreconditionerType>
+void
+test(const SparseMatrix<double>    &A,
+     const SparseMatrix<float>     &A_float,
+     InnerControlType              &inner_control,
+     const InnerPreconditionerType &inner_preconditioner)
+{
+  const unsigned int n = A.m();
+  Vector<double>     rhs(n), solution(n), reference(n);
+  for (unsigned int i = 0; i < n; ++i)
+    rhs(i) = 1. + std::sin(0.3 * i);
+
+  {
+    SolverControl     control(1000, 1e-13 * rhs.l2_norm());
+    SolverCG<>        solver(control);
+    SparseILU<double> ilu;
+    ilu.initialize(A);
+    solver.solve(A, reference, rhs, ilu);
+  }
+
+  SolverCG<Vector<float>> inner_solver(inner_control);
+
+  SolverControl control(100, 1e-12 * rhs.l2_norm());
+  SolverIterativeRefinement<Vector<double>> solver(control);
+  solver.solve(A, solution, rhs, inner_solver, A_float, inner_preconditioner);
+
+  Vector<double> residual(n);
+  A.residual(residual, solution, rhs);
+  solution -= reference;
+  deallog << "Residual reduced below tolerance: "
+          << (residual.l2_norm() < 1e-12 * rhs.l2_norm() ? "yes" : "no")
+          << ", error beyond single precision: "
+          << (solution.l2_norm() < 1e-9 * reference.l2_norm() ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+  SparseMatrix<float> A_float(structure);
+  A_float.copy_from(A);
+
+  {
+    deallog.push("ssor");
+    PreconditionSSOR<SparseMatrix<float>> ssor;
+    ssor.initialize(A_float, 1.2);
+    ReductionControl inner_control(1000, 0., 1e-3);
+    test(A, A_float, inner_control, ssor);
+    deallog.pop();
+  }
+
+  {
+    deallog.push("ilu");
+    SparseILU<float> ilu;
+    ilu.initialize(A);
+    ReductionControl inner_control(1000, 0., 1e-2);
+    test(A, A_float, inner_control, ilu);
+    deallog.pop();
+  }
+
+  {
+    deallog.push("fixed");
+    SparseILU<float> ilu;
+    ilu.initialize(A);
+    IterationNumberControl inner_control(5);
+    test(A, A_float, inner_control, ilu);
+    deallog.pop();
+  }
+}
@@ -0,0 +1,98 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that SolverPipelinedCG needs the same number of iterations as
+// SolverCG, up to one, and computes the same solution, both for the generic
+// vector operations with Vector<double> and for the fused operations with
+// LinearAlgebra::distributed::Vector<double>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipelined_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A,
+     const PreconditionerType   &preconditioner,
+     const std::string          &name)
+{
+  VectorType b(A.m()), x_cg(A.m()), x_pipelined(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    b(i) = 1. + 0.01 * (i % 13);
+
+  SolverControl        control_cg(1000, 1e-8 * b.l2_norm());
+  SolverCG<VectorType> cg(control_cg);
+  cg.solve(A, x_cg, b, preconditioner);
+
+  SolverControl                 control(1000, 1e-8 * b.l2_norm());
+  SolverPipelinedCG<VectorType> pipelined_cg(control);
+  check_solver_within_range(
+    pipelined_cg.solve(A, x_pipelined, b, preconditioner),
+    control.last_step(),
+    control_cg.last_step() - 1,
+    control_cg.last_step() + 1);
+
+  x_pipelined -= x_cg;
+  deallog << name << " difference to CG solution: "
+          << (x_pipelined.linfty_norm() < 1e-6 * x_cg.linfty_norm() ?
+                "ok" :
+                "too large")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionIdentity                   identity;
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+
+  DiagonalMatrix<LinearAlgebra::distributed::Vector<double>> jacobi;
+  jacobi.get_vector().reinit(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    jacobi.get_vector()(i) = 1. / A.diag_element(i);
+
+  test<Vector<double>>(A, identity, "Vector, identity");
+  test<Vector<double>>(A, ssor, "Vector, SSOR");
+  test<LinearAlgebra::distributed::Vector<double>>(
+    A, identity, "LinearAlgebra::distributed::Vector, identity");
+  test<LinearAlgebra::distributed::Vector<double>>(
+    A, jacobi, "LinearAlgebra::distributed::Vector, Jacobi");
+}
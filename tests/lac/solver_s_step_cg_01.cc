@@ -0,0 +1,115 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that SolverSStepCG computes the same solution as SolverCG with a
+// similar number of iterations, for several block sizes s with the
+// Chebyshev basis and with the monomial basis, for Vector and
+// LinearAlgebra::distributed::Vector. The problem is large enough for the
+// inner products to be split into several blocks
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_s_step_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename MatrixType, typename PreconditionerType>
+void
+test(const MatrixType         &A,
+     const PreconditionerType &preconditioner,
+     const std::string        &name)
+{
+  const unsigned int n = A.m();
+  VectorType         b, x_cg;
+  b.reinit(n);
+  x_cg.reinit(n);
+  for (unsigned int i = 0; i < n; ++i)
+    b(i) = 1. + 0.01 * (i % 13);
+
+  SolverControl        control_cg(1000, 1e-8 * b.l2_norm());
+  SolverCG<VectorType> cg(control_cg);
+  cg.solve(A, x_cg, b, preconditioner);
+
+  using AdditionalData = typename SolverSStepCG<VectorType>::AdditionalData;
+  for (const unsigned int s : {1, 2, 4, 8})
+    for (const auto basis : {AdditionalData::BasisType::chebyshev,
+                             AdditionalData::BasisType::monomial})
+      {
+        // the monomial basis is only stable for small s
+        if (basis == AdditionalData::BasisType::monomial && s > 4)
+          continue;
+
+        VectorType x;
+        x.reinit(n);
+        SolverControl             control(1000, 1e-8 * b.l2_norm());
+        SolverSStepCG<VectorType> solver(control, AdditionalData(s, basis));
+        solver.solve(A, x, b, preconditioner);
+
+        x -= x_cg;
+        deallog << name << ", s=" << s
+                << (basis == AdditionalData::BasisType::chebyshev ?
+                      " Chebyshev" :
+                      " monomial")
+                << ": iterations "
+                << (control.last_step() <= control_cg.last_step() + 2 * s ?
+                      "ok" :
+                      "too many")
+                << ", difference to CG solution: "
+                << (x.linfty_norm() < 1e-6 * x_cg.linfty_norm() ? "ok" :
+                                                                  "too large")
+                << std::endl;
+      }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 128;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionIdentity                   identity;
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+
+  DiagonalMatrix<LinearAlgebra::distributed::Vector<double>> jacobi;
+  jacobi.get_vector().reinit(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    jacobi.get_vector()(i) = 1. / A.diag_element(i);
+
+  test<Vector<double>>(A, identity, "Vector, identity");
+  test<Vector<double>>(A, ssor, "Vector, SSOR");
+  test<LinearAlgebra::distributed::Vector<double>>(
+    A, jacobi, "LinearAlgebra::distributed::Vector, Jacobi");
+}
@@ -0,0 +1,225 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparseDirectCholesky on the five-point stencil of the Laplacian with
+// both orderings, the reuse of the symbolic analysis, the independence of
+// the result of the number of threads, a tridiagonal matrix whose
+// elimination tree is a chain, no reuse of the analysis for a different
+// sparsity pattern with the same number of entries, and the detection of a
+// matrix that is not positive definite
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_direct_cholesky.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+
+double
+residual(const SparseMatrix<double> &A,
+         const Vector<double>       &x,
+         const Vector<double>       &b)
+{
+  Vector<double> r(b.size());
+  A.residual(r, x, b);
+  return r.l2_norm() / b.l2_norm();
+}
+
+
+
+void
+test_laplace(const unsigned int size)
+{
+  const unsigned int dim = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  Vector<double> b(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    b(i) = std::sin(0.3 * i) + 1.;
+
+  deallog << "Size " << dim << std::endl;
+
+  Vector<double> x_nested_dissection(dim);
+  std::size_t    n_nonzero_nested_dissection = 0;
+  for (const auto ordering :
+       {SparseDirectCholesky::AdditionalData::Ordering::nested_dissection,
+        SparseDirectCholesky::AdditionalData::Ordering::identity})
+    {
+      SparseDirectCholesky solver;
+      solver.initialize(A, ordering);
+      Vector<double> x(dim);
+      solver.vmult(x, b);
+      deallog << (ordering == SparseDirectCholesky::AdditionalData::Ordering::
+                                nested_dissection ?
+                    "Nested dissection" :
+                    "Identity")
+              << " residual: "
+              << (residual(A, x, b) < 1e-10 ? "ok" : "too large")
+              << std::endl;
+      if (ordering ==
+          SparseDirectCholesky::AdditionalData::Ordering::nested_dissection)
+        {
+          x_nested_dissection         = x;
+          n_nonzero_nested_dissection = solver.n_nonzero_elements();
+        }
+      else
+        {
+          x -= x_nested_dissection;
+          deallog << "Same solution: "
+                  << (x.linfty_norm() <
+                          1e-10 * x_nested_dissection.linfty_norm() ?
+                        "yes" :
+                        "no")
+                  << std::endl;
+          deallog << "Less fill-in with nested dissection: "
+                  << (n_nonzero_nested_dissection <
+                          solver.n_nonzero_elements() ?
+                        "yes" :
+                        "no")
+                  << std::endl;
+        }
+    }
+
+  // factorize a scaled matrix with the same sparsity pattern, reusing the
+  // analysis
+  SparseDirectCholesky solver;
+  solver.initialize(A);
+  const unsigned int n_supernodes = solver.n_supernodes();
+  A *= 2.;
+  Vector<double> x(b);
+  solver.solve(A, x);
+  x.sadd(2., -1., x_nested_dissection);
+  deallog << "Reuse analysis: "
+          << (x.linfty_norm() < 1e-10 * x_nested_dissection.linfty_norm() &&
+                  solver.n_supernodes() == n_supernodes ?
+                "ok" :
+                "wrong")
+          << std::endl;
+
+  // the factorization must not depend on the number of threads
+  Vector<double> x_serial(b);
+  MultithreadInfo::set_thread_limit(1);
+  solver.factorize(A);
+  solver.solve(x_serial);
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  solver.factorize(A);
+  x = b;
+  solver.solve(x);
+  x -= x_serial;
+  deallog << "Independent of threads: " << (x.linfty_norm() == 0 ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+void
+test_tridiagonal(const unsigned int size)
+{
+  DynamicSparsityPattern dsp(size, size);
+  for (unsigned int i = 0; i < size; ++i)
+    for (unsigned int j = (i > 0 ? i - 1 : 0); j < std::min(i + 2, size); ++j)
+      dsp.add(i, j);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int i = 0; i < size; ++i)
+    for (unsigned int j = (i > 0 ? i - 1 : 0); j < std::min(i + 2, size); ++j)
+      A.set(i, j, i == j ? 2. : -1.);
+
+  Vector<double> b(size);
+  for (unsigned int i = 0; i < size; ++i)
+    b(i) = std::cos(0.1 * i);
+
+  deallog << "Tridiagonal size " << size << std::endl;
+  for (const auto ordering :
+       {SparseDirectCholesky::AdditionalData::Ordering::nested_dissection,
+        SparseDirectCholesky::AdditionalData::Ordering::identity})
+    {
+      SparseDirectCholesky solver;
+      solver.initialize(A, ordering);
+      Vector<double> x(size);
+      solver.vmult(x, b);
+      deallog << "Residual: "
+              << (residual(A, x, b) < 1e-10 ? "ok" : "too large")
+              << ", entries of factor: " << solver.n_nonzero_elements()
+              << std::endl;
+    }
+
+  // a matrix of the same size and number of entries, but with the coupling
+  // of the last two rows moved to the first and the last row, must not reuse
+  // the analysis of the tridiagonal matrix
+  {
+    DynamicSparsityPattern dsp_moved(size, size);
+    for (auto p = sparsity.begin(); p != sparsity.end(); ++p)
+      if (std::min(p->row(), p->column()) != size - 2 ||
+          std::max(p->row(), p->column()) != size - 1)
+        dsp_moved.add(p->row(), p->column());
+    dsp_moved.add(0, size - 1);
+    dsp_moved.add(size - 1, 0);
+    SparsityPattern sparsity_moved;
+    sparsity_moved.copy_from(dsp_moved);
+    SparseMatrix<double> A_moved(sparsity_moved);
+    for (auto p = sparsity_moved.begin(); p != sparsity_moved.end(); ++p)
+      A_moved.set(p->row(), p->column(), p->row() == p->column() ? 3. : -1.);
+
+    SparseDirectCholesky solver;
+    solver.initialize(A);
+    solver.factorize(A_moved);
+    Vector<double> x(b);
+    solver.solve(x);
+    deallog << "Different pattern with the same number of entries: "
+            << (residual(A_moved, x, b) < 1e-10 ? "ok" : "too large")
+            << std::endl;
+  }
+
+  // flip the sign of one diagonal entry
+  A.set(size / 2, size / 2, -2.);
+  SparseDirectCholesky solver;
+  try
+    {
+      solver.initialize(A);
+    }
+  catch (const SparseDirectCholesky::ExcNotPositiveDefinite &e)
+    {
+      deallog << "Exception: " << e.get_exc_name() << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_laplace(16);
+  test_laplace(64);
+  test_laplace(256);
+
+  test_tridiagonal(10);
+  test_tridiagonal(100000);
+}
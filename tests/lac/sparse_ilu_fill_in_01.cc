@@ -0,0 +1,139 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// test the ILU(k) and ILUT variants of SparseILU: with enough fill-in, they
+// generate the exact inverse, and with less fill-in, they need fewer GMRES
+// iterations than ILU(0) for a nonsymmetric matrix
+
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+
+void
+check_inverse(const SparseMatrix<double>              &A,
+              const SparseILU<double>::AdditionalData &data)
+{
+  SparseILU<double> ilu;
+  ilu.initialize(A, data);
+
+  Vector<double> v(A.m()), tmp1(A.m()), tmp2(A.m());
+  for (unsigned int j = 0; j < v.size(); ++j)
+    v(j) = random_value<double>();
+
+  A.vmult(tmp1, v);
+  ilu.vmult(tmp2, tmp1);
+  tmp2 -= v;
+  deallog << "Relative residual of exact decomposition: "
+          << (tmp2.l2_norm() / v.l2_norm() < 1e-12 ? "ok" : "too large")
+          << std::endl;
+}
+
+
+
+void
+solve(const SparseMatrix<double>              &A,
+      const SparseILU<double>::AdditionalData &data,
+      SparseILU<double>                       &ilu)
+{
+  ilu.initialize(A, data);
+
+  Vector<double> x(A.m()), b(A.m());
+  for (unsigned int j = 0; j < b.size(); ++j)
+    b(j) = 1. + j % 3;
+
+  SolverControl               control(500, 1e-10 * b.l2_norm());
+  SolverGMRES<Vector<double>> solver(control);
+  solver.solve(A, x, b, ilu);
+  deallog << "GMRES iterations: " << control.last_step() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(2);
+
+  using FillIn = SparseILU<double>::AdditionalData::FillIn;
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  // with a level of fill larger than the bandwidth, ILU(k) is the exact
+  // LU decomposition, and so is ILUT with a zero drop tolerance
+  {
+    SparseILU<double>::AdditionalData data;
+    data.fill_in       = FillIn::level;
+    data.fill_in_level = dim;
+    deallog.push("ILU(k)");
+    check_inverse(A, data);
+    deallog.pop();
+
+    data.fill_in        = FillIn::threshold;
+    data.drop_tolerance = 0.;
+    deallog.push("ILUT");
+    check_inverse(A, data);
+    deallog.pop();
+  }
+
+  // solve with a varying amount of fill-in
+  for (unsigned int level = 0; level < 4; ++level)
+    {
+      SparseILU<double>::AdditionalData data;
+      data.fill_in       = FillIn::level;
+      data.fill_in_level = level;
+      deallog.push("ILU(" + std::to_string(level) + ")");
+      SparseILU<double> ilu;
+      solve(A, data, ilu);
+
+      // recompute the decomposition with the previous sparsity pattern
+      data.use_previous_sparsity = true;
+      solve(A, data, ilu);
+      deallog.pop();
+    }
+
+  for (const double tolerance : {1e-1, 1e-2, 1e-3})
+    {
+      SparseILU<double>::AdditionalData data;
+      data.fill_in        = FillIn::threshold;
+      data.drop_tolerance = tolerance;
+      deallog.push("ILUT");
+      deallog << "Drop tolerance " << tolerance << std::endl;
+      SparseILU<double> ilu;
+      solve(A, data, ilu);
+
+      // limit the fill-in
+      data.max_fill_in_per_row = 1;
+      solve(A, data, ilu);
+      deallog.pop();
+    }
+}
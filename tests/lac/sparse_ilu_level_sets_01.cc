@@ -0,0 +1,84 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that SparseILU and SparseMIC give the same results when the forward
+// and backward substitutions are run level by level in parallel as in the
+// sequential case, both with the pattern of the matrix and with additional
+// fill-in
+
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+
+template <typename Preconditioner>
+void
+test(const SparseMatrix<double> &A, const unsigned int extra_off_diagonals)
+{
+  Vector<double> src(A.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  Vector<double> result[2];
+  for (unsigned int use_level_sets = 0; use_level_sets < 2; ++use_level_sets)
+    {
+      const typename Preconditioner::AdditionalData data(
+        0., extra_off_diagonals, false, nullptr, use_level_sets == 1);
+      Preconditioner prec;
+      prec.initialize(A, data);
+      result[use_level_sets].reinit(A.m());
+      prec.vmult(result[use_level_sets], src);
+    }
+
+  deallog << "Extra off-diagonals " << extra_off_diagonals << ": "
+          << (result[0] == result[1] ? "identical" : "differ") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int size = 4; size <= 64; size *= 4)
+    {
+      const unsigned int dim = (size - 1) * (size - 1);
+      deallog << "Size " << size << " Unknowns " << dim << std::endl;
+
+      FDMatrix        testproblem(size, size);
+      SparsityPattern structure(dim, dim, 5);
+      testproblem.five_point_structure(structure);
+      structure.compress();
+      SparseMatrix<double> A(structure);
+      testproblem.five_point(A);
+
+      deallog.push("ILU");
+      for (unsigned int extra = 0; extra < 3; ++extra)
+        test<SparseILU<double>>(A, extra);
+      deallog.pop();
+
+      deallog.push("MIC");
+      test<SparseMIC<double>>(A, 0);
+      deallog.pop();
+    }
+}
@@ -0,0 +1,138 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparseMatrix::Tvmult and SparseMatrix::Tvmult_add with several
+// threads, which use the column-wise index map of the sparsity pattern,
+// against the sequential versions, and check that the map is discarded when
+// the sparsity pattern changes
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+fill_matrix(SparsityPattern      &sparsity,
+            SparseMatrix<double> &matrix,
+            const unsigned int    m,
+            const unsigned int    n,
+            const unsigned int    stride)
+{
+  DynamicSparsityPattern dsp(m, n);
+  for (unsigned int i = 0; i < m; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      if ((i * stride + j) % 11 == 0 || (i * n) / m == j)
+        dsp.add(i, j);
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+  for (auto &entry : matrix)
+    entry.value() = std::sin(1. + entry.row() + 0.3 * entry.column());
+}
+
+
+
+void
+test(const SparsityPattern &sparsity, const SparseMatrix<double> &matrix)
+{
+  Vector<double> src(matrix.m()), dst(matrix.n()), dst_add(matrix.n());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = std::cos(0.7 * i);
+
+  // the sequential versions
+  MultithreadInfo::set_thread_limit(1);
+  Vector<double> reference(matrix.n()), reference_add(matrix.n());
+  matrix.Tvmult(reference, src);
+  reference_add = 1.;
+  matrix.Tvmult_add(reference_add, src);
+  deallog << "Index map after sequential Tvmult: "
+          << (sparsity.has_column_index_map() ? "yes" : "no") << std::endl;
+
+  // the index map is not built implicitly on more threads either
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  matrix.Tvmult(dst, src);
+  deallog << "Index map after Tvmult on several threads: "
+          << (sparsity.has_column_index_map() ? "yes" : "no") << std::endl;
+
+  sparsity.store_column_index_map();
+  matrix.Tvmult(dst, src);
+  dst_add = 1.;
+  matrix.Tvmult_add(dst_add, src);
+  dst -= reference;
+  dst_add -= reference_add;
+  deallog << "Index map after parallel Tvmult: "
+          << (sparsity.has_column_index_map() ? "yes" : "no")
+          << ", same result: "
+          << (dst.linfty_norm() == 0 && dst_add.linfty_norm() == 0 ? "yes" :
+                                                                     "no")
+          << std::endl;
+
+  // compare with vmult on an explicitly transposed matrix
+  DynamicSparsityPattern dsp(matrix.n(), matrix.m());
+  for (const auto &entry : sparsity)
+    dsp.add(entry.column(), entry.row());
+  SparsityPattern transpose_sparsity;
+  transpose_sparsity.copy_from(dsp);
+  SparseMatrix<double> transpose(transpose_sparsity);
+  for (const auto &entry : matrix)
+    transpose.set(entry.column(), entry.row(), entry.value());
+  transpose.vmult(dst, src);
+  dst -= reference;
+  deallog << "Same as vmult with the transpose: "
+          << (dst.linfty_norm() < 1e-13 * reference.linfty_norm() ? "yes" :
+                                                                    "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  SparsityPattern      sparsity;
+  SparseMatrix<double> matrix;
+
+  fill_matrix(sparsity, matrix, 100, 100, 3);
+  deallog << "Size " << matrix.m() << 'x' << matrix.n() << std::endl;
+  test(sparsity, matrix);
+
+  // changing the structure discards the index map, which then needs to be
+  // built again for the new structure
+  fill_matrix(sparsity, matrix, 231, 157, 7);
+  deallog << "Size " << matrix.m() << 'x' << matrix.n()
+          << ", index map after reinit: "
+          << (sparsity.has_column_index_map() ? "yes" : "no") << std::endl;
+  test(sparsity, matrix);
+
+  fill_matrix(sparsity, matrix, 64, 1000, 5);
+  deallog << "Size " << matrix.m() << 'x' << matrix.n() << std::endl;
+  test(sparsity, matrix);
+
+  // release the index map again
+  const std::size_t memory = sparsity.memory_consumption();
+  sparsity.clear_column_index_map();
+  deallog << "Index map after clear: "
+          << (sparsity.has_column_index_map() ? "yes" : "no")
+          << ", memory released: "
+          << (sparsity.memory_consumption() < memory ? "yes" : "no")
+          << std::endl;
+}
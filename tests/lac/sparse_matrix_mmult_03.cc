@@ -0,0 +1,204 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparseMatrix::mmult, SparseMatrix::Tmmult, and SparseMatrix::PtAP
+// for square and rectangular matrices with and without the vector argument
+// against products of full matrices, and compare the sparsity patterns built
+// by these functions with the ones computed by DynamicSparsityPattern
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+fill_matrix(SparsityPattern      &sparsity,
+            SparseMatrix<double> &matrix,
+            const unsigned int    m,
+            const unsigned int    n,
+            const unsigned int    seed)
+{
+  DynamicSparsityPattern dsp(m, n);
+  for (unsigned int i = 0; i < m; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      if ((i * 7 + j * 3 + seed) % 23 == 0 || (i * n) / m == j)
+        dsp.add(i, j);
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+  for (auto &entry : matrix)
+    entry.value() = std::sin(1. + seed + entry.row() + 0.3 * entry.column());
+}
+
+
+
+bool
+same_pattern(const SparsityPattern &sparsity, DynamicSparsityPattern &dsp)
+{
+  if (sparsity.n_rows() == sparsity.n_cols())
+    for (unsigned int i = 0; i < sparsity.n_rows(); ++i)
+      dsp.add(i, i);
+  SparsityPattern reference;
+  reference.copy_from(dsp);
+
+  if (reference.n_nonzero_elements() != sparsity.n_nonzero_elements())
+    return false;
+  for (auto it = sparsity.begin(), it_ref = reference.begin();
+       it != sparsity.end();
+       ++it, ++it_ref)
+    if (it->row() != it_ref->row() || it->column() != it_ref->column())
+      return false;
+  return true;
+}
+
+
+
+double
+error(const SparseMatrix<double> &C, const FullMatrix<double> &reference)
+{
+  FullMatrix<double> difference(C.m(), C.n());
+  difference.copy_from(C);
+  difference.add(-1., reference);
+  return difference.frobenius_norm() / reference.frobenius_norm();
+}
+
+
+
+void
+test(const unsigned int m, const unsigned int n, const unsigned int k)
+{
+  deallog << "A: " << m << 'x' << n << ", B: " << n << 'x' << k << std::endl;
+
+  SparsityPattern      sparsity_A, sparsity_B, sparsity_BT;
+  SparseMatrix<double> A, B, BT;
+  fill_matrix(sparsity_A, A, m, n, 1);
+  fill_matrix(sparsity_B, B, n, k, 2);
+  fill_matrix(sparsity_BT, BT, m, k, 3);
+
+  FullMatrix<double> full_A(m, n), full_B(n, k), full_BT(m, k);
+  full_A.copy_from(A);
+  full_B.copy_from(B);
+  full_BT.copy_from(BT);
+
+  Vector<double> V_mmult(n), V_Tmmult(m);
+  for (unsigned int i = 0; i < n; ++i)
+    V_mmult(i) = 1. + 0.1 * i;
+  for (unsigned int i = 0; i < m; ++i)
+    V_Tmmult(i) = 2. - 0.05 * i;
+
+  // C = A * B and C = A * diag(V) * B
+  {
+    SparsityPattern      sparsity_C;
+    SparseMatrix<double> C(sparsity_C);
+    A.mmult(C, B);
+    FullMatrix<double> reference(m, k);
+    full_A.mmult(reference, full_B);
+    DynamicSparsityPattern dsp;
+    dsp.compute_mmult_pattern(sparsity_A, sparsity_B);
+    deallog << "mmult: error " << (error(C, reference) < 1e-14 ? "ok" : "wrong")
+            << ", same pattern: "
+            << (same_pattern(sparsity_C, dsp) ? "yes" : "no") << std::endl;
+
+    // with the vector argument and without rebuilding the sparsity pattern,
+    // which adds to the previous content
+    A.mmult(C, B, V_mmult, false);
+    FullMatrix<double> scaled_B(full_B);
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < k; ++j)
+        scaled_B(i, j) *= V_mmult(i);
+    full_A.mmult(reference, scaled_B, true);
+    deallog << "mmult with vector: error "
+            << (error(C, reference) < 1e-14 ? "ok" : "wrong") << std::endl;
+  }
+
+  // C = A^T * B and C = A^T * diag(V) * B
+  {
+    SparsityPattern      sparsity_C;
+    SparseMatrix<double> C(sparsity_C);
+    A.Tmmult(C, BT);
+    FullMatrix<double> reference(n, k);
+    full_A.Tmmult(reference, full_BT);
+    DynamicSparsityPattern dsp;
+    dsp.compute_Tmmult_pattern(sparsity_A, sparsity_BT);
+    deallog << "Tmmult: error "
+            << (error(C, reference) < 1e-14 ? "ok" : "wrong")
+            << ", same pattern: "
+            << (same_pattern(sparsity_C, dsp) ? "yes" : "no") << std::endl;
+
+    A.Tmmult(C, BT, V_Tmmult);
+    FullMatrix<double> scaled_BT(full_BT);
+    for (unsigned int i = 0; i < m; ++i)
+      for (unsigned int j = 0; j < k; ++j)
+        scaled_BT(i, j) *= V_Tmmult(i);
+    full_A.Tmmult(reference, scaled_BT);
+    deallog << "Tmmult with vector: error "
+            << (error(C, reference) < 1e-14 ? "ok" : "wrong") << std::endl;
+  }
+
+  // C = P^T * S * P for the square matrix S = B^T * B + I
+  {
+    SparsityPattern      sparsity_S;
+    SparseMatrix<double> S(sparsity_S);
+    BT.Tmmult(S, BT);
+    for (unsigned int i = 0; i < S.m(); ++i)
+      S.diag_element(i) += 1.;
+    FullMatrix<double> full_S(k, k);
+    full_S.copy_from(S);
+
+    SparsityPattern      sparsity_Q;
+    SparseMatrix<double> Q;
+    fill_matrix(sparsity_Q, Q, k, n, 4);
+    FullMatrix<double> full_Q(k, n);
+    full_Q.copy_from(Q);
+
+    SparsityPattern      sparsity_C;
+    SparseMatrix<double> C(sparsity_C);
+    S.PtAP(C, Q);
+    FullMatrix<double> reference(n, n);
+    reference.triple_product(full_S, full_Q, full_Q, true, false);
+    deallog << "PtAP: error " << (error(C, reference) < 1e-14 ? "ok" : "wrong")
+            << ", size " << C.m() << 'x' << C.n() << ", entries "
+            << C.n_nonzero_elements() << std::endl;
+
+    // the product is the same as the one of Tmmult and mmult
+    SparsityPattern      sparsity_SP, sparsity_D;
+    SparseMatrix<double> SP(sparsity_SP), D(sparsity_D);
+    S.mmult(SP, Q);
+    Q.Tmmult(D, SP);
+    deallog << "Same as Tmmult(mmult): "
+            << (error(C, reference) == error(D, reference) &&
+                    sparsity_C.n_nonzero_elements() ==
+                      sparsity_D.n_nonzero_elements() ?
+                  "yes" :
+                  "no")
+            << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(12, 12, 12);
+  test(10, 17, 6);
+  test(23, 8, 31);
+  test(200, 150, 250);
+}
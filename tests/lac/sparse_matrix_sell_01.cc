@@ -0,0 +1,185 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that SparseMatrixSELL computes the same matrix-vector products and
+// relaxation operations as the SparseMatrix it was built from, for a
+// pattern with rows of varying length
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename number>
+void
+check(const std::string    &name,
+      const Vector<number> &reference,
+      Vector<number>       &result)
+{
+  result -= reference;
+  const number tolerance =
+    100 * std::numeric_limits<number>::epsilon() * reference.l2_norm();
+  deallog << name << ": " << (result.l2_norm() <= tolerance ? "ok" : "failed")
+          << std::endl;
+}
+
+
+
+template <typename number>
+void
+test(const unsigned int size, const unsigned int sorting_scope)
+{
+  const unsigned int dim = (size - 1) * (size - 1);
+
+  deallog << "Size " << size << " Unknowns " << dim << " Sorting scope "
+          << sorting_scope << std::endl;
+
+  // nine point stencil plus some entries in a few rows to get rows of very
+  // different length
+  FDMatrix               testproblem(size, size);
+  DynamicSparsityPattern dsp(dim, dim);
+  testproblem.nine_point_structure(dsp);
+  for (unsigned int i = 0; i < dim; i += 7)
+    for (unsigned int j = 0; j < dim; j += 3)
+      dsp.add(i, j);
+  SparsityPattern structure;
+  structure.copy_from(dsp);
+
+  SparseMatrix<number> A(structure);
+  testproblem.nine_point(A, true);
+  for (unsigned int i = 0; i < dim; i += 7)
+    for (unsigned int j = 0; j < dim; j += 3)
+      if (i != j)
+        A.add(i, j, -0.01 * (1. + random_value<double>()));
+
+  SparseMatrixSELL<number> B;
+  B.reinit(A,
+           typename SparseMatrixSELL<number>::AdditionalData(sorting_scope));
+
+  deallog << "Nonzero elements: " << B.n_nonzero_elements() << std::endl;
+
+  Vector<number> src(dim), dst1(dim), dst2(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    src(i) = random_value<number>();
+
+  A.vmult(dst1, src);
+  B.vmult(dst2, src);
+  check("vmult", dst1, dst2);
+
+  A.vmult_add(dst1, src);
+  B.vmult(dst2, src);
+  B.vmult_add(dst2, src);
+  check("vmult_add", dst1, dst2);
+
+  A.Tvmult(dst1, src);
+  B.Tvmult(dst2, src);
+  check("Tvmult", dst1, dst2);
+
+  A.Tvmult_add(dst1, src);
+  B.Tvmult(dst2, src);
+  B.Tvmult_add(dst2, src);
+  check("Tvmult_add", dst1, dst2);
+
+  Vector<number> rhs(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    rhs(i) = random_value<number>();
+  const number norm1 = A.residual(dst1, src, rhs);
+  const number norm2 = B.residual(dst2, src, rhs);
+  check("residual", dst1, dst2);
+  deallog << "residual norm: "
+          << (std::abs(norm1 - norm2) <=
+                  100 * std::numeric_limits<number>::epsilon() * norm1 ?
+                "ok" :
+                "failed")
+          << std::endl;
+
+  A.precondition_Jacobi(dst1, src, 0.8);
+  B.precondition_Jacobi(dst2, src, 0.8);
+  check("Jacobi", dst1, dst2);
+
+  PreconditionSSOR<SparseMatrix<number>> ssor_A;
+  ssor_A.initialize(A, 1.2);
+  PreconditionSSOR<SparseMatrixSELL<number>> ssor_B;
+  ssor_B.initialize(B, 1.2);
+  ssor_A.vmult(dst1, src);
+  ssor_B.vmult(dst2, src);
+  check("SSOR", dst1, dst2);
+}
+
+
+
+
+// use the matrix as a drop-in replacement for SparseMatrix in a
+// preconditioned CG solver
+void
+solve(const unsigned int size)
+{
+  const unsigned int dim = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  SparseMatrixSELL<double> B(structure);
+  B.copy_from(A);
+
+  Vector<double> f(dim), u(dim);
+  f = 1.;
+
+  SolverControl            control(1000, 1e-10);
+  SolverCG<Vector<double>> solver(control);
+
+  PreconditionSSOR<SparseMatrix<double>> ssor_A;
+  ssor_A.initialize(A, 1.2);
+  solver.solve(A, u, f, ssor_A);
+  const unsigned int steps_csr = control.last_step();
+
+  u = 0.;
+  PreconditionSSOR<SparseMatrixSELL<double>> ssor_B;
+  ssor_B.initialize(B, 1.2);
+  solver.solve(B, u, f, ssor_B);
+  deallog << "Same number of CG iterations: "
+          << (control.last_step() == steps_csr ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<double>(5, 1);
+  test<double>(17, 1);
+  test<double>(17, 16);
+  test<double>(33, 256);
+  test<double>(65, 32);
+  test<float>(17, 1);
+  test<float>(33, 64);
+
+  solve(33);
+}
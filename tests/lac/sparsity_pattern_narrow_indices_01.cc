@@ -0,0 +1,196 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that SparseMatrix and SparseILU compute the same results after
+// SparsityPattern::store_narrow_column_indices() has been called, for a
+// pattern in which some rows span too many columns to be stored in narrow
+// form, and that the entries can still be accessed through iterators, entry
+// lookup, output, and block_write()/block_read()
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+void
+compare(const std::string &name, const Vector<double> &a, Vector<double> &b)
+{
+  b -= a;
+  deallog << name << ": " << (b.linfty_norm() == 0. ? "identical" : "differ")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // a banded matrix with a few entries far away from the diagonal, so that
+  // the column span of the corresponding rows is larger than what the
+  // narrow index type can represent
+  const unsigned int n = 3 * std::numeric_limits<std::uint16_t>::max();
+  const unsigned int far_rows[] = {5, 1000, n / 2};
+
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = (i < 2 ? 0 : i - 2); j < std::min(i + 3, n); ++j)
+      dsp.add(i, j);
+  for (const unsigned int i : far_rows)
+    {
+      dsp.add(i, n - 1 - i);
+      dsp.add(n - 1 - i, i);
+    }
+
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int i = 0; i < n; ++i)
+    for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+      entry->value() =
+        (entry->column() == i ? 10. : -1. + 0.5 * random_value<double>());
+
+  Vector<double> src(n);
+  for (unsigned int i = 0; i < n; ++i)
+    src(i) = random_value<double>();
+
+  std::vector<std::size_t> pos_right_of_diagonal;
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      auto entry = A.begin(i);
+      while (entry != A.end(i) && entry->column() <= i)
+        ++entry;
+      pos_right_of_diagonal.push_back(entry - A.begin(0));
+    }
+
+  // compute all results with the full column indices and with the narrow
+  // ones. the operations are done in the same order in both cases, so the
+  // results need to be identical
+  std::vector<Vector<double>> results[2];
+  std::string                 printed[2];
+  double                      product_norm[2];
+  std::size_t                 product_entries[2];
+  std::size_t                 memory[2];
+  for (unsigned int narrow = 0; narrow < 2; ++narrow)
+    {
+      if (narrow == 1)
+        {
+          sparsity.store_narrow_column_indices();
+          deallog << "Narrow column indices: "
+                  << sparsity.has_narrow_column_indices() << std::endl;
+        }
+      memory[narrow] = sparsity.memory_consumption();
+
+      Vector<double> tmp(n), tmp2(n);
+
+      A.vmult(tmp, src);
+      results[narrow].push_back(tmp);
+
+      tmp2 = tmp;
+      A.vmult_add(tmp2, src);
+      results[narrow].push_back(tmp2);
+
+      const double residual = A.residual(tmp2, src, tmp);
+      tmp2.add(residual);
+      results[narrow].push_back(tmp2);
+
+      tmp = src;
+      A.SOR(tmp, 1.2);
+      results[narrow].push_back(tmp);
+
+      tmp = src;
+      A.TSOR(tmp, 1.2);
+      results[narrow].push_back(tmp);
+
+      A.precondition_SSOR(tmp, src, 1.2, pos_right_of_diagonal);
+      results[narrow].push_back(tmp);
+
+      SparseILU<double> ilu;
+      ilu.initialize(A, SparseILU<double>::AdditionalData(0., 1));
+      ilu.vmult(tmp, src);
+      results[narrow].push_back(tmp);
+      ilu.Tvmult(tmp, src);
+      results[narrow].push_back(tmp);
+
+      // access all entries through the iterators of the sparsity pattern and
+      // through the entry lookup of the matrix
+      tmp = 0.;
+      for (unsigned int i = 0; i < n; ++i)
+        for (auto entry = sparsity.begin(i); entry != sparsity.end(i); ++entry)
+          tmp(i) += A(i, entry->column()) * src(entry->column()) +
+                    A.el(entry->column(), i);
+      results[narrow].push_back(tmp);
+
+      std::ostringstream out;
+      A.print(out);
+      printed[narrow] = out.str();
+
+      SparsityPattern      product_sparsity;
+      SparseMatrix<double> product(product_sparsity);
+      A.mmult(product, A);
+      product_norm[narrow]    = product.frobenius_norm();
+      product_entries[narrow] = product.n_nonzero_elements();
+    }
+
+  const std::string names[] = {"vmult",
+                               "vmult_add",
+                               "residual",
+                               "SOR",
+                               "TSOR",
+                               "SSOR",
+                               "ILU",
+                               "ILU^T",
+                               "entry lookup"};
+  for (unsigned int i = 0; i < results[0].size(); ++i)
+    compare(names[i], results[0][i], results[1][i]);
+  deallog << "print: " << (printed[0] == printed[1] ? "identical" : "differ")
+          << std::endl;
+  deallog << "mmult: "
+          << (product_norm[0] == product_norm[1] &&
+                  product_entries[0] == product_entries[1] ?
+                "identical" :
+                "differ")
+          << std::endl;
+
+  // the full column indices are released, so the narrow form needs less
+  // memory
+  deallog << "Memory reduced: " << (memory[1] < memory[0]) << std::endl;
+
+  // block_write() writes the full column indices, which block_read() reads
+  // into a pattern that is equal to the original one
+  std::stringstream stream;
+  sparsity.block_write(stream);
+  SparsityPattern read_sparsity;
+  read_sparsity.block_read(stream);
+  SparsityPattern original;
+  original.copy_from(dsp);
+  deallog << "block_write/block_read: "
+          << (read_sparsity == original && sparsity == original ? "equal" :
+                                                                 "differ")
+          << ", narrow after reading: "
+          << read_sparsity.has_narrow_column_indices() << std::endl;
+
+  // the pattern goes back to the full indices when it is reinitialized
+  sparsity.copy_from(dsp);
+  deallog << "Narrow column indices after reinit: "
+          << sparsity.has_narrow_column_indices() << std::endl;
+}
@@ -0,0 +1,218 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SymmetricSparseMatrix against SparseMatrix: assemble both with
+// AffineConstraints::distribute_local_to_global() from the element matrices
+// of bilinear elements on a structured grid with some constraints, and
+// compare the entries, matrix-vector products with one and several threads,
+// the SSOR preconditioner, SparseMIC, and the iterations of SolverCG
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/symmetric_sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int n_cells_per_direction)
+{
+  const unsigned int m = n_cells_per_direction + 1;
+  const unsigned int n = m * m;
+  deallog << "Size " << n << std::endl;
+
+  // constrain some vertices on the left edge to their neighbors as for
+  // hanging nodes, and the vertices on the bottom edge to a boundary value
+  AffineConstraints<double> constraints;
+  for (unsigned int i = 1; i < m - 1; i += 2)
+    {
+      constraints.add_line(i * m);
+      constraints.add_entry(i * m, (i - 1) * m, 0.5);
+      constraints.add_entry(i * m, (i + 1) * m, 0.5);
+    }
+  for (unsigned int j = 1; j < m; ++j)
+    {
+      constraints.add_line(j);
+      constraints.set_inhomogeneity(j, 0.1 * j);
+    }
+  constraints.close();
+
+  std::vector<std::vector<types::global_dof_index>> cells;
+  for (unsigned int i = 0; i < m - 1; ++i)
+    for (unsigned int j = 0; j < m - 1; ++j)
+      cells.push_back(
+        {i * m + j, i * m + j + 1, (i + 1) * m + j, (i + 1) * m + j + 1});
+
+  DynamicSparsityPattern dsp(n, n);
+  for (const auto &cell : cells)
+    constraints.add_entries_local_to_global(cell, dsp, false);
+  SparsityPattern sparsity, upper_sparsity;
+  sparsity.copy_from(dsp);
+  upper_sparsity.copy_upper_triangle_from(dsp);
+
+  // the stiffness matrix of a bilinear element plus a mass term that varies
+  // between the cells
+  SparseMatrix<double>          A(sparsity);
+  SymmetricSparseMatrix<double> S(upper_sparsity);
+  Vector<double>                rhs_A(n), rhs_S(n);
+  FullMatrix<double>            cell_matrix(4, 4);
+  Vector<double>                cell_rhs(4);
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      const double mass = 0.01 * (1. + std::sin(1. * c));
+      for (unsigned int i = 0; i < 4; ++i)
+        {
+          for (unsigned int j = 0; j < 4; ++j)
+            cell_matrix(i, j) =
+              (i == j ? 2. / 3. : ((i ^ j) == 3 ? -1. / 3. : -1. / 6.)) +
+              mass * (i == j ? 4. : ((i ^ j) == 3 ? 1. : 2.)) / 36.;
+          cell_rhs(i) = std::cos(0.1 * c + i);
+        }
+      constraints.distribute_local_to_global(
+        cell_matrix, cell_rhs, cells[c], A, rhs_A);
+      constraints.distribute_local_to_global(
+        cell_matrix, cell_rhs, cells[c], S, rhs_S);
+    }
+
+  deallog << "Stored entries: SparseMatrix " << A.n_nonzero_elements()
+          << ", SymmetricSparseMatrix " << S.n_nonzero_elements() << std::endl;
+
+  double matrix_difference = 0;
+  for (const auto &entry : A)
+    matrix_difference =
+      std::max(matrix_difference,
+               std::abs(entry.value() - S(entry.row(), entry.column())));
+  rhs_S -= rhs_A;
+  deallog << "Same entries: "
+          << (matrix_difference < 1e-15 && rhs_S.linfty_norm() < 1e-15 ? "yes" :
+                                                                           "no")
+          << std::endl;
+
+  // matrix-vector products
+  Vector<double> src(n), dst_A(n), dst_S(n), dst_serial(n);
+  for (unsigned int i = 0; i < n; ++i)
+    src(i) = std::cos(0.7 * i);
+
+  A.vmult(dst_A, src);
+  MultithreadInfo::set_thread_limit(1);
+  S.vmult(dst_serial, src);
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  S.vmult(dst_S, src);
+  dst_serial -= dst_S;
+  dst_S -= dst_A;
+  deallog << "vmult: error "
+          << (dst_S.linfty_norm() < 1e-14 * dst_A.linfty_norm() ? "ok" :
+                                                                  "wrong")
+          << ", independent of threads: "
+          << (dst_serial.linfty_norm() == 0 ? "yes" : "no") << std::endl;
+
+  A.vmult(dst_A, src);
+  dst_S = dst_A;
+  A.Tvmult_add(dst_A, src);
+  S.vmult_add(dst_S, src);
+  dst_S -= dst_A;
+  deallog << "vmult_add: error "
+          << (dst_S.linfty_norm() < 1e-14 * dst_A.linfty_norm() ? "ok" :
+                                                                  "wrong")
+          << std::endl;
+
+  const double residual_A = A.residual(dst_A, src, rhs_A);
+  const double residual_S = S.residual(dst_S, src, rhs_A);
+  dst_S -= dst_A;
+  deallog << "residual: error "
+          << (std::abs(residual_A - residual_S) < 1e-14 * residual_A &&
+                  dst_S.linfty_norm() < 1e-14 * dst_A.linfty_norm() ?
+                "ok" :
+                "wrong")
+          << std::endl;
+
+  // relaxation preconditioners
+  PreconditionSSOR<SparseMatrix<double>> ssor_A;
+  ssor_A.initialize(A, 1.2);
+  PreconditionSSOR<SymmetricSparseMatrix<double>> ssor_S;
+  ssor_S.initialize(S, 1.2);
+  ssor_A.vmult(dst_A, src);
+  ssor_S.vmult(dst_S, src);
+  dst_S -= dst_A;
+  deallog << "SSOR: error "
+          << (dst_S.linfty_norm() < 1e-13 * dst_A.linfty_norm() ? "ok" :
+                                                                  "wrong")
+          << std::endl;
+
+  SparseMIC<double> mic_A, mic_S;
+  mic_A.initialize(A);
+  mic_S.initialize(S);
+  mic_A.vmult(dst_A, src);
+  mic_S.vmult(dst_S, src);
+  dst_S -= dst_A;
+  deallog << "MIC: error "
+          << (dst_S.linfty_norm() < 1e-13 * dst_A.linfty_norm() ? "ok" :
+                                                                  "wrong")
+          << ", less memory: "
+          << (mic_S.memory_consumption() < mic_A.memory_consumption() ? "yes" :
+                                                                        "no")
+          << std::endl;
+
+  // solve with both matrices
+  for (const unsigned int preconditioner : {0, 1})
+    {
+      Vector<double> solution_A(n), solution_S(n);
+      SolverControl  control_A(1000, 1e-10 * rhs_A.l2_norm());
+      SolverControl  control_S(1000, 1e-10 * rhs_A.l2_norm());
+      SolverCG<>     solver_A(control_A), solver_S(control_S);
+      if (preconditioner == 0)
+        {
+          solver_A.solve(A, solution_A, rhs_A, ssor_A);
+          solver_S.solve(S, solution_S, rhs_A, ssor_S);
+        }
+      else
+        {
+          solver_A.solve(A, solution_A, rhs_A, mic_A);
+          solver_S.solve(S, solution_S, rhs_A, mic_S);
+        }
+      solution_S -= solution_A;
+      deallog << (preconditioner == 0 ? "SSOR" : "MIC")
+              << " CG iterations: SparseMatrix " << control_A.last_step()
+              << ", SymmetricSparseMatrix " << control_S.last_step()
+              << ", same solution: "
+              << (solution_S.linfty_norm() < 1e-8 * solution_A.linfty_norm() ?
+                    "yes" :
+                    "no")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  test(5);
+  test(40);
+  test(150);
+}
@@ -0,0 +1,134 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparsityPatternBuilder: add entries, with many duplicates, from
+// several tasks at once and compare the resulting SparsityPattern and
+// DynamicSparsityPattern with the ones built sequentially
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern_builder.h>
+
+#include "../tests.h"
+
+
+// the columns of the entries in row i: a band, plus some far away columns
+// that are added several times
+std::vector<types::global_dof_index>
+columns_of_row(const types::global_dof_index i, const types::global_dof_index n)
+{
+  std::vector<types::global_dof_index> columns;
+  for (types::global_dof_index j = (i < 3 ? 0 : i - 3); j < std::min(n, i + 4);
+       ++j)
+    columns.push_back(j);
+  for (unsigned int k = 0; k < 4; ++k)
+    columns.push_back((i * 17 + 5) % n);
+  columns.push_back((i * 7) % n);
+  return columns;
+}
+
+
+
+void
+test(const types::global_dof_index m, const types::global_dof_index n)
+{
+  deallog << "Size " << m << 'x' << n << std::endl;
+
+  DynamicSparsityPattern dsp(m, n);
+  for (types::global_dof_index i = 0; i < m; ++i)
+    for (const auto j : columns_of_row(i, n))
+      dsp.add(i, j);
+
+  // add every row several times, through the different functions, and
+  // from several tasks
+  SparsityPatternBuilder builder(m, n);
+  for (unsigned int repetition = 0; repetition < 3; ++repetition)
+    parallel::apply_to_subranges(
+      types::global_dof_index(0),
+      m,
+      [&](const types::global_dof_index begin,
+          const types::global_dof_index end) {
+        for (types::global_dof_index i = begin; i < end; ++i)
+          {
+            const auto columns = columns_of_row(i, n);
+            if (repetition == 0)
+              builder.add_row_entries(i, make_array_view(columns));
+            else if (repetition == 1)
+              {
+                std::vector<std::pair<types::global_dof_index,
+                                      types::global_dof_index>>
+                  entries;
+                for (const auto j : columns)
+                  entries.emplace_back(i, j);
+                builder.add_entries(make_array_view(entries));
+              }
+            else
+              for (const auto j : columns)
+                builder.add(i, j);
+          }
+      },
+      50);
+  deallog << "Buffered entries: "
+          << (builder.n_buffered_entries() >= dsp.n_nonzero_elements() ?
+                "ok" :
+                "too few")
+          << std::endl;
+
+  SparsityPattern sp_reference, sp;
+  sp_reference.copy_from(dsp);
+  builder.copy_to(sp);
+  deallog << "SparsityPattern: " << sp.n_nonzero_elements() << " entries, "
+          << (sp == sp_reference ? "identical" : "differ") << std::endl;
+
+  DynamicSparsityPattern dsp_copy(m, n);
+  builder.copy_to(dsp_copy);
+  bool identical = (dsp_copy.n_nonzero_elements() == dsp.n_nonzero_elements());
+  for (types::global_dof_index i = 0; i < m; ++i)
+    for (auto p = dsp.begin(i); p != dsp.end(i); ++p)
+      identical = identical && dsp_copy.exists(i, p->column());
+  deallog << "DynamicSparsityPattern: " << dsp_copy.n_nonzero_elements()
+          << " entries, " << (identical ? "identical" : "differ")
+          << std::endl;
+
+  // now copy into a pattern that only stores every other block of rows
+  IndexSet rows(m);
+  for (types::global_dof_index i = 0; i < m; i += 20)
+    rows.add_range(i, std::min(m, i + 10));
+  DynamicSparsityPattern dsp_rows(m, n, rows);
+  builder.copy_to(dsp_rows);
+  identical = true;
+  for (types::global_dof_index i = 0; i < m; ++i)
+    identical = identical && (dsp_rows.row_length(i) ==
+                              (rows.is_element(i) ? dsp.row_length(i) : 0));
+  deallog << "DynamicSparsityPattern with row set: "
+          << dsp_rows.n_nonzero_elements() << " entries, "
+          << (identical ? "identical" : "differ") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(1000, 1000);
+  test(500, 1500);
+  test(50000, 50000);
+}
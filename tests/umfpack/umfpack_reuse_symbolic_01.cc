@@ -0,0 +1,104 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparseDirectUMFPACK::AdditionalData::reuse_symbolic_factorization:
+// refactorize matrices with the same sparsity pattern but different entries,
+// as in a Newton iteration, and then a matrix with a different sparsity
+// pattern, and compare the solutions with those of a fresh factorization
+
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+
+void
+check(SparseDirectUMFPACK        &solver,
+      const SparseMatrix<double> &A,
+      const Vector<double>       &b)
+{
+  solver.factorize(A);
+  Vector<double> x(b.size());
+  solver.vmult(x, b);
+
+  SparseDirectUMFPACK fresh_solver;
+  fresh_solver.initialize(A);
+  Vector<double> x_fresh(b.size());
+  fresh_solver.vmult(x_fresh, b);
+
+  Vector<double> r(b.size());
+  A.residual(r, x, b);
+  x -= x_fresh;
+  deallog << "Residual: " << (r.l2_norm() < 1e-10 * b.l2_norm() ? "ok" : "no")
+          << ", same as fresh factorization: "
+          << (x.linfty_norm() < 1e-10 * x_fresh.linfty_norm() ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix testproblem(size, size);
+
+  SparsityPattern five_point(dim, dim, 5);
+  testproblem.five_point_structure(five_point);
+  five_point.compress();
+  SparseMatrix<double> A(five_point);
+
+  SparsityPattern nine_point(dim, dim, 9);
+  testproblem.nine_point_structure(nine_point);
+  nine_point.compress();
+  SparseMatrix<double> B(nine_point);
+
+  Vector<double> b(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    b(i) = std::sin(0.3 * i) + 1.;
+
+  SparseDirectUMFPACK solver;
+  testproblem.five_point(A);
+  solver.initialize(A, SparseDirectUMFPACK::AdditionalData(true));
+
+  // matrices with the same sparsity pattern but different entries, both
+  // symmetric and nonsymmetric ones
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      testproblem.five_point(A, step % 2 == 1);
+      for (unsigned int i = 0; i < dim; ++i)
+        A.diag_element(i) += step;
+      deallog << "Five-point stencil, step " << step << ": ";
+      check(solver, A, b);
+    }
+
+  // a different sparsity pattern requires a new symbolic factorization
+  testproblem.nine_point(B);
+  deallog << "Nine-point stencil: ";
+  check(solver, B, b);
+
+  // and back
+  testproblem.five_point(A);
+  deallog << "Five-point stencil: ";
+  check(solver, A, b);
+}
@@ -0,0 +1,72 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// check that Vector::reinit() sets all entries to zero when the vector grows
+// beyond its capacity, shrinks, or takes over the thread partitioning of
+// another vector, for sizes large enough to run the zeroing in parallel
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+check_zero(const Vector<double> &v)
+{
+  unsigned int n_nonzero = 0;
+  for (const double entry : v)
+    if (entry != 0.)
+      ++n_nonzero;
+  deallog << "size " << v.size() << ", nonzero entries: " << n_nonzero
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  Vector<double> v(100000), w;
+  v = 1.;
+
+  // grow beyond the capacity
+  v.reinit(300000);
+  check_zero(v);
+
+  // shrink
+  v = 2.;
+  v.reinit(150000);
+  check_zero(v);
+
+  // grow within the capacity
+  v = 3.;
+  v.reinit(250000);
+  check_zero(v);
+
+  // take the size and thread partitioning from another vector
+  w.reinit(v);
+  check_zero(w);
+  w = 4.;
+  w.reinit(v);
+  check_zero(w);
+
+  // omit zeroing entries only keeps the values if the size does not change
+  w = 5.;
+  w.reinit(v, true);
+  deallog << "entry after reinit with omit_zeroing_entries: " << w(1000)
+          << std::endl;
+}